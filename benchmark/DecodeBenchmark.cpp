@@ -0,0 +1,200 @@
+/**
+ * @brief Measures the throughput of the bulk conversion routines of @ref NetworkUtils and of the dynamic mesh decoder.
+ * @details Arrays of 32-bit values and indices in network byte order are converted with the scalar routines and with
+ * each vector routine that is supported by the CPU. Afterwards, dynamic mesh messages with 2000 vertices (a typical
+ * datagram) and one million vertices (a reassembled message) are decoded via @ref DynamicMeshMessage and compared with
+ * the previous per-element decoder loop. All throughputs are given in GB/s of input bytes.
+ *
+ * Usage: DecodeBenchmark [durationPerCaseSeconds]
+ */
+#include <Common.hpp>
+#include <DynamicMeshMessage.hpp>
+
+
+/**
+ * @brief Append a value in network byte order to a byte container.
+ * @param[inout] bytes The container to which to append the value.
+ * @param[in] value The value to be appended.
+ */
+template <typename T> static void Append(std::vector<uint8_t>& bytes, T value){
+    value = NetworkUtils::NetworkToNativeByteOrder(value);
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+    bytes.insert(bytes.end(), p, p + sizeof(T));
+}
+
+
+/**
+ * @brief Run a function repeatedly for a given duration and get the best throughput.
+ * @param[in] numBytes The number of input bytes that are processed by a single call of the function.
+ * @param[in] duration The duration in seconds.
+ * @param[in] function The function to be measured.
+ * @return The throughput in GB/s.
+ */
+template <typename F> static double Measure(size_t numBytes, double duration, F function){
+    double best = std::numeric_limits<double>::infinity();
+    auto start = std::chrono::steady_clock::now();
+    do {
+        auto t0 = std::chrono::steady_clock::now();
+        function();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    } while(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < duration);
+    return 1e-9 * static_cast<double>(numBytes) / best;
+}
+
+
+/**
+ * @brief Create a dynamic mesh message, where the counts and indices are 32-bit values if the number of vertices exceeds 16 bits.
+ * @param[in] numVertices The number of vertices.
+ * @return The serialized message.
+ */
+static std::vector<uint8_t> CreateDynamicMeshMessage(uint32_t numVertices){
+    const bool largeCounts = (numVertices > 0xFFFF);
+    DynamicMeshMessageUnion header{};
+    header.protocol.messageType = MESSAGE_TYPE_DYNAMIC_MESH;
+    header.protocol.meshID = NetworkUtils::NetworkToNativeByteOrder(uint32_t(1));
+    header.protocol.updateMesh = 1;
+    header.protocol.visible = 1;
+    header.protocol.quaternion.w = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    for(int k = 0; k < 3; ++k){
+        header.protocol.scale[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+        header.protocol.diffuseColorMultiplier[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+        header.protocol.specularColorMultiplier[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+        header.protocol.emissionColorMultiplier[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    }
+    header.protocol.shininessMultiplier = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    std::vector<uint8_t> bytes(header.bytes, header.bytes + sizeof(header));
+    auto appendCount = [&bytes, largeCounts](uint32_t value){
+        if(largeCounts){
+            Append(bytes, value);
+        }
+        else{
+            Append(bytes, static_cast<uint16_t>(value));
+        }
+    };
+    appendCount(numVertices);
+    for(uint32_t v = 0; v < numVertices; ++v){
+        Append(bytes, static_cast<GLfloat>(v % 2));
+        Append(bytes, std::sin(0.01f * static_cast<GLfloat>(v)));
+        Append(bytes, static_cast<GLfloat>(v / 2));
+        Append(bytes, 1.0f);
+        Append(bytes, 0.5f);
+        Append(bytes, 0.0f);
+    }
+    appendCount(3 * (numVertices - 2));
+    for(uint32_t v = 0; v < (numVertices - 2); ++v){
+        appendCount(v);
+        appendCount(v + 1);
+        appendCount(v + 2);
+    }
+    return bytes;
+}
+
+
+/**
+ * @brief The previous dynamic mesh decoder: one byte swap per element, scalar bounds and a range check per index.
+ * @param[in] bytes The serialized message.
+ * @param[in] largeCounts True if counts and indices are 32-bit values.
+ * @param[out] vertices The decoded vertices.
+ * @param[out] indices The decoded indices.
+ * @param[out] lowest The lowest position.
+ * @return True if success, false otherwise.
+ */
+static bool DecodePerElement(const std::vector<uint8_t>& bytes, bool largeCounts, std::vector<DynamicMeshVertex>& vertices, std::vector<GLuint>& indices, glm::vec3& lowest){
+    auto readCount = [&bytes, largeCounts](size_t offset){ return largeCounts ? static_cast<size_t>(NetworkUtils::ReadNetworkByteOrder<uint32_t>(&bytes[offset])) : static_cast<size_t>(NetworkUtils::ReadNetworkByteOrder<uint16_t>(&bytes[offset])); };
+    const size_t countSize = largeCounts ? sizeof(uint32_t) : sizeof(uint16_t);
+    size_t result = sizeof(DynamicMeshMessageUnion);
+    size_t numVertices = readCount(result);
+    result += countSize;
+    vertices.resize(numVertices);
+    glm::vec3 minPosition(std::numeric_limits<GLfloat>::infinity());
+    glm::vec3 maxPosition(-std::numeric_limits<GLfloat>::infinity());
+    for(size_t v = 0; v < numVertices; ++v){
+        const DynamicMeshMessageVertexUnion* vData = reinterpret_cast<const DynamicMeshMessageVertexUnion*>(&bytes[result]);
+        DynamicMeshVertex& vertex = vertices[v];
+        vertex.position[0] = NetworkUtils::NetworkToNativeByteOrder(vData->vertex.x);
+        vertex.position[1] = NetworkUtils::NetworkToNativeByteOrder(vData->vertex.y);
+        vertex.position[2] = NetworkUtils::NetworkToNativeByteOrder(vData->vertex.z);
+        vertex.color[0]    = NetworkUtils::NetworkToNativeByteOrder(vData->vertex.r);
+        vertex.color[1]    = NetworkUtils::NetworkToNativeByteOrder(vData->vertex.g);
+        vertex.color[2]    = NetworkUtils::NetworkToNativeByteOrder(vData->vertex.b);
+        minPosition.x = std::min(minPosition.x, vertex.position[0]);
+        minPosition.y = std::min(minPosition.y, vertex.position[1]);
+        minPosition.z = std::min(minPosition.z, vertex.position[2]);
+        maxPosition.x = std::max(maxPosition.x, vertex.position[0]);
+        maxPosition.y = std::max(maxPosition.y, vertex.position[1]);
+        maxPosition.z = std::max(maxPosition.z, vertex.position[2]);
+        result += sizeof(DynamicMeshMessageVertexUnion);
+    }
+    lowest = minPosition;
+    size_t numIndices = readCount(result);
+    result += countSize;
+    indices.resize(numIndices);
+    for(size_t i = 0; i < numIndices; ++i){
+        indices[i] = static_cast<GLuint>(readCount(result));
+        if(static_cast<size_t>(indices[i]) >= numVertices){
+            return false;
+        }
+        result += countSize;
+    }
+    return true;
+}
+
+
+int main(int argc, char** argv){
+    const double duration = (argc > 1) ? std::max(0.01, std::atof(argv[1])) : 0.5;
+    const char* levelNames[] = {"scalar", "sse4", "avx2"};
+    NetworkUtils::SIMDLevel supportedLevel = NetworkUtils::GetSIMDLevel();
+    std::printf("simd level: %s\n\n", levelNames[supportedLevel]);
+
+    // 32-bit arrays (in cache and out of cache)
+    for(size_t numValues : {size_t(12000), size_t(8) << 20}){
+        std::vector<uint8_t> source(4 * numValues);
+        for(size_t i = 0; i < source.size(); ++i){
+            source[i] = static_cast<uint8_t>(i * 2654435761u >> 13);
+        }
+        std::vector<uint32_t> destination(numValues);
+        std::printf("array32 (%zu values, %zu bytes)\n", numValues, source.size());
+        std::printf("  scalar: %7.2f GB/s\n", Measure(source.size(), duration, [&](){ NetworkUtils::ReadNetworkByteOrderArray32Scalar(destination.data(), source.data(), numValues); }));
+        #ifdef NETWORK_UTILS_X86
+        if(supportedLevel >= NetworkUtils::SIMD_LEVEL_SSE4){
+            std::printf("  sse4:   %7.2f GB/s\n", Measure(source.size(), duration, [&](){ NetworkUtils::ReadNetworkByteOrderArray32SSE4(destination.data(), source.data(), numValues); }));
+        }
+        if(supportedLevel >= NetworkUtils::SIMD_LEVEL_AVX2){
+            std::printf("  avx2:   %7.2f GB/s\n", Measure(source.size(), duration, [&](){ NetworkUtils::ReadNetworkByteOrderArray32AVX2(destination.data(), source.data(), numValues); }));
+        }
+        #endif
+        for(size_t i = 0; i < numValues; ++i){
+            uint16_t index = NetworkUtils::NativeToNetworkByteOrder(static_cast<uint16_t>(i));
+            std::memcpy(&source[2 * i], &index, sizeof(index));
+        }
+        volatile uint32_t sink = 0;
+        std::printf("indices16 (%zu values, %zu bytes)\n", numValues, 2 * numValues);
+        std::printf("  scalar: %7.2f GB/s\n", Measure(2 * numValues, duration, [&](){ sink = NetworkUtils::ReadNetworkByteOrderIndicesScalar<uint16_t>(destination.data(), source.data(), numValues); }));
+        std::printf("  best:   %7.2f GB/s\n", Measure(2 * numValues, duration, [&](){ sink = NetworkUtils::ReadNetworkByteOrderIndices16(destination.data(), source.data(), numValues); }));
+        std::printf("indices32 (%zu values, %zu bytes)\n", numValues, 4 * numValues);
+        std::printf("  scalar: %7.2f GB/s\n", Measure(4 * numValues, duration, [&](){ sink = NetworkUtils::ReadNetworkByteOrderIndicesScalar<uint32_t>(destination.data(), source.data(), numValues); }));
+        std::printf("  best:   %7.2f GB/s\n\n", Measure(4 * numValues, duration, [&](){ sink = NetworkUtils::ReadNetworkByteOrderIndices32(destination.data(), source.data(), numValues); }));
+        (void) sink;
+    }
+
+    // dynamic mesh messages
+    for(uint32_t numVertices : {uint32_t(2000), uint32_t(1000000)}){
+        const bool largeCounts = (numVertices > 0xFFFF);
+        std::vector<uint8_t> bytes = CreateDynamicMeshMessage(numVertices);
+        std::vector<DynamicMeshVertex> vertices;
+        std::vector<GLuint> indices;
+        glm::vec3 lowest;
+        DynamicMeshMessage message;
+        const int32_t length = static_cast<int32_t>(bytes.size());
+        int32_t rx = largeCounts ? message.DeserializeLarge(bytes.data(), length) : message.Deserialize(bytes.data(), length);
+        if((rx != length) || !DecodePerElement(bytes, largeCounts, vertices, indices, lowest) || (0 != std::memcmp(vertices.data(), message.meshVertices.data(), vertices.size() * sizeof(DynamicMeshVertex))) || (indices != message.meshIndices) || (lowest != message.aabbOfVertices.lowestPosition)){
+            std::printf("ERROR: decoders do not match\n");
+            return -1;
+        }
+        std::printf("dynamic mesh (%u vertices, %zu bytes)\n", numVertices, bytes.size());
+        std::printf("  per element: %7.2f GB/s\n", Measure(bytes.size(), duration, [&](){ (void) DecodePerElement(bytes, largeCounts, vertices, indices, lowest); }));
+        std::printf("  bulk:        %7.2f GB/s\n\n", Measure(bytes.size(), duration, [&](){ (void) (largeCounts ? message.DeserializeLarge(bytes.data(), length) : message.Deserialize(bytes.data(), length)); }));
+    }
+    return 0;
+}
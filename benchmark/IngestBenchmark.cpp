@@ -0,0 +1,359 @@
+/**
+ * @brief Stress-tests the message path from the UDP socket to the render thread with a synthetic load.
+ * @details A generator thread sends a configurable mix of pose-only mesh messages, point light messages, dynamic mesh
+ * messages with 2000 vertices and camera messages at a target rate via loopback (or the default multicast group) to a
+ * running @ref NetworkManager. Each datagram contains exactly one message. The main thread acts as render thread and
+ * fetches, applies and releases the messages once per frame. Applying a message only reads the decoded data, because
+ * there is no OpenGL context. At the end, the decoded message rate, the number of dropped datagrams, the depth of the
+ * message queue and the per-frame apply time are reported.
+ *
+ * Usage: IngestBenchmark [messagesPerSecond] [durationSeconds] [mix] [target] [framePeriodMs]
+ *  - mix: weights of pose:light:dynamicMesh:camera messages, e.g. "70:10:5:15"
+ *  - target: "loopback" or "multicast"
+ */
+#include <Common.hpp>
+#include <NetworkManager.hpp>
+#include <MessageManager.hpp>
+#include <PrismaConfiguration.hpp>
+
+
+static constexpr uint16_t benchmarkUDPPort = 31518;
+static constexpr uint32_t benchmarkNumObjects = 1000;
+static constexpr uint32_t benchmarkNumPointLights = 256;
+static constexpr uint32_t benchmarkNumDynamicMeshes = 16;
+static constexpr uint32_t benchmarkNumDynamicMeshVertices = 2000;
+
+
+/**
+ * @brief The message types that are generated by the benchmark.
+ */
+enum IngestMessageType {
+    INGEST_MESSAGE_POSE = 0,
+    INGEST_MESSAGE_POINT_LIGHT,
+    INGEST_MESSAGE_DYNAMIC_MESH,
+    INGEST_MESSAGE_CAMERA,
+    INGEST_MESSAGE_NUM_TYPES
+};
+
+
+/**
+ * @brief Append a value in network byte order to a byte container.
+ * @param[inout] bytes The container to which to append the value.
+ * @param[in] value The value to be appended.
+ */
+template <typename T> static void Append(std::vector<uint8_t>& bytes, T value){
+    value = NetworkUtils::NetworkToNativeByteOrder(value);
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+    bytes.insert(bytes.end(), p, p + sizeof(T));
+}
+
+
+/**
+ * @brief Create a pose-only mesh message, i.e. a mesh message that refers to an already loaded mesh.
+ * @param[in] id The mesh ID.
+ * @return The serialized message.
+ */
+static std::vector<uint8_t> CreatePoseMessage(uint32_t id){
+    const std::string name = "suzanne.obj";
+    MeshMessageUnion msg{};
+    msg.protocol.messageType = MESSAGE_TYPE_MESH;
+    msg.protocol.meshID = NetworkUtils::NetworkToNativeByteOrder(id);
+    msg.protocol.visible = 1;
+    msg.protocol.castShadow = 1;
+    msg.protocol.position[0] = NetworkUtils::NetworkToNativeByteOrder(static_cast<GLfloat>(id % 100));
+    msg.protocol.position[2] = NetworkUtils::NetworkToNativeByteOrder(static_cast<GLfloat>(id / 100));
+    msg.protocol.quaternion[0] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    for(int k = 0; k < 3; ++k){
+        msg.protocol.scale[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+        msg.protocol.diffuseColorMultiplier[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+        msg.protocol.specularColorMultiplier[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+        msg.protocol.emissionColorMultiplier[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    }
+    msg.protocol.shininessMultiplier = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    msg.protocol.nameStringLength = NetworkUtils::NetworkToNativeByteOrder(static_cast<uint16_t>(name.length()));
+    std::vector<uint8_t> bytes(msg.bytes, msg.bytes + sizeof(msg));
+    bytes.insert(bytes.end(), name.begin(), name.end());
+    return bytes;
+}
+
+
+/**
+ * @brief Create a point light message.
+ * @param[in] id The point light ID.
+ * @return The serialized message.
+ */
+static std::vector<uint8_t> CreatePointLightMessage(uint32_t id){
+    PointLightMessageUnion msg{};
+    msg.protocol.messageType = MESSAGE_TYPE_POINT_LIGHT;
+    msg.protocol.pointLightID = NetworkUtils::NetworkToNativeByteOrder(id);
+    msg.protocol.visible = 1;
+    for(int k = 0; k < 3; ++k){
+        msg.protocol.color[k] = NetworkUtils::NetworkToNativeByteOrder((k == static_cast<int>(id % 3)) ? 1.0f : 0.5f);
+    }
+    msg.protocol.position[0] = NetworkUtils::NetworkToNativeByteOrder(static_cast<GLfloat>(id % 16));
+    msg.protocol.position[1] = NetworkUtils::NetworkToNativeByteOrder(2.0f);
+    msg.protocol.position[2] = NetworkUtils::NetworkToNativeByteOrder(static_cast<GLfloat>(id / 16));
+    msg.protocol.quadraticFalloff = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    msg.protocol.invRadiusPow4 = NetworkUtils::NetworkToNativeByteOrder(0.0001f);
+    return std::vector<uint8_t>(msg.bytes, msg.bytes + sizeof(msg));
+}
+
+
+/**
+ * @brief Create a dynamic mesh message with @ref benchmarkNumDynamicMeshVertices vertices (16-bit counts and indices).
+ * @param[in] id The dynamic mesh ID.
+ * @return The serialized message.
+ */
+static std::vector<uint8_t> CreateDynamicMeshMessage(uint32_t id){
+    DynamicMeshMessageUnion header{};
+    header.protocol.messageType = MESSAGE_TYPE_DYNAMIC_MESH;
+    header.protocol.meshID = NetworkUtils::NetworkToNativeByteOrder(id);
+    header.protocol.updateMesh = 1;
+    header.protocol.visible = 1;
+    header.protocol.quaternion.w = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    for(int k = 0; k < 3; ++k){
+        header.protocol.scale[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+        header.protocol.diffuseColorMultiplier[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+        header.protocol.specularColorMultiplier[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+        header.protocol.emissionColorMultiplier[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    }
+    header.protocol.shininessMultiplier = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    std::vector<uint8_t> bytes(header.bytes, header.bytes + sizeof(header));
+    Append(bytes, static_cast<uint16_t>(benchmarkNumDynamicMeshVertices));
+    for(uint32_t v = 0; v < benchmarkNumDynamicMeshVertices; ++v){
+        Append(bytes, static_cast<GLfloat>(v % 2));
+        Append(bytes, std::sin(0.01f * static_cast<GLfloat>(v + id)));
+        Append(bytes, static_cast<GLfloat>(v / 2));
+        Append(bytes, 1.0f);
+        Append(bytes, 0.5f);
+        Append(bytes, 0.0f);
+    }
+    Append(bytes, static_cast<uint16_t>(3 * (benchmarkNumDynamicMeshVertices - 2)));
+    for(uint32_t v = 0; v < (benchmarkNumDynamicMeshVertices - 2); ++v){
+        Append(bytes, static_cast<uint16_t>(v));
+        Append(bytes, static_cast<uint16_t>(v + 1));
+        Append(bytes, static_cast<uint16_t>(v + 2));
+    }
+    return bytes;
+}
+
+
+/**
+ * @brief Create a camera message.
+ * @param[in] id An index that is used to vary the camera position.
+ * @return The serialized message.
+ */
+static std::vector<uint8_t> CreateCameraMessage(uint32_t id){
+    CameraMessageUnion msg{};
+    msg.protocol.messageType = MESSAGE_TYPE_CAMERA;
+    msg.protocol.mode = CAMERA_MODE_PERSPECTIVE;
+    msg.protocol.position[0] = NetworkUtils::NetworkToNativeByteOrder(10.0f * std::cos(0.01f * static_cast<GLfloat>(id)));
+    msg.protocol.position[1] = NetworkUtils::NetworkToNativeByteOrder(5.0f);
+    msg.protocol.position[2] = NetworkUtils::NetworkToNativeByteOrder(10.0f * std::sin(0.01f * static_cast<GLfloat>(id)));
+    msg.protocol.quaternion[3] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    msg.protocol.clipNear = NetworkUtils::NetworkToNativeByteOrder(0.01f);
+    msg.protocol.clipFar = NetworkUtils::NetworkToNativeByteOrder(1000.0f);
+    msg.protocol.orthographicLeft = NetworkUtils::NetworkToNativeByteOrder(-1.0f);
+    msg.protocol.orthographicRight = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    msg.protocol.orthographicBottom = NetworkUtils::NetworkToNativeByteOrder(-1.0f);
+    msg.protocol.orthographicTop = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    msg.protocol.perspectiveFieldOfView = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    return std::vector<uint8_t>(msg.bytes, msg.bytes + sizeof(msg));
+}
+
+
+/**
+ * @brief Create all messages that are sent by the generator, such that no message has to be created while sending.
+ * @return For each message type a list of serialized messages with different object IDs.
+ */
+static std::array<std::vector<std::vector<uint8_t>>, INGEST_MESSAGE_NUM_TYPES> CreateMessages(void){
+    std::array<std::vector<std::vector<uint8_t>>, INGEST_MESSAGE_NUM_TYPES> messages;
+    for(uint32_t id = 0; id < benchmarkNumObjects; ++id){
+        messages[INGEST_MESSAGE_POSE].push_back(CreatePoseMessage(id));
+    }
+    for(uint32_t id = 0; id < benchmarkNumPointLights; ++id){
+        messages[INGEST_MESSAGE_POINT_LIGHT].push_back(CreatePointLightMessage(id));
+    }
+    for(uint32_t id = 0; id < benchmarkNumDynamicMeshes; ++id){
+        messages[INGEST_MESSAGE_DYNAMIC_MESH].push_back(CreateDynamicMeshMessage(id));
+    }
+    for(uint32_t id = 0; id < benchmarkNumObjects; ++id){
+        messages[INGEST_MESSAGE_CAMERA].push_back(CreateCameraMessage(id));
+    }
+    return messages;
+}
+
+
+/**
+ * @brief Parse the message mix.
+ * @param[in] mix The weights of all message types separated by colons, e.g. "70:10:5:15".
+ * @return The weight of each message type.
+ */
+static std::array<double, INGEST_MESSAGE_NUM_TYPES> ParseMix(const std::string& mix){
+    std::array<double, INGEST_MESSAGE_NUM_TYPES> weights{};
+    size_t begin = 0;
+    for(size_t i = 0; (i < weights.size()) && (begin < mix.length()); ++i){
+        size_t end = mix.find(':', begin);
+        weights[i] = std::max(0.0, std::stod(mix.substr(begin, end - begin)));
+        begin = (std::string::npos == end) ? mix.length() : (end + 1);
+    }
+    return weights;
+}
+
+
+/**
+ * @brief Send messages at a target rate until the duration has elapsed.
+ * @param[in] messages For each message type a list of serialized messages that are sent in turn.
+ * @param[in] destination The destination address.
+ * @param[in] messagesPerSecond The target rate in messages per second.
+ * @param[in] durationSeconds The duration in seconds.
+ * @param[in] weights The weight of each message type.
+ * @param[out] numSent The number of messages that have been sent for each message type.
+ */
+static void Generate(const std::array<std::vector<std::vector<uint8_t>>, INGEST_MESSAGE_NUM_TYPES>& messages, IPAddress destination, double messagesPerSecond, double durationSeconds, std::array<double, INGEST_MESSAGE_NUM_TYPES> weights, std::array<uint64_t, INGEST_MESSAGE_NUM_TYPES>& numSent){
+    UDPSocket udpSocket;
+    if(!udpSocket.Open()){
+        return;
+    }
+    std::mt19937 generator(42);
+    std::discrete_distribution<int> distribution(weights.begin(), weights.end());
+    std::array<size_t, INGEST_MESSAGE_NUM_TYPES> next{};
+    uint64_t numTotal = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for(;;){
+        double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        if(t >= durationSeconds){
+            break;
+        }
+        uint64_t numTarget = static_cast<uint64_t>(t * messagesPerSecond);
+        if(numTotal >= numTarget){
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+        for(; numTotal < numTarget; ++numTotal){
+            int type = distribution(generator);
+            const std::vector<uint8_t>& bytes = messages[type][next[type]];
+            next[type] = (next[type] + 1) % messages[type].size();
+            (void) udpSocket.SendTo(destination, &bytes[0], static_cast<int32_t>(bytes.size()));
+            numSent[type]++;
+        }
+    }
+    udpSocket.Close();
+}
+
+
+/**
+ * @brief Apply fetched messages by reading the decoded data, as far as this is possible without an OpenGL context.
+ * @param[in] messages The messages that have been fetched from the message manager.
+ * @return A checksum of the decoded data, such that the work is not optimized away.
+ */
+static double ApplyMessages(const std::vector<MessageBaseType*>& messages){
+    double checksum = 0.0;
+    for(auto&& msg : messages){
+        switch(msg->messageType){
+            case MESSAGE_TYPE_MESH:
+                checksum += static_cast<const MeshMessage*>(msg)->object.position.x;
+                break;
+            case MESSAGE_TYPE_POINT_LIGHT:
+                checksum += static_cast<const PointLightMessage*>(msg)->pointLight.position.x;
+                break;
+            case MESSAGE_TYPE_DYNAMIC_MESH:
+                for(auto&& vertex : static_cast<const DynamicMeshMessage*>(msg)->meshVertices){
+                    checksum += vertex.position[1];
+                }
+                break;
+            case MESSAGE_TYPE_CAMERA:
+                checksum += static_cast<const CameraMessage*>(msg)->camera.position.x;
+                break;
+            default:
+                break;
+        }
+    }
+    return checksum;
+}
+
+
+int main(int argc, char** argv){
+    double messagesPerSecond = (argc > 1) ? std::stod(argv[1]) : 100000.0;
+    double durationSeconds = (argc > 2) ? std::stod(argv[2]) : 5.0;
+    std::string mix = (argc > 3) ? argv[3] : "70:10:5:15";
+    std::string target = (argc > 4) ? argv[4] : "loopback";
+    uint32_t framePeriodMs = (argc > 5) ? static_cast<uint32_t>(std::stoul(argv[5])) : 16;
+    std::array<double, INGEST_MESSAGE_NUM_TYPES> weights = ParseMix(mix);
+    #ifdef _WIN32
+    WSADATA wsadata;
+    (void) WSAStartup(MAKEWORD(2, 2), &wsadata);
+    #endif
+
+    // start the network manager, which joins the default multicast group
+    prismaConfiguration.Clear();
+    prismaConfiguration.network.localPort = benchmarkUDPPort;
+    IPAddress destination(127, 0, 0, 1, benchmarkUDPPort);
+    if("multicast" == target){
+        const auto& group = prismaConfiguration.network.receive.multicastGroups.at(0);
+        destination = IPAddress(group[0], group[1], group[2], group[3], benchmarkUDPPort);
+    }
+    else{
+        prismaConfiguration.network.receive.multicastGroups.clear();
+    }
+    std::printf("ingest: %.0f messages/s for %.1f s, mix (pose:light:dynamicMesh:camera) %s, target %u.%u.%u.%u:%u, frame period %u ms\n", messagesPerSecond, durationSeconds, mix.c_str(), destination.ip[0], destination.ip[1], destination.ip[2], destination.ip[3], destination.port, framePeriodMs);
+    NetworkManager networkManager;
+    networkManager.Start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    // generate messages and act as render thread
+    std::array<uint64_t, INGEST_MESSAGE_NUM_TYPES> numSent{};
+    std::atomic<bool> generating(true);
+    std::array<std::vector<std::vector<uint8_t>>, INGEST_MESSAGE_NUM_TYPES> generatedMessages = CreateMessages();
+    std::thread generator([&](){ Generate(generatedMessages, destination, messagesPerSecond, durationSeconds, weights, numSent); generating = false; });
+    std::vector<MessageBaseType*> messages;
+    std::vector<double> applyTimes;
+    uint64_t numFetched = 0;
+    size_t sumDepth = 0;
+    size_t maxDepth = 0;
+    double checksum = 0.0;
+    auto tStart = std::chrono::steady_clock::now();
+    auto tEnd = tStart;
+    for(auto tFrame = tStart; generating || (std::chrono::steady_clock::now() - tEnd) < std::chrono::milliseconds(200); tFrame += std::chrono::milliseconds(framePeriodMs)){
+        if(generating){
+            tEnd = std::chrono::steady_clock::now();
+        }
+        size_t depth = messageManager.GetStatistics().depth;
+        sumDepth += depth;
+        maxDepth = std::max(maxDepth, depth);
+        auto t0 = std::chrono::steady_clock::now();
+        messageManager.FetchMessages(messages);
+        numFetched += messages.size();
+        checksum += ApplyMessages(messages);
+        messageManager.ReleaseMessages(messages);
+        applyTimes.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+        std::this_thread::sleep_until(tFrame + std::chrono::milliseconds(framePeriodMs));
+    }
+    generator.join();
+    MessageQueueStatistics statistics = messageManager.GetStatistics();
+    networkManager.Stop();
+
+    // print results
+    double duration = std::chrono::duration<double>(tEnd - tStart).count();
+    uint64_t numSentTotal = 0;
+    for(auto&& n : numSent){
+        numSentTotal += n;
+    }
+    std::sort(applyTimes.begin(), applyTimes.end());
+    double sumApplyTimes = 0.0;
+    for(auto&& a : applyTimes){
+        sumApplyTimes += a;
+    }
+    uint64_t numDroppedDatagrams = (numSentTotal > statistics.numPushed) ? (numSentTotal - statistics.numPushed) : 0;
+    std::printf("sent:         %llu messages (pose %llu, light %llu, dynamicMesh %llu, camera %llu), %.0f messages/s\n", static_cast<unsigned long long>(numSentTotal), static_cast<unsigned long long>(numSent[INGEST_MESSAGE_POSE]), static_cast<unsigned long long>(numSent[INGEST_MESSAGE_POINT_LIGHT]), static_cast<unsigned long long>(numSent[INGEST_MESSAGE_DYNAMIC_MESH]), static_cast<unsigned long long>(numSent[INGEST_MESSAGE_CAMERA]), static_cast<double>(numSentTotal) / duration);
+    std::printf("decoded:      %llu messages, %.0f messages/s\n", static_cast<unsigned long long>(statistics.numPushed), static_cast<double>(statistics.numPushed) / duration);
+    std::printf("dropped:      %llu datagrams (%.2f %%) before decoding, %llu messages by the message queue, %llu messages coalesced\n", static_cast<unsigned long long>(numDroppedDatagrams), numSentTotal ? (100.0 * static_cast<double>(numDroppedDatagrams) / static_cast<double>(numSentTotal)) : 0.0, static_cast<unsigned long long>(statistics.numDropped), static_cast<unsigned long long>(statistics.numCoalesced));
+    std::printf("queue depth:  mean %.1f, max %zu (per frame), max %zu (total), capacity %zu\n", applyTimes.empty() ? 0.0 : (static_cast<double>(sumDepth) / static_cast<double>(applyTimes.size())), maxDepth, statistics.maxDepth, statistics.capacity);
+    if(!applyTimes.empty()){
+        std::printf("apply time:   %zu frames, %llu messages, mean %.3f ms, p50 %.3f ms, p99 %.3f ms, max %.3f ms (checksum %g)\n", applyTimes.size(), static_cast<unsigned long long>(numFetched), 1000.0 * sumApplyTimes / static_cast<double>(applyTimes.size()), 1000.0 * applyTimes[applyTimes.size() / 2], 1000.0 * applyTimes[(applyTimes.size() * 99) / 100], 1000.0 * applyTimes.back(), checksum);
+    }
+    #ifdef _WIN32
+    WSACleanup();
+    #endif
+    return 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * @brief Measures the startup time of a mesh library with and without mesh cache files.
+ * @details A synthetic asset directory with a given number of meshes is written to the temporary directory. Every second
+ * mesh is a textured OBJ file with a material library and its own PNG texture, all other meshes are ASCII ply files. All
+ * meshes are loaded one after the other like @ref MeshLibraryBase::LoadMeshData does:
+ *  - parse: every mesh file is parsed, no cache files are used,
+ *  - cold: every mesh file is parsed and its cache file is written,
+ *  - cached: every mesh is read from its cache file,
+ *  - touched: the modification times of all source files have changed (e.g. after a checkout), every mesh is read from
+ *    its cache file after the source files have been hashed,
+ *  - cached after touch: every mesh is read from its cache file without hashing, because the modification times have been
+ *    updated by the previous run.
+ * The benchmark exits with a non-zero value if a mesh cannot be loaded.
+ *
+ * Usage: MeshCacheBenchmark [numMeshes] [gridSize] [textureSize]
+ */
+#include <Common.hpp>
+#include <ColorMesh.hpp>
+#include <TextureMesh.hpp>
+#include <MeshCache.hpp>
+#include <PrismaConfiguration.hpp>
+#include <thirdparty/lodepng/lodepng.h>
+
+
+/**
+ * @brief Write a textured grid mesh to an OBJ file with a material library and a PNG texture.
+ * @param[in] filename The name of the OBJ file. The material library and the texture are written next to it.
+ * @param[in] gridSize The number of vertices along each side of the grid.
+ * @param[in] textureSize The width and height of the texture in pixels.
+ * @return True if success, false otherwise.
+ */
+static bool WriteObjMesh(const std::filesystem::path& filename, uint32_t gridSize, uint32_t textureSize){
+    std::filesystem::path mtlFilename = filename;
+    std::filesystem::path pngFilename = filename;
+    mtlFilename.replace_extension(".mtl");
+    pngFilename.replace_extension(".png");
+    std::vector<uint8_t> pixels(3 * static_cast<size_t>(textureSize) * textureSize);
+    uint32_t seed = static_cast<uint32_t>(std::hash<std::string>()(filename.string()));
+    for(size_t n = 0; n < pixels.size(); ++n){
+        seed = seed * 1664525u + 1013904223u;
+        pixels[n] = static_cast<uint8_t>((n / 3) % textureSize + (seed >> 28));
+    }
+    if(lodepng::encode(pngFilename.string(), pixels, textureSize, textureSize, LCT_RGB, 8)){
+        return false;
+    }
+    std::ofstream mtl(mtlFilename, std::ofstream::binary);
+    mtl << "newmtl grid\nNs 32.0\nKa 0.0 0.0 0.0\nKd 1.0 1.0 1.0\nKs 0.5 0.5 0.5\nKe 0.0 0.0 0.0\nd 1.0\nmap_Kd " << pngFilename.filename().string() << "\n";
+    if(!mtl.good()){
+        return false;
+    }
+    std::ofstream file(filename, std::ofstream::binary);
+    file << "# synthetic grid mesh\nmtllib " << mtlFilename.filename().string() << "\no grid\n";
+    char line[256];
+    for(uint32_t y = 0; y < gridSize; ++y){
+        for(uint32_t x = 0; x < gridSize; ++x){
+            float px = 0.01f * static_cast<float>(x);
+            float py = 0.01f * static_cast<float>(y);
+            float pz = 0.1f * std::sin(0.05f * static_cast<float>(x)) * std::cos(0.05f * static_cast<float>(y));
+            int n = std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\nvn 0 0 1\nvt %.6f %.6f\n", px, py, pz, static_cast<float>(x) / static_cast<float>(gridSize - 1), static_cast<float>(y) / static_cast<float>(gridSize - 1));
+            file.write(line, n);
+        }
+    }
+    file << "usemtl grid\n";
+    for(uint32_t y = 0; (y + 1) < gridSize; ++y){
+        for(uint32_t x = 0; (x + 1) < gridSize; ++x){
+            uint32_t i0 = y * gridSize + x + 1;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + gridSize;
+            uint32_t i3 = i2 + 1;
+            int n = std::snprintf(line, sizeof(line), "f %u/%u/%u %u/%u/%u %u/%u/%u\nf %u/%u/%u %u/%u/%u %u/%u/%u\n", i0, i0, i0, i1, i1, i1, i3, i3, i3, i0, i0, i0, i3, i3, i3, i2, i2, i2);
+            file.write(line, n);
+        }
+    }
+    return file.good();
+}
+
+
+/**
+ * @brief Write a colored grid mesh to an ASCII ply file.
+ * @param[in] filename The name of the ply file.
+ * @param[in] gridSize The number of vertices along each side of the grid.
+ * @return True if success, false otherwise.
+ */
+static bool WritePlyMesh(const std::filesystem::path& filename, uint32_t gridSize){
+    std::ofstream file(filename, std::ofstream::binary);
+    file << "ply\nformat ascii 1.0\ncomment synthetic grid mesh\n";
+    file << "element vertex " << (gridSize * gridSize) << "\n";
+    file << "property float x\nproperty float y\nproperty float z\n";
+    file << "property float nx\nproperty float ny\nproperty float nz\n";
+    file << "property uchar red\nproperty uchar green\nproperty uchar blue\n";
+    file << "element face " << (2 * (gridSize - 1) * (gridSize - 1)) << "\n";
+    file << "property list uchar int vertex_indices\nend_header\n";
+    char line[256];
+    for(uint32_t y = 0; y < gridSize; ++y){
+        for(uint32_t x = 0; x < gridSize; ++x){
+            float px = 0.01f * static_cast<float>(x);
+            float py = 0.01f * static_cast<float>(y);
+            float pz = 0.1f * std::sin(0.05f * static_cast<float>(x)) * std::cos(0.05f * static_cast<float>(y));
+            int n = std::snprintf(line, sizeof(line), "%g %g %g 0 0 1 %u %u %u\n", px, py, pz, x & 0xFF, y & 0xFF, (x ^ y) & 0xFF);
+            file.write(line, n);
+        }
+    }
+    for(uint32_t y = 0; (y + 1) < gridSize; ++y){
+        for(uint32_t x = 0; (x + 1) < gridSize; ++x){
+            uint32_t i0 = y * gridSize + x;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + gridSize;
+            uint32_t i3 = i2 + 1;
+            int n = std::snprintf(line, sizeof(line), "3 %u %u %u\n3 %u %u %u\n", i0, i1, i3, i0, i3, i2);
+            file.write(line, n);
+        }
+    }
+    return file.good();
+}
+
+
+/**
+ * @brief Create an empty mesh for a mesh file based on its extension.
+ * @param[in] filename The name of the mesh file.
+ * @return The mesh.
+ */
+static std::unique_ptr<MeshBase> CreateMesh(const std::string& filename){
+    if(filename.ends_with(".ply")){
+        return std::make_unique<ColorMesh>();
+    }
+    return std::make_unique<TextureMesh>();
+}
+
+
+/**
+ * @brief Load all meshes and print the total load time.
+ * @param[in] name The name of the run.
+ * @param[in] filenames The names of all mesh files.
+ * @param[in] readCache True if the meshes are to be read from their cache files.
+ * @param[in] writeCache True if the cache files are to be written after a mesh file has been parsed.
+ * @return True if success, false if at least one mesh could not be loaded.
+ */
+static bool LoadMeshes(const std::string& name, const std::vector<std::string>& filenames, bool readCache, bool writeCache){
+    bool success = true;
+    auto t0 = std::chrono::steady_clock::now();
+    for(auto&& filename : filenames){
+        std::unique_ptr<MeshBase> mesh = CreateMesh(filename);
+        if(readCache){
+            success &= MeshCache::Read(filename, *mesh);
+            continue;
+        }
+        success &= mesh->ReadFromFile(filename);
+        if(writeCache){
+            success &= MeshCache::Write(filename, *mesh);
+        }
+    }
+    double ms = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count() * 1000.0;
+    std::printf("%-19s %s %10.3f ms %8.3f ms/mesh\n", name.c_str(), success ? "ok    " : "FAILED", ms, ms / static_cast<double>(filenames.size()));
+    return success;
+}
+
+
+int main(int argc, char** argv){
+    uint32_t numMeshes = (argc > 1) ? static_cast<uint32_t>(std::stoul(argv[1])) : 200;
+    uint32_t gridSize = (argc > 2) ? std::max(2u, static_cast<uint32_t>(std::stoul(argv[2]))) : 200;
+    uint32_t textureSize = (argc > 3) ? std::max(1u, static_cast<uint32_t>(std::stoul(argv[3]))) : 512;
+    prismaConfiguration.Clear();
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "prisma_mesh_cache_benchmark";
+    std::error_code ec;
+    (void) std::filesystem::remove_all(directory, ec);
+    if(!std::filesystem::create_directories(directory, ec)){
+        PrintE("Could not create directory \"%s\"\n", directory.string().c_str());
+        return -1;
+    }
+
+    // write the asset directory
+    std::vector<std::string> filenames;
+    uintmax_t numBytes = 0;
+    for(uint32_t i = 0; i < numMeshes; ++i){
+        std::filesystem::path filename = directory / ("mesh" + std::to_string(i) + ((i % 2) ? ".ply" : ".obj"));
+        if(!((i % 2) ? WritePlyMesh(filename, gridSize) : WriteObjMesh(filename, gridSize, textureSize))){
+            PrintE("Could not write mesh file \"%s\"\n", filename.string().c_str());
+            return -1;
+        }
+        filenames.push_back(filename.string());
+    }
+    for(auto&& entry : std::filesystem::directory_iterator(directory, ec)){
+        numBytes += entry.file_size();
+    }
+    std::printf("assets: %u meshes (%u obj with %ux%u png texture, %u ascii ply), %u x %u vertices each, %.1f MB\n", numMeshes, (numMeshes + 1) / 2, textureSize, textureSize, numMeshes / 2, gridSize, gridSize, static_cast<double>(numBytes) / 1048576.0);
+
+    // load all meshes
+    bool success = LoadMeshes("parse", filenames, false, false);
+    success &= LoadMeshes("cold", filenames, false, true);
+    success &= LoadMeshes("cached", filenames, true, false);
+    auto touchTime = std::filesystem::file_time_type::clock::now();
+    for(auto&& entry : std::filesystem::directory_iterator(directory, ec)){
+        if(!entry.path().string().ends_with(".prismamesh")){
+            std::filesystem::last_write_time(entry.path(), touchTime, ec);
+        }
+    }
+    success &= LoadMeshes("touched", filenames, true, false);
+    success &= LoadMeshes("cached after touch", filenames, true, false);
+    (void) std::filesystem::remove_all(directory, ec);
+    return success ? 0 : -1;
+}
@@ -0,0 +1,404 @@
+/**
+ * @brief Measures the decode path (Deserialize and IsValid) of every message type and the serialization of window event messages.
+ * @details Each message type is decoded with realistic payloads, e.g. a mesh pose message with 256 meshes or a dynamic mesh
+ * message with 2000 vertices as it fits into a single datagram. The message object is reused like it is done by the message
+ * pool of the @ref MessageManager. For each case, the time per message and the number of heap allocations per message are
+ * reported, both for a reused message object (steady state) and for a new message object (first use).
+ *
+ * Usage: MessageBenchmark [durationPerCaseSeconds]
+ */
+#include <Common.hpp>
+#include <AmbientLightMessage.hpp>
+#include <AtmosphereMessage.hpp>
+#include <CameraMessage.hpp>
+#include <ClearMessage.hpp>
+#include <DirectionalLightMessage.hpp>
+#include <DynamicMeshMessage.hpp>
+#include <DynamicMeshPatchMessage.hpp>
+#include <EngineParameterMessage.hpp>
+#include <FragmentMessage.hpp>
+#include <MeshMessage.hpp>
+#include <MeshPoseMessage.hpp>
+#include <PointLightMessage.hpp>
+#include <SpotLightMessage.hpp>
+#include <WaterMeshMessage.hpp>
+#include <WindowEventMessage.hpp>
+
+
+/* Count all heap allocations of the process */
+static std::atomic<uint64_t> numAllocations(0);
+__attribute__((noinline)) static void* Allocate(std::size_t size){
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    if(void* p = std::malloc(size ? size : 1)){
+        return p;
+    }
+    throw std::bad_alloc();
+}
+__attribute__((noinline)) static void Deallocate(void* p){ std::free(p); }
+void* operator new(std::size_t size){ return Allocate(size); }
+void* operator new[](std::size_t size){ return Allocate(size); }
+void operator delete(void* p) noexcept { Deallocate(p); }
+void operator delete[](void* p) noexcept { Deallocate(p); }
+void operator delete(void* p, std::size_t) noexcept { Deallocate(p); }
+void operator delete[](void* p, std::size_t) noexcept { Deallocate(p); }
+
+
+/**
+ * @brief Append a value in network byte order to a byte container.
+ * @param[inout] bytes The container to which to append the value.
+ * @param[in] value The value to be appended.
+ */
+template <typename T> static void Append(std::vector<uint8_t>& bytes, T value){
+    value = NetworkUtils::NetworkToNativeByteOrder(value);
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+    bytes.insert(bytes.end(), p, p + sizeof(T));
+}
+
+
+/**
+ * @brief Convert a fixed-size message union to a byte container.
+ * @param[in] msg The message union.
+ * @return The serialized message.
+ */
+template <typename T> static std::vector<uint8_t> ToBytes(const T& msg){
+    return std::vector<uint8_t>(msg.bytes, msg.bytes + sizeof(msg));
+}
+
+
+/**
+ * @brief Measure the decode path of a message type and print the result.
+ * @tparam T The message type.
+ * @param[in] name The name of the case.
+ * @param[in] bytes The serialized message.
+ * @param[in] duration The duration of the measurement in seconds.
+ * @param[in] decode A function (T&, const uint8_t*, int32_t) that returns the number of deserialized bytes.
+ * @return True if the message has been decoded completely and is valid, false otherwise.
+ */
+template <typename T, typename F> static bool Run(const char* name, const std::vector<uint8_t>& bytes, double duration, F decode){
+    const int32_t length = static_cast<int32_t>(bytes.size());
+    T message;
+    if((decode(message, bytes.data(), length) != length) || !message.IsValid()){
+        std::printf("ERROR: %s could not be decoded\n", name);
+        return false;
+    }
+
+    // reused message object
+    uint64_t numMessages = 0;
+    uint64_t allocations = numAllocations.load();
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point end;
+    volatile bool valid = true;
+    do {
+        for(int k = 0; k < 64; ++k){
+            (void) decode(message, bytes.data(), length);
+            valid = message.IsValid();
+        }
+        numMessages += 64;
+        end = std::chrono::steady_clock::now();
+    } while(std::chrono::duration<double>(end - start).count() < duration);
+    double nsPerMessage = 1e9 * std::chrono::duration<double>(end - start).count() / static_cast<double>(numMessages);
+    double allocationsReused = static_cast<double>(numAllocations.load() - allocations) / static_cast<double>(numMessages);
+
+    // new message object
+    constexpr uint64_t numNewMessages = 256;
+    allocations = numAllocations.load();
+    for(uint64_t k = 0; k < numNewMessages; ++k){
+        T newMessage;
+        (void) decode(newMessage, bytes.data(), length);
+        valid = newMessage.IsValid();
+    }
+    double allocationsNew = static_cast<double>(numAllocations.load() - allocations) / static_cast<double>(numNewMessages);
+    std::printf("%-26s %8d %12.1f %14.2f %12.2f\n", name, length, nsPerMessage, allocationsReused, allocationsNew);
+    return valid;
+}
+
+
+/**
+ * @brief Measure the decode path of a message type that is decoded via Deserialize.
+ */
+template <typename T> static bool Run(const char* name, const std::vector<uint8_t>& bytes, double duration){
+    return Run<T>(name, bytes, duration, [](T& message, const uint8_t* b, int32_t n){ return message.Deserialize(b, n); });
+}
+
+
+static std::vector<uint8_t> CreateCameraMessage(void){
+    CameraMessageUnion msg{};
+    msg.protocol.messageType = MESSAGE_TYPE_CAMERA;
+    msg.protocol.mode = CAMERA_MODE_PERSPECTIVE;
+    msg.protocol.hasTimestamp = 1;
+    msg.protocol.position[1] = NetworkUtils::NativeToNetworkByteOrder(10.0f);
+    msg.protocol.quaternion[3] = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+    msg.protocol.clipNear = NetworkUtils::NativeToNetworkByteOrder(0.1f);
+    msg.protocol.clipFar = NetworkUtils::NativeToNetworkByteOrder(1000.0f);
+    msg.protocol.perspectiveFieldOfView = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+    std::vector<uint8_t> bytes = ToBytes(msg);
+    Append(bytes, 12.5);
+    return bytes;
+}
+
+
+static std::vector<uint8_t> CreateMeshMessage(void){
+    const std::string name = "models/vehicle/hull.obj";
+    MeshMessageUnion msg{};
+    msg.protocol.messageType = MESSAGE_TYPE_MESH;
+    msg.protocol.meshID = NetworkUtils::NativeToNetworkByteOrder(uint32_t(7));
+    msg.protocol.visible = 1;
+    msg.protocol.castShadow = 1;
+    msg.protocol.hasTimestamp = 1;
+    msg.protocol.quaternion.w = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+    for(int k = 0; k < 3; ++k){
+        msg.protocol.scale[k] = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+        msg.protocol.diffuseColorMultiplier[k] = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+        msg.protocol.specularColorMultiplier[k] = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+        msg.protocol.emissionColorMultiplier[k] = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+    }
+    msg.protocol.shininessMultiplier = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+    msg.protocol.nameStringLength = NetworkUtils::NativeToNetworkByteOrder(static_cast<uint16_t>(name.size()));
+    std::vector<uint8_t> bytes = ToBytes(msg);
+    Append(bytes, 12.5);
+    bytes.insert(bytes.end(), name.begin(), name.end());
+    return bytes;
+}
+
+
+static std::vector<uint8_t> CreateMeshPoseMessage(uint16_t numMeshes, bool compressed){
+    MeshPoseMessageUnion msg{};
+    msg.protocol.messageType = MESSAGE_TYPE_MESH_POSE;
+    msg.protocol.hasScale = 1;
+    msg.protocol.compressedQuaternion = compressed;
+    msg.protocol.halfScale = compressed;
+    msg.protocol.hasTimestamp = 1;
+    msg.protocol.numberOfMeshes = NetworkUtils::NativeToNetworkByteOrder(numMeshes);
+    std::vector<uint8_t> bytes = ToBytes(msg);
+    Append(bytes, 12.5);
+    for(uint32_t i = 0; i < numMeshes; ++i){
+        Append(bytes, i);
+    }
+    for(uint32_t i = 0; i < numMeshes; ++i){
+        Append(bytes, static_cast<GLfloat>(i));
+        Append(bytes, 0.5f);
+        Append(bytes, -static_cast<GLfloat>(i));
+    }
+    for(uint32_t i = 0; i < numMeshes; ++i){
+        if(compressed){
+            Append(bytes, uint32_t((512u << 20) | (512u << 10) | 512u));
+        }
+        else{
+            Append(bytes, 1.0f);
+            Append(bytes, 0.0f);
+            Append(bytes, 0.0f);
+            Append(bytes, 0.0f);
+        }
+    }
+    for(uint32_t i = 0; i < numMeshes; ++i){
+        for(int k = 0; k < 3; ++k){
+            if(compressed){
+                Append(bytes, uint16_t(0x3C00)); // 1.0 as half-precision float
+            }
+            else{
+                Append(bytes, 1.0f);
+            }
+        }
+    }
+    return bytes;
+}
+
+
+static std::vector<uint8_t> CreateWaterMeshMessage(uint16_t numPolygons, uint16_t numVertices){
+    WaterMeshMessageUnion msg{};
+    msg.protocol.messageType = MESSAGE_TYPE_WATER_MESH;
+    msg.protocol.updateMesh = 1;
+    msg.protocol.visible = 1;
+    std::vector<uint8_t> bytes = ToBytes(msg);
+    Append(bytes, numPolygons);
+    for(uint16_t p = 0; p < numPolygons; ++p){
+        Append(bytes, numVertices);
+        for(uint16_t v = 0; v < numVertices; ++v){
+            GLfloat angle = 6.28318530718f * static_cast<GLfloat>(v) / static_cast<GLfloat>(numVertices);
+            GLfloat radius = (v % 2) ? 80.0f : 100.0f;
+            Append(bytes, 300.0f * static_cast<GLfloat>(p) + radius * std::cos(angle));
+            Append(bytes, radius * std::sin(angle));
+        }
+    }
+    return bytes;
+}
+
+
+static std::vector<uint8_t> CreateDynamicMeshMessage(uint32_t numVertices){
+    const bool largeCounts = (numVertices > 0xFFFF);
+    DynamicMeshMessageUnion msg{};
+    msg.protocol.messageType = MESSAGE_TYPE_DYNAMIC_MESH;
+    msg.protocol.meshID = NetworkUtils::NativeToNetworkByteOrder(uint32_t(1));
+    msg.protocol.updateMesh = 1;
+    msg.protocol.visible = 1;
+    msg.protocol.quaternion.w = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+    for(int k = 0; k < 3; ++k){
+        msg.protocol.scale[k] = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+        msg.protocol.diffuseColorMultiplier[k] = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+        msg.protocol.specularColorMultiplier[k] = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+        msg.protocol.emissionColorMultiplier[k] = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+    }
+    msg.protocol.shininessMultiplier = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+    std::vector<uint8_t> bytes = ToBytes(msg);
+    auto appendCount = [&bytes, largeCounts](uint32_t value){
+        if(largeCounts){
+            Append(bytes, value);
+        }
+        else{
+            Append(bytes, static_cast<uint16_t>(value));
+        }
+    };
+    appendCount(numVertices);
+    for(uint32_t v = 0; v < numVertices; ++v){
+        Append(bytes, static_cast<GLfloat>(v % 2));
+        Append(bytes, std::sin(0.01f * static_cast<GLfloat>(v)));
+        Append(bytes, static_cast<GLfloat>(v / 2));
+        Append(bytes, 1.0f);
+        Append(bytes, 0.5f);
+        Append(bytes, 0.0f);
+    }
+    appendCount(3 * (numVertices - 2));
+    for(uint32_t v = 0; v < (numVertices - 2); ++v){
+        appendCount(v);
+        appendCount(v + 1);
+        appendCount(v + 2);
+    }
+    return bytes;
+}
+
+
+static std::vector<uint8_t> CreateDynamicMeshPatchMessage(uint16_t numVertices, uint16_t numIndices){
+    DynamicMeshPatchMessageUnion msg{};
+    msg.protocol.messageType = MESSAGE_TYPE_DYNAMIC_MESH_PATCH;
+    msg.protocol.meshID = NetworkUtils::NativeToNetworkByteOrder(uint32_t(1));
+    msg.protocol.vertexOffset = NetworkUtils::NativeToNetworkByteOrder(uint32_t(100));
+    std::vector<uint8_t> bytes = ToBytes(msg);
+    Append(bytes, numVertices);
+    for(uint16_t v = 0; v < numVertices; ++v){
+        Append(bytes, static_cast<GLfloat>(v));
+        Append(bytes, 1.0f);
+        Append(bytes, 2.0f);
+        Append(bytes, 1.0f);
+        Append(bytes, 0.5f);
+        Append(bytes, 0.0f);
+    }
+    Append(bytes, uint32_t(300));
+    Append(bytes, numIndices);
+    for(uint16_t i = 0; i < numIndices; ++i){
+        Append(bytes, static_cast<uint32_t>(100 + i / 3 + i % 3));
+    }
+    return bytes;
+}
+
+
+static std::vector<uint8_t> CreateFragmentMessage(uint16_t payloadLength){
+    FragmentMessageUnion msg{};
+    msg.protocol.messageType = MESSAGE_TYPE_FRAGMENT;
+    msg.protocol.transferID = NetworkUtils::NativeToNetworkByteOrder(uint32_t(42));
+    msg.protocol.fragmentIndex = NetworkUtils::NativeToNetworkByteOrder(uint16_t(3));
+    msg.protocol.fragmentCount = NetworkUtils::NativeToNetworkByteOrder(uint16_t(10));
+    msg.protocol.totalLength = NetworkUtils::NativeToNetworkByteOrder(uint32_t(10 * payloadLength));
+    msg.protocol.payloadOffset = NetworkUtils::NativeToNetworkByteOrder(uint32_t(3 * payloadLength));
+    msg.protocol.payloadLength = NetworkUtils::NativeToNetworkByteOrder(payloadLength);
+    std::vector<uint8_t> bytes = ToBytes(msg);
+    bytes.resize(bytes.size() + payloadLength, 0xAB);
+    return bytes;
+}
+
+
+int main(int argc, char** argv){
+    const double duration = (argc > 1) ? std::max(0.01, std::atof(argv[1])) : 0.2;
+    std::printf("%-26s %8s %12s %14s %12s\n", "message", "bytes", "ns/message", "allocs/reused", "allocs/new");
+    bool success = true;
+    {
+        ClearMessageUnion msg{};
+        msg.protocol.messageType = MESSAGE_TYPE_CLEAR;
+        success &= Run<ClearMessage>("clear", ToBytes(msg), duration);
+    }
+    {
+        EngineParameterMessageUnion msg{};
+        msg.protocol.messageType = MESSAGE_TYPE_ENGINE_PARAMETER;
+        msg.protocol.gamma = NetworkUtils::NativeToNetworkByteOrder(2.2f);
+        msg.protocol.exposure = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+        success &= Run<EngineParameterMessage>("engineParameter", ToBytes(msg), duration);
+    }
+    success &= Run<CameraMessage>("camera", CreateCameraMessage(), duration);
+    {
+        AtmosphereMessageUnion msg{};
+        msg.protocol.messageType = MESSAGE_TYPE_ATMOSPHERE;
+        msg.protocol.sunLightDirection[1] = NetworkUtils::NativeToNetworkByteOrder(-1.0f);
+        msg.protocol.radiusPlanet = NetworkUtils::NativeToNetworkByteOrder(6371000.0f);
+        msg.protocol.radiusAtmosphere = NetworkUtils::NativeToNetworkByteOrder(6471000.0f);
+        msg.protocol.numRayTracingSteps[0] = 16;
+        msg.protocol.numRayTracingSteps[1] = 8;
+        success &= Run<AtmosphereMessage>("atmosphere", ToBytes(msg), duration);
+    }
+    {
+        AmbientLightMessageUnion msg{};
+        msg.protocol.messageType = MESSAGE_TYPE_AMBIENT_LIGHT;
+        msg.protocol.color[0] = msg.protocol.color[1] = msg.protocol.color[2] = NetworkUtils::NativeToNetworkByteOrder(0.1f);
+        success &= Run<AmbientLightMessage>("ambientLight", ToBytes(msg), duration);
+    }
+    {
+        DirectionalLightMessageUnion msg{};
+        msg.protocol.messageType = MESSAGE_TYPE_DIRECTIONAL_LIGHT;
+        msg.protocol.directionalLightID = NetworkUtils::NativeToNetworkByteOrder(uint32_t(1));
+        msg.protocol.visible = 1;
+        msg.protocol.direction[1] = NetworkUtils::NativeToNetworkByteOrder(-1.0f);
+        success &= Run<DirectionalLightMessage>("directionalLight", ToBytes(msg), duration);
+    }
+    {
+        PointLightMessageUnion msg{};
+        msg.protocol.messageType = MESSAGE_TYPE_POINT_LIGHT;
+        msg.protocol.pointLightID = NetworkUtils::NativeToNetworkByteOrder(uint32_t(1));
+        msg.protocol.visible = 1;
+        msg.protocol.color[0] = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+        msg.protocol.quadraticFalloff = NetworkUtils::NativeToNetworkByteOrder(0.1f);
+        msg.protocol.invRadiusPow4 = NetworkUtils::NativeToNetworkByteOrder(0.0001f);
+        success &= Run<PointLightMessage>("pointLight", ToBytes(msg), duration);
+    }
+    {
+        SpotLightMessageUnion msg{};
+        msg.protocol.messageType = MESSAGE_TYPE_SPOT_LIGHT;
+        msg.protocol.spotLightID = NetworkUtils::NativeToNetworkByteOrder(uint32_t(1));
+        msg.protocol.visible = 1;
+        msg.protocol.direction[2] = NetworkUtils::NativeToNetworkByteOrder(1.0f);
+        msg.protocol.cosInnerCutOffAngle = NetworkUtils::NativeToNetworkByteOrder(0.9f);
+        msg.protocol.cosOuterCutOffAngle = NetworkUtils::NativeToNetworkByteOrder(0.8f);
+        success &= Run<SpotLightMessage>("spotLight", ToBytes(msg), duration);
+    }
+    success &= Run<MeshMessage>("mesh", CreateMeshMessage(), duration);
+    success &= Run<MeshPoseMessage>("meshPose (256, float)", CreateMeshPoseMessage(256, false), duration);
+    success &= Run<MeshPoseMessage>("meshPose (256, compressed)", CreateMeshPoseMessage(256, true), duration);
+    success &= Run<WaterMeshMessage>("waterMesh (4x64)", CreateWaterMeshMessage(4, 64), duration);
+    success &= Run<DynamicMeshMessage>("dynamicMesh (2000)", CreateDynamicMeshMessage(2000), duration);
+    success &= Run<DynamicMeshMessage>("dynamicMesh (100000)", CreateDynamicMeshMessage(100000), duration, [](DynamicMeshMessage& message, const uint8_t* b, int32_t n){ return message.DeserializeLarge(b, n); });
+    success &= Run<DynamicMeshPatchMessage>("dynamicMeshPatch (256)", CreateDynamicMeshPatchMessage(256, 384), duration);
+    success &= Run<FragmentMessage>("fragment (1400)", CreateFragmentMessage(1400), duration);
+
+    // serialization of window event messages (one message per frame)
+    WindowEventMessage windowEventMessage;
+    windowEventMessage.framebufferWidth = 1920;
+    windowEventMessage.framebufferHeight = 1080;
+    std::vector<uint8_t> bytes;
+    windowEventMessage.eventContainer.keyEvents.assign(2, KeyEventData(65, 1, 0));
+    windowEventMessage.eventContainer.mouseButtonEvents.assign(1, MouseButtonEventData(0, 1, 0));
+    windowEventMessage.eventContainer.cursorEvents.assign(8, CursorEventData(960.0, 540.0));
+    windowEventMessage.eventContainer.scrollEvents.assign(1, ScrollEventData(0.0, 1.0));
+    windowEventMessage.Serialize(bytes);
+    uint64_t numMessages = 0;
+    uint64_t allocations = numAllocations.load();
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point end;
+    do {
+        for(int k = 0; k < 64; ++k){
+            windowEventMessage.Serialize(bytes);
+        }
+        numMessages += 64;
+        end = std::chrono::steady_clock::now();
+    } while(std::chrono::duration<double>(end - start).count() < duration);
+    double nsPerMessage = 1e9 * std::chrono::duration<double>(end - start).count() / static_cast<double>(numMessages);
+    double allocationsReused = static_cast<double>(numAllocations.load() - allocations) / static_cast<double>(numMessages);
+    std::printf("%-26s %8zu %12.1f %14.2f %12s\n", "windowEvent (serialize)", bytes.size(), nsPerMessage, allocationsReused, "-");
+    return success ? 0 : -1;
+}
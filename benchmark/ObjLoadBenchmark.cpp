@@ -0,0 +1,273 @@
+/**
+ * @brief Measures the parsing of ASCII mesh files with the memory-mapped @ref TextTokenizer compared with the previous
+ * line parser (std::getline, removal of CR, StringHelper::SplitString and std::stof/std::sscanf per line).
+ * @details A synthetic OBJ file of a given size with a material library is written to the temporary directory. Both
+ * parsers read all positions, normals, texture coordinates and face indices of that file and must yield the same
+ * result. Afterwards, the whole file is read via @ref TextureMesh::ReadFromFile. Finally, the conversion of 8-bit sRGB
+ * color channels to linear RGB is measured with std::pow and with the lookup table of @ref ColorMesh. All times are the
+ * best of all repetitions.
+ *
+ * Usage: ObjLoadBenchmark [fileSizeMB] [numRepetitions]
+ */
+#include <Common.hpp>
+#include <MappedFile.hpp>
+#include <TextTokenizer.hpp>
+#include <StringHelper.hpp>
+#include <TextureMesh.hpp>
+#include <PrismaConfiguration.hpp>
+
+
+/**
+ * @brief The result of parsing an OBJ file.
+ */
+struct ObjData {
+    std::vector<std::array<GLfloat,3>> v;    // Positions.
+    std::vector<std::array<GLfloat,3>> vn;   // Normals.
+    std::vector<std::array<GLfloat,2>> vt;   // Texture coordinates.
+    std::vector<std::array<uint32_t,3>> f;   // Face corners (position, texture coordinate and normal index).
+
+    void Clear(void){ v.clear(); vn.clear(); vt.clear(); f.clear(); }
+    bool operator==(const ObjData& other) const { return (v == other.v) && (vn == other.vn) && (vt == other.vt) && (f == other.f); }
+};
+
+
+/**
+ * @brief Write a synthetic OBJ file that consists of several grid objects.
+ * @param[in] filename The name of the OBJ file. The material library is written next to it.
+ * @param[in] fileSize The minimum size of the OBJ file in bytes.
+ * @return True if success, false otherwise.
+ */
+static bool WriteObjFile(const std::filesystem::path& filename, size_t fileSize){
+    constexpr uint32_t gridSize = 200;
+    std::filesystem::path mtlFilename = filename;
+    mtlFilename.replace_extension(".mtl");
+    std::ofstream mtl(mtlFilename, std::ofstream::binary);
+    mtl << "newmtl grid\nNs 32.0\nKa 0.0 0.0 0.0\nKd 0.8 0.7 0.6\nKs 0.5 0.5 0.5\nKe 0.0 0.0 0.0\nd 1.0\n";
+    if(!mtl.good()){
+        return false;
+    }
+    std::ofstream file(filename, std::ofstream::binary);
+    file << "# synthetic grid objects\nmtllib " << mtlFilename.filename().string() << "\n";
+    std::string text;
+    char line[256];
+    size_t numBytes = 0;
+    uint32_t indexOffset = 0;
+    for(uint32_t object = 0; (numBytes < fileSize) && file.good(); ++object){
+        text.clear();
+        text += "o grid" + std::to_string(object) + "\n";
+        for(uint32_t y = 0; y < gridSize; ++y){
+            for(uint32_t x = 0; x < gridSize; ++x){
+                float px = 0.01f * static_cast<float>(x) + static_cast<float>(object);
+                float py = 0.01f * static_cast<float>(y);
+                float pz = 0.1f * std::sin(0.05f * static_cast<float>(x)) * std::cos(0.05f * static_cast<float>(y));
+                int n = std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\nvn %.4f %.4f %.4f\nvt %.6f %.6f\n", px, py, pz, 0.0f, -0.0f, 1.0f, static_cast<float>(x) / static_cast<float>(gridSize - 1), static_cast<float>(y) / static_cast<float>(gridSize - 1));
+                text.append(line, static_cast<size_t>(n));
+            }
+        }
+        text += "usemtl grid\n";
+        for(uint32_t y = 0; (y + 1) < gridSize; ++y){
+            for(uint32_t x = 0; (x + 1) < gridSize; ++x){
+                uint32_t i0 = indexOffset + y * gridSize + x + 1;
+                uint32_t i1 = i0 + 1;
+                uint32_t i2 = i0 + gridSize;
+                uint32_t i3 = i2 + 1;
+                int n = std::snprintf(line, sizeof(line), "f %u/%u/%u %u/%u/%u %u/%u/%u\nf %u/%u/%u %u/%u/%u %u/%u/%u\n", i0, i0, i0, i1, i1, i1, i3, i3, i3, i0, i0, i0, i3, i3, i3, i2, i2, i2);
+                text.append(line, static_cast<size_t>(n));
+            }
+        }
+        indexOffset += gridSize * gridSize;
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        numBytes += text.size();
+    }
+    return file.good();
+}
+
+
+/**
+ * @brief Parse an OBJ file with the previous line parser.
+ * @param[in] filename The name of the OBJ file.
+ * @param[out] data The parsed data.
+ * @return True if success, false otherwise.
+ */
+static bool ParseWithLineParser(const std::string& filename, ObjData& data){
+    data.Clear();
+    std::ifstream file(filename, std::ifstream::binary);
+    if(!file.is_open()){
+        return false;
+    }
+    while(file.good()){
+        std::string line;
+        std::getline(file, line);
+        line.erase(std::remove_if(line.begin(), line.end(), [](char c){ return ('\r' == c) || ('\n' == c); }), line.end());
+        std::vector<std::string> words = StringHelper::SplitString(line);
+        if(words.empty() || ('#' == words[0][0])){
+            continue;
+        }
+        if((0 == words[0].compare("v")) && (4 == words.size())){
+            data.v.push_back({std::stof(words[1]), std::stof(words[2]), std::stof(words[3])});
+        }
+        else if((0 == words[0].compare("vn")) && (4 == words.size())){
+            data.vn.push_back({std::stof(words[1]), std::stof(words[2]), std::stof(words[3])});
+        }
+        else if((0 == words[0].compare("vt")) && (3 == words.size())){
+            data.vt.push_back({std::stof(words[1]), std::stof(words[2])});
+        }
+        else if(0 == words[0].compare("f")){
+            if(4 != words.size()){
+                return false;
+            }
+            for(int k = 1; k < 4; ++k){
+                std::array<uint32_t,3> u;
+                if(3 != std::sscanf(words[k].c_str(), "%u/%u/%u", &u[0], &u[1], &u[2])){
+                    return false;
+                }
+                data.f.push_back(u);
+            }
+        }
+    }
+    return true;
+}
+
+
+/**
+ * @brief Parse an OBJ file with the memory-mapped tokenizer.
+ * @param[in] filename The name of the OBJ file.
+ * @param[out] data The parsed data.
+ * @return True if success, false otherwise.
+ */
+static bool ParseWithTokenizer(const std::string& filename, ObjData& data){
+    data.Clear();
+    MappedFile file;
+    if(!file.Open(filename)){
+        return false;
+    }
+    TextTokenizer tokenizer(file.GetData(), file.GetSize());
+    while(tokenizer.NextLine()){
+        std::string_view keyword = tokenizer.NextWord();
+        if(keyword.empty() || ('#' == keyword[0])){
+            continue;
+        }
+        if(keyword == "v"){
+            std::array<GLfloat,3> p;
+            if(tokenizer.NextNumber(p[0]) && tokenizer.NextNumber(p[1]) && tokenizer.NextNumber(p[2]) && tokenizer.IsEndOfLine()){
+                data.v.push_back(p);
+            }
+        }
+        else if(keyword == "vn"){
+            std::array<GLfloat,3> n;
+            if(tokenizer.NextNumber(n[0]) && tokenizer.NextNumber(n[1]) && tokenizer.NextNumber(n[2]) && tokenizer.IsEndOfLine()){
+                data.vn.push_back(n);
+            }
+        }
+        else if(keyword == "vt"){
+            std::array<GLfloat,2> t;
+            if(tokenizer.NextNumber(t[0]) && tokenizer.NextNumber(t[1]) && tokenizer.IsEndOfLine()){
+                data.vt.push_back(t);
+            }
+        }
+        else if(keyword == "f"){
+            for(int k = 0; k < 3; ++k){
+                std::array<uint32_t,3> u;
+                if(!tokenizer.NextNumbers('/', u)){
+                    return false;
+                }
+                data.f.push_back(u);
+            }
+            if(!tokenizer.IsEndOfLine()){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+/**
+ * @brief Run a function repeatedly and get the best time.
+ * @param[in] numRepetitions The number of repetitions.
+ * @param[in] function The function to be measured, returns false on failure.
+ * @return The best time in milliseconds or a negative value if the function failed.
+ */
+template <typename F> static double Measure(uint32_t numRepetitions, F function){
+    double best = std::numeric_limits<double>::infinity();
+    for(uint32_t n = 0; n < numRepetitions; ++n){
+        auto t0 = std::chrono::steady_clock::now();
+        bool success = function();
+        auto t1 = std::chrono::steady_clock::now();
+        if(!success){
+            return -1.0;
+        }
+        best = std::min(best, 1000.0 * std::chrono::duration<double>(t1 - t0).count());
+    }
+    return best;
+}
+
+
+int main(int argc, char** argv){
+    const size_t fileSizeMB = (argc > 1) ? std::max(static_cast<size_t>(1), static_cast<size_t>(std::stoull(argv[1]))) : 1024;
+    const uint32_t numRepetitions = (argc > 2) ? std::max(1u, static_cast<uint32_t>(std::stoul(argv[2]))) : 1;
+    prismaConfiguration.Clear();
+    std::filesystem::path filename = std::filesystem::temp_directory_path() / "prisma_benchmark.obj";
+    std::filesystem::path mtlFilename = filename;
+    mtlFilename.replace_extension(".mtl");
+    if(!WriteObjFile(filename, fileSizeMB << 20)){
+        std::printf("could not write \"%s\"\n", filename.string().c_str());
+        return 1;
+    }
+    const double megabytes = static_cast<double>(std::filesystem::file_size(filename)) / static_cast<double>(1 << 20);
+    std::printf("obj file: %.1f MB\n", megabytes);
+    std::printf("%-32s %12s %10s %10s\n", "parser", "ms", "MB/s", "speedup");
+    bool success = true;
+
+    // parse with both parsers
+    ObjData lineData, tokenizerData;
+    double msLine = Measure(numRepetitions, [&](){ return ParseWithLineParser(filename.string(), lineData); });
+    double msTokenizer = Measure(numRepetitions, [&](){ return ParseWithTokenizer(filename.string(), tokenizerData); });
+    success &= (msLine > 0.0) && (msTokenizer > 0.0) && (lineData == tokenizerData);
+    std::printf("%-32s %12.1f %10.1f %9.1fx\n", "getline+SplitString+stof", msLine, 1000.0 * megabytes / msLine, 1.0);
+    std::printf("%-32s %12.1f %10.1f %9.1fx\n", "mmap+TextTokenizer", msTokenizer, 1000.0 * megabytes / msTokenizer, msLine / msTokenizer);
+    if(lineData == tokenizerData){
+        std::printf("both parsers: %zu v, %zu vn, %zu vt, %zu face corners\n", tokenizerData.v.size(), tokenizerData.vn.size(), tokenizerData.vt.size(), tokenizerData.f.size());
+    }
+    else{
+        std::printf("parsers differ\n");
+    }
+    lineData = ObjData();
+    tokenizerData = ObjData();
+
+    // read the whole mesh
+    double msMesh = Measure(numRepetitions, [&](){ TextureMesh mesh; return mesh.ReadFromFile(filename.string()); });
+    success &= (msMesh > 0.0);
+    std::printf("%-32s %12.1f %10.1f\n", "TextureMesh::ReadFromFile", msMesh, 1000.0 * megabytes / msMesh);
+    std::error_code ec;
+    (void) std::filesystem::remove(filename, ec);
+    (void) std::filesystem::remove(mtlFilename, ec);
+
+    // convert sRGB to linear RGB: std::pow per channel vs. lookup table
+    constexpr size_t numChannels = 1 << 24;
+    std::vector<uint8_t> channels(numChannels);
+    for(size_t i = 0; i < numChannels; ++i){
+        channels[i] = static_cast<uint8_t>((i * 2654435761u) >> 24);
+    }
+    std::vector<GLfloat> powResult(numChannels), lutResult(numChannels);
+    double msPow = Measure(numRepetitions, [&](){
+        for(size_t i = 0; i < numChannels; ++i){
+            powResult[i] = static_cast<GLfloat>(std::pow(static_cast<double>(static_cast<GLfloat>(static_cast<double>(channels[i]) / 255.0)), 2.2));
+        }
+        return true;
+    });
+    std::array<GLfloat,256> table;
+    for(size_t i = 0; i < table.size(); ++i){
+        table[i] = static_cast<GLfloat>(std::pow(static_cast<double>(static_cast<GLfloat>(static_cast<double>(i) / 255.0)), 2.2));
+    }
+    double msLUT = Measure(numRepetitions, [&](){
+        for(size_t i = 0; i < numChannels; ++i){
+            lutResult[i] = table[channels[i]];
+        }
+        return true;
+    });
+    success &= (powResult == lutResult);
+    std::printf("%-32s %12.1f %10s %9.1fx\n", "sRGB->linear std::pow", msPow, "", 1.0);
+    std::printf("%-32s %12.1f %10s %9.1fx\n", "sRGB->linear lookup table", msLUT, "", msPow / msLUT);
+    return success ? 0 : 1;
+}
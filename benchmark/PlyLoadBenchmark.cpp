@@ -0,0 +1,189 @@
+/**
+ * @brief Measures the time to read a colored mesh from a ply file in ASCII and in binary format.
+ * @details A synthetic grid mesh with positions, normals and colors is written to the temporary directory in the formats
+ * ascii, binary_little_endian and binary_big_endian. Each file is read via @ref ColorMesh::ReadFromFile and the best load
+ * time of all repetitions is reported together with the speedup relative to the ASCII format. The bounding boxes of all
+ * formats must be equal.
+ *
+ * Usage: PlyLoadBenchmark [gridSize] [numRepetitions]
+ */
+#include <Common.hpp>
+#include <ColorMesh.hpp>
+#include <PrismaConfiguration.hpp>
+
+
+/**
+ * @brief Append a value in a given byte order to a byte container.
+ * @param[inout] bytes The container to which to append the value.
+ * @param[in] value The value to be appended.
+ * @param[in] bigEndian True if the value is to be appended in big endian byte order, false for little endian.
+ */
+template <typename T> static void Append(std::vector<uint8_t>& bytes, T value, bool bigEndian){
+    uint8_t b[sizeof(T)];
+    std::memcpy(b, &value, sizeof(T));
+    if(bigEndian != (std::endian::big == std::endian::native)){
+        std::reverse(b, b + sizeof(T));
+    }
+    bytes.insert(bytes.end(), b, b + sizeof(T));
+}
+
+
+/**
+ * @brief Write a grid mesh to a ply file.
+ * @param[in] filename The name of the ply file.
+ * @param[in] format The ply format, either "ascii", "binary_little_endian" or "binary_big_endian".
+ * @param[in] gridSize The number of vertices along each side of the grid.
+ * @return True if success, false otherwise.
+ */
+static bool WriteGridMesh(const std::string& filename, const std::string& format, uint32_t gridSize){
+    std::ofstream file(filename, std::ofstream::binary);
+    if(!file.is_open()){
+        return false;
+    }
+    const uint32_t numVertices = gridSize * gridSize;
+    const uint32_t numFaces = 2 * (gridSize - 1) * (gridSize - 1);
+    file << "ply\nformat " << format << " 1.0\ncomment synthetic grid mesh\n";
+    file << "element vertex " << numVertices << "\n";
+    file << "property float x\nproperty float y\nproperty float z\n";
+    file << "property float nx\nproperty float ny\nproperty float nz\n";
+    file << "property uchar red\nproperty uchar green\nproperty uchar blue\n";
+    file << "element face " << numFaces << "\n";
+    file << "property list uchar int vertex_indices\nend_header\n";
+    const bool ascii = ("ascii" == format);
+    const bool bigEndian = ("binary_big_endian" == format);
+    std::vector<uint8_t> bytes;
+    std::string text;
+    char line[256];
+    for(uint32_t y = 0; y < gridSize; ++y){
+        for(uint32_t x = 0; x < gridSize; ++x){
+            float px = 0.01f * static_cast<float>(x);
+            float py = 0.01f * static_cast<float>(y);
+            float pz = 0.1f * std::sin(0.05f * static_cast<float>(x)) * std::cos(0.05f * static_cast<float>(y));
+            uint8_t r = static_cast<uint8_t>(x), g = static_cast<uint8_t>(y), b = static_cast<uint8_t>(x ^ y);
+            if(ascii){
+                int n = std::snprintf(line, sizeof(line), "%g %g %g 0 0 1 %u %u %u\n", px, py, pz, r, g, b);
+                text.append(line, static_cast<size_t>(n));
+            }
+            else{
+                Append(bytes, px, bigEndian);
+                Append(bytes, py, bigEndian);
+                Append(bytes, pz, bigEndian);
+                Append(bytes, 0.0f, bigEndian);
+                Append(bytes, 0.0f, bigEndian);
+                Append(bytes, 1.0f, bigEndian);
+                bytes.push_back(r);
+                bytes.push_back(g);
+                bytes.push_back(b);
+            }
+        }
+    }
+    for(uint32_t y = 0; (y + 1) < gridSize; ++y){
+        for(uint32_t x = 0; (x + 1) < gridSize; ++x){
+            int32_t i0 = static_cast<int32_t>(y * gridSize + x);
+            int32_t i1 = i0 + 1;
+            int32_t i2 = i0 + static_cast<int32_t>(gridSize);
+            int32_t i3 = i2 + 1;
+            const int32_t triangles[2][3] = {{i0, i1, i3}, {i0, i3, i2}};
+            for(auto&& t : triangles){
+                if(ascii){
+                    int n = std::snprintf(line, sizeof(line), "3 %d %d %d\n", t[0], t[1], t[2]);
+                    text.append(line, static_cast<size_t>(n));
+                }
+                else{
+                    bytes.push_back(3);
+                    Append(bytes, t[0], bigEndian);
+                    Append(bytes, t[1], bigEndian);
+                    Append(bytes, t[2], bigEndian);
+                }
+            }
+        }
+    }
+    if(ascii){
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+    else{
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+    return file.good();
+}
+
+
+/**
+ * @brief Read a ply file repeatedly and get the best load time.
+ * @param[in] filename The name of the ply file.
+ * @param[in] numRepetitions The number of repetitions.
+ * @param[out] aabb The bounding box of the mesh that has been read.
+ * @return The best load time in milliseconds or a negative value if the file could not be read.
+ */
+static double Measure(const std::string& filename, uint32_t numRepetitions, AABB& aabb){
+    double best = std::numeric_limits<double>::infinity();
+    for(uint32_t n = 0; n < numRepetitions; ++n){
+        ColorMesh mesh;
+        auto t0 = std::chrono::steady_clock::now();
+        bool success = mesh.ReadFromFile(filename);
+        auto t1 = std::chrono::steady_clock::now();
+        if(!success){
+            return -1.0;
+        }
+        best = std::min(best, 1000.0 * std::chrono::duration<double>(t1 - t0).count());
+        aabb = mesh.GetAABBOfVertices();
+    }
+    return best;
+}
+
+
+/**
+ * @brief Check whether two bounding boxes are equal within the precision of the ASCII format.
+ * @param[in] a The first bounding box.
+ * @param[in] b The second bounding box.
+ * @return True if both bounding boxes are equal, false otherwise.
+ */
+static bool IsEqual(const AABB& a, const AABB& b){
+    for(int k = 0; k < 3; ++k){
+        if((std::fabs(a.lowestPosition[k] - b.lowestPosition[k]) > 1e-4f) || (std::fabs(a.dimension[k] - b.dimension[k]) > 1e-4f)){
+            return false;
+        }
+    }
+    return true;
+}
+
+
+int main(int argc, char** argv){
+    const uint32_t gridSize = (argc > 1) ? std::max(2u, static_cast<uint32_t>(std::stoul(argv[1]))) : 1000;
+    const uint32_t numRepetitions = (argc > 2) ? std::max(1u, static_cast<uint32_t>(std::stoul(argv[2]))) : 3;
+    prismaConfiguration.Clear();
+    std::printf("grid mesh: %u vertices, %u triangles\n", gridSize * gridSize, 2 * (gridSize - 1) * (gridSize - 1));
+    std::printf("%-22s %12s %12s %10s\n", "format", "bytes", "ms", "speedup");
+    const std::string formats[3] = {"ascii", "binary_little_endian", "binary_big_endian"};
+    double msASCII = 0.0;
+    AABB aabbASCII;
+    bool success = true;
+    for(auto&& format : formats){
+        std::filesystem::path filename = std::filesystem::temp_directory_path() / ("prisma_benchmark_" + format + ".ply");
+        if(!WriteGridMesh(filename.string(), format, gridSize)){
+            std::printf("%-22s could not write \"%s\"\n", format.c_str(), filename.string().c_str());
+            success = false;
+            continue;
+        }
+        AABB aabb;
+        double ms = Measure(filename.string(), numRepetitions, aabb);
+        uintmax_t numBytes = std::filesystem::file_size(filename);
+        std::error_code ec;
+        (void) std::filesystem::remove(filename, ec);
+        if(ms < 0.0){
+            std::printf("%-22s FAILED\n", format.c_str());
+            success = false;
+            continue;
+        }
+        if("ascii" == format){
+            msASCII = ms;
+            aabbASCII = aabb;
+        }
+        else if(!IsEqual(aabb, aabbASCII)){
+            std::printf("%-22s bounding box differs from ascii\n", format.c_str());
+            success = false;
+        }
+        std::printf("%-22s %12llu %12.3f %9.1fx\n", format.c_str(), static_cast<unsigned long long>(numBytes), ms, (msASCII > 0.0) ? (msASCII / ms) : 0.0);
+    }
+    return success ? 0 : 1;
+}
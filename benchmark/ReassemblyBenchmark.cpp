@@ -0,0 +1,144 @@
+/**
+ * @brief Measures the throughput of the reassembly of fragmented dynamic mesh messages.
+ * @details A dynamic mesh message with one million vertices is split into fragments that fit into a single datagram. The
+ * fragments are inserted to a @ref MessageReassembler in random order and the reassembled bytes are decoded via
+ * @ref DynamicMeshMessage::DeserializeLarge, in the same way as it is done by the network thread.
+ */
+#include <Common.hpp>
+#include <DynamicMeshMessage.hpp>
+#include <FragmentMessage.hpp>
+#include <MessageReassembler.hpp>
+
+
+/**
+ * @brief Append a value in network byte order to a byte container.
+ * @param[inout] bytes The container to which to append the value.
+ * @param[in] value The value to be appended.
+ */
+template <typename T> static void Append(std::vector<uint8_t>& bytes, T value){
+    value = NetworkUtils::NetworkToNativeByteOrder(value);
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+    bytes.insert(bytes.end(), p, p + sizeof(T));
+}
+
+
+/**
+ * @brief Create a large dynamic mesh message (32-bit counts and indices).
+ * @param[in] numVertices The number of vertices.
+ * @return The serialized message.
+ */
+static std::vector<uint8_t> CreateDynamicMeshMessage(uint32_t numVertices){
+    std::vector<uint8_t> bytes;
+    DynamicMeshMessageUnion header{};
+    header.protocol.messageType = MESSAGE_TYPE_DYNAMIC_MESH;
+    header.protocol.meshID = NetworkUtils::NetworkToNativeByteOrder(uint32_t(1));
+    header.protocol.updateMesh = 1;
+    header.protocol.visible = 1;
+    header.protocol.quaternion.w = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    for(int k = 0; k < 3; ++k){
+        header.protocol.scale[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+        header.protocol.diffuseColorMultiplier[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    }
+    header.protocol.shininessMultiplier = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+    bytes.insert(bytes.end(), header.bytes, header.bytes + sizeof(header));
+    Append(bytes, numVertices);
+    for(uint32_t v = 0; v < numVertices; ++v){
+        float x = static_cast<float>(v % 1000);
+        float y = static_cast<float>(v / 1000);
+        Append(bytes, x);
+        Append(bytes, y);
+        Append(bytes, 0.0f);
+        Append(bytes, x / 1000.0f);
+        Append(bytes, y / 1000.0f);
+        Append(bytes, 0.5f);
+    }
+    uint32_t numTriangles = numVertices - 2;
+    Append(bytes, numTriangles * 3);
+    for(uint32_t t = 0; t < numTriangles; ++t){
+        Append(bytes, t);
+        Append(bytes, t + 1);
+        Append(bytes, t + 2);
+    }
+    return bytes;
+}
+
+
+/**
+ * @brief Split a message into fragment messages, one fragment message for each datagram.
+ * @param[in] message The serialized message.
+ * @param[in] transferID The transfer identifier.
+ * @param[in] maxDatagramSize The maximum size of a datagram.
+ * @return A list of datagrams.
+ */
+static std::vector<std::vector<uint8_t>> CreateFragments(const std::vector<uint8_t>& message, uint32_t transferID, size_t maxDatagramSize){
+    size_t maxPayload = maxDatagramSize - sizeof(FragmentMessageUnion);
+    size_t fragmentCount = (message.size() + maxPayload - 1) / maxPayload;
+    std::vector<std::vector<uint8_t>> datagrams(fragmentCount);
+    for(size_t i = 0; i < fragmentCount; ++i){
+        size_t offset = i * maxPayload;
+        size_t length = std::min(maxPayload, message.size() - offset);
+        std::vector<uint8_t>& d = datagrams[i];
+        d.push_back(MESSAGE_TYPE_FRAGMENT);
+        Append(d, transferID);
+        Append(d, static_cast<uint16_t>(i));
+        Append(d, static_cast<uint16_t>(fragmentCount));
+        Append(d, static_cast<uint32_t>(message.size()));
+        Append(d, static_cast<uint32_t>(offset));
+        Append(d, static_cast<uint16_t>(length));
+        d.insert(d.end(), message.begin() + offset, message.begin() + offset + length);
+    }
+    return datagrams;
+}
+
+
+int main(int argc, char** argv){
+    uint32_t numVertices = (argc > 1) ? static_cast<uint32_t>(std::stoul(argv[1])) : 1000000;
+    constexpr int numRepetitions = 20;
+    constexpr size_t maxDatagramSize = 65507;
+
+    std::vector<uint8_t> message = CreateDynamicMeshMessage(numVertices);
+    std::vector<std::vector<uint8_t>> datagrams = CreateFragments(message, 42, maxDatagramSize);
+    std::mt19937 generator(0);
+    std::shuffle(datagrams.begin(), datagrams.end(), generator);
+    std::printf("message: %u vertices, %zu bytes, %zu fragments\n", numVertices, message.size(), datagrams.size());
+
+    MessageReassembler reassembler;
+    reassembler.Reset(message.size(), message.size(), 1000);
+    FragmentMessage fragment;
+    DynamicMeshMessage dynamicMeshMessage;
+    std::vector<uint8_t> reassembledBytes;
+    IPAddress source(127, 0, 0, 1, 31416);
+    double reassemblyTime = 0.0;
+    double decodeTime = 0.0;
+    for(int r = 0; r <= numRepetitions; ++r){
+        auto t0 = std::chrono::steady_clock::now();
+        bool complete = false;
+        for(auto&& d : datagrams){
+            int32_t n = fragment.Deserialize(&d[0], static_cast<int32_t>(d.size()));
+            if((n != static_cast<int32_t>(d.size())) || !fragment.IsValid()){
+                std::printf("ERROR: invalid fragment\n");
+                return -1;
+            }
+            complete = (MESSAGE_REASSEMBLER_RESULT_COMPLETE == reassembler.Insert(source, fragment, reassembledBytes));
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        int32_t length = static_cast<int32_t>(reassembledBytes.size());
+        if(!complete || (dynamicMeshMessage.DeserializeLarge(&reassembledBytes[0], length) != length) || !dynamicMeshMessage.IsValid()){
+            std::printf("ERROR: reassembly failed\n");
+            return -1;
+        }
+        auto t2 = std::chrono::steady_clock::now();
+        if(r){ // the first repetition warms up all buffers
+            reassemblyTime += std::chrono::duration<double>(t1 - t0).count();
+            decodeTime += std::chrono::duration<double>(t2 - t1).count();
+        }
+    }
+    reassemblyTime /= static_cast<double>(numRepetitions);
+    decodeTime /= static_cast<double>(numRepetitions);
+    double megabytes = static_cast<double>(message.size()) / 1048576.0;
+    std::printf("reassembly: %8.3f ms (%8.1f MiB/s)\n", reassemblyTime * 1000.0, megabytes / reassemblyTime);
+    std::printf("decode:     %8.3f ms (%8.1f MiB/s)\n", decodeTime * 1000.0, megabytes / decodeTime);
+    std::printf("total:      %8.3f ms (%8.1f MiB/s, %.1f meshes/s)\n", (reassemblyTime + decodeTime) * 1000.0, megabytes / (reassemblyTime + decodeTime), 1.0 / (reassemblyTime + decodeTime));
+    return 0;
+}
+
@@ -0,0 +1,219 @@
+/**
+ * @brief Measures the time to load a scene with many objects over each ingest transport.
+ * @details A scene of mesh messages is sent to a running @ref NetworkManager via UDP, TCP, a Unix domain socket (linux
+ * only) and shared memory (linux only). The main thread acts as render thread and fetches the messages from the
+ * @ref MessageManager once per frame. The load time is measured from the first byte that is sent until the last message
+ * has been fetched. Messages that are lost, e.g. due to socket buffer or message queue overflows, are reported.
+ */
+#include <Common.hpp>
+#include <NetworkManager.hpp>
+#include <MessageManager.hpp>
+#include <PrismaConfiguration.hpp>
+
+
+static constexpr uint16_t benchmarkUDPPort = 31516;
+static constexpr uint16_t benchmarkTCPPort = 31517;
+static const std::string benchmarkUnixSocketPath = "/tmp/prisma_benchmark.sock";
+static const std::string benchmarkSharedMemoryName = "/prisma_benchmark";
+
+
+/**
+ * @brief Create all messages of a scene and pack them into datagrams.
+ * @param[in] numObjects The number of mesh objects.
+ * @return A list of datagrams, each datagram contains one or more mesh messages.
+ */
+static std::vector<std::vector<uint8_t>> CreateScene(uint32_t numObjects){
+    constexpr size_t maxDatagramSize = 65507;
+    const std::string name = "suzanne.obj";
+    std::vector<std::vector<uint8_t>> datagrams(1);
+    for(uint32_t i = 0; i < numObjects; ++i){
+        MeshMessageUnion msg{};
+        msg.protocol.messageType = MESSAGE_TYPE_MESH;
+        msg.protocol.meshID = NetworkUtils::NetworkToNativeByteOrder(i);
+        msg.protocol.visible = 1;
+        msg.protocol.castShadow = 1;
+        msg.protocol.position[0] = NetworkUtils::NetworkToNativeByteOrder(static_cast<GLfloat>(i % 100));
+        msg.protocol.position[2] = NetworkUtils::NetworkToNativeByteOrder(static_cast<GLfloat>(i / 100));
+        msg.protocol.quaternion[0] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+        for(int k = 0; k < 3; ++k){
+            msg.protocol.scale[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+            msg.protocol.diffuseColorMultiplier[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+            msg.protocol.specularColorMultiplier[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+            msg.protocol.emissionColorMultiplier[k] = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+        }
+        msg.protocol.shininessMultiplier = NetworkUtils::NetworkToNativeByteOrder(1.0f);
+        msg.protocol.nameStringLength = NetworkUtils::NetworkToNativeByteOrder(static_cast<uint16_t>(name.length()));
+        if((datagrams.back().size() + sizeof(msg) + name.length()) > maxDatagramSize){
+            datagrams.emplace_back();
+        }
+        datagrams.back().insert(datagrams.back().end(), msg.bytes, msg.bytes + sizeof(msg));
+        datagrams.back().insert(datagrams.back().end(), name.begin(), name.end());
+    }
+    return datagrams;
+}
+
+
+/**
+ * @brief Send bytes over a stream socket.
+ * @param[in] s The connected socket.
+ * @param[in] bytes The bytes to be sent.
+ * @param[in] length The number of bytes to be sent.
+ * @return True if success, false otherwise.
+ */
+static bool SendAll(int s, const uint8_t* bytes, size_t length){
+    while(length){
+        int tx = static_cast<int>(send(s, reinterpret_cast<const char*>(bytes), static_cast<int>(length), 0));
+        if(tx <= 0){
+            return false;
+        }
+        bytes += tx;
+        length -= static_cast<size_t>(tx);
+    }
+    return true;
+}
+
+
+/**
+ * @brief Send all datagrams of a scene via a given transport.
+ * @param[in] transport The transport, either "udp", "tcp", "unix" or "sharedMemory".
+ * @param[in] datagrams The datagrams of the scene.
+ * @return True if success, false otherwise.
+ */
+static bool SendScene(const std::string& transport, const std::vector<std::vector<uint8_t>>& datagrams){
+    if("udp" == transport){
+        UDPSocket udpSocket;
+        if(!udpSocket.Open()){
+            return false;
+        }
+        for(auto&& d : datagrams){
+            (void) udpSocket.SendTo(IPAddress(127, 0, 0, 1, benchmarkUDPPort), &d[0], static_cast<int32_t>(d.size()));
+        }
+        udpSocket.Close();
+        return true;
+    }
+    #ifdef __linux__
+    if("sharedMemory" == transport){
+        SharedMemoryRing ring;
+        if(!ring.Connect(benchmarkSharedMemoryName)){
+            return false;
+        }
+        for(auto&& d : datagrams){
+            while(!ring.Write(&d[0], static_cast<int32_t>(d.size()))){
+                std::this_thread::yield();
+            }
+        }
+        ring.Close();
+        return true;
+    }
+    #endif
+    int s = -1;
+    if("tcp" == transport){
+        s = static_cast<int>(socket(AF_INET, SOCK_STREAM, 0));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(benchmarkTCPPort);
+        addr.sin_addr.s_addr = htonl(0x7F000001);
+        if((s < 0) || (connect(s, reinterpret_cast<const struct sockaddr*>(&addr), sizeof(addr)) < 0)){
+            return false;
+        }
+    }
+    #ifdef __linux__
+    if("unix" == transport){
+        s = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, benchmarkUnixSocketPath.c_str(), benchmarkUnixSocketPath.length());
+        if((s < 0) || (connect(s, reinterpret_cast<const struct sockaddr*>(&addr), sizeof(addr)) < 0)){
+            return false;
+        }
+    }
+    #endif
+    if(s < 0){
+        return false;
+    }
+    bool success = true;
+    for(auto&& d : datagrams){
+        uint32_t header = NetworkUtils::NetworkToNativeByteOrder(static_cast<uint32_t>(d.size()));
+        success = success && SendAll(s, reinterpret_cast<const uint8_t*>(&header), sizeof(header)) && SendAll(s, &d[0], d.size());
+    }
+    #ifdef _WIN32
+    (void) closesocket(s);
+    #else
+    (void) close(s);
+    #endif
+    return success;
+}
+
+
+/**
+ * @brief Load a scene via a given transport and print the result.
+ * @param[in] transport The transport, either "udp", "tcp", "unix" or "sharedMemory".
+ * @param[in] datagrams The datagrams of the scene.
+ * @param[in] numObjects The number of mesh messages of the scene.
+ * @param[in] framePeriodMs The period in milliseconds at which the render thread fetches messages.
+ */
+static void LoadScene(const std::string& transport, const std::vector<std::vector<uint8_t>>& datagrams, uint32_t numObjects, uint32_t framePeriodMs){
+    prismaConfiguration.Clear();
+    prismaConfiguration.network.localPort = benchmarkUDPPort;
+    prismaConfiguration.network.receive.multicastGroups.clear();
+    prismaConfiguration.network.transport = ("sharedMemory" == transport) ? "sharedMemory" : "udp";
+    prismaConfiguration.network.sharedMemory.name = benchmarkSharedMemoryName;
+    prismaConfiguration.network.stream.tcpPort = ("tcp" == transport) ? benchmarkTCPPort : 0;
+    prismaConfiguration.network.stream.unixSocketPath = ("unix" == transport) ? benchmarkUnixSocketPath : "";
+    NetworkManager networkManager;
+    networkManager.Start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    std::atomic<bool> sent(false);
+    auto t0 = std::chrono::steady_clock::now();
+    std::thread sender([&](){ sent = SendScene(transport, datagrams); });
+    std::vector<MessageBaseType*> messages;
+    uint32_t numReceived = 0;
+    auto tLast = t0;
+    auto tIdle = t0;
+    for(;;){
+        messageManager.FetchMessages(messages);
+        auto now = std::chrono::steady_clock::now();
+        if(!messages.empty()){
+            numReceived += static_cast<uint32_t>(messages.size());
+            tLast = now;
+            tIdle = now;
+        }
+        messageManager.ReleaseMessages(messages);
+        if((numReceived >= numObjects) || ((now - tIdle) > std::chrono::milliseconds(1000))){
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(framePeriodMs));
+    }
+    sender.join();
+    networkManager.Stop();
+    double ms = std::chrono::duration<double>(tLast - t0).count() * 1000.0;
+    std::printf("%-13s %s %6u / %6u messages, %9.3f ms\n", transport.c_str(), sent ? "ok    " : "FAILED", numReceived, numObjects, ms);
+}
+
+
+int main(int argc, char** argv){
+    uint32_t numObjects = (argc > 1) ? static_cast<uint32_t>(std::stoul(argv[1])) : 10000;
+    uint32_t framePeriodMs = (argc > 2) ? static_cast<uint32_t>(std::stoul(argv[2])) : 16;
+    #ifdef _WIN32
+    WSADATA wsadata;
+    (void) WSAStartup(MAKEWORD(2, 2), &wsadata);
+    #endif
+    std::vector<std::vector<uint8_t>> datagrams = CreateScene(numObjects);
+    size_t numBytes = 0;
+    for(auto&& d : datagrams){
+        numBytes += d.size();
+    }
+    std::printf("scene: %u mesh messages, %zu bytes, %zu datagrams/frames, frame period %u ms\n", numObjects, numBytes, datagrams.size(), framePeriodMs);
+    LoadScene("udp", datagrams, numObjects, framePeriodMs);
+    LoadScene("tcp", datagrams, numObjects, framePeriodMs);
+    #ifdef __linux__
+    LoadScene("unix", datagrams, numObjects, framePeriodMs);
+    LoadScene("sharedMemory", datagrams, numObjects, framePeriodMs);
+    #endif
+    #ifdef _WIN32
+    WSACleanup();
+    #endif
+    return 0;
+}
+
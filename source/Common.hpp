@@ -26,6 +26,11 @@
 #include <future>
 #include <random>
 #include <algorithm>
+#include <bit>
+#include <charconv>
+#include <string_view>
+#include <memory>
+#include <span>
 
 
 /* OS depending */
@@ -40,6 +45,16 @@
 #include <sys/utsname.h>
 #include <arpa/inet.h>
 #include <net/if.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #else
 // Other
 #endif
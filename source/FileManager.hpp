@@ -32,9 +32,10 @@ inline std::filesystem::path GetApplicationPath(void){
 
 /**
  * @brief Generate the filename of the protocol file based on the current system time.
- * @return The filename of the format "YYYYMMDD_hhmmssmmm.txt".
+ * @param[in] extension The file extension to be appended.
+ * @return The filename of the format "YYYYMMDD_hhmmssmmm.txt" or "YYYYMMDD_hhmmssmmm" followed by the given extension.
  */
-inline std::string GenerateProtocolFileName(void){
+inline std::string GenerateProtocolFileName(std::string extension = ".txt"){
     auto timePoint = std::chrono::system_clock::now();
     std::time_t systemTime = std::chrono::system_clock::to_time_t(timePoint);
     std::tm* gmTime = std::gmtime(&systemTime);
@@ -50,7 +51,7 @@ inline std::string GenerateProtocolFileName(void){
     uint32_t utcNanoseconds = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
     char buffer[64];
     sprintf(buffer, "%u%02u%02u_%02u%02u%02u%03u", 1900 + utcYear, 1 + utcMonth, utcMDay, utcHour, utcMinute, utcSecond, utcNanoseconds / 1000000);
-    return std::string(buffer) + ".txt";
+    return std::string(buffer) + extension;
 }
 
 
@@ -59,6 +60,7 @@ inline std::string GenerateProtocolFileName(void){
 
 enum EnumFileName {
     FILENAME_PRISMA_PROTOCOL,
+    FILENAME_PRISMA_TRACE,
     FILENAME_PRISMA_CONFIGURATION,
     FILENAME_SHADER_COLORMESH,
     FILENAME_SHADER_TEXTUREMESH,
@@ -97,6 +99,7 @@ inline std::string FileName(EnumFileName enumFileName){
     std::filesystem::path result;
     switch(enumFileName){
         case FILENAME_PRISMA_PROTOCOL:               result = protocolPath / FileManager::GenerateProtocolFileName();   break;
+        case FILENAME_PRISMA_TRACE:                  result = protocolPath / FileManager::GenerateProtocolFileName(".json"); break;
         case FILENAME_PRISMA_CONFIGURATION:          result = applicationPath / "assets" / "PRISMA.json";               break;
         case FILENAME_SHADER_COLORMESH:              result = shaderPath / "ColorMesh.glsl";                            break;
         case FILENAME_SHADER_TEXTUREMESH:            result = shaderPath / "TextureMesh.glsl";                          break;
@@ -0,0 +1,243 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <LatencyHistogram.hpp>
+#include <Profiler.hpp>
+
+
+/**
+ * @brief The number of recent frames whose work time is used to predict the work time of the next frame in just-in-time mode.
+ */
+#define FRAME_PACER_NUM_WORK_SAMPLES (32)
+
+
+/**
+ * @brief The frame pacing mode of the render loop.
+ */
+enum FramePacingMode: uint8_t {
+    FRAME_PACING_MODE_VSYNC = 0x00,          // Swap with the configured swap interval, the swap blocks until the vertical blank.
+    FRAME_PACING_MODE_UNCAPPED = 0x01,       // Swap interval of zero, render as fast as possible.
+    FRAME_PACING_MODE_FIXED_RATE = 0x02,     // Swap interval of zero, each frame starts at a fixed rate.
+    FRAME_PACING_MODE_JUST_IN_TIME = 0x03    // Swap interval of one, each frame starts as late as possible before the next vertical blank.
+};
+
+
+/**
+ * @brief Convert a string to a frame pacing mode.
+ * @param[out] mode The resulting frame pacing mode.
+ * @param[in] name Either "vsync", "uncapped", "fixedRate" or "justInTime".
+ * @return True if success, false if the name is invalid.
+ */
+inline bool FramePacingModeFromString(FramePacingMode& mode, const std::string& name){
+    if(0 == name.compare("vsync")){
+        mode = FRAME_PACING_MODE_VSYNC;
+        return true;
+    }
+    if(0 == name.compare("uncapped")){
+        mode = FRAME_PACING_MODE_UNCAPPED;
+        return true;
+    }
+    if(0 == name.compare("fixedRate")){
+        mode = FRAME_PACING_MODE_FIXED_RATE;
+        return true;
+    }
+    if(0 == name.compare("justInTime")){
+        mode = FRAME_PACING_MODE_JUST_IN_TIME;
+        return true;
+    }
+    return false;
+}
+
+
+/**
+ * @brief Paces the frames of the render loop and measures the achieved pacing.
+ * @details The render loop calls @ref WaitForFrameStart before it fetches messages, @ref BeforeSwap before and
+ * @ref AfterSwap after swapping the double buffers.
+ *
+ * In just-in-time mode, the swap is synchronized to the vertical blank (swap interval of one) and the GPU is drained
+ * before and after each swap, such that the CPU knows when a frame has been completed and when it has been swapped. The
+ * next frame starts at the predicted vertical blank minus the predicted work time (maximum of the recent
+ * @ref FRAME_PACER_NUM_WORK_SAMPLES frames) minus a safety margin. Messages that arrive while the render thread sleeps are
+ * therefore latched by the next frame instead of the frame after it.
+ *
+ * The jitter is given by the absolute difference of successive swap intervals. A deadline is missed if a swap interval
+ * exceeds 1.5 times the target period.
+ */
+class FramePacer {
+    public:
+        /**
+         * @brief Construct a new frame pacer in vsync mode.
+         */
+        FramePacer(): mode(FRAME_PACING_MODE_VSYNC), swapInterval(1), period(0), margin(0), nextFrameStart(0), frameStart(0), previousSwap(0), previousInterval(0), nextWorkSample(0), numFrames(0), numMissedDeadlines(0), intervalSum(0.0){ workSamples.fill(0); }
+
+        /**
+         * @brief Start frame pacing and reset all statistics.
+         * @param[in] pacingMode The frame pacing mode.
+         * @param[in] vsyncSwapInterval The swap interval in vsync mode.
+         * @param[in] targetFrameRate The frame rate in Hz in fixed-rate mode.
+         * @param[in] refreshRate The refresh rate of the monitor in Hz. A value of zero assumes 60 Hz.
+         * @param[in] justInTimeMarginUs The safety margin in microseconds in just-in-time mode.
+         * @return The swap interval to be set for the GL context.
+         */
+        int Start(FramePacingMode pacingMode, uint32_t vsyncSwapInterval, double targetFrameRate, int refreshRate, uint32_t justInTimeMarginUs){
+            mode = pacingMode;
+            double refreshPeriod = 1.0 / static_cast<double>((refreshRate > 0) ? refreshRate : 60);
+            switch(mode){
+                case FRAME_PACING_MODE_VSYNC:        swapInterval = static_cast<int>(vsyncSwapInterval); period = ToNanoseconds(static_cast<double>(vsyncSwapInterval) * refreshPeriod); break;
+                case FRAME_PACING_MODE_UNCAPPED:     swapInterval = 0;                                   period = 0;                                                                    break;
+                case FRAME_PACING_MODE_FIXED_RATE:   swapInterval = 0;                                   period = ToNanoseconds(1.0 / std::max(targetFrameRate, 1.0));                  break;
+                case FRAME_PACING_MODE_JUST_IN_TIME: swapInterval = 1;                                   period = ToNanoseconds(refreshPeriod);                                         break;
+            }
+            margin = 1000 * static_cast<int64_t>(justInTimeMarginUs);
+            nextFrameStart = 0;
+            frameStart = 0;
+            previousSwap = 0;
+            previousInterval = 0;
+            workSamples.fill(0);
+            nextWorkSample = 0;
+            numFrames = 0;
+            numMissedDeadlines = 0;
+            intervalSum = 0.0;
+            jitter.Clear();
+            wakeLateness.Clear();
+            Print("frame pacing: mode=%s, swapInterval=%d, period=%.3f ms\n", GetModeName(), swapInterval, 1e-6 * static_cast<double>(period));
+            return swapInterval;
+        }
+
+        /**
+         * @brief Wait until the next frame should start. Must be called before the messages of a frame are latched.
+         */
+        void WaitForFrameStart(void){
+            int64_t tNow = Now();
+            if(FRAME_PACING_MODE_FIXED_RATE == mode){
+                nextFrameStart = (nextFrameStart && ((tNow - nextFrameStart) < period)) ? (nextFrameStart + period) : tNow;
+                tNow = SleepUntil(nextFrameStart);
+            }
+            else if((FRAME_PACING_MODE_JUST_IN_TIME == mode) && previousSwap){
+                int64_t predictedWork = *std::max_element(workSamples.begin(), workSamples.end());
+                nextFrameStart = previousSwap + period - predictedWork - margin;
+                tNow = SleepUntil(nextFrameStart);
+            }
+            frameStart = tNow;
+        }
+
+        /**
+         * @brief Must be called after the frame has been rendered and before the double buffers are swapped.
+         */
+        void BeforeSwap(void){
+            if(FRAME_PACING_MODE_JUST_IN_TIME == mode){
+                PROFILE_ZONE("FinishFrame");
+                glFinish();
+                workSamples[nextWorkSample] = Now() - frameStart;
+                nextWorkSample = (nextWorkSample + 1) % FRAME_PACER_NUM_WORK_SAMPLES;
+            }
+        }
+
+        /**
+         * @brief Must be called after the double buffers have been swapped.
+         */
+        void AfterSwap(void){
+            if(FRAME_PACING_MODE_JUST_IN_TIME == mode){
+                PROFILE_ZONE("WaitForSwap");
+                glFinish();
+            }
+            int64_t tSwap = Now();
+            if(previousSwap){
+                int64_t interval = tSwap - previousSwap;
+                if(previousInterval){
+                    jitter.Add(std::abs(interval - previousInterval));
+                }
+                if(period && (2 * interval > 3 * period)){
+                    numMissedDeadlines++;
+                }
+                intervalSum += static_cast<double>(interval);
+                previousInterval = interval;
+                numFrames++;
+            }
+            previousSwap = tSwap;
+        }
+
+        /**
+         * @brief Print the achieved frame interval, the jitter and the number of missed deadlines.
+         * @details Nothing is printed if less than two frames have been swapped.
+         */
+        void PrintSummary(void) const {
+            if(!numFrames){
+                return;
+            }
+            Print("frame pacing: mode=%s, frames=%llu, interval=%.3f ms, jitter p50=%.3f ms, p99=%.3f ms, max=%.3f ms, missed=%llu\n", GetModeName(), static_cast<unsigned long long>(numFrames), 1e-6 * intervalSum / static_cast<double>(numFrames), jitter.GetPercentile(0.5), jitter.GetPercentile(0.99), jitter.GetMax(), static_cast<unsigned long long>(numMissedDeadlines));
+            if(wakeLateness.GetCount()){
+                Print("frame pacing: wake-up lateness p50=%.3f ms, p99=%.3f ms, max=%.3f ms\n", wakeLateness.GetPercentile(0.5), wakeLateness.GetPercentile(0.99), wakeLateness.GetMax());
+            }
+        }
+
+    private:
+        FramePacingMode mode;                                                // The frame pacing mode.
+        int swapInterval;                                                    // The swap interval of the GL context.
+        int64_t period;                                                      // Target period in nanoseconds, zero if there is no target.
+        int64_t margin;                                                      // Safety margin in nanoseconds in just-in-time mode.
+        int64_t nextFrameStart;                                              // Scheduled start of the next frame in nanoseconds.
+        int64_t frameStart;                                                  // Start of the current frame in nanoseconds.
+        int64_t previousSwap;                                                // Time of the previous swap in nanoseconds, zero if there was no swap.
+        int64_t previousInterval;                                            // Previous swap interval in nanoseconds, zero if unknown.
+        std::array<int64_t, FRAME_PACER_NUM_WORK_SAMPLES> workSamples;       // Work times of recent frames in nanoseconds (just-in-time mode).
+        size_t nextWorkSample;                                               // Index of the next work sample to be overwritten.
+        uint64_t numFrames;                                                  // Number of measured swap intervals.
+        uint64_t numMissedDeadlines;                                         // Number of swap intervals that exceeded 1.5 times the target period.
+        double intervalSum;                                                  // Sum of all swap intervals in nanoseconds.
+        LatencyHistogram jitter;                                             // Absolute differences of successive swap intervals.
+        LatencyHistogram wakeLateness;                                       // Differences between the actual and the scheduled start of a frame.
+
+        /**
+         * @brief Get the current time.
+         * @return Time in nanoseconds of the steady clock.
+         */
+        static int64_t Now(void){ return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+        /**
+         * @brief Convert seconds to nanoseconds.
+         * @param[in] seconds Time in seconds.
+         * @return Time in nanoseconds.
+         */
+        static int64_t ToNanoseconds(double seconds){ return static_cast<int64_t>(1e9 * seconds); }
+
+        /**
+         * @brief Sleep until a point in time and record the wake-up lateness.
+         * @param[in] t The time in nanoseconds until which to sleep.
+         * @return The time in nanoseconds after waking up.
+         * @details The thread sleeps until one millisecond before @p t and yields for the remaining time, because the
+         * wake-up of a sleeping thread is not precise enough.
+         */
+        int64_t SleepUntil(int64_t t){
+            PROFILE_ZONE("FramePacing");
+            constexpr int64_t spinTime = 1000000;
+            int64_t tNow = Now();
+            if(tNow >= t){
+                return tNow;
+            }
+            if((t - tNow) > spinTime){
+                std::this_thread::sleep_for(std::chrono::nanoseconds(t - tNow - spinTime));
+            }
+            while((tNow = Now()) < t){
+                std::this_thread::yield();
+            }
+            wakeLateness.Add(tNow - t);
+            return tNow;
+        }
+
+        /**
+         * @brief Get the name of the frame pacing mode as used in the configuration file.
+         * @return The name of the mode.
+         */
+        const char* GetModeName(void) const {
+            switch(mode){
+                case FRAME_PACING_MODE_VSYNC:        return "vsync";
+                case FRAME_PACING_MODE_UNCAPPED:     return "uncapped";
+                case FRAME_PACING_MODE_FIXED_RATE:   return "fixedRate";
+                case FRAME_PACING_MODE_JUST_IN_TIME: return "justInTime";
+            }
+            return "unknown";
+        }
+};
+
@@ -1,9 +1,11 @@
 #include <GLWindow.hpp>
 #include <PrismaConfiguration.hpp>
+#include <Profiler.hpp>
 
 
 GLWindow::GLWindow(){
     glfwWindow = nullptr;
+    closeRequested = false;
 }
 
 GLWindow::~GLWindow(){
@@ -20,6 +22,7 @@ void GLWindow::Run(GLWindowCallbacks* callbacks){
 }
 
 void GLWindow::Close(void){
+    closeRequested = true;
     if(glfwWindow){
         glfwSetWindowShouldClose(glfwWindow, GL_TRUE);
     }
@@ -91,9 +94,13 @@ bool GLWindow::Initialize(GLWindowCallbacks* callbacks){
         return false;
     }
 
-    // Set swap interval and print info
-    glfwSwapInterval(1);
+    // Print info and set swap interval according to the frame pacing mode
     PrintGLInfo();
+    FramePacingMode pacingMode = FRAME_PACING_MODE_VSYNC;
+    (void) FramePacingModeFromString(pacingMode, prismaConfiguration.window.framePacing);
+    GLFWmonitor* pacingMonitor = targetMonitor ? targetMonitor : glfwGetPrimaryMonitor();
+    const GLFWvidmode* videoMode = pacingMonitor ? glfwGetVideoMode(pacingMonitor) : nullptr;
+    glfwSwapInterval(framePacer.Start(pacingMode, prismaConfiguration.window.swapInterval, prismaConfiguration.window.targetFrameRate, videoMode ? videoMode->refreshRate : 0, prismaConfiguration.window.justInTimeMarginUs));
     return true;
 }
 
@@ -111,7 +118,10 @@ void GLWindow::MainLoop(GLWindowCallbacks* callbacks){
             glfwSetTime(0.0);
             double tPrevious = 0.0;
             double tFPS = 0.0;
-            while(!glfwWindowShouldClose(glfwWindow)){
+            while(!glfwWindowShouldClose(glfwWindow) && !closeRequested){
+                // wait until the frame should start, such that the latest messages are latched
+                framePacer.WaitForFrameStart();
+
                 // measure elapsed time
                 double tNow = glfwGetTime();
                 double dt = tNow - tPrevious;
@@ -129,11 +139,19 @@ void GLWindow::MainLoop(GLWindowCallbacks* callbacks){
                 }
 
                 // update, render and swap double buffers
+                ProfilerZone frameZone("Update");
                 callbacks->CallbackUpdate(glfwWindow, dt);
+                frameZone.Next("Render");
                 callbacks->CallbackRender(glfwWindow);
+                frameZone.Next("SwapBuffers");
+                framePacer.BeforeSwap();
                 glfwSwapBuffers(glfwWindow);
+                framePacer.AfterSwap();
+                callbacks->CallbackSwapped(glfwWindow);
+                frameZone.Next("PollEvents");
                 glfwPollEvents();
             }
+            framePacer.PrintSummary();
         }
         callbacks->CallbackTerminate(glfwWindow);
     }
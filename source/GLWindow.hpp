@@ -4,6 +4,7 @@
 #include <Common.hpp>
 #include <NonCopyable.hpp>
 #include <GLWindowCallbacks.hpp>
+#include <FramePacer.hpp>
 
 
 class GLWindow: private NonCopyable {
@@ -30,7 +31,9 @@ class GLWindow: private NonCopyable {
         void Close(void);
 
     private:
-        GLFWwindow* glfwWindow;    /// The internal GLFW window object.
+        GLFWwindow* glfwWindow;                /// The internal GLFW window object.
+        std::atomic<bool> closeRequested;      /// True if @ref Close has been called, e.g. before the window has been created.
+        FramePacer framePacer;                 /// Paces the frames of the main loop according to the configured frame pacing mode.
 
         /**
          * @brief Initialize the GL window.
@@ -58,6 +58,16 @@ class GLWindowCallbacks {
             (void)wnd;
         }
 
+        /**
+         * @brief The swap callback function.
+         * @param[in] wnd The GLFW window.
+         * @details This callback function is called after the double buffers of the frame that has been rendered via
+         * @ref CallbackRender have been swapped.
+         */
+        virtual void CallbackSwapped(GLFWwindow* wnd){
+            (void)wnd;
+        }
+
         /**
          * @brief The GLFW key callback function.
          * @param[in] wnd The window that received the event.
@@ -1,6 +1,7 @@
 #include <MainApplication.hpp>
 #include <FileManager.hpp>
 #include <PrismaConfiguration.hpp>
+#include <Profiler.hpp>
 
 
 MainApplication mainApplication;
@@ -12,16 +13,23 @@ void MainApplication::Run(int argc, char** argv){
     std::signal(SIGINT, &SignalHandler);
     std::signal(SIGTERM, &SignalHandler);
     std::signal(SIGSEGV, &SignalHandler);
+    #ifndef _WIN32
+    std::signal(SIGUSR1, &SignalHandler);
+    #endif
     RedirectPrintsToFile();
 
-    // load configuration file
+    // parse arguments and load configuration file
     std::string alternativeConfigurationFile = "";
-    if(2 == argc){
-        alternativeConfigurationFile = argv[1];
+    std::string replayFile = "";
+    double replaySpeed = 1.0;
+    if(!ParseArguments(argc, argv, alternativeConfigurationFile, replayFile, replaySpeed)){
+        return;
     }
     if(!prismaConfiguration.ReadFromFile(alternativeConfigurationFile)){
         return;
     }
+    profiler.Enable(prismaConfiguration.engine.enableProfiler);
+    profiler.SetThreadName("render");
 
     // print information
     PrintSystemInfo();
@@ -29,10 +37,18 @@ void MainApplication::Run(int argc, char** argv){
     PrintConfiguration();
     Print("\n");
 
-    // start network manager, create window and run event loop
-    networkManager.Start();
+    // start network manager (or replay a datagram log), create window and run event loop
+    if(replayFile.empty()){
+        networkManager.Start();
+    }
+    else{
+        engine.GetFrameTimeStatistics().Enable();
+        networkManager.StartReplay(replayFile, replaySpeed, [this](){ CloseWindow(); });
+    }
     glWindow.Run(&engine);
     networkManager.Stop();
+    engine.GetFrameTimeStatistics().PrintSummary();
+    engine.GetLatencyStatistics().PrintSummary();
 }
 
 void MainApplication::CloseWindow(void){
@@ -43,6 +59,36 @@ void MainApplication::SendWindowEventMessage(WindowEventMessage& msg){
     networkManager.SendWindowEventMessage(msg);
 }
 
+void MainApplication::SendTelemetryMessage(TelemetryMessage& msg){
+    networkManager.SendTelemetryMessage(msg);
+}
+
+bool MainApplication::ParseArguments(int argc, char** argv, std::string& configurationFile, std::string& replayFile, double& replaySpeed){
+    for(int i = 1; i < argc; ++i){
+        std::string argument(argv[i]);
+        if(("--replay" == argument) && ((i + 1) < argc)){
+            replayFile = argv[++i];
+        }
+        else if(("--replay-speed" == argument) && ((i + 1) < argc)){
+            try{
+                replaySpeed = std::stod(argv[++i]);
+            }
+            catch(...){
+                PrintE("Invalid replay speed \"%s\"!\n", argv[i]);
+                return false;
+            }
+        }
+        else if(configurationFile.empty() && (argument.rfind("--", 0) != 0)){
+            configurationFile = argument;
+        }
+        else{
+            PrintE("Invalid argument \"%s\"! Usage: PRISMA [configuration.json] [--replay file] [--replay-speed factor]\n", argument.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
 void MainApplication::PrintSystemInfo(void){
     // title
     Print("PRISMA\n\n");
@@ -199,6 +245,11 @@ void MainApplication::SignalHandler(int signal){
         case SIGTERM:
             mainApplication.CloseWindow();
             break;
+        #ifndef _WIN32
+        case SIGUSR1:
+            profiler.RequestDump();
+            break;
+        #endif
     }
 }
 
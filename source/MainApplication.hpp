@@ -7,6 +7,7 @@
 #include <Engine.hpp>
 #include <NetworkManager.hpp>
 #include <WindowEventMessage.hpp>
+#include <TelemetryMessage.hpp>
 
 
 class MainApplication: private NonCopyable {
@@ -29,11 +30,28 @@ class MainApplication: private NonCopyable {
          */
         void SendWindowEventMessage(WindowEventMessage& msg);
 
+        /**
+         * @brief Send a telemetry message via the network manager.
+         * @param[in] msg The message to be send.
+         */
+        void SendTelemetryMessage(TelemetryMessage& msg);
+
     private:
         GLWindow glWindow;               // The internal GL window object.
         Engine engine;                   // The internal PRISMA engine that handles input events and rendering (this engine also contains the PRISMA state).
         NetworkManager networkManager;   // The network manager that handles incomming UDP messages.
 
+        /**
+         * @brief Parse the arguments that were passed to the application.
+         * @param[in] argc Number of arguments passed to the application.
+         * @param[in] argv List of arguments passed to the application.
+         * @param[out] configurationFile The filename of an alternative configuration file or an empty string if no configuration file is given.
+         * @param[out] replayFile The filename of a datagram log to be replayed (--replay) or an empty string if no replay is requested.
+         * @param[out] replaySpeed The replay speed (--replay-speed), where a value less than or equal to zero replays the datagrams as fast as possible.
+         * @return True if success, false if an argument is invalid.
+         */
+        bool ParseArguments(int argc, char** argv, std::string& configurationFile, std::string& replayFile, double& replaySpeed);
+
         /**
          * @brief Print system information to the output.
          */
@@ -0,0 +1,110 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <NonCopyable.hpp>
+
+
+/**
+ * @brief A read-only view of the whole content of a file.
+ * @details On Linux the file is memory-mapped, such that the content is parsed in place without being copied. On other
+ * systems the content is read into a buffer.
+ */
+class MappedFile: private NonCopyable {
+    public:
+        /**
+         * @brief Construct a new mapped file object without any content.
+         */
+        MappedFile(): data(nullptr), size(0), mappedSize(0){}
+
+        /**
+         * @brief Unmap the file.
+         */
+        ~MappedFile(){ Close(); }
+
+        /**
+         * @brief Map the whole content of a file.
+         * @param[in] filename The name of the file to be mapped.
+         * @return True if success, false otherwise.
+         */
+        bool Open(const std::string& filename){
+            Close();
+            #ifdef __linux__
+            int fd = open(filename.c_str(), O_RDONLY);
+            if(fd < 0){
+                return false;
+            }
+            struct stat st;
+            if(fstat(fd, &st) < 0){
+                (void) close(fd);
+                return false;
+            }
+            size = static_cast<size_t>(st.st_size);
+            if(size){
+                void* memory = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if(MAP_FAILED == memory){
+                    (void) close(fd);
+                    size = 0;
+                    return false;
+                }
+                (void) madvise(memory, size, MADV_SEQUENTIAL);
+                data = reinterpret_cast<const char*>(memory);
+                mappedSize = size;
+            }
+            (void) close(fd);
+            return true;
+            #else
+            std::ifstream file(filename, std::ifstream::binary | std::ifstream::ate);
+            if(!file.is_open()){
+                return false;
+            }
+            buffer.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            if(!file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))){
+                buffer.clear();
+                return false;
+            }
+            data = buffer.data();
+            size = buffer.size();
+            return true;
+            #endif
+        }
+
+        /**
+         * @brief Unmap the file and release the content.
+         */
+        void Close(void){
+            #ifdef __linux__
+            if(mappedSize){
+                (void) munmap(const_cast<char*>(data), mappedSize);
+            }
+            #else
+            buffer.clear();
+            buffer.shrink_to_fit();
+            #endif
+            data = nullptr;
+            size = 0;
+            mappedSize = 0;
+        }
+
+        /**
+         * @brief Get the content of the file.
+         * @return Pointer to the first byte or nullptr if the file is empty or not open.
+         */
+        const char* GetData(void) const { return data; }
+
+        /**
+         * @brief Get the size of the file.
+         * @return Number of bytes of the file content.
+         */
+        size_t GetSize(void) const { return size; }
+
+    private:
+        const char* data;           // Pointer to the first byte of the content.
+        size_t size;                // Number of bytes of the content.
+        size_t mappedSize;          // Number of bytes that have been mapped, zero if nothing is mapped.
+        #ifndef __linux__
+        std::vector<char> buffer;   // Content of the file if memory mapping is not supported.
+        #endif
+};
+
@@ -2,6 +2,10 @@
 
 
 #include <Common.hpp>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NETWORK_UTILS_X86
+#endif
 
 
 namespace NetworkUtils {
@@ -41,5 +45,341 @@ template <typename T> inline T NetworkToNativeByteOrder(T t){
 }
 
 
+/**
+ * @brief Swap the native host byte order to the network byte order.
+ * @tparam T Template data type.
+ * @param t The value for which to swap the byte order.
+ * @return Input value, where the byte order is changed from native to network byte order.
+ */
+template <typename T> inline T NativeToNetworkByteOrder(T t){
+    return NetworkToNativeByteOrder(t);
+}
+
+
+/**
+ * @brief Read a value in network byte order from possibly unaligned memory.
+ * @tparam T Template data type.
+ * @param bytes The bytes containing the value in network byte order.
+ * @return The value in native byte order.
+ */
+template <typename T> inline T ReadNetworkByteOrder(const uint8_t* bytes){
+    T t;
+    std::memcpy(&t, bytes, sizeof(T));
+    return NetworkToNativeByteOrder(t);
+}
+
+
+/**
+ * @brief Convert a half-precision floating-point value (IEEE 754 binary16) to a single-precision floating-point value.
+ * @param h The half-precision value in native byte order.
+ * @return The single-precision value.
+ */
+inline float HalfToFloat(uint16_t h){
+    union {
+        uint32_t u;
+        float f;
+    } result;
+    uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+    uint32_t exponent = static_cast<uint32_t>(h >> 10) & 0x1F;
+    uint32_t mantissa = static_cast<uint32_t>(h) & 0x03FF;
+    if(!exponent){ // zero or subnormal number
+        float f = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -f : f;
+    }
+    if(0x1F == exponent){ // infinity or NaN
+        result.u = sign | 0x7F800000 | (mantissa << 13);
+        return result.f;
+    }
+    result.u = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    return result.f;
+}
+
+
+/**
+ * @brief The instruction set that is used by the bulk conversion routines.
+ */
+enum SIMDLevel {
+    SIMD_LEVEL_SCALAR = 0,   // Plain C++ without vector instructions.
+    SIMD_LEVEL_SSE4,         // SSE4.1 (including SSSE3 byte shuffles).
+    SIMD_LEVEL_AVX2          // AVX2 (256-bit integer instructions).
+};
+
+
+/**
+ * @brief Get the best instruction set that is supported by the CPU.
+ * @return The SIMD level that is used by the bulk conversion routines. The CPU is only queried once.
+ * @details The vector routines are compiled with function-specific target attributes, such that the binary still runs
+ * on CPUs without SSE4.1 or AVX2.
+ */
+inline SIMDLevel GetSIMDLevel(void){
+    #ifdef NETWORK_UTILS_X86
+    static const SIMDLevel level = __builtin_cpu_supports("avx2") ? SIMD_LEVEL_AVX2 : (__builtin_cpu_supports("sse4.1") ? SIMD_LEVEL_SSE4 : SIMD_LEVEL_SCALAR);
+    return level;
+    #else
+    return SIMD_LEVEL_SCALAR;
+    #endif
+}
+
+
+/**
+ * @brief Copy 32-bit values from network byte order to native byte order (scalar version).
+ * @param[out] destination The destination of count 32-bit values.
+ * @param[in] source The source bytes, need not be aligned.
+ * @param[in] count The number of 32-bit values.
+ */
+inline void ReadNetworkByteOrderArray32Scalar(void* destination, const uint8_t* source, size_t count){
+    uint8_t* dst = reinterpret_cast<uint8_t*>(destination);
+    for(size_t i = 0; i < count; ++i){
+        uint32_t value = ReadNetworkByteOrder<uint32_t>(&source[4 * i]);
+        std::memcpy(&dst[4 * i], &value, sizeof(value));
+    }
+}
+
+
+/**
+ * @brief Copy indices from network byte order to native 32-bit values and get the maximum index (scalar version).
+ * @tparam T The type of the indices in the source, either uint16_t or uint32_t.
+ * @param[out] destination The destination of count 32-bit values.
+ * @param[in] source The source bytes, need not be aligned.
+ * @param[in] count The number of indices.
+ * @return The maximum index or zero if count is zero.
+ */
+template <typename T> inline uint32_t ReadNetworkByteOrderIndicesScalar(uint32_t* destination, const uint8_t* source, size_t count){
+    uint32_t maxIndex = 0;
+    for(size_t i = 0; i < count; ++i){
+        destination[i] = static_cast<uint32_t>(ReadNetworkByteOrder<T>(&source[sizeof(T) * i]));
+        maxIndex = std::max(maxIndex, destination[i]);
+    }
+    return maxIndex;
+}
+
+
+#ifdef NETWORK_UTILS_X86
+/**
+ * @brief Copy 32-bit values from network byte order to native byte order (SSE4 version).
+ */
+__attribute__((target("sse4.1"))) inline void ReadNetworkByteOrderArray32SSE4(void* destination, const uint8_t* source, size_t count){
+    const __m128i mask = _mm_setr_epi8(3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12);
+    uint8_t* dst = reinterpret_cast<uint8_t*>(destination);
+    size_t i = 0;
+    for(; (i + 4) <= count; i += 4){
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[4 * i]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[4 * i]), _mm_shuffle_epi8(v, mask));
+    }
+    ReadNetworkByteOrderArray32Scalar(&dst[4 * i], &source[4 * i], count - i);
+}
+
+
+/**
+ * @brief Copy 32-bit values from network byte order to native byte order (AVX2 version).
+ */
+__attribute__((target("avx2"))) inline void ReadNetworkByteOrderArray32AVX2(void* destination, const uint8_t* source, size_t count){
+    const __m256i mask = _mm256_setr_epi8(3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12, 3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12);
+    uint8_t* dst = reinterpret_cast<uint8_t*>(destination);
+    size_t i = 0;
+    for(; (i + 8) <= count; i += 8){
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&source[4 * i]));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dst[4 * i]), _mm256_shuffle_epi8(v, mask));
+    }
+    ReadNetworkByteOrderArray32Scalar(&dst[4 * i], &source[4 * i], count - i);
+}
+
+
+/**
+ * @brief Copy 16-bit indices from network byte order to native 32-bit values and get the maximum index (SSE4 version).
+ */
+__attribute__((target("sse4.1"))) inline uint32_t ReadNetworkByteOrderIndices16SSE4(uint32_t* destination, const uint8_t* source, size_t count){
+    const __m128i mask = _mm_setr_epi8(1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14);
+    __m128i maxIndex = _mm_setzero_si128();
+    size_t i = 0;
+    for(; (i + 8) <= count; i += 8){
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[2 * i])), mask);
+        __m128i lo = _mm_cvtepu16_epi32(v);
+        __m128i hi = _mm_cvtepu16_epi32(_mm_srli_si128(v, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i + 4]), hi);
+        maxIndex = _mm_max_epu32(maxIndex, _mm_max_epu32(lo, hi));
+    }
+    maxIndex = _mm_max_epu32(maxIndex, _mm_shuffle_epi32(maxIndex, _MM_SHUFFLE(1,0,3,2)));
+    maxIndex = _mm_max_epu32(maxIndex, _mm_shuffle_epi32(maxIndex, _MM_SHUFFLE(2,3,0,1)));
+    return std::max(static_cast<uint32_t>(_mm_cvtsi128_si32(maxIndex)), ReadNetworkByteOrderIndicesScalar<uint16_t>(&destination[i], &source[2 * i], count - i));
+}
+
+
+/**
+ * @brief Copy 16-bit indices from network byte order to native 32-bit values and get the maximum index (AVX2 version).
+ */
+__attribute__((target("avx2"))) inline uint32_t ReadNetworkByteOrderIndices16AVX2(uint32_t* destination, const uint8_t* source, size_t count){
+    const __m128i mask = _mm_setr_epi8(1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14);
+    __m256i maxIndex = _mm256_setzero_si256();
+    size_t i = 0;
+    for(; (i + 8) <= count; i += 8){
+        __m256i v = _mm256_cvtepu16_epi32(_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[2 * i])), mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&destination[i]), v);
+        maxIndex = _mm256_max_epu32(maxIndex, v);
+    }
+    __m128i m = _mm_max_epu32(_mm256_castsi256_si128(maxIndex), _mm256_extracti128_si256(maxIndex, 1));
+    m = _mm_max_epu32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1,0,3,2)));
+    m = _mm_max_epu32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2,3,0,1)));
+    return std::max(static_cast<uint32_t>(_mm_cvtsi128_si32(m)), ReadNetworkByteOrderIndicesScalar<uint16_t>(&destination[i], &source[2 * i], count - i));
+}
+
+
+/**
+ * @brief Copy 32-bit indices from network byte order to native byte order and get the maximum index (SSE4 version).
+ */
+__attribute__((target("sse4.1"))) inline uint32_t ReadNetworkByteOrderIndices32SSE4(uint32_t* destination, const uint8_t* source, size_t count){
+    const __m128i mask = _mm_setr_epi8(3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12);
+    __m128i maxIndex = _mm_setzero_si128();
+    size_t i = 0;
+    for(; (i + 4) <= count; i += 4){
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[4 * i])), mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[i]), v);
+        maxIndex = _mm_max_epu32(maxIndex, v);
+    }
+    maxIndex = _mm_max_epu32(maxIndex, _mm_shuffle_epi32(maxIndex, _MM_SHUFFLE(1,0,3,2)));
+    maxIndex = _mm_max_epu32(maxIndex, _mm_shuffle_epi32(maxIndex, _MM_SHUFFLE(2,3,0,1)));
+    return std::max(static_cast<uint32_t>(_mm_cvtsi128_si32(maxIndex)), ReadNetworkByteOrderIndicesScalar<uint32_t>(&destination[i], &source[4 * i], count - i));
+}
+
+
+/**
+ * @brief Copy 32-bit indices from network byte order to native byte order and get the maximum index (AVX2 version).
+ */
+__attribute__((target("avx2"))) inline uint32_t ReadNetworkByteOrderIndices32AVX2(uint32_t* destination, const uint8_t* source, size_t count){
+    const __m256i mask = _mm256_setr_epi8(3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12, 3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12);
+    __m256i maxIndex = _mm256_setzero_si256();
+    size_t i = 0;
+    for(; (i + 8) <= count; i += 8){
+        __m256i v = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&source[4 * i])), mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&destination[i]), v);
+        maxIndex = _mm256_max_epu32(maxIndex, v);
+    }
+    __m128i m = _mm_max_epu32(_mm256_castsi256_si128(maxIndex), _mm256_extracti128_si256(maxIndex, 1));
+    m = _mm_max_epu32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1,0,3,2)));
+    m = _mm_max_epu32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2,3,0,1)));
+    return std::max(static_cast<uint32_t>(_mm_cvtsi128_si32(m)), ReadNetworkByteOrderIndicesScalar<uint32_t>(&destination[i], &source[4 * i], count - i));
+}
+
+
+/**
+ * @brief Update the bounds of the first three components of strided vertices (SSE4 version).
+ * @details Four floats are loaded per vertex, thus at least four floats per vertex are required. The fourth lane is ignored.
+ */
+__attribute__((target("sse4.1"))) inline void UpdateBoundsSSE4(const GLfloat* vertices, size_t numVertices, size_t floatsPerVertex, glm::vec3& lowest, glm::vec3& highest){
+    __m128 lo = _mm_setr_ps(lowest.x, lowest.y, lowest.z, 0.0f);
+    __m128 hi = _mm_setr_ps(highest.x, highest.y, highest.z, 0.0f);
+    for(size_t v = 0; v < numVertices; ++v){
+        __m128 p = _mm_loadu_ps(&vertices[v * floatsPerVertex]);
+        lo = _mm_min_ps(p, lo); // the second operand is returned for NaN, thus NaN values are ignored like with std::min
+        hi = _mm_max_ps(p, hi);
+    }
+    alignas(16) float l[4], h[4];
+    _mm_store_ps(l, lo);
+    _mm_store_ps(h, hi);
+    lowest = glm::vec3(l[0], l[1], l[2]);
+    highest = glm::vec3(h[0], h[1], h[2]);
+}
+#endif /* NETWORK_UTILS_X86 */
+
+
+/**
+ * @brief Copy 32-bit values (e.g. floats) from network byte order to native byte order.
+ * @param[out] destination The destination of count 32-bit values.
+ * @param[in] source The source bytes, need not be aligned.
+ * @param[in] count The number of 32-bit values.
+ * @details AVX2 or SSE4 is used if supported by the CPU (see @ref GetSIMDLevel).
+ */
+inline void ReadNetworkByteOrderArray32(void* destination, const uint8_t* source, size_t count){
+    if constexpr (std::endian::native == std::endian::big){
+        std::memcpy(destination, source, 4 * count);
+        return;
+    }
+    #ifdef NETWORK_UTILS_X86
+    switch(GetSIMDLevel()){
+        case SIMD_LEVEL_AVX2: ReadNetworkByteOrderArray32AVX2(destination, source, count); return;
+        case SIMD_LEVEL_SSE4: ReadNetworkByteOrderArray32SSE4(destination, source, count); return;
+        default: break;
+    }
+    #endif
+    ReadNetworkByteOrderArray32Scalar(destination, source, count);
+}
+
+
+/**
+ * @brief Copy 16-bit indices from network byte order to native 32-bit values and get the maximum index.
+ * @param[out] destination The destination of count 32-bit values.
+ * @param[in] source The source bytes, need not be aligned.
+ * @param[in] count The number of indices.
+ * @return The maximum index or zero if count is zero, such that all indices can be checked with a single comparison.
+ */
+inline uint32_t ReadNetworkByteOrderIndices16(uint32_t* destination, const uint8_t* source, size_t count){
+    #ifdef NETWORK_UTILS_X86
+    switch(GetSIMDLevel()){
+        case SIMD_LEVEL_AVX2: return ReadNetworkByteOrderIndices16AVX2(destination, source, count);
+        case SIMD_LEVEL_SSE4: return ReadNetworkByteOrderIndices16SSE4(destination, source, count);
+        default: break;
+    }
+    #endif
+    return ReadNetworkByteOrderIndicesScalar<uint16_t>(destination, source, count);
+}
+
+
+/**
+ * @brief Copy 32-bit indices from network byte order to native byte order and get the maximum index.
+ * @param[out] destination The destination of count 32-bit values.
+ * @param[in] source The source bytes, need not be aligned.
+ * @param[in] count The number of indices.
+ * @return The maximum index or zero if count is zero, such that all indices can be checked with a single comparison.
+ */
+inline uint32_t ReadNetworkByteOrderIndices32(uint32_t* destination, const uint8_t* source, size_t count){
+    #ifdef NETWORK_UTILS_X86
+    switch(GetSIMDLevel()){
+        case SIMD_LEVEL_AVX2: return ReadNetworkByteOrderIndices32AVX2(destination, source, count);
+        case SIMD_LEVEL_SSE4: return ReadNetworkByteOrderIndices32SSE4(destination, source, count);
+        default: break;
+    }
+    #endif
+    return ReadNetworkByteOrderIndicesScalar<uint32_t>(destination, source, count);
+}
+
+
+/**
+ * @brief Copy vertices of 32-bit floats from network byte order to native byte order and compute the bounds of the positions.
+ * @param[out] destination The destination of numVertices * floatsPerVertex floats.
+ * @param[in] source The source bytes, need not be aligned.
+ * @param[in] numVertices The number of vertices.
+ * @param[in] floatsPerVertex The number of floats per vertex, where the first three floats are the position.
+ * @param[out] lowest The component-wise minimum of all positions, +infinity if there are no vertices.
+ * @param[out] highest The component-wise maximum of all positions, -infinity if there are no vertices.
+ * @details The vertices are converted in blocks and the bounds of a block are reduced while the block is still in the
+ * cache. NaN values are ignored by the reduction.
+ */
+inline void ReadNetworkByteOrderVertices(GLfloat* destination, const uint8_t* source, size_t numVertices, size_t floatsPerVertex, glm::vec3& lowest, glm::vec3& highest){
+    constexpr size_t blockSize = 512;
+    lowest = glm::vec3(std::numeric_limits<GLfloat>::infinity());
+    highest = glm::vec3(-std::numeric_limits<GLfloat>::infinity());
+    for(size_t first = 0; first < numVertices; first += blockSize){
+        size_t n = std::min(blockSize, numVertices - first);
+        GLfloat* block = &destination[first * floatsPerVertex];
+        ReadNetworkByteOrderArray32(block, &source[first * floatsPerVertex * sizeof(GLfloat)], n * floatsPerVertex);
+        #ifdef NETWORK_UTILS_X86
+        if((floatsPerVertex >= 4) && (SIMD_LEVEL_SCALAR != GetSIMDLevel())){
+            UpdateBoundsSSE4(block, n, floatsPerVertex, lowest, highest);
+            continue;
+        }
+        #endif
+        for(size_t v = 0; v < n; ++v){
+            const GLfloat* p = &block[v * floatsPerVertex];
+            lowest.x = std::min(lowest.x, p[0]);
+            lowest.y = std::min(lowest.y, p[1]);
+            lowest.z = std::min(lowest.z, p[2]);
+            highest.x = std::max(highest.x, p[0]);
+            highest.y = std::max(highest.y, p[1]);
+            highest.z = std::max(highest.z, p[2]);
+        }
+    }
+}
+
 } /* namespace: NetworkUtils */
 
@@ -1,5 +1,7 @@
 #include <PrismaConfiguration.hpp>
 #include <FileManager.hpp>
+#include <MessageQueue.hpp>
+#include <FramePacer.hpp>
 #include <nlohmann/json.hpp>
 
 
@@ -26,6 +28,10 @@ void PrismaConfiguration::Clear(void){
     window.showFPSInTitle = false;
     window.closeWithEscape = true;
     window.allowManualCameraControl = true;
+    window.framePacing = "vsync";
+    window.swapInterval = 1;
+    window.targetFrameRate = 60.0;
+    window.justInTimeMarginUs = 1500;
     engine.enableWaterReflection = true;
     engine.enableAtmosphericScattering = true;
     engine.enableShadowMapping = true;
@@ -39,14 +45,37 @@ void PrismaConfiguration::Clear(void){
     engine.shadowMapResolution = 4096;
     engine.maxNumBloomMips = 6;
     engine.convertSRGBToLinearRGB = true;
+    engine.poseInterpolationDelayMs = 50;
+    engine.poseExtrapolationLimitMs = 100;
+    engine.enableGPUPassTimers = true;
+    engine.enableProfiler = false;
+    engine.enableMeshCache = true;
     network.localPort = 31416;
     network.interfaceAddress = {0,0,0,0};
     network.interfaceName = "";
     network.socketPriority = 6;
     network.socketErrorRetryTimeMs = 1000;
+    network.transport = "udp";
+    network.sharedMemory.name = "/prisma";
+    network.sharedMemory.size = 16777216;
+    network.stream.tcpAddress = {127,0,0,1};
+    network.stream.tcpPort = 0;
+    network.stream.unixSocketPath = "";
+    network.stream.receiveBufferSize = 4194304;
     network.receive.multicastGroups = {{239,0,0,1}};
+    network.receive.batchSize = 64;
+    network.receive.socketBufferSize = 0;
+    network.receive.queueCapacity = 4096;
+    network.receive.overflowPolicy = "dropOldest";
+    network.receive.coalesceMessages = true;
+    network.receive.fragmentTimeoutMs = 1000;
+    network.receive.maxMessageSize = 268435456;
+    network.receive.maxReassemblyBytes = 268435456;
+    network.receive.captureFile = "";
     network.send.destinationAddresses.clear();
     network.send.timeToLive = 1;
+    network.send.onlyOnChange = false;
+    network.send.telemetryPeriodMs = 0;
 }
 
 bool PrismaConfiguration::ReadFromFile(std::string alternativeConfigurationFile){
@@ -87,6 +116,10 @@ bool PrismaConfiguration::ReadFromFile(std::string alternativeConfigurationFile)
     try{ window.showFPSInTitle              = jsonData.at("window").at("showFPSInTitle");                                       } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ window.closeWithEscape             = jsonData.at("window").at("closeWithEscape");                                      } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ window.allowManualCameraControl    = jsonData.at("window").at("allowManualCameraControl");                             } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ window.framePacing                 = jsonData.at("window").at("framePacing");                                          } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ window.swapInterval                = jsonData.at("window").at("swapInterval");                                         } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ window.targetFrameRate             = jsonData.at("window").at("targetFrameRate");                                      } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ window.justInTimeMarginUs          = jsonData.at("window").at("justInTimeMarginUs");                                   } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ engine.enableWaterReflection       = jsonData.at("engine").at("enableWaterReflection");                                } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ engine.enableAtmosphericScattering = jsonData.at("engine").at("enableAtmosphericScattering");                          } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ engine.enableShadowMapping         = jsonData.at("engine").at("enableShadowMapping");                                  } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
@@ -100,14 +133,71 @@ bool PrismaConfiguration::ReadFromFile(std::string alternativeConfigurationFile)
     try{ engine.shadowMapResolution         = jsonData.at("engine").at("shadowMapResolution");                                  } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ engine.maxNumBloomMips             = jsonData.at("engine").at("maxNumBloomMips");                                      } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ engine.convertSRGBToLinearRGB      = jsonData.at("engine").at("convertSRGBToLinearRGB");                               } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ engine.poseInterpolationDelayMs    = jsonData.at("engine").at("poseInterpolationDelayMs");                             } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ engine.poseExtrapolationLimitMs    = jsonData.at("engine").at("poseExtrapolationLimitMs");                             } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ engine.enableGPUPassTimers         = jsonData.at("engine").at("enableGPUPassTimers");                                  } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ engine.enableProfiler              = jsonData.at("engine").at("enableProfiler");                                       } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ engine.enableMeshCache             = jsonData.at("engine").at("enableMeshCache");                                      } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ network.localPort                  = jsonData.at("network").at("localPort");                                           } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ network.interfaceAddress           = jsonData.at("network").at("interfaceAddress");                                    } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ network.interfaceName              = jsonData.at("network").at("interfaceName");                                       } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ network.socketPriority             = jsonData.at("network").at("socketPriority");                                      } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ network.socketErrorRetryTimeMs     = jsonData.at("network").at("socketErrorRetryTimeMs");                              } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.transport                  = jsonData.at("network").at("transport");                                           } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.sharedMemory.name          = jsonData.at("network").at("sharedMemory").at("name");                             } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.sharedMemory.size          = jsonData.at("network").at("sharedMemory").at("size");                             } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.stream.tcpAddress          = jsonData.at("network").at("stream").at("tcpAddress");                             } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.stream.tcpPort             = jsonData.at("network").at("stream").at("tcpPort");                                } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.stream.unixSocketPath      = jsonData.at("network").at("stream").at("unixSocketPath");                         } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.stream.receiveBufferSize   = jsonData.at("network").at("stream").at("receiveBufferSize");                      } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ network.receive.multicastGroups    = jsonData.at("network").at("receive").at("multicastGroups");                       } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.receive.batchSize          = jsonData.at("network").at("receive").at("batchSize");                             } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.receive.socketBufferSize   = jsonData.at("network").at("receive").at("socketBufferSize");                      } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.receive.queueCapacity      = jsonData.at("network").at("receive").at("queueCapacity");                         } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.receive.overflowPolicy     = jsonData.at("network").at("receive").at("overflowPolicy");                        } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.receive.coalesceMessages   = jsonData.at("network").at("receive").at("coalesceMessages");                      } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.receive.fragmentTimeoutMs  = jsonData.at("network").at("receive").at("fragmentTimeoutMs");                     } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.receive.maxMessageSize     = jsonData.at("network").at("receive").at("maxMessageSize");                        } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.receive.maxReassemblyBytes = jsonData.at("network").at("receive").at("maxReassemblyBytes");                    } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.receive.captureFile        = jsonData.at("network").at("receive").at("captureFile");                           } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ network.send.destinationAddresses  = jsonData.at("network").at("send").at("destinationAddresses");                     } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
     try{ network.send.timeToLive            = jsonData.at("network").at("send").at("timeToLive");                               } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.send.onlyOnChange          = jsonData.at("network").at("send").at("onlyOnChange");                             } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    try{ network.send.telemetryPeriodMs     = jsonData.at("network").at("send").at("telemetryPeriodMs");                        } catch(const std::exception& e){ success = false; PrintE("Error in configuration file \"%s\": %s\n", filename.c_str(), e.what()); }
+    FramePacingMode pacingMode;
+    if(!FramePacingModeFromString(pacingMode, window.framePacing)){
+        PrintE("Error in configuration file \"%s\": Invalid frame pacing mode \"%s\"!\n", filename.c_str(), window.framePacing.c_str());
+        success = false;
+    }
+    if(!(window.targetFrameRate > 0.0)){
+        PrintE("Error in configuration file \"%s\": Target frame rate must be greater than zero!\n", filename.c_str());
+        success = false;
+    }
+    MessageQueueOverflowPolicy policy;
+    if(!MessageQueueOverflowPolicyFromString(policy, network.receive.overflowPolicy)){
+        PrintE("Error in configuration file \"%s\": Invalid message queue overflow policy \"%s\"!\n", filename.c_str(), network.receive.overflowPolicy.c_str());
+        success = false;
+    }
+    if(("udp" != network.transport) && ("sharedMemory" != network.transport)){
+        PrintE("Error in configuration file \"%s\": Invalid transport \"%s\"!\n", filename.c_str(), network.transport.c_str());
+        success = false;
+    }
+    if(("sharedMemory" == network.transport) && (network.sharedMemory.name.empty() || (network.sharedMemory.size < 65536))){
+        PrintE("Error in configuration file \"%s\": Shared memory requires a name and a size of at least 65536 bytes!\n", filename.c_str());
+        success = false;
+    }
+    if(!network.receive.queueCapacity){
+        PrintE("Error in configuration file \"%s\": Message queue capacity must be greater than zero!\n", filename.c_str());
+        success = false;
+    }
+    if(network.receive.maxMessageSize > static_cast<uint32_t>(std::numeric_limits<int32_t>::max())){
+        PrintE("Error in configuration file \"%s\": Maximum message size must not exceed %d bytes!\n", filename.c_str(), std::numeric_limits<int32_t>::max());
+        success = false;
+    }
+    if(network.receive.maxReassemblyBytes < network.receive.maxMessageSize){
+        PrintE("Error in configuration file \"%s\": Maximum number of reassembly bytes must not be less than the maximum message size!\n", filename.c_str());
+        success = false;
+    }
     for(auto&& a : network.send.destinationAddresses){
         if((a[0] > 0x00FF) || (a[1] > 0x00FF) || (a[2] > 0x00FF) || (a[3] > 0x00FF) || !a[4]){
             PrintE("Error in configuration file \"%s\": Invalid destination address %u.%u.%u.%u:%u!\n", filename.c_str(), a[0], a[1], a[2], a[3], a[4]);
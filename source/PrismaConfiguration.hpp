@@ -22,6 +22,10 @@ class PrismaConfiguration {
             bool showFPSInTitle;                                      // True if FPS should be shown in title.
             bool closeWithEscape;                                     // True if the window should be closed with the escape key of the keyboard.
             bool allowManualCameraControl;                            // True if the camera is allowed to be controlled manually.
+            std::string framePacing;                                  // Frame pacing mode, either "vsync", "uncapped", "fixedRate" or "justInTime".
+            uint32_t swapInterval;                                    // Number of vertical blanks to wait for before swapping the buffers in vsync mode.
+            double targetFrameRate;                                   // Frame rate in Hz in fixedRate mode.
+            uint32_t justInTimeMarginUs;                              // Safety margin in microseconds by which a frame starts earlier than predicted in justInTime mode.
         } window;
         struct {
             bool enableWaterReflection;                               // True if water reflection should be enabled, false otherwise.
@@ -37,6 +41,11 @@ class PrismaConfiguration {
             GLsizei shadowMapResolution;                              // Resolution of the shadow map in pixels.
             GLuint maxNumBloomMips;                                   // The maximum number of bloom mips.
             bool convertSRGBToLinearRGB;                              // True if mesh color and diffuse maps should be converted from standard RGB (sRGB) to linear RGB, false otherwise.
+            uint32_t poseInterpolationDelayMs;                        // Delay in milliseconds by which timestamped poses are displayed behind the latest received pose.
+            uint32_t poseExtrapolationLimitMs;                        // Maximum time in milliseconds by which timestamped poses are extrapolated beyond the latest received pose.
+            bool enableGPUPassTimers;                                 // True if the GPU time of each render pass should be measured via non-blocking timestamp queries.
+            bool enableProfiler;                                      // True if CPU zones of all threads should be recorded, such that a trace can be written on demand.
+            bool enableMeshCache;                                     // True if preprocessed mesh data should be read from and written to binary mesh cache files next to the mesh files.
         } engine;
         struct {
             uint16_t localPort;                                       // The local port to be bound.
@@ -44,12 +53,34 @@ class PrismaConfiguration {
             std::string interfaceName;                                // Name of the network interface to be used for joining the multicast group. If this string is empty, @ref interfaceAddress is used.
             int32_t socketPriority;                                   // The socket priority (linux only, in range [0 (lowest), 6 (greatest)]).
             uint32_t socketErrorRetryTimeMs;                          // Time in milliseconds to wait in case of an socket error before trying again.
+            std::string transport;                                    // Transport via which messages are received, either "udp" or "sharedMemory". Messages are always sent via UDP.
+            struct {
+                std::string name;                                     // Name of the POSIX shared memory object, e.g. "/prisma" (linux only).
+                uint32_t size;                                        // Capacity of the shared memory ring in bytes, rounded up to a power of two.
+            } sharedMemory;
+            struct {
+                std::array<uint8_t,4> tcpAddress;                     // IPv4 address of the interface at which to listen for TCP connections, {0,0,0,0} for all interfaces.
+                uint16_t tcpPort;                                     // TCP port to listen at for reliable stream connections. A value of zero disables TCP.
+                std::string unixSocketPath;                           // Path of the Unix domain socket to listen at (linux only). An empty string disables Unix domain sockets.
+                int32_t receiveBufferSize;                            // Size of the socket receive buffer of each stream connection in bytes. A value less than or equal to zero keeps the default value of the OS.
+            } stream;
             struct {
                 std::vector<std::array<uint8_t,4>> multicastGroups;   // The group addresses to be joined.
+                uint32_t batchSize;                                   // Maximum number of datagrams to be received with a single system call (at least 1).
+                int32_t socketBufferSize;                             // Size of the socket receive buffer in bytes. A value less than or equal to zero keeps the default value of the OS.
+                uint32_t queueCapacity;                               // Maximum number of messages in the queue between the network thread and the render thread.
+                std::string overflowPolicy;                           // Action if the message queue is full, either "block", "dropOldest" or "coalesce".
+                bool coalesceMessages;                                // True if messages that are superseded by newer messages of the same object should be removed before they are processed.
+                uint32_t fragmentTimeoutMs;                           // Time in milliseconds after which an incomplete fragmented message is discarded.
+                uint32_t maxMessageSize;                              // Maximum size in bytes of a fragmented message after reassembly.
+                uint32_t maxReassemblyBytes;                          // Maximum sum of the total lengths in bytes of all fragmented messages that are reassembled at the same time.
+                std::string captureFile;                              // Name of the file to which all received datagrams are captured. An empty string disables the capture.
             } receive;
             struct {
                 std::vector<std::array<uint16_t,5>> destinationAddresses;   // The destination addresses {ipA, ipB, ipC, ipD, port} to which to send messages.
                 uint8_t timeToLive;                                         // The time-to-live (TTL) value to be set for multicast messages.
+                bool onlyOnChange;                                          // True if window event messages should only be sent if they contain events or if the framebuffer size has changed.
+                uint32_t telemetryPeriodMs;                                 // Period in milliseconds at which telemetry messages are sent. A value of zero disables telemetry messages.
             } send;
         } network;
 
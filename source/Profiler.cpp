@@ -0,0 +1,92 @@
+#include <Profiler.hpp>
+
+
+Profiler profiler;
+
+
+/**
+ * @brief Owns the profiler buffer of a thread and releases it when the thread terminates.
+ */
+struct ProfilerThreadHandle {
+    ProfilerThreadBuffer* buffer = nullptr;
+    ~ProfilerThreadHandle(){
+        if(buffer){
+            profiler.ReleaseThreadBuffer(buffer);
+        }
+    }
+};
+static thread_local ProfilerThreadHandle profilerThreadHandle;
+
+
+void Profiler::Record(const char* name, int64_t start, int64_t end){
+    GetThreadBuffer()->Add(name, start, end - start);
+}
+
+void Profiler::SetThreadName(const std::string& name){
+    if(!IsEnabled()){
+        return;
+    }
+    ProfilerThreadBuffer* buffer = GetThreadBuffer();
+    const std::lock_guard<std::mutex> lock(mtx);
+    buffer->threadName = name;
+}
+
+bool Profiler::WriteChromeTrace(const std::string& filename){
+    FILE* file = std::fopen(filename.c_str(), "wb");
+    if(!file){
+        PrintE("Could not write profiler trace \"%s\"!\n", filename.c_str());
+        return false;
+    }
+    std::vector<const char*> names;
+    std::vector<int64_t> starts;
+    std::vector<int64_t> durations;
+    size_t numZones = 0;
+    const char* separator = "";
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    const std::lock_guard<std::mutex> lock(mtx);
+    for(auto&& buffer : buffers){
+        std::string threadName = buffer->threadName.empty() ? ("thread " + std::to_string(buffer->lane)) : buffer->threadName;
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", separator, buffer->lane, threadName.c_str());
+        separator = ",\n";
+        buffer->Copy(names, starts, durations);
+        for(size_t i = 0; i < names.size(); ++i){
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", names[i], buffer->lane, 0.001 * static_cast<double>(starts[i]), 0.001 * static_cast<double>(durations[i]));
+        }
+        numZones += names.size();
+    }
+    std::fprintf(file, "\n]}\n");
+    bool success = (0 == std::ferror(file));
+    success &= (0 == std::fclose(file));
+    if(success){
+        Print("Wrote profiler trace with %zu zones of %zu threads to \"%s\"\n", numZones, buffers.size(), filename.c_str());
+    }
+    else{
+        PrintE("Could not write profiler trace \"%s\"!\n", filename.c_str());
+    }
+    return success;
+}
+
+void Profiler::ReleaseThreadBuffer(ProfilerThreadBuffer* buffer){
+    const std::lock_guard<std::mutex> lock(mtx);
+    buffer->inUse = false;
+}
+
+ProfilerThreadBuffer* Profiler::GetThreadBuffer(void){
+    if(!profilerThreadHandle.buffer){
+        const std::lock_guard<std::mutex> lock(mtx);
+        for(auto&& buffer : buffers){
+            if(!buffer->inUse){
+                buffer->inUse = true;
+                buffer->threadName.clear();
+                profilerThreadHandle.buffer = buffer.get();
+                break;
+            }
+        }
+        if(!profilerThreadHandle.buffer){
+            buffers.push_back(std::make_unique<ProfilerThreadBuffer>(static_cast<uint32_t>(buffers.size() + 1)));
+            profilerThreadHandle.buffer = buffers.back().get();
+        }
+    }
+    return profilerThreadHandle.buffer;
+}
+
@@ -0,0 +1,247 @@
+#pragma once
+
+
+#include <Common.hpp>
+
+
+/**
+ * @brief The number of zones that are kept per thread. Must be a power of two. Older zones are overwritten.
+ */
+#define PROFILER_NUM_EVENTS_PER_THREAD (65536)
+
+
+/**
+ * @brief Helper macros to generate a unique variable name for @ref PROFILE_ZONE.
+ */
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+
+
+/**
+ * @brief Profile the enclosing scope.
+ * @param[in] name The name of the zone. Must be a string literal or any other string with static storage duration.
+ */
+#define PROFILE_ZONE(name) ProfilerZone PROFILER_CONCAT(profilerZone, __LINE__)(name)
+
+
+/**
+ * @brief A single zone that has been recorded by a thread. All members are atomic, such that the exporting thread can
+ * read a buffer while the owning thread overwrites old zones.
+ */
+struct ProfilerEvent {
+    std::atomic<const char*> name;   // The name of the zone.
+    std::atomic<int64_t> start;      // Start time in nanoseconds since the profiler has been constructed.
+    std::atomic<int64_t> duration;   // Duration in nanoseconds.
+};
+
+
+/**
+ * @brief A ring of zones that is written by exactly one thread without locks.
+ * @details The owning thread increments @ref numStarted before and @ref numFinished after writing a zone (seqlock). A
+ * reader copies all zones up to @ref numFinished and discards the zones that might have been overwritten in the meantime.
+ */
+class ProfilerThreadBuffer {
+    public:
+        /**
+         * @brief Construct a new thread buffer.
+         * @param[in] lane The unique lane number that is used as thread identifier in the trace.
+         */
+        explicit ProfilerThreadBuffer(uint32_t lane): lane(lane), inUse(true), numStarted(0), numFinished(0), events(new ProfilerEvent[PROFILER_NUM_EVENTS_PER_THREAD]){}
+
+        /**
+         * @brief Add a zone. Must only be called by the owning thread.
+         * @param[in] name The name of the zone.
+         * @param[in] start Start time in nanoseconds.
+         * @param[in] duration Duration in nanoseconds.
+         */
+        void Add(const char* name, int64_t start, int64_t duration){
+            uint64_t n = numFinished.load(std::memory_order_relaxed);
+            numStarted.store(n + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            ProfilerEvent& e = events[n & (PROFILER_NUM_EVENTS_PER_THREAD - 1)];
+            e.name.store(name, std::memory_order_relaxed);
+            e.start.store(start, std::memory_order_relaxed);
+            e.duration.store(duration, std::memory_order_relaxed);
+            numFinished.store(n + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Copy all consistent zones of this buffer. Can be called by any thread.
+         * @param[out] names Names of the zones.
+         * @param[out] starts Start times of the zones in nanoseconds.
+         * @param[out] durations Durations of the zones in nanoseconds.
+         */
+        void Copy(std::vector<const char*>& names, std::vector<int64_t>& starts, std::vector<int64_t>& durations) const {
+            names.clear();
+            starts.clear();
+            durations.clear();
+            uint64_t last = numFinished.load(std::memory_order_acquire);
+            uint64_t first = (last > PROFILER_NUM_EVENTS_PER_THREAD) ? (last - PROFILER_NUM_EVENTS_PER_THREAD) : 0;
+            for(uint64_t n = first; n < last; ++n){
+                const ProfilerEvent& e = events[n & (PROFILER_NUM_EVENTS_PER_THREAD - 1)];
+                names.push_back(e.name.load(std::memory_order_relaxed));
+                starts.push_back(e.start.load(std::memory_order_relaxed));
+                durations.push_back(e.duration.load(std::memory_order_relaxed));
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t started = numStarted.load(std::memory_order_relaxed);
+            uint64_t firstValid = (started > PROFILER_NUM_EVENTS_PER_THREAD) ? (started - PROFILER_NUM_EVENTS_PER_THREAD) : 0;
+            if(firstValid > first){
+                size_t numOverwritten = static_cast<size_t>(std::min(firstValid, last) - first);
+                names.erase(names.begin(), names.begin() + numOverwritten);
+                starts.erase(starts.begin(), starts.begin() + numOverwritten);
+                durations.erase(durations.begin(), durations.begin() + numOverwritten);
+            }
+        }
+
+        const uint32_t lane;                        // Unique lane number that is used as thread identifier in the trace.
+        std::string threadName;                     // Name of the thread that owns this buffer, protected by the profiler.
+        bool inUse;                                 // True if a thread owns this buffer, protected by the profiler.
+
+    private:
+        std::atomic<uint64_t> numStarted;           // Number of zones whose write has been started.
+        std::atomic<uint64_t> numFinished;          // Number of zones whose write has been finished.
+        std::unique_ptr<ProfilerEvent[]> events;    // Ring of zones.
+};
+
+
+/**
+ * @brief A lightweight CPU profiler that records scoped zones of all threads and exports them as Chrome trace JSON.
+ * @details Each thread records its zones into its own @ref ProfilerThreadBuffer, which is acquired once when the first
+ * zone of that thread ends. Buffers of terminated threads are reused by new threads, e.g. by the asynchronous workers of
+ * the mesh loader. If the profiler is disabled, a zone costs a single relaxed atomic load. The resulting file can be
+ * opened with chrome://tracing or https://ui.perfetto.dev.
+ */
+class Profiler {
+    public:
+        /**
+         * @brief Construct a new profiler. The profiler is disabled.
+         */
+        Profiler(): enabled(false), dumpRequested(false), epoch(std::chrono::steady_clock::now()){}
+
+        /**
+         * @brief Enable or disable the recording of zones.
+         * @param[in] enable True if zones should be recorded, false otherwise.
+         */
+        void Enable(bool enable){ enabled.store(enable, std::memory_order_relaxed); }
+
+        /**
+         * @brief Check whether the profiler is enabled.
+         * @return True if zones are recorded, false otherwise.
+         */
+        bool IsEnabled(void) const { return enabled.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the current time of the profiler clock.
+         * @return Time in nanoseconds since the profiler has been constructed.
+         */
+        int64_t Now(void) const { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count(); }
+
+        /**
+         * @brief Record a zone for the calling thread.
+         * @param[in] name The name of the zone.
+         * @param[in] start Start time in nanoseconds, see @ref Now.
+         * @param[in] end End time in nanoseconds, see @ref Now.
+         */
+        void Record(const char* name, int64_t start, int64_t end);
+
+        /**
+         * @brief Set the name of the calling thread as it appears in the trace.
+         * @param[in] name The name of the thread.
+         * @details Nothing happens if the profiler is disabled, such that threads do not acquire a buffer.
+         */
+        void SetThreadName(const std::string& name);
+
+        /**
+         * @brief Request a trace to be written. This function is async-signal-safe.
+         */
+        void RequestDump(void){ dumpRequested.store(true, std::memory_order_relaxed); }
+
+        /**
+         * @brief Check whether a trace has been requested via @ref RequestDump and reset the request.
+         * @return True if a trace has been requested, false otherwise.
+         */
+        bool ConsumeDumpRequest(void){ return dumpRequested.exchange(false, std::memory_order_relaxed); }
+
+        /**
+         * @brief Write all zones that are currently stored in the thread buffers to a Chrome trace JSON file.
+         * @param[in] filename The name of the output file.
+         * @return True if success, false otherwise.
+         */
+        bool WriteChromeTrace(const std::string& filename);
+
+        /**
+         * @brief Release the buffer of a thread that is terminating, such that it can be reused by another thread.
+         * @param[in] buffer The buffer to be released.
+         */
+        void ReleaseThreadBuffer(ProfilerThreadBuffer* buffer);
+
+    private:
+        std::atomic<bool> enabled;                                     // True if zones are recorded.
+        std::atomic<bool> dumpRequested;                               // True if a trace has been requested.
+        const std::chrono::steady_clock::time_point epoch;             // Reference time point of all timestamps.
+        std::mutex mtx;                                                // Protects @ref buffers and the thread names.
+        std::vector<std::unique_ptr<ProfilerThreadBuffer>> buffers;    // Buffers of all threads that have recorded zones.
+
+        /**
+         * @brief Get the buffer of the calling thread and acquire one if the thread does not own a buffer yet.
+         * @return The buffer of the calling thread.
+         */
+        ProfilerThreadBuffer* GetThreadBuffer(void);
+};
+
+
+extern Profiler profiler;
+
+
+/**
+ * @brief A scoped zone that is recorded by the global @ref profiler when it ends.
+ */
+class ProfilerZone {
+    public:
+        /**
+         * @brief Begin a new zone if the profiler is enabled.
+         * @param[in] name The name of the zone. Must be a string literal or any other string with static storage duration.
+         */
+        explicit ProfilerZone(const char* name): name(nullptr), start(0){ Begin(name); }
+
+        /**
+         * @brief End the zone.
+         */
+        ~ProfilerZone(){ End(); }
+
+        /**
+         * @brief End the current zone and begin the next one, e.g. for consecutive render passes.
+         * @param[in] nextName The name of the next zone.
+         */
+        void Next(const char* nextName){
+            End();
+            Begin(nextName);
+        }
+
+        /**
+         * @brief End the zone before the end of the scope. Nothing happens if the zone has already been ended.
+         */
+        void End(void){
+            if(name){
+                profiler.Record(name, start, profiler.Now());
+                name = nullptr;
+            }
+        }
+
+    private:
+        const char* name;   // The name of the zone or nullptr if the zone is not recorded.
+        int64_t start;      // Start time in nanoseconds.
+
+        /**
+         * @brief Begin a zone if the profiler is enabled.
+         * @param[in] zoneName The name of the zone.
+         */
+        void Begin(const char* zoneName){
+            if(profiler.IsEnabled()){
+                name = zoneName;
+                start = profiler.Now();
+            }
+        }
+};
+
@@ -24,6 +24,28 @@ inline bool EndsWith(const std::string s, const std::string pattern) {
 }
 
 
+/**
+ * @brief Check whether a given string ends with a given pattern, ignoring the case of ASCII characters.
+ * @param[in] s The string to be checked.
+ * @param[in] pattern The pattern to be considered.
+ * @return True if the input string s ends with the specified pattern or if the pattern is empty, false otherwise.
+ * @details Unlike @ref ToLowerASCIICopy, no copy of the string is made.
+ */
+inline bool EndsWithIgnoreCaseASCII(std::string_view s, std::string_view pattern){
+    if(s.size() < pattern.size()){
+        return false;
+    }
+    auto toLower = [](char c){ return ((c >= 'A') && (c <= 'Z')) ? static_cast<char>((c - 'A') + 'a') : c; };
+    s.remove_prefix(s.size() - pattern.size());
+    for(size_t i = 0; i < pattern.size(); ++i){
+        if(toLower(s[i]) != toLower(pattern[i])){
+            return false;
+        }
+    }
+    return true;
+}
+
+
 /**
  * @brief Split a string at spaces.
  * @param[in] s The string to split.
@@ -0,0 +1,280 @@
+#pragma once
+
+
+#include <Common.hpp>
+
+
+/**
+ * @brief Splits a text buffer into lines and whitespace-separated words in place.
+ * @details Words are returned as views into the buffer and numbers are parsed via std::from_chars, such that no memory is
+ * allocated while parsing. Carriage returns are treated as whitespace, so both LF and CRLF line endings are supported.
+ */
+class TextTokenizer {
+    public:
+        /**
+         * @brief Construct a new tokenizer for a text buffer.
+         * @param[in] text Pointer to the first character of the text, may be nullptr if @p length is zero.
+         * @param[in] length The number of characters of the text.
+         */
+        TextTokenizer(const char* text, size_t length): cursor(text), lineEnd(text), nextLine(text), end(text + length){}
+
+        /**
+         * @brief Move to the next line. All words of the current line that have not been read are skipped.
+         * @return True if success, false if the end of the text has been reached.
+         */
+        bool NextLine(void){
+            if(nextLine >= end){
+                cursor = lineEnd = end;
+                return false;
+            }
+            cursor = nextLine;
+            const char* lf = reinterpret_cast<const char*>(std::memchr(nextLine, '\n', static_cast<size_t>(end - nextLine)));
+            lineEnd = lf ? lf : end;
+            nextLine = lf ? (lf + 1) : end;
+            return true;
+        }
+
+        /**
+         * @brief Get the next word of the current line.
+         * @return The word or an empty view if there are no more words in the current line.
+         */
+        std::string_view NextWord(void){
+            SkipSpaces();
+            const char* first = cursor;
+            const char* last = first;
+            const char* e = lineEnd;
+            while((last < e) && !IsSpace(*last)){
+                ++last;
+            }
+            cursor = last;
+            return std::string_view(first, static_cast<size_t>(last - first));
+        }
+
+        /**
+         * @brief Get the next word of the current line as a number.
+         * @param[out] value The number.
+         * @return True if success, false if there is no next word or if the word is not a number.
+         */
+        template <typename T> bool NextNumber(T& value){
+            if constexpr(std::is_same_v<T, float>){ // parse in place without searching the end of the word first
+                SkipSpaces();
+                const char* last = ParseFloat(cursor, lineEnd, value);
+                if(last && ((last == lineEnd) || IsSpace(*last))){
+                    cursor = last;
+                    return true;
+                }
+            }
+            return ParseNumber(NextWord(), value);
+        }
+
+        /**
+         * @brief Get the next word of the current line as a fixed number of integer numbers separated by a separator, e.g. "1/2/3".
+         * @param[in] separator The character that separates the numbers.
+         * @param[out] values The numbers.
+         * @return True if success, false if there is no next word or if the word does not contain exactly N numbers.
+         * @details The word is parsed in place, see @ref ParseNumbers.
+         */
+        template <typename T, size_t N> bool NextNumbers(char separator, std::array<T,N>& values){
+            SkipSpaces();
+            const char* last = ParseNumbersPrefix(cursor, lineEnd, separator, values);
+            if(last && ((last == lineEnd) || IsSpace(*last))){
+                cursor = last;
+                return true;
+            }
+            (void) NextWord();
+            return false;
+        }
+
+        /**
+         * @brief Get the remaining part of the current line without leading and trailing whitespace, e.g. a filename that
+         * contains spaces.
+         * @return The remaining part of the current line.
+         */
+        std::string_view GetRemainder(void){
+            SkipSpaces();
+            const char* last = lineEnd;
+            while((last > cursor) && IsSpace(last[-1])){
+                --last;
+            }
+            std::string_view remainder(cursor, static_cast<size_t>(last - cursor));
+            cursor = lineEnd;
+            return remainder;
+        }
+
+        /**
+         * @brief Check whether all words of the current line have been read.
+         * @return True if there are no more words in the current line, false otherwise.
+         */
+        bool IsEndOfLine(void){
+            SkipSpaces();
+            return (cursor >= lineEnd);
+        }
+
+        /**
+         * @brief Get the position of the line that follows the current line, e.g. the start of binary data that follows a
+         * text header.
+         * @return Pointer to the first character of the next line.
+         */
+        const char* GetNextLinePosition(void) const { return nextLine; }
+
+        /**
+         * @brief Parse a word as a number. A leading '+' is accepted for compatibility with std::stof.
+         * @param[in] word The word to be parsed.
+         * @param[out] value The number.
+         * @return True if success, false if the word is empty or not a number.
+         * @details Floats in plain decimal notation with up to 19 significant digits are parsed by @ref ParseFloat,
+         * all other numbers via std::from_chars. Both yield the correctly rounded value.
+         */
+        template <typename T> static bool ParseNumber(std::string_view word, T& value){
+            const char* first = word.data();
+            const char* last = first + word.size();
+            if constexpr(std::is_same_v<T, float>){
+                if(last == ParseFloat(first, last, value)){
+                    return true;
+                }
+            }
+            if((first < last) && ('+' == *first)){
+                ++first;
+            }
+            auto [ptr, ec] = std::from_chars(first, last, value);
+            return (std::errc() == ec) && (last == ptr) && (first != last);
+        }
+
+        /**
+         * @brief Parse a word that contains a fixed number of integer numbers separated by a separator, e.g. "1/2/3".
+         * @param[in] word The word to be parsed.
+         * @param[in] separator The character that separates the numbers.
+         * @param[out] values The numbers.
+         * @return True if success, false if the word does not contain exactly N numbers.
+         * @details Each number may have a leading '+' like in @ref ParseNumber.
+         */
+        template <typename T, size_t N> static bool ParseNumbers(std::string_view word, char separator, std::array<T,N>& values){
+            const char* last = word.data() + word.size();
+            return (last == ParseNumbersPrefix(word.data(), last, separator, values));
+        }
+
+    private:
+        const char* cursor;     // Position of the next character to be read in the current line.
+        const char* lineEnd;    // End of the current line (position of the LF or end of the text).
+        const char* nextLine;   // Start of the next line.
+        const char* end;        // End of the text.
+
+        /**
+         * @brief Check whether a character is a whitespace character.
+         * @param[in] c The character to be checked.
+         * @return True if c is a space, a tab or a carriage return (or vertical tab and form feed), false otherwise.
+         */
+        static bool IsSpace(char c){ return (' ' == c) || ('\t' == c) || ('\r' == c) || ('\v' == c) || ('\f' == c); }
+
+        /**
+         * @brief Parse a float in plain decimal notation at the start of a text, e.g. "-12.3456" or "1.5e-3", without calling std::from_chars.
+         * @param[in] first Pointer to the first character.
+         * @param[in] last Pointer to the end of the text.
+         * @param[out] value The number.
+         * @return Pointer to the first character after the number or nullptr if the number must be parsed via std::from_chars instead.
+         * @details A leading '+' is accepted like in @ref ParseNumber. The significand is read as an integer and scaled by an
+         * exact power of ten in double precision, which is correctly rounded if the significand is less than 2^53 and the
+         * exponent is within [-22, 22]. Rounding that double to float is correctly rounded too, unless the double is exactly
+         * halfway between two floats.
+         */
+        static const char* ParseFloat(const char* first, const char* last, float& value){
+            static constexpr double powersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+            first += ((first < last) && ('+' == *first)) ? 1 : 0;
+            bool negative = (first < last) && ('-' == *first);
+            first += negative ? 1 : 0;
+            uint64_t significand = 0;
+            int32_t exponent = 0;
+            int32_t numDigits = 0;
+            bool hasDigits = false;
+            auto readDigits = [&](int32_t exponentPerDigit){
+                for(; (first < last) && (static_cast<unsigned char>(*first - '0') < 10); ++first){
+                    significand = 10 * significand + static_cast<uint64_t>(*first - '0');
+                    numDigits += significand ? 1 : 0;
+                    exponent += exponentPerDigit;
+                    hasDigits = true;
+                }
+            };
+            readDigits(0);
+            if((first < last) && ('.' == *first)){
+                ++first;
+                readDigits(-1);
+            }
+            if(!hasDigits || (numDigits > 19)){
+                return nullptr;
+            }
+            if((first < last) && (('e' == *first) || ('E' == *first))){
+                ++first;
+                bool negativeExponent = (first < last) && ('-' == *first);
+                first += ((first < last) && (('-' == *first) || ('+' == *first))) ? 1 : 0;
+                int32_t e = 0;
+                const char* digits = first;
+                for(; (first < last) && (static_cast<unsigned char>(*first - '0') < 10); ++first){
+                    e = 10 * e + (*first - '0');
+                    if(e > 1000){
+                        return nullptr;
+                    }
+                }
+                if(digits == first){
+                    return nullptr;
+                }
+                exponent += negativeExponent ? -e : e;
+            }
+            if(!significand){
+                value = negative ? -0.0f : 0.0f;
+                return first;
+            }
+            if((significand > (uint64_t(1) << 53)) || (exponent < -22) || (exponent > 22)){
+                return nullptr;
+            }
+            double d = static_cast<double>(significand);
+            d = (exponent < 0) ? (d / powersOfTen[-exponent]) : (d * powersOfTen[exponent]);
+            if(!(d >= static_cast<double>(std::numeric_limits<float>::min())) || (d > static_cast<double>(std::numeric_limits<float>::max()))){
+                return nullptr;
+            }
+            if(0x10000000 == (std::bit_cast<uint64_t>(d) & 0x1FFFFFFF)){
+                return nullptr;
+            }
+            value = static_cast<float>(negative ? -d : d);
+            return first;
+        }
+
+        /**
+         * @brief Parse a fixed number of integer numbers separated by a separator at the start of a text, e.g. "1/2/3".
+         * @param[in] first Pointer to the first character.
+         * @param[in] last Pointer to the end of the text.
+         * @param[in] separator The character that separates the numbers.
+         * @param[out] values The numbers.
+         * @return Pointer to the first character after the last number or nullptr if the text does not start with N numbers.
+         */
+        template <typename T, size_t N> static const char* ParseNumbersPrefix(const char* first, const char* last, char separator, std::array<T,N>& values){
+            static_assert(std::is_integral_v<T>);
+            for(size_t i = 0; i < N; ++i){
+                if(i){
+                    if((first >= last) || (separator != *first)){
+                        return nullptr;
+                    }
+                    ++first;
+                }
+                first += ((first < last) && ('+' == *first)) ? 1 : 0;
+                auto [ptr, ec] = std::from_chars(first, last, values[i]);
+                if(std::errc() != ec){
+                    return nullptr;
+                }
+                first = ptr;
+            }
+            return first;
+        }
+
+        /**
+         * @brief Skip all whitespace characters in the current line.
+         */
+        void SkipSpaces(void){
+            const char* c = cursor; // local pointers, since the characters may alias the members
+            const char* e = lineEnd;
+            while((c < e) && IsSpace(*c)){
+                ++c;
+            }
+            cursor = c;
+        }
+};
+
@@ -25,6 +25,16 @@ class AABB {
             dimension = glm::vec3(0.0);
         }
 
+        /**
+         * @brief Extend this AABB such that it also contains another AABB.
+         * @param[in] other The AABB to be contained.
+         */
+        void Merge(const AABB& other){
+            glm::vec3 maxPosition = glm::max(lowestPosition + dimension, other.lowestPosition + other.dimension);
+            lowestPosition = glm::min(lowestPosition, other.lowestPosition);
+            dimension = maxPosition - lowestPosition;
+        }
+
         /**
          * @brief Transform this AABB by a given matrix.
          * @param[in] M The transformation matrix.
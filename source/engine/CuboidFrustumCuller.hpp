@@ -5,6 +5,20 @@
 #include <AABB.hpp>
 
 
+/**
+ * @brief The number of objects that passed or failed the frustum culling of a view.
+ */
+struct CullingStatistics {
+    uint32_t numVisible;   // Number of objects that are visible by the camera frustum.
+    uint32_t numCulled;    // Number of objects that have been sorted out because they are outside the camera frustum.
+
+    /**
+     * @brief Construct new culling statistics with zero objects.
+     */
+    CullingStatistics(): numVisible(0), numCulled(0){}
+};
+
+
 /**
  * @brief This class is used to check whether a cuboid is visible by the cameras frustum or not.
  * @note The cuboid must be aligned to the world space axes.
@@ -2,12 +2,23 @@
 #include <MessageManager.hpp>
 #include <PrismaConfiguration.hpp>
 #include <MainApplication.hpp>
+#include <FileManager.hpp>
+#include <Profiler.hpp>
+
+
+/**
+ * @brief Names of the profiler zones that apply a message, indexed by @ref MessageType.
+ */
+static const char* const applyMessageZoneNames[] = {
+    "ApplyClear", "ApplyEngineParameter", "ApplyCamera", "ApplyAtmosphere", "ApplyAmbientLight", "ApplyDirectionalLight", "ApplyPointLight",
+    "ApplySpotLight", "ApplyMesh", "ApplyWaterMesh", "ApplyDynamicMesh", "ApplyFragment", "ApplyMeshPose", "ApplyDynamicMeshPatch"
+};
 
 
 bool Engine::CallbackInitialize(GLFWwindow* wnd){
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    glPerformanceCounter.Generate();
-    #endif
+    gpuPassTimer.Generate(prismaConfiguration.engine.enableGPUPassTimers);
+    telemetryCollector.Start(prismaConfiguration.network.send.telemetryPeriodMs);
+    gpuMemoryInfo.Generate();
     bool success = true;
     int w, h;
     glfwGetFramebufferSize(wnd, &w, &h);
@@ -39,24 +50,45 @@ void Engine::CallbackTerminate(GLFWwindow* wnd){
     environment.Delete();
     gBuffer.Delete();
     guiRenderer.Delete();
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    glPerformanceCounter.Delete();
-    #endif
+    gpuPassTimer.Delete();
     (void)wnd;
 }
 
 void Engine::CallbackUpdate(GLFWwindow* wnd, double dt){
+    frameTimeStatistics.Add(dt);
+
+    // write a profiler trace if requested via F2 or SIGUSR1
+    if(profiler.ConsumeDumpRequest()){
+        if(profiler.IsEnabled()){
+            (void) profiler.WriteChromeTrace(FileName(FILENAME_PRISMA_TRACE));
+        }
+        else{
+            PrintW("Profiler trace requested but the profiler is disabled (engine.enableProfiler)\n");
+        }
+    }
+
     // publish event message
     WindowEventMessage msg = inputSystem.GenerateWindowEventMessage(wnd);
     mainApplication.SendWindowEventMessage(msg);
 
+    // publish telemetry message if the telemetry period has elapsed
+    if(telemetryCollector.AddFrame(dt)){
+        SendTelemetryMessage();
+    }
+
     // update the camera if manual camera control is enabled
     bool manualCameraControl = inputSystem.UpdateCamera(prismaState.camera, dt);
 
     // update the PRISMA state
-    std::vector<MessageBaseType*> messages = messageManager.FetchMessages();
+    double localTime = glfwGetTime();
+    int64_t steadyTime = LatencyStatistics::Now();
+    ProfilerZone fetchZone("FetchMessages");
+    messageManager.FetchMessages(messages);
+    fetchZone.End();
     prismaState.meshLibrary.StartProtection();
     for(auto&& msg : messages){
+        ProfilerZone applyZone((msg->messageType <= MESSAGE_TYPE_DYNAMIC_MESH_PATCH) ? applyMessageZoneNames[msg->messageType] : "ApplyUnknown");
+        double receiveTime = msg->receiveTime ? (localTime - 1e-9 * static_cast<double>(steadyTime - msg->receiveTime)) : localTime; // local time at which the message has been received
         switch(msg->messageType){
             case MESSAGE_TYPE_AMBIENT_LIGHT:
                 prismaState.lightLibrary.ProcessAmbientLightMessage(*reinterpret_cast<AmbientLightMessage*>(msg));
@@ -82,6 +114,13 @@ void Engine::CallbackUpdate(GLFWwindow* wnd, double dt){
                     prismaState.camera.orthographicBottom =  cameraMessage->camera.orthographicBottom;
                     prismaState.camera.orthographicTop =  cameraMessage->camera.orthographicTop;
                     prismaState.camera.perspectiveFieldOfView =  cameraMessage->camera.perspectiveFieldOfView;
+                    if(cameraMessage->hasTimestamp){
+                        prismaState.poseClock.Update(cameraMessage->timestamp, receiveTime);
+                        prismaState.cameraPoseHistory.Insert(cameraMessage->timestamp, cameraMessage->camera.position, cameraMessage->camera.quaternion);
+                    }
+                    else{
+                        prismaState.cameraPoseHistory.Clear();
+                    }
                 }
                 break;
             case MESSAGE_TYPE_CLEAR:
@@ -93,12 +132,22 @@ void Engine::CallbackUpdate(GLFWwindow* wnd, double dt){
             case MESSAGE_TYPE_ENGINE_PARAMETER:
                 prismaState.engineParameter = reinterpret_cast<EngineParameterMessage*>(msg)->engineParameter;
                 break;
-            case MESSAGE_TYPE_MESH:
-                prismaState.meshLibrary.ProcessMeshMessage(*reinterpret_cast<MeshMessage*>(msg));
+            case MESSAGE_TYPE_MESH: {
+                MeshMessage* meshMessage = reinterpret_cast<MeshMessage*>(msg);
+                if(meshMessage->hasTimestamp){
+                    prismaState.poseClock.Update(meshMessage->timestamp, receiveTime);
+                }
+                prismaState.meshLibrary.ProcessMeshMessage(*meshMessage);
                 break;
-            case MESSAGE_TYPE_DYNAMIC_MESH:
-                prismaState.dynamicMeshLibrary.ProcessDynamicMeshMessage(*reinterpret_cast<DynamicMeshMessage*>(msg));
+            }
+            case MESSAGE_TYPE_DYNAMIC_MESH: {
+                DynamicMeshMessage* dynamicMeshMessage = reinterpret_cast<DynamicMeshMessage*>(msg);
+                if(dynamicMeshMessage->hasTimestamp){
+                    prismaState.poseClock.Update(dynamicMeshMessage->timestamp, receiveTime);
+                }
+                prismaState.dynamicMeshLibrary.ProcessDynamicMeshMessage(*dynamicMeshMessage);
                 break;
+            }
             case MESSAGE_TYPE_POINT_LIGHT:
                 prismaState.lightLibrary.ProcessPointLightMessage(*reinterpret_cast<PointLightMessage*>(msg));
                 break;
@@ -108,8 +157,35 @@ void Engine::CallbackUpdate(GLFWwindow* wnd, double dt){
             case MESSAGE_TYPE_WATER_MESH:
                 prismaState.waterMeshRenderer.ProcessWaterMeshMessage(*reinterpret_cast<WaterMeshMessage*>(msg));
                 break;
+            case MESSAGE_TYPE_MESH_POSE: {
+                MeshPoseMessage* meshPoseMessage = reinterpret_cast<MeshPoseMessage*>(msg);
+                if(meshPoseMessage->hasTimestamp){
+                    prismaState.poseClock.Update(meshPoseMessage->timestamp, receiveTime);
+                }
+                prismaState.meshLibrary.ProcessMeshPoseMessage(*meshPoseMessage);
+                break;
+            }
+            case MESSAGE_TYPE_DYNAMIC_MESH_PATCH:
+                prismaState.dynamicMeshLibrary.ProcessDynamicMeshPatchMessage(*reinterpret_cast<DynamicMeshPatchMessage*>(msg));
+                break;
+            case MESSAGE_TYPE_FRAGMENT:
+                break;
         }
-        delete msg;
+    }
+    latencyStatistics.AddAppliedMessages(messages);
+    messageManager.ReleaseMessages(messages);
+
+    // interpolate or extrapolate timestamped poses to the time at which this frame is going to be displayed
+    if(manualCameraControl){
+        prismaState.cameraPoseHistory.Clear();
+    }
+    if(prismaState.poseClock.IsValid()){
+        PROFILE_ZONE("InterpolatePoses");
+        double displayTime = prismaState.poseClock.ToSenderTime(localTime + dt) - 0.001 * static_cast<double>(prismaConfiguration.engine.poseInterpolationDelayMs);
+        double maxExtrapolation = 0.001 * static_cast<double>(prismaConfiguration.engine.poseExtrapolationLimitMs);
+        prismaState.meshLibrary.InterpolatePoses(displayTime, maxExtrapolation);
+        prismaState.dynamicMeshLibrary.InterpolatePoses(displayTime, maxExtrapolation);
+        (void) prismaState.cameraPoseHistory.Evaluate(displayTime, maxExtrapolation, prismaState.camera.position, prismaState.camera.quaternion);
     }
     prismaState.meshLibrary.EndProtection();
 
@@ -118,71 +194,51 @@ void Engine::CallbackUpdate(GLFWwindow* wnd, double dt){
 }
 
 void Engine::CallbackRender(GLFWwindow* wnd){
+    gpuPassTimer.BeginFrame();
+    ProfilerZone passZone(GetRenderPassName(RENDER_PASS_REFLECTION_REFRACTION));
+
     // render scene reflection/refraction textures
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    glPerformanceCounter.BeginQuery();
-    #endif
     if(prismaConfiguration.engine.enableWaterReflection){
         RenderSceneReflectionAndRefraction(); // updates the camera uniform buffer object
     }
     else{
         prismaState.camera.UpdateUniformBufferObject();
     }
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    double t1 = 1000.0 * glPerformanceCounter.EndQuery();
-    #endif
+    gpuPassTimer.EndPass(RENDER_PASS_REFLECTION_REFRACTION);
+    passZone.Next(GetRenderPassName(RENDER_PASS_GBUFFER));
 
     // render 3D scene to G-Buffer
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    glPerformanceCounter.BeginQuery();
-    #endif
     gBuffer.Use();
     gBuffer.ClearFramebuffer(prismaState.camera.clipFar);
     gBuffer.DrawScene(prismaState);
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    double t2 = 1000.0 * glPerformanceCounter.EndQuery();
-    #endif
+    gpuPassTimer.EndPass(RENDER_PASS_GBUFFER);
+    passZone.Next(GetRenderPassName(RENDER_PASS_SHADOW));
 
     // render 3D scene to shadow mapper
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    glPerformanceCounter.BeginQuery();
-    #endif
     if(prismaConfiguration.engine.enableShadowMapping){
         shadowMapper.Use();
         shadowMapper.DrawScene(prismaState);
     }
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    double t3 = 1000.0 * glPerformanceCounter.EndQuery();
-    #endif
+    gpuPassTimer.EndPass(RENDER_PASS_SHADOW);
+    passZone.Next(GetRenderPassName(RENDER_PASS_AMBIENT_OCCLUSION));
 
     // ambient Occlusion
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    glPerformanceCounter.BeginQuery();
-    #endif
     if(prismaConfiguration.engine.enableAmbientOcclusion){
         ambientOcclusion.Use();
         ambientOcclusion.SetPositionTexture(gBuffer.GetPositionTexture());
         ambientOcclusion.SetNormalTexture(gBuffer.GetNormalTexture());
         ambientOcclusion.Draw(prismaState.engineParameter);
     }
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    double t4 = 1000.0 * glPerformanceCounter.EndQuery();
-    #endif
+    gpuPassTimer.EndPass(RENDER_PASS_AMBIENT_OCCLUSION);
+    passZone.Next(GetRenderPassName(RENDER_PASS_WATER));
 
     // render water mesh to G-buffer
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    glPerformanceCounter.BeginQuery();
-    #endif
     gBuffer.Use();
     gBuffer.DrawWaterMesh(prismaState, environmentReflection.GetSceneTexture(), environmentRefraction.GetSceneTexture());
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    double t5 = 1000.0 * glPerformanceCounter.EndQuery();
-    #endif
+    gpuPassTimer.EndPass(RENDER_PASS_WATER);
+    passZone.Next(GetRenderPassName(RENDER_PASS_ENVIRONMENT));
 
     // environmental rendering (lighting, shadow casting, fog, ...)
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    glPerformanceCounter.BeginQuery();
-    #endif
     environment.Use(prismaState.engineParameter);
     environment.SetShadowCascadeFarPlanes(shadowMapper.GetCascadeFarPlanes());
     environment.SetPositionTexture(gBuffer.GetPositionTexture());
@@ -195,48 +251,44 @@ void Engine::CallbackRender(GLFWwindow* wnd){
     environment.SetShadowMapTexture(shadowMapper.GetDepthTextureArray());
     environment.ApplyScene(prismaState);
     environment.Draw();
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    double t6 = 1000.0 * glPerformanceCounter.EndQuery();
-    #endif
+    gpuPassTimer.EndPass(RENDER_PASS_ENVIRONMENT);
+    passZone.Next(GetRenderPassName(RENDER_PASS_BLOOM));
 
     // apply bloom to brightness texture
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    glPerformanceCounter.BeginQuery();
-    #endif
     if(prismaConfiguration.engine.enableBloom){
         bloom.Use();
         bloom.Draw(environment.GetBrightnessTexture(), environment.GetBrightnessTextureSize());
     }
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    double t7 = 1000.0 * glPerformanceCounter.EndQuery();
-    #endif
+    gpuPassTimer.EndPass(RENDER_PASS_BLOOM);
+    passZone.Next(GetRenderPassName(RENDER_PASS_GUI));
 
     // render GUI
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    glPerformanceCounter.BeginQuery();
-    #endif
     guiRenderer.Use();
     guiRenderer.Draw(inputSystem.ManualCameraControlEnabled());
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    double t8 = 1000.0 * glPerformanceCounter.EndQuery();
-    #endif
+    gpuPassTimer.EndPass(RENDER_PASS_GUI);
+    passZone.Next(GetRenderPassName(RENDER_PASS_POST_PROCESSING));
 
     // post processing
-    #ifdef DEBUG_PRINT_PERFORMANCE
-    glPerformanceCounter.BeginQuery();
-    #endif
     postProcessing.Use();
     postProcessing.SetGUITexture(guiRenderer.GetGUITexture());
     postProcessing.SetSceneTexture(environment.GetSceneTexture());
     postProcessing.SetBloomTexture(bloom.GetBloomTexture());
     postProcessing.Draw(prismaState.engineParameter);
+    gpuPassTimer.EndPass(RENDER_PASS_POST_PROCESSING);
+    passZone.End();
+    gpuPassTimer.EndFrame();
     #ifdef DEBUG_PRINT_PERFORMANCE
-    double t9 = 1000.0 * glPerformanceCounter.EndQuery();
-    fprintf(stderr,"[ms]: ReRe=%07.3f   GBuf=%07.3f   CSM=%07.3f   SSAO=%07.3f   GBuf=%07.3f   ENV=%07.3f   BLOOM=%07.3f   GUI=%07.3f   POST=%07.3f   SUM=%07.3f\n",t1,t2,t3,t4,t5,t6,t7,t8,t9,t1+t2+t3+t4+t5+t6+t7+t8+t9);
+    const std::array<float, RENDER_PASS_COUNT>& t = gpuPassTimer.GetPassTimes();
+    fprintf(stderr,"[ms]: ReRe=%07.3f   GBuf=%07.3f   CSM=%07.3f   SSAO=%07.3f   GBuf=%07.3f   ENV=%07.3f   BLOOM=%07.3f   GUI=%07.3f   POST=%07.3f   SUM=%07.3f\n",t[0],t[1],t[2],t[3],t[4],t[5],t[6],t[7],t[8],gpuPassTimer.GetTotalTime());
     #endif
     (void)wnd;
 }
 
+void Engine::CallbackSwapped(GLFWwindow* wnd){
+    latencyStatistics.AddSwap();
+    (void)wnd;
+}
+
 void Engine::CallbackFramebufferSize(GLFWwindow* wnd, int width, int height){
     GLsizei fbWidth = static_cast<GLsizei>(width);
     GLsizei fbHeight = static_cast<GLsizei>(height);
@@ -348,3 +400,24 @@ void Engine::RenderSceneReflectionAndRefraction(void){
     DEBUG_GLCHECK( glDisable(GL_CLIP_DISTANCE0); );
 }
 
+void Engine::SendTelemetryMessage(void){
+    TelemetryMessage& msg = telemetryCollector.Finish();
+    msg.gpuPassTimesValid = gpuPassTimer.IsValid();
+    msg.gpuPassTimes = gpuPassTimer.GetPassTimes();
+    msg.meshes = prismaState.meshLibrary.GetCullingStatistics();
+    msg.dynamicMeshes = prismaState.dynamicMeshLibrary.GetCullingStatistics();
+    msg.pointLights = prismaState.lightLibrary.GetPointLightCullingStatistics();
+    msg.spotLights = prismaState.lightLibrary.GetSpotLightCullingStatistics();
+    MessageQueueStatistics queueStatistics = messageManager.GetStatistics();
+    msg.messageQueueDepth = static_cast<uint32_t>(queueStatistics.depth);
+    msg.messageQueueMaxDepth = static_cast<uint32_t>(queueStatistics.maxDepth);
+    msg.numberOfDroppedMessages = static_cast<uint32_t>(queueStatistics.numDropped);
+    msg.meshLoaderBacklog = prismaState.meshLibrary.GetLoaderBacklog();
+    msg.gpuMemoryValid = gpuMemoryInfo.Query(msg.gpuMemoryUsed, msg.gpuMemoryAvailable);
+    msg.numberOfAppliedMessages = static_cast<uint32_t>(latencyStatistics.GetPeriodReceiveToApply().GetCount());
+    msg.receiveToApply = latencyStatistics.GetPeriodReceiveToApply();
+    msg.applyToSwap = latencyStatistics.GetPeriodApplyToSwap();
+    latencyStatistics.ClearPeriod();
+    mainApplication.SendTelemetryMessage(msg);
+}
+
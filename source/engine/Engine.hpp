@@ -1,5 +1,5 @@
 #pragma once
-// #define DEBUG_PRINT_PERFORMANCE // uncomment if required
+// #define DEBUG_PRINT_PERFORMANCE // uncomment if required (prints the GPU pass times of each frame)
 
 
 #include <GLWindowCallbacks.hpp>
@@ -13,12 +13,34 @@
 #include <AmbientOcclusion.hpp>
 #include <GUIRenderer.hpp>
 #include <PostProcessing.hpp>
-#ifdef DEBUG_PRINT_PERFORMANCE
-#include <GLPerformanceCounter.hpp>
-#endif
+#include <MessageBaseType.hpp>
+#include <FrameTimeStatistics.hpp>
+#include <TelemetryCollector.hpp>
+#include <GPUMemoryInfo.hpp>
+#include <GPUPassTimer.hpp>
+#include <LatencyStatistics.hpp>
 
 
 class Engine: public GLWindowCallbacks {
+    public:
+        /**
+         * @brief Get the frame time statistics of the render loop.
+         * @return Reference to the frame time statistics. Frame times are only collected if they have been enabled.
+         */
+        FrameTimeStatistics& GetFrameTimeStatistics(void){ return frameTimeStatistics; }
+
+        /**
+         * @brief Get the GPU pass timer of the render loop.
+         * @return Reference to the GPU pass timer. Results of a frame become available a few frames later.
+         */
+        GPUPassTimer& GetGPUPassTimer(void){ return gpuPassTimer; }
+
+        /**
+         * @brief Get the message-to-photon latency statistics.
+         * @return Reference to the latency statistics.
+         */
+        LatencyStatistics& GetLatencyStatistics(void){ return latencyStatistics; }
+
     protected:
         /**
          * @brief The initialization callback function.
@@ -49,6 +71,13 @@ class Engine: public GLWindowCallbacks {
          */
         void CallbackRender(GLFWwindow* wnd);
 
+        /**
+         * @brief The swap callback function.
+         * @param[in] wnd The GLFW window.
+         * @details This callback function is called after the frame rendered by @ref CallbackRender has been swapped.
+         */
+        void CallbackSwapped(GLFWwindow* wnd);
+
         /**
          * @brief The GLFW framebuffer size callback function.
          * @param[in] wnd The window whose framebuffer was resized.
@@ -104,9 +133,12 @@ class Engine: public GLWindowCallbacks {
         AmbientOcclusion ambientOcclusion;           // The ambient occlusion renderer.
         PostProcessing postProcessing;               // The post processing renderer.
         GUIRenderer guiRenderer;                     // The GUI renderer.
-        #ifdef DEBUG_PRINT_PERFORMANCE
-        GLPerformanceCounter glPerformanceCounter;   // A query counter to be used to measure performance of draw calls.
-        #endif
+        std::vector<MessageBaseType*> messages;      // Messages that have been fetched from the message manager, the capacity is kept between updates.
+        FrameTimeStatistics frameTimeStatistics;     // Frame times of the render loop, e.g. for the statistics of a replay.
+        TelemetryCollector telemetryCollector;       // Collects frame times for periodic telemetry messages.
+        GPUMemoryInfo gpuMemoryInfo;                 // Queries the dedicated GPU memory for telemetry messages.
+        GPUPassTimer gpuPassTimer;                   // Measures the GPU time of each render pass without stalling the CPU.
+        LatencyStatistics latencyStatistics;         // Receive→apply and apply→swap latencies of received messages.
 
         /**
          * @brief Clear double buffers and set default color (black)
@@ -118,5 +150,10 @@ class Engine: public GLWindowCallbacks {
          * @brief Render the whole scene (excluding water) from two points of view to obtain reflection and refraction textures.
          */
         void RenderSceneReflectionAndRefraction(void);
+
+        /**
+         * @brief Complete the telemetry message of the current telemetry period and send it via the main application.
+         */
+        void SendTelemetryMessage(void);
 };
 
@@ -125,6 +125,14 @@ class EventContainer {
             scrollEvents.swap(eventContainer.scrollEvents);
         }
 
+        /**
+         * @brief Check whether this container contains any event.
+         * @return True if all event sub containers are empty, false otherwise.
+         */
+        bool IsEmpty(void) const {
+            return keyEvents.empty() && mouseButtonEvents.empty() && cursorEvents.empty() && scrollEvents.empty();
+        }
+
         /**
          * @brief Limit the number of events to an upper boundary.
          * @param[in] N The maximum number of events to be stored in each of the event sub containers.
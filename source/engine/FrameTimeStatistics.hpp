@@ -0,0 +1,63 @@
+#pragma once
+
+
+#include <Common.hpp>
+
+
+/**
+ * @brief Collects the frame times of the render loop and prints a summary, e.g. at the end of a replay.
+ * @details Frame times are only collected after @ref Enable has been called, such that a normal run does not grow
+ * the internal container.
+ */
+class FrameTimeStatistics {
+    public:
+        /**
+         * @brief Construct new frame time statistics. The collection of frame times is disabled.
+         */
+        FrameTimeStatistics(): enabled(false){}
+
+        /**
+         * @brief Enable the collection of frame times and remove all frame times that have been collected so far.
+         */
+        void Enable(void){
+            frameTimes.clear();
+            frameTimes.reserve(65536);
+            enabled = true;
+        }
+
+        /**
+         * @brief Add the time of a frame if the collection of frame times is enabled.
+         * @param[in] dt The elapsed time to the previous frame in seconds.
+         */
+        void Add(double dt){
+            if(enabled){
+                frameTimes.push_back(dt);
+            }
+        }
+
+        /**
+         * @brief Print the number of frames and the mean, minimum, maximum and percentiles of the frame times in milliseconds.
+         * @details Nothing is printed if the collection of frame times is disabled.
+         */
+        void PrintSummary(void) const {
+            if(!enabled){
+                return;
+            }
+            if(frameTimes.empty()){
+                Print("frame times: frames=0\n");
+                return;
+            }
+            std::vector<double> sorted(frameTimes);
+            std::sort(sorted.begin(), sorted.end());
+            double sum = 0.0;
+            for(auto&& dt : sorted){
+                sum += dt;
+            }
+            auto percentile = [&sorted](double p){ return 1000.0 * sorted[static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5)]; };
+            Print("frame times: frames=%zu, mean=%.3f ms, min=%.3f ms, p50=%.3f ms, p95=%.3f ms, p99=%.3f ms, max=%.3f ms\n", sorted.size(), 1000.0 * sum / static_cast<double>(sorted.size()), 1000.0 * sorted.front(), percentile(0.5), percentile(0.95), percentile(0.99), 1000.0 * sorted.back());
+        }
+
+    private:
+        bool enabled;                   // True if frame times are collected.
+        std::vector<double> frameTimes; // All collected frame times in seconds.
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+
+#include <Common.hpp>
+
+
+/**
+ * @brief Vendor-specific query values for the GPU memory. They are not part of the GL core profile and are therefore
+ * not defined by the GL loader.
+ */
+#define GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX   (0x9048)
+#define GPU_MEMORY_INFO_CURRENT_AVAILABLE_MEMORY_NVX (0x9049)
+#define GPU_MEMORY_INFO_TEXTURE_FREE_MEMORY_ATI      (0x87FC)
+
+
+/**
+ * @brief Queries the dedicated GPU memory via the GL_NVX_gpu_memory_info or the GL_ATI_meminfo extension.
+ * @details The supported extension is detected once via @ref Generate. If none of both extensions is available, then
+ * @ref Query reports an invalid result. The GL_ATI_meminfo extension only reports the free memory, the used memory is
+ * zero in this case.
+ */
+class GPUMemoryInfo {
+    public:
+        /**
+         * @brief Construct a new GPU memory info object.
+         * @details The supported extension has to be detected by @ref Generate.
+         */
+        GPUMemoryInfo(): hasNVX(false), hasATI(false){}
+
+        /**
+         * @brief Detect the supported memory info extension. A GL context must be current.
+         */
+        void Generate(void){
+            hasNVX = false;
+            hasATI = false;
+            GLint numExtensions = 0;
+            DEBUG_GLCHECK( glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions); );
+            for(GLint i = 0; i < numExtensions; ++i){
+                const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+                if(name){
+                    hasNVX |= (0 == std::strcmp(name, "GL_NVX_gpu_memory_info"));
+                    hasATI |= (0 == std::strcmp(name, "GL_ATI_meminfo"));
+                }
+            }
+        }
+
+        /**
+         * @brief Query the current GPU memory.
+         * @param[out] usedKiB The used dedicated GPU memory in KiB.
+         * @param[out] availableKiB The available dedicated GPU memory in KiB.
+         * @return True if the memory has been queried, false if no memory info extension is supported.
+         */
+        bool Query(uint32_t& usedKiB, uint32_t& availableKiB) const {
+            usedKiB = 0;
+            availableKiB = 0;
+            if(hasNVX){
+                GLint total = 0, available = 0;
+                DEBUG_GLCHECK( glGetIntegerv(GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX, &total); );
+                DEBUG_GLCHECK( glGetIntegerv(GPU_MEMORY_INFO_CURRENT_AVAILABLE_MEMORY_NVX, &available); );
+                usedKiB = static_cast<uint32_t>(std::max(0, total - available));
+                availableKiB = static_cast<uint32_t>(std::max(0, available));
+                return true;
+            }
+            if(hasATI){
+                GLint free[4] = {0, 0, 0, 0};
+                DEBUG_GLCHECK( glGetIntegerv(GPU_MEMORY_INFO_TEXTURE_FREE_MEMORY_ATI, &free[0]); );
+                availableKiB = static_cast<uint32_t>(std::max(0, free[0]));
+                return true;
+            }
+            return false;
+        }
+
+    private:
+        bool hasNVX;   // True if the GL_NVX_gpu_memory_info extension is supported.
+        bool hasATI;   // True if the GL_ATI_meminfo extension is supported.
+};
+
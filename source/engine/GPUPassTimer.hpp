@@ -0,0 +1,217 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <RenderPass.hpp>
+
+
+/**
+ * @brief The number of frames whose timestamp queries can be in flight at once.
+ */
+#define GPU_PASS_TIMER_NUM_FRAMES (4)
+
+
+/**
+ * @brief Measures the GPU time of each render pass without stalling the CPU.
+ * @details Each frame writes one GL_TIMESTAMP query at the beginning of the frame via @ref BeginFrame and one at the end
+ * of each render pass via @ref EndPass. The queries of a frame are stored in a ring of @ref GPU_PASS_TIMER_NUM_FRAMES
+ * slots. Results are only read back if they are available (GL_QUERY_RESULT_AVAILABLE), usually a few frames later, such
+ * that the GPU never has to be drained. If all slots are still in flight, the current frame is not measured. The
+ * timer can be enabled or disabled at runtime, a disabled timer does not issue any GL calls.
+ */
+class GPUPassTimer {
+    public:
+        /**
+         * @brief Construct a new GPU pass timer.
+         * @details The query objects have to be generated by @ref Generate.
+         */
+        GPUPassTimer(): supported(false), enabled(false), recording(false), valid(false), currentSlot(0), numSkippedFrames(0), numMeasuredFrames(0){
+            for(auto&& slot : queries){
+                slot.fill(0);
+            }
+            pending.fill(false);
+            passTimes.fill(0.0f);
+        }
+
+        /**
+         * @brief Generate the query objects. A GL context must be current.
+         * @param[in] enable True if the timer should be enabled, false otherwise.
+         * @details The timer stays disabled if the GL context does not provide a timestamp counter.
+         */
+        void Generate(bool enable){
+            GLint counterBits = 0;
+            if(GLAD_GL_VERSION_3_3){
+                DEBUG_GLCHECK( glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &counterBits); );
+            }
+            supported = (counterBits > 0);
+            if(supported){
+                DEBUG_GLCHECK( glGenQueries(GPU_PASS_TIMER_NUM_FRAMES * (RENDER_PASS_COUNT + 1), &queries[0][0]); );
+            }
+            else if(enable){
+                PrintW("GPU pass timers are not supported by the GL context\n");
+            }
+            pending.fill(false);
+            currentSlot = 0;
+            SetEnabled(enable);
+        }
+
+        /**
+         * @brief Delete the query objects.
+         */
+        void Delete(void){
+            if(supported){
+                DEBUG_GLCHECK( glDeleteQueries(GPU_PASS_TIMER_NUM_FRAMES * (RENDER_PASS_COUNT + 1), &queries[0][0]); );
+            }
+            for(auto&& slot : queries){
+                slot.fill(0);
+            }
+            pending.fill(false);
+            supported = false;
+            enabled = false;
+            recording = false;
+            valid = false;
+        }
+
+        /**
+         * @brief Enable or disable the timer. Pending queries of a disabled timer are discarded.
+         * @param[in] enable True if the timer should be enabled, false otherwise.
+         */
+        void SetEnabled(bool enable){
+            enabled = enable && supported;
+            if(!enabled){
+                pending.fill(false);
+                recording = false;
+                valid = false;
+            }
+        }
+
+        /**
+         * @brief Check whether the timer is enabled.
+         * @return True if the timer is enabled, false otherwise.
+         */
+        bool IsEnabled(void) const { return enabled; }
+
+        /**
+         * @brief Collect all results that are available and begin the measurement of a new frame.
+         * @details Must be called before the first render pass of a frame.
+         */
+        void BeginFrame(void){
+            if(!enabled){
+                return;
+            }
+            for(uint32_t k = 0; k < GPU_PASS_TIMER_NUM_FRAMES; ++k){ // oldest slot first
+                CollectSlot((currentSlot + k) % GPU_PASS_TIMER_NUM_FRAMES);
+            }
+            recording = !pending[currentSlot];
+            if(recording){
+                DEBUG_GLCHECK( glQueryCounter(queries[currentSlot][0], GL_TIMESTAMP); );
+            }
+            else{
+                numSkippedFrames++;
+            }
+        }
+
+        /**
+         * @brief Mark the end of a render pass.
+         * @param[in] pass The render pass that has just been issued. All passes must be ended in the order of @ref RenderPass.
+         */
+        void EndPass(RenderPass pass){
+            if(recording){
+                DEBUG_GLCHECK( glQueryCounter(queries[currentSlot][static_cast<size_t>(pass) + 1], GL_TIMESTAMP); );
+            }
+        }
+
+        /**
+         * @brief End the measurement of the current frame.
+         * @details Must be called after the last render pass of a frame.
+         */
+        void EndFrame(void){
+            if(recording){
+                pending[currentSlot] = true;
+                currentSlot = (currentSlot + 1) % GPU_PASS_TIMER_NUM_FRAMES;
+                recording = false;
+            }
+        }
+
+        /**
+         * @brief Check whether pass times have been measured.
+         * @return True if at least one frame has been measured since the timer has been enabled, false otherwise.
+         */
+        bool IsValid(void) const { return valid; }
+
+        /**
+         * @brief Get the GPU times of the latest measured frame.
+         * @return The GPU time of each render pass in milliseconds, indexed by @ref RenderPass.
+         */
+        const std::array<float, RENDER_PASS_COUNT>& GetPassTimes(void) const { return passTimes; }
+
+        /**
+         * @brief Get the GPU time of a single render pass of the latest measured frame.
+         * @param[in] pass The render pass.
+         * @return The GPU time in milliseconds.
+         */
+        float GetPassTime(RenderPass pass) const { return (pass < RENDER_PASS_COUNT) ? passTimes[pass] : 0.0f; }
+
+        /**
+         * @brief Get the total GPU time of all render passes of the latest measured frame.
+         * @return The GPU time in milliseconds.
+         */
+        float GetTotalTime(void) const {
+            float sum = 0.0f;
+            for(auto&& t : passTimes){
+                sum += t;
+            }
+            return sum;
+        }
+
+        /**
+         * @brief Get the number of frames that have been measured.
+         * @return Number of frames whose results have been read back.
+         */
+        uint64_t GetNumberOfMeasuredFrames(void) const { return numMeasuredFrames; }
+
+        /**
+         * @brief Get the number of frames that have not been measured because all query slots were in flight.
+         * @return Number of skipped frames.
+         */
+        uint64_t GetNumberOfSkippedFrames(void) const { return numSkippedFrames; }
+
+    private:
+        bool supported;                                                                              // True if the GL context provides a timestamp counter.
+        bool enabled;                                                                                // True if the timer is enabled.
+        bool recording;                                                                              // True if the current frame is being measured.
+        bool valid;                                                                                  // True if @ref passTimes contains measured values.
+        uint32_t currentSlot;                                                                        // Index of the slot that is used for the current frame.
+        uint64_t numSkippedFrames;                                                                   // Number of frames that have not been measured.
+        uint64_t numMeasuredFrames;                                                                  // Number of frames whose results have been read back.
+        std::array<std::array<GLuint, RENDER_PASS_COUNT + 1>, GPU_PASS_TIMER_NUM_FRAMES> queries;    // Timestamp queries of each slot: frame begin followed by the end of each pass.
+        std::array<bool, GPU_PASS_TIMER_NUM_FRAMES> pending;                                         // True if the queries of a slot have been issued but not read back.
+        std::array<float, RENDER_PASS_COUNT> passTimes;                                              // GPU times of the latest measured frame in milliseconds.
+
+        /**
+         * @brief Read back the results of a slot if they are available.
+         * @param[in] slot The slot to be read back.
+         * @details Timestamps of a frame complete in order, so the slot is available if its last query is available.
+         */
+        void CollectSlot(uint32_t slot){
+            if(!pending[slot]){
+                return;
+            }
+            GLint available = 0;
+            DEBUG_GLCHECK( glGetQueryObjectiv(queries[slot][RENDER_PASS_COUNT], GL_QUERY_RESULT_AVAILABLE, &available); );
+            if(!available){
+                return;
+            }
+            GLuint64 timestamps[RENDER_PASS_COUNT + 1];
+            for(size_t i = 0; i <= RENDER_PASS_COUNT; ++i){
+                DEBUG_GLCHECK( glGetQueryObjectui64v(queries[slot][i], GL_QUERY_RESULT, &timestamps[i]); );
+            }
+            for(size_t i = 0; i < RENDER_PASS_COUNT; ++i){
+                passTimes[i] = (timestamps[i + 1] > timestamps[i]) ? static_cast<float>(1.0e-6 * static_cast<double>(timestamps[i + 1] - timestamps[i])) : 0.0f;
+            }
+            pending[slot] = false;
+            valid = true;
+            numMeasuredFrames++;
+        }
+};
+
@@ -6,6 +6,7 @@
 #include <PrismaConfiguration.hpp>
 #include <EventContainer.hpp>
 #include <WindowEventMessage.hpp>
+#include <Profiler.hpp>
 
 
 class InputSystem {
@@ -84,6 +85,9 @@ class InputSystem {
                         break;
                 }
             }
+            else if((GLFW_KEY_F2 == key) && (GLFW_PRESS == action)){ // write profiler trace
+                profiler.RequestDump();
+            }
             else if(GLFW_KEY_W == key){ // forward
                 switch(action){
                     case GLFW_PRESS:     moveForward = true;    break;
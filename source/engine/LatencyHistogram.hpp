@@ -0,0 +1,160 @@
+#pragma once
+
+
+#include <Common.hpp>
+
+
+/**
+ * @brief The number of bins per power of two of a latency histogram. Must be a power of two.
+ */
+#define LATENCY_HISTOGRAM_BINS_PER_OCTAVE (8)
+
+
+/**
+ * @brief The number of powers of two that are covered by a latency histogram, starting at one microsecond. The last octave
+ * starts at 2^25 microseconds (about 33.6 seconds) and its last bin starts at about 62.9 seconds and has no upper bound.
+ */
+#define LATENCY_HISTOGRAM_NUM_OCTAVES (24)
+
+
+/**
+ * @brief A histogram of latencies with logarithmically spaced bins of constant memory.
+ * @details Latencies below @ref LATENCY_HISTOGRAM_BINS_PER_OCTAVE microseconds are binned linearly with a width of one
+ * microsecond, larger latencies are binned with a relative width of 1/@ref LATENCY_HISTOGRAM_BINS_PER_OCTAVE. The last
+ * bin is open-ended, i.e. it also counts all latencies beyond the covered range. The mean and the maximum are exact,
+ * percentiles are given by the center of the corresponding bin, limited to the maximum.
+ */
+class LatencyHistogram {
+    public:
+        /**
+         * @brief The total number of bins.
+         */
+        static constexpr size_t NUM_BINS = LATENCY_HISTOGRAM_BINS_PER_OCTAVE * LATENCY_HISTOGRAM_NUM_OCTAVES;
+
+        /**
+         * @brief Construct an empty latency histogram.
+         */
+        LatencyHistogram(){ Clear(); }
+
+        /**
+         * @brief Remove all latencies.
+         */
+        void Clear(void){
+            bins.fill(0);
+            count = 0;
+            sum = 0.0;
+            maximum = 0;
+        }
+
+        /**
+         * @brief Add a latency.
+         * @param[in] latency The latency in nanoseconds. Negative values are counted as zero.
+         * @param[in] n The number of times the latency is added, e.g. the number of messages that share the latency.
+         */
+        void Add(int64_t latency, uint64_t n = 1){
+            latency = std::max(latency, int64_t(0));
+            bins[GetBinIndex(latency)] += n;
+            count += n;
+            sum += static_cast<double>(latency) * static_cast<double>(n);
+            maximum = std::max(maximum, latency);
+        }
+
+        /**
+         * @brief Add all latencies of another histogram.
+         * @param[in] other The histogram whose latencies are to be added.
+         */
+        void Merge(const LatencyHistogram& other){
+            for(size_t i = 0; i < NUM_BINS; ++i){
+                bins[i] += other.bins[i];
+            }
+            count += other.count;
+            sum += other.sum;
+            maximum = std::max(maximum, other.maximum);
+        }
+
+        /**
+         * @brief Get the number of latencies.
+         * @return Number of latencies that have been added.
+         */
+        uint64_t GetCount(void) const { return count; }
+
+        /**
+         * @brief Get the mean latency.
+         * @return Mean latency in milliseconds or zero if the histogram is empty.
+         */
+        double GetMean(void) const { return count ? (1e-6 * sum / static_cast<double>(count)) : 0.0; }
+
+        /**
+         * @brief Get the maximum latency.
+         * @return Maximum latency in milliseconds or zero if the histogram is empty.
+         */
+        double GetMax(void) const { return 1e-6 * static_cast<double>(maximum); }
+
+        /**
+         * @brief Get a percentile of the latencies.
+         * @param[in] p The percentile in range [0, 1].
+         * @return The center of the bin that contains the percentile in milliseconds or zero if the histogram is empty.
+         * The result is limited to the maximum latency.
+         */
+        double GetPercentile(double p) const {
+            if(!count){
+                return 0.0;
+            }
+            uint64_t rank = static_cast<uint64_t>(std::clamp(p, 0.0, 1.0) * static_cast<double>(count - 1) + 0.5) + 1;
+            uint64_t cumulative = 0;
+            size_t i = 0;
+            for(; i < (NUM_BINS - 1); ++i){
+                cumulative += bins[i];
+                if(cumulative >= rank){
+                    break;
+                }
+            }
+            double center = 0.5 * static_cast<double>(GetBinLowerBound(i) + GetBinLowerBound(i + 1));
+            return std::min(1e-3 * center, GetMax());
+        }
+
+        /**
+         * @brief Get the number of latencies of a bin.
+         * @param[in] index The bin index in range [0, @ref NUM_BINS).
+         * @return Number of latencies in the bin.
+         */
+        uint64_t GetBinCount(size_t index) const { return bins[index]; }
+
+        /**
+         * @brief Get the lower bound of a bin.
+         * @param[in] index The bin index in range [0, @ref NUM_BINS].
+         * @return Lower bound in microseconds. The upper bound of a bin is given by the lower bound of the next bin, except for
+         * the last bin, which has no upper bound.
+         */
+        static uint64_t GetBinLowerBound(size_t index){
+            if(index < LATENCY_HISTOGRAM_BINS_PER_OCTAVE){
+                return static_cast<uint64_t>(index);
+            }
+            size_t octave = index / LATENCY_HISTOGRAM_BINS_PER_OCTAVE;
+            uint64_t sub = static_cast<uint64_t>(index % LATENCY_HISTOGRAM_BINS_PER_OCTAVE);
+            return (LATENCY_HISTOGRAM_BINS_PER_OCTAVE + sub) << (octave - 1);
+        }
+
+    private:
+        std::array<uint64_t, NUM_BINS> bins;   // Number of latencies of each bin.
+        uint64_t count;                        // Total number of latencies.
+        double sum;                            // Sum of all latencies in nanoseconds.
+        int64_t maximum;                       // Maximum latency in nanoseconds.
+
+        /**
+         * @brief Get the bin index of a latency.
+         * @param[in] latency The latency in nanoseconds, must not be negative.
+         * @return The bin index in range [0, @ref NUM_BINS).
+         */
+        static size_t GetBinIndex(int64_t latency){
+            uint64_t us = static_cast<uint64_t>(latency) / 1000;
+            if(us < LATENCY_HISTOGRAM_BINS_PER_OCTAVE){
+                return static_cast<size_t>(us);
+            }
+            size_t msb = 63 - static_cast<size_t>(std::countl_zero(us));
+            size_t shift = msb - static_cast<size_t>(std::countr_zero(static_cast<uint64_t>(LATENCY_HISTOGRAM_BINS_PER_OCTAVE)));
+            size_t index = (shift + 1) * LATENCY_HISTOGRAM_BINS_PER_OCTAVE + static_cast<size_t>((us >> shift) & (LATENCY_HISTOGRAM_BINS_PER_OCTAVE - 1));
+            return std::min(index, NUM_BINS - 1);
+        }
+};
+
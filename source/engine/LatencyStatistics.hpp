@@ -0,0 +1,116 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <LatencyHistogram.hpp>
+#include <MessageBaseType.hpp>
+
+
+/**
+ * @brief Measures the message-to-photon latency, split into the time from receiving a datagram until its messages are
+ * applied by the render thread (receive→apply) and the time from applying until the frame is swapped (apply→swap).
+ * @details The network thread stores the receive time of each message via @ref Now. The render thread calls
+ * @ref AddAppliedMessages after applying the messages of a frame and @ref AddSwap after swapping that frame. Each message
+ * contributes one sample to both histograms. Total histograms cover the whole run, period histograms are cleared by
+ * @ref ClearPeriod, e.g. for telemetry messages. The swap time is the time at which the swap call returns, which may be
+ * before the frame is actually scanned out.
+ */
+class LatencyStatistics {
+    public:
+        /**
+         * @brief Construct new latency statistics.
+         */
+        LatencyStatistics(): applyTime(0), numPendingMessages(0){}
+
+        /**
+         * @brief Get the current time of the clock that is used for all latency timestamps.
+         * @return Time in nanoseconds of the steady clock.
+         */
+        static int64_t Now(void){ return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+        /**
+         * @brief Add the receive→apply latency of all messages that have been applied during the current frame.
+         * @param[in] messages The messages that have been applied.
+         */
+        void AddAppliedMessages(const std::vector<MessageBaseType*>& messages){
+            if(messages.empty()){
+                return;
+            }
+            applyTime = Now();
+            for(auto&& msg : messages){
+                if(msg->receiveTime){
+                    int64_t latency = applyTime - msg->receiveTime;
+                    totalReceiveToApply.Add(latency);
+                    periodReceiveToApply.Add(latency);
+                    numPendingMessages++;
+                }
+            }
+        }
+
+        /**
+         * @brief Add the apply→swap latency of all messages that have been applied since the previous swap.
+         */
+        void AddSwap(void){
+            if(numPendingMessages){
+                int64_t latency = Now() - applyTime;
+                totalApplyToSwap.Add(latency, numPendingMessages);
+                periodApplyToSwap.Add(latency, numPendingMessages);
+                numPendingMessages = 0;
+            }
+        }
+
+        /**
+         * @brief Get the receive→apply latencies of the current period.
+         * @return Histogram of latencies since the last call to @ref ClearPeriod.
+         */
+        const LatencyHistogram& GetPeriodReceiveToApply(void) const { return periodReceiveToApply; }
+
+        /**
+         * @brief Get the apply→swap latencies of the current period.
+         * @return Histogram of latencies since the last call to @ref ClearPeriod.
+         */
+        const LatencyHistogram& GetPeriodApplyToSwap(void) const { return periodApplyToSwap; }
+
+        /**
+         * @brief Clear the histograms of the current period.
+         */
+        void ClearPeriod(void){
+            periodReceiveToApply.Clear();
+            periodApplyToSwap.Clear();
+        }
+
+        /**
+         * @brief Print the summary and all non-empty bins of the total histograms.
+         * @details Nothing is printed if no message has been applied.
+         */
+        void PrintSummary(void) const {
+            PrintHistogram("receive->apply", totalReceiveToApply);
+            PrintHistogram("apply->swap", totalApplyToSwap);
+        }
+
+    private:
+        int64_t applyTime;                        // Time at which the messages of the current frame have been applied.
+        uint64_t numPendingMessages;              // Number of messages that have been applied but whose frame has not been swapped.
+        LatencyHistogram totalReceiveToApply;     // Receive→apply latencies of the whole run.
+        LatencyHistogram totalApplyToSwap;        // Apply→swap latencies of the whole run.
+        LatencyHistogram periodReceiveToApply;    // Receive→apply latencies of the current period.
+        LatencyHistogram periodApplyToSwap;       // Apply→swap latencies of the current period.
+
+        /**
+         * @brief Print the summary and all non-empty bins of a histogram.
+         * @param[in] name The name of the latency.
+         * @param[in] histogram The histogram to be printed.
+         */
+        static void PrintHistogram(const char* name, const LatencyHistogram& histogram){
+            if(!histogram.GetCount()){
+                return;
+            }
+            Print("%s latency: messages=%llu, mean=%.3f ms, p50=%.3f ms, p95=%.3f ms, p99=%.3f ms, max=%.3f ms\n", name, static_cast<unsigned long long>(histogram.GetCount()), histogram.GetMean(), histogram.GetPercentile(0.5), histogram.GetPercentile(0.95), histogram.GetPercentile(0.99), histogram.GetMax());
+            for(size_t i = 0; i < LatencyHistogram::NUM_BINS; ++i){
+                if(histogram.GetBinCount(i)){
+                    Print("    [%.3f, %.3f) ms: %llu\n", 1e-3 * static_cast<double>(LatencyHistogram::GetBinLowerBound(i)), 1e-3 * static_cast<double>(LatencyHistogram::GetBinLowerBound(i + 1)), static_cast<unsigned long long>(histogram.GetBinCount(i)));
+                }
+            }
+        }
+};
+
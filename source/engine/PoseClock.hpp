@@ -0,0 +1,75 @@
+#pragma once
+
+
+#include <Common.hpp>
+
+
+/**
+ * @brief The rate in seconds per second at which the estimated clock offset is allowed to grow to follow a drifting sender clock.
+ */
+#define POSE_CLOCK_DRIFT_RATE (0.001)
+
+
+/**
+ * @brief If the offset between the local clock and the sender clock grows by more than this time in seconds, the estimate is restarted.
+ */
+#define POSE_CLOCK_RESET_TIME (1.0)
+
+
+/**
+ * @brief Maps the local time to the time base of the sender of timestamped poses.
+ * @details The offset between the local clock and the sender clock is estimated from the arrival of timestamped messages.
+ * The smallest observed offset is tracked, since it corresponds to the message with the shortest transport delay. The
+ * estimate grows slowly by @ref POSE_CLOCK_DRIFT_RATE to follow a sender clock that runs slower than the local clock.
+ */
+class PoseClock {
+    public:
+        /**
+         * @brief Construct a new pose clock without an offset estimate.
+         */
+        PoseClock(){ Reset(); }
+
+        /**
+         * @brief Reset the offset estimate.
+         */
+        void Reset(void){
+            valid = false;
+            offset = 0.0;
+            lastLocalTime = 0.0;
+        }
+
+        /**
+         * @brief Update the offset estimate with a received timestamp.
+         * @param[in] senderTime The timestamp of a received message in seconds (sender time base).
+         * @param[in] localTime The local time in seconds at which the message has been received.
+         */
+        void Update(double senderTime, double localTime){
+            double newOffset = localTime - senderTime;
+            if(!valid || (newOffset > (offset + POSE_CLOCK_RESET_TIME))){
+                offset = newOffset;
+                valid = true;
+            }
+            else{
+                offset = std::min(offset + POSE_CLOCK_DRIFT_RATE * std::max(0.0, localTime - lastLocalTime), newOffset);
+            }
+            lastLocalTime = localTime;
+        }
+
+        /**
+         * @brief Check whether the offset has been estimated.
+         * @return True if at least one timestamp has been received since the last reset, false otherwise.
+         */
+        bool IsValid(void) const { return valid; }
+
+        /**
+         * @brief Convert a local time to the time base of the sender.
+         * @param[in] localTime The local time in seconds.
+         * @return The corresponding sender time in seconds.
+         */
+        double ToSenderTime(double localTime) const { return localTime - offset; }
+
+    private:
+        bool valid;             // True if @ref offset has been estimated.
+        double offset;          // The estimated offset in seconds between the local clock and the sender clock.
+        double lastLocalTime;   // The local time in seconds of the latest update.
+};
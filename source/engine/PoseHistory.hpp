@@ -0,0 +1,136 @@
+#pragma once
+
+
+#include <Common.hpp>
+
+
+/**
+ * @brief The number of timestamped poses that are kept for a single object.
+ */
+#define POSE_HISTORY_LENGTH (4)
+
+
+/**
+ * @brief If a new pose is older than the latest pose by more than this time in seconds, the history is restarted.
+ */
+#define POSE_HISTORY_RESET_TIME (1.0)
+
+
+/**
+ * @brief A short history of timestamped poses of a single object that is used to interpolate or extrapolate the pose at
+ * an arbitrary point in time.
+ * @details All times are given in the time base of the sender of the poses. Poses are kept in chronological order.
+ */
+class PoseHistory {
+    public:
+        /**
+         * @brief Construct a new and empty pose history.
+         */
+        PoseHistory(){ Clear(); }
+
+        /**
+         * @brief Remove all poses from the history.
+         */
+        void Clear(void){ numSamples = 0; }
+
+        /**
+         * @brief Insert a timestamped pose into the history.
+         * @param[in] time The timestamp of the pose in seconds.
+         * @param[in] position The position at the given time.
+         * @param[in] quaternion The unit quaternion {x, y, z, w} at the given time.
+         * @details Poses that are older than the latest pose are ignored, unless they are older by more than @ref POSE_HISTORY_RESET_TIME,
+         * which indicates a restart of the sender clock. A pose with the same timestamp as the latest pose replaces the latest pose.
+         */
+        void Insert(double time, glm::vec3 position, glm::vec4 quaternion){
+            if(numSamples){
+                const Sample& latest = samples[numSamples - 1];
+                if(time < (latest.time - POSE_HISTORY_RESET_TIME)){
+                    numSamples = 0;
+                }
+                else if(time < latest.time){
+                    return;
+                }
+                else{
+                    // keep quaternions in the same hemisphere, such that the interpolation takes the shortest path
+                    if(glm::dot(latest.quaternion, quaternion) < 0.0f){
+                        quaternion = -quaternion;
+                    }
+                    if(time == latest.time){
+                        numSamples--;
+                    }
+                }
+            }
+            if(POSE_HISTORY_LENGTH == numSamples){
+                std::copy(samples + 1, samples + POSE_HISTORY_LENGTH, samples);
+                numSamples--;
+            }
+            samples[numSamples].time = time;
+            samples[numSamples].position = position;
+            samples[numSamples].quaternion = quaternion;
+            numSamples++;
+        }
+
+        /**
+         * @brief Evaluate the pose at a given time.
+         * @param[in] time The time in seconds for which to evaluate the pose.
+         * @param[in] maxExtrapolation The maximum time in seconds to extrapolate beyond the latest pose.
+         * @param[out] position The interpolated or extrapolated position.
+         * @param[out] quaternion The interpolated or extrapolated unit quaternion {x, y, z, w}.
+         * @return True if a pose has been evaluated, false if the history is empty.
+         * @details Between two poses the position is interpolated linearly and the orientation is interpolated spherically (slerp).
+         * Beyond the latest pose, the motion between the two latest poses is continued for at most @ref maxExtrapolation seconds.
+         * Before the oldest pose, the oldest pose is returned.
+         */
+        bool Evaluate(double time, double maxExtrapolation, glm::vec3& position, glm::vec4& quaternion) const {
+            if(!numSamples){
+                return false;
+            }
+            if((1 == numSamples) || (time <= samples[0].time)){
+                const Sample& s = (time <= samples[0].time) ? samples[0] : samples[numSamples - 1];
+                position = s.position;
+                quaternion = s.quaternion;
+                return true;
+            }
+            size_t i = 1;
+            while((i < (numSamples - 1)) && (samples[i].time < time)){
+                i++;
+            }
+            const Sample& s0 = samples[i - 1];
+            const Sample& s1 = samples[i];
+            time = std::min(time, s1.time + std::max(0.0, maxExtrapolation));
+            GLfloat t = static_cast<GLfloat>((time - s0.time) / (s1.time - s0.time));
+            position = s0.position + t * (s1.position - s0.position);
+            quaternion = Slerp(s0.quaternion, s1.quaternion, t);
+            return true;
+        }
+
+    private:
+        struct Sample {                      // A single timestamped pose.
+            double time;                     // The timestamp in seconds.
+            glm::vec3 position;              // The position.
+            glm::vec4 quaternion;            // The unit quaternion {x, y, z, w}.
+        };
+        Sample samples[POSE_HISTORY_LENGTH]; // Poses in chronological order.
+        size_t numSamples;                   // The number of valid poses in @ref samples.
+
+        /**
+         * @brief Spherical linear interpolation between two unit quaternions of the same hemisphere.
+         * @param[in] q0 The unit quaternion at t = 0.
+         * @param[in] q1 The unit quaternion at t = 1.
+         * @param[in] t The interpolation parameter. Values greater than one extrapolate the rotation.
+         * @return The normalized quaternion.
+         */
+        static glm::vec4 Slerp(glm::vec4 q0, glm::vec4 q1, GLfloat t){
+            GLfloat cosTheta = std::clamp(glm::dot(q0, q1), -1.0f, 1.0f);
+            glm::vec4 q;
+            if(cosTheta > 0.9995f){
+                q = q0 + t * (q1 - q0);
+            }
+            else{
+                GLfloat theta = std::acos(cosTheta);
+                q = (std::sin((1.0f - t) * theta) * q0 + std::sin(t * theta) * q1) / std::sin(theta);
+            }
+            GLfloat length = glm::length(q);
+            return (length > 0.0f) ? (q / length) : q1;
+        }
+};
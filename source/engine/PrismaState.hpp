@@ -10,6 +10,8 @@
 #include <WaterMeshRenderer.hpp>
 #include <EngineParameter.hpp>
 #include <PrismaConfiguration.hpp>
+#include <PoseHistory.hpp>
+#include <PoseClock.hpp>
 
 
 class PrismaState {
@@ -21,6 +23,8 @@ class PrismaState {
         Atmosphere atmosphere;                     // The atmosphere that contains sunlight, fog, etc.
         WaterMeshRenderer waterMeshRenderer;       // The water mesh renderer.
         EngineParameter engineParameter;           // The runtime parameter for the PRISMA engine.
+        PoseHistory cameraPoseHistory;             // The pose history of the camera if the latest camera pose has been timestamped.
+        PoseClock poseClock;                       // Maps the local time to the time base of the sender of timestamped poses.
 
         /**
          * @brief Clear the whole PRISMA state and set default values.
@@ -30,6 +34,8 @@ class PrismaState {
             if(clearCamera){
                 SetInitialCameraValues();
             }
+            cameraPoseHistory.Clear();
+            poseClock.Reset();
             meshLibrary.Clear();
             dynamicMeshLibrary.Clear();
             lightLibrary.Clear();
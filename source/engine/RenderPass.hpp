@@ -0,0 +1,33 @@
+#pragma once
+
+
+#include <Common.hpp>
+
+
+/**
+ * @brief The render passes of a frame in the order in which they are executed by the engine.
+ */
+enum RenderPass: uint8_t {
+    RENDER_PASS_REFLECTION_REFRACTION = 0,   // Scene reflection and refraction textures for the water.
+    RENDER_PASS_GBUFFER,                     // Geometry pass of all meshes into the G-buffer.
+    RENDER_PASS_SHADOW,                      // Cascaded shadow maps.
+    RENDER_PASS_AMBIENT_OCCLUSION,           // Screen space ambient occlusion.
+    RENDER_PASS_WATER,                       // Geometry pass of the water into the G-buffer.
+    RENDER_PASS_ENVIRONMENT,                 // Deferred lighting, atmosphere and fog.
+    RENDER_PASS_BLOOM,                       // Bloom.
+    RENDER_PASS_GUI,                         // GUI overlay.
+    RENDER_PASS_POST_PROCESSING,             // Post processing into the default framebuffer.
+    RENDER_PASS_COUNT                        // Number of render passes.
+};
+
+
+/**
+ * @brief Get the short name of a render pass, e.g. for prints.
+ * @param[in] pass The render pass.
+ * @return The name of the render pass.
+ */
+inline const char* GetRenderPassName(RenderPass pass){
+    static const char* names[RENDER_PASS_COUNT] = {"ReRe", "GBuf", "CSM", "SSAO", "Water", "ENV", "BLOOM", "GUI", "POST"};
+    return (pass < RENDER_PASS_COUNT) ? names[pass] : "";
+}
+
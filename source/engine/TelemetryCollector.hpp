@@ -0,0 +1,86 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <TelemetryMessage.hpp>
+
+
+/**
+ * @brief Collects the frame times of the render loop for one telemetry period and summarizes them in a telemetry message.
+ * @details The collector is disabled until @ref Start has been called with a period greater than zero. The capacity of
+ * the internal container is kept between periods.
+ */
+class TelemetryCollector {
+    public:
+        /**
+         * @brief Construct a new telemetry collector. The collector is disabled.
+         */
+        TelemetryCollector(): period(0.0), elapsedTime(0.0), nextSequenceNumber(0){}
+
+        /**
+         * @brief Start the collection and reset the sequence number.
+         * @param[in] periodMs The telemetry period in milliseconds. A value of zero disables the collector.
+         */
+        void Start(uint32_t periodMs){
+            period = 0.001 * static_cast<double>(periodMs);
+            elapsedTime = 0.0;
+            nextSequenceNumber = 0;
+            frameTimes.clear();
+            if(periodMs){
+                frameTimes.reserve(4096);
+            }
+        }
+
+        /**
+         * @brief Add the time of a frame.
+         * @param[in] dt The elapsed time to the previous frame in seconds.
+         * @return True if the telemetry period has elapsed and a message should be generated via @ref Finish, false otherwise.
+         */
+        bool AddFrame(double dt){
+            if(period <= 0.0){
+                return false;
+            }
+            frameTimes.push_back(dt);
+            elapsedTime += dt;
+            return (elapsedTime >= period);
+        }
+
+        /**
+         * @brief Finish the current telemetry period and start the next one.
+         * @return Reference to the internal telemetry message whose sequence number and frame time statistics have been
+         * set. All other values are kept from the previous period and are to be set by the caller.
+         */
+        TelemetryMessage& Finish(void){
+            message.sequenceNumber = nextSequenceNumber++;
+            message.numberOfFrames = static_cast<uint32_t>(frameTimes.size());
+            message.frameTimeMean = 0.0f;
+            message.frameTimeP50 = 0.0f;
+            message.frameTimeP95 = 0.0f;
+            message.frameTimeP99 = 0.0f;
+            message.frameTimeMax = 0.0f;
+            if(!frameTimes.empty()){
+                std::sort(frameTimes.begin(), frameTimes.end());
+                double sum = 0.0;
+                for(auto&& dt : frameTimes){
+                    sum += dt;
+                }
+                auto percentile = [this](double p){ return static_cast<float>(1000.0 * frameTimes[static_cast<size_t>(p * static_cast<double>(frameTimes.size() - 1) + 0.5)]); };
+                message.frameTimeMean = static_cast<float>(1000.0 * sum / static_cast<double>(frameTimes.size()));
+                message.frameTimeP50 = percentile(0.5);
+                message.frameTimeP95 = percentile(0.95);
+                message.frameTimeP99 = percentile(0.99);
+                message.frameTimeMax = static_cast<float>(1000.0 * frameTimes.back());
+            }
+            frameTimes.clear();
+            elapsedTime = std::fmod(elapsedTime, period);
+            return message;
+        }
+
+    private:
+        double period;                    // The telemetry period in seconds, zero if the collector is disabled.
+        double elapsedTime;               // Elapsed time of the current telemetry period in seconds.
+        uint32_t nextSequenceNumber;      // Sequence number of the next telemetry message.
+        std::vector<double> frameTimes;   // Frame times of the current telemetry period in seconds.
+        TelemetryMessage message;         // The telemetry message that is reused for all periods.
+};
+
@@ -2,8 +2,16 @@
 #include <thirdparty/mapbox/earcut.hpp>
 
 
+NonConvexPolygon::NonConvexPolygon(){}
+
+NonConvexPolygon::~NonConvexPolygon(){}
+
 void NonConvexPolygon::Triangulate(std::vector<WaterMeshVertex>& inoutVertices, std::vector<GLuint>& inoutIndices){
-    std::vector<GLuint> indices = mapbox::earcut<GLuint>(verticesAndHoles);
+    if(!earcut){
+        earcut = std::make_unique<mapbox::detail::Earcut<GLuint>>();
+    }
+    (*earcut)(verticesAndHoles);
+    const std::vector<GLuint>& indices = earcut->indices;
     if(!(indices.size() % 3)){
         // add new indices
         GLuint indexOffset = static_cast<GLuint>(inoutVertices.size());
@@ -5,15 +5,32 @@
 #include <WaterMesh.hpp>
 
 
+namespace mapbox::detail { template <typename N> class Earcut; }
+
+
 class NonConvexPolygon {
     public:
         std::vector<std::vector<std::array<GLfloat,2>>> verticesAndHoles;   // A list of polylines where the first polyline indicates the outer hull vertices and all following polylines indicate hole vertices.
 
+        /**
+         * @brief Construct a new non-convex polygon.
+         */
+        NonConvexPolygon();
+
+        /**
+         * @brief Destroy the non-convex polygon.
+         */
+        ~NonConvexPolygon();
+
         /**
          * @brief Triangulate this non-convex polygon (@ref verticesAndHoles) and insert the resulting vertices and indices at the end of the given output container.
          * @param[inout] inoutVertices The container of vertices where to store the vertices of this non-convex polygon.
          * @param[inout] inoutIndices The container of indices where to store the indices of the triangulation.
+         * @details The memory of the triangulation is kept, such that triangulating a reused polygon does not allocate memory unless it grows.
          */
         void Triangulate(std::vector<WaterMeshVertex>& inoutVertices, std::vector<GLuint>& inoutIndices);
+
+    private:
+        std::unique_ptr<mapbox::detail::Earcut<GLuint>> earcut;   // The triangulation, created on first use and reused for all further triangulations.
 };
 
@@ -13,6 +13,7 @@
 #include <SpotLightMessage.hpp>
 #include <Camera.hpp>
 #include <CuboidFrustumCuller.hpp>
+#include <Profiler.hpp>
 
 
 /**
@@ -127,6 +128,18 @@ class LightLibrary {
             shader.SetAmbientLightColor(ambientLight.color);
         }
 
+        /**
+         * @brief Get the point light culling statistics of the latest view that has been applied via @ref ApplyVisibleLights.
+         * @return The number of visible and culled point lights.
+         */
+        CullingStatistics GetPointLightCullingStatistics(void) const { return pointLightCullingStatistics; }
+
+        /**
+         * @brief Get the spot light culling statistics of the latest view that has been applied via @ref ApplyVisibleLights.
+         * @return The number of visible and culled spot lights.
+         */
+        CullingStatistics GetSpotLightCullingStatistics(void) const { return spotLightCullingStatistics; }
+
     private:
         GLuint ssboDirectionalLights;                                                 // The internal shader storage buffer object for directional lights.
         GLuint ssboPointLights;                                                       // The internal shader storage buffer object for point lights.
@@ -139,6 +152,8 @@ class LightLibrary {
         std::unordered_map<DirectionalLightID, DirectionalLight> directionalLights;   // Container of all directional lights.
         std::unordered_map<PointLightID, PointLight> pointLights;                     // Container of all point lights.
         std::unordered_map<SpotLightID, SpotLight> spotLights;                        // Container of all spot lights.
+        CullingStatistics pointLightCullingStatistics;                                // Culling statistics of point lights of the latest view that has been applied via @ref ApplyVisibleLights.
+        CullingStatistics spotLightCullingStatistics;                                 // Culling statistics of spot lights of the latest view that has been applied via @ref ApplyVisibleLights.
 
         /**
          * @brief Generate all shader storage buffer objects for point light and spot light data.
@@ -307,8 +322,11 @@ class LightLibrary {
             std::vector<DirectionalLight>& directionalLightsToApply = std::get<0>(result);
             std::vector<PointLight>& pointLightsToApply = std::get<1>(result);
             std::vector<SpotLight>& spotLightsToApply = std::get<2>(result);
+            PROFILE_ZONE("CullLights");
             glm::mat4 cameraProjectionView = camera.GetProjectionViewMatrix();
             CuboidFrustumCuller culler(cameraProjectionView);
+            pointLightCullingStatistics = CullingStatistics();
+            spotLightCullingStatistics = CullingStatistics();
 
             // copy visible directional lights to output
             directionalLightsToApply.clear();
@@ -331,6 +349,7 @@ class LightLibrary {
                 // ignore lights that are not visible by the camera
                 AABB cuboid = light.CalculateAABB();
                 if(!culler.IsVisible(cuboid)){
+                    pointLightCullingStatistics.numCulled++;
                     continue;
                 }
 
@@ -339,6 +358,7 @@ class LightLibrary {
                 visiblePointLights.push_back({squaredDistance, light});
             }
             std::sort(visiblePointLights.begin(), visiblePointLights.end(), [](std::pair<double,PointLight> a, std::pair<double,PointLight> b){ return a.first < b.first; });
+            pointLightCullingStatistics.numVisible = static_cast<uint32_t>(visiblePointLights.size());
             pointLightsToApply.clear();
             for(auto&& visibleLight : visiblePointLights){
                 pointLightsToApply.push_back(visibleLight.second);
@@ -356,6 +376,7 @@ class LightLibrary {
                 // ignore lights that are not visible by the camera
                 AABB cuboid = light.CalculateAABB();
                 if(!culler.IsVisible(cuboid)){
+                    spotLightCullingStatistics.numCulled++;
                     continue;
                 }
 
@@ -364,6 +385,7 @@ class LightLibrary {
                 visibleSpotLights.push_back({squaredDistance, light});
             }
             std::sort(visibleSpotLights.begin(), visibleSpotLights.end(), [](std::pair<double,SpotLight> a, std::pair<double,SpotLight> b){ return a.first < b.first; });
+            spotLightCullingStatistics.numVisible = static_cast<uint32_t>(visibleSpotLights.size());
             spotLightsToApply.clear();
             for(auto&& visibleLight : visibleSpotLights){
                 spotLightsToApply.push_back(visibleLight.second);
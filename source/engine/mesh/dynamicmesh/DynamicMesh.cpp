@@ -1,9 +1,11 @@
 #include <DynamicMesh.hpp>
+#include <Profiler.hpp>
 
 
 DynamicMesh::DynamicMesh(){
     vao = vbo = ebo = 0;
     numIndices = 0;
+    numVertices = 0;
     bufferSizeVertices = 0;
     bufferSizeIndices = 0;
 }
@@ -25,6 +27,7 @@ void DynamicMesh::Generate(void){
         DEBUG_GLCHECK( glEnableVertexAttribArray(1); );
     DEBUG_GLCHECK( glBindVertexArray(0); );
     numIndices = 0;
+    numVertices = 0;
     aabbVertices.Clear();
 }
 
@@ -42,12 +45,15 @@ void DynamicMesh::Delete(void){
         ebo = 0;
     }
     numIndices = 0;
+    numVertices = 0;
     bufferSizeVertices = 0;
     bufferSizeIndices = 0;
     aabbVertices.Clear();
 }
 
 void DynamicMesh::UpdateMeshData(const std::vector<DynamicMeshVertex>& vertices, const std::vector<GLuint>& indices, const AABB aabbOfVertices){
+    PROFILE_ZONE("UploadDynamicMesh");
+
     // bind vertex array object
     DEBUG_GLCHECK( glBindVertexArray(vao); );
 
@@ -73,9 +79,37 @@ void DynamicMesh::UpdateMeshData(const std::vector<DynamicMeshVertex>& vertices,
 
     DEBUG_GLCHECK( glBindVertexArray(0); );
     numIndices = static_cast<GLsizei>(indices.size());
+    numVertices = vertices.size();
     this->aabbVertices = aabbOfVertices;
 }
 
+bool DynamicMesh::UpdateMeshDataRange(size_t vertexOffset, const std::vector<DynamicMeshVertex>& vertices, size_t indexOffset, const std::vector<GLuint>& indices, const AABB aabbOfVertices){
+    PROFILE_ZONE("UploadDynamicMeshPatch");
+    // check ranges
+    if(((vertexOffset + vertices.size()) > numVertices) || ((indexOffset + indices.size()) > static_cast<size_t>(numIndices))){
+        return false;
+    }
+    for(auto&& index : indices){
+        if(static_cast<size_t>(index) >= numVertices){
+            return false;
+        }
+    }
+
+    // upload sub ranges only
+    if(!vertices.empty()){
+        DEBUG_GLCHECK( glBindBuffer(GL_ARRAY_BUFFER, vbo); );
+        DEBUG_GLCHECK( glBufferSubData(GL_ARRAY_BUFFER, vertexOffset * sizeof(DynamicMeshVertex), vertices.size() * sizeof(DynamicMeshVertex), &(vertices[0])); );
+        aabbVertices.Merge(aabbOfVertices);
+    }
+    if(!indices.empty()){
+        DEBUG_GLCHECK( glBindVertexArray(vao); );
+        DEBUG_GLCHECK( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo); );
+        DEBUG_GLCHECK( glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, indexOffset * sizeof(GLuint), indices.size() * sizeof(GLuint), &(indices[0])); );
+        DEBUG_GLCHECK( glBindVertexArray(0); );
+    }
+    return true;
+}
+
 void DynamicMesh::ClearMeshData(void){
     std::vector<DynamicMeshVertex> emptyVertices;
     std::vector<GLuint> emptyIndices;
@@ -45,6 +45,19 @@ class DynamicMesh {
          */
         void UpdateMeshData(const std::vector<DynamicMeshVertex>& vertices, const std::vector<GLuint>& indices, const AABB aabbOfVertices);
 
+        /**
+         * @brief Replace a range of the current vertices and a range of the current indices.
+         * @param[in] vertexOffset Index of the first vertex to be replaced.
+         * @param[in] vertices The vertices that replace the current vertices starting at vertexOffset.
+         * @param[in] indexOffset Position of the first index to be replaced.
+         * @param[in] indices The indices that replace the current indices starting at indexOffset. All indices must refer to existing vertices.
+         * @param[in] aabbOfVertices The axis-aligned bounding box that contains all given vertices.
+         * @return True if success, false if a range exceeds the current mesh data. In this case the mesh data remains unchanged.
+         * @details Only the given ranges are uploaded to the GPU. The bounding box of the mesh is extended by the bounding box of the
+         * given vertices, thus it contains all vertices but may be larger than required until the whole mesh data is updated via @ref UpdateMeshData.
+         */
+        bool UpdateMeshDataRange(size_t vertexOffset, const std::vector<DynamicMeshVertex>& vertices, size_t indexOffset, const std::vector<GLuint>& indices, const AABB aabbOfVertices);
+
         /**
          * @brief Clear the current mesh data.
          * @details The mesh has to be generated by @ref Generate before calling this member function!
@@ -72,6 +85,7 @@ class DynamicMesh {
         GLuint vbo;                   // VBO for mesh data.
         GLuint ebo;                   // EBO for mesh data.
         GLsizei numIndices;           // The number of indices to be rendered.
+        size_t numVertices;           // The number of vertices of the current mesh data.
         size_t bufferSizeVertices;    // Current buffer size for vertices.
         size_t bufferSizeIndices;     // Current buffer size for indices.
         AABB aabbVertices;            // The axis-aligned bounding box containing all vertices.
@@ -6,6 +6,9 @@
 #include <DynamicMesh.hpp>
 #include <ShaderDynamicMesh.hpp>
 #include <DynamicMeshMessage.hpp>
+#include <DynamicMeshPatchMessage.hpp>
+#include <PoseHistory.hpp>
+#include <Profiler.hpp>
 
 
 class DynamicMeshLibrary {
@@ -40,6 +43,7 @@ class DynamicMeshLibrary {
                 delete it.second;
             }
             dynamicMeshObjects.clear();
+            poseHistories.clear();
         }
 
         /**
@@ -62,6 +66,33 @@ class DynamicMeshLibrary {
             }
         }
 
+        /**
+         * @brief Process a dynamic mesh patch message to replace a range of vertices and indices of an existing mesh.
+         * @param[in] message The dynamic mesh patch message to be processed.
+         * @details The message is ignored if the mesh does not exist or if a range exceeds the current mesh data.
+         * @note This function must be called from within the GL main thread.
+         */
+        void ProcessDynamicMeshPatchMessage(const DynamicMeshPatchMessage& message){
+            auto it = dynamicMeshObjects.find(message.meshID);
+            if(it != dynamicMeshObjects.end()){
+                (void) it->second->UpdateMeshDataRange(message.vertexOffset, message.meshVertices, message.indexOffset, message.meshIndices, message.aabbOfVertices);
+            }
+        }
+
+        /**
+         * @brief Set the pose of all dynamic meshes with timestamped poses to the interpolated or extrapolated pose at a given time.
+         * @param[in] time The time in seconds (sender time base) for which to evaluate the poses.
+         * @param[in] maxExtrapolation The maximum time in seconds to extrapolate beyond the latest received pose.
+         */
+        void InterpolatePoses(double time, double maxExtrapolation){
+            for(auto&& it : poseHistories){
+                auto itObject = dynamicMeshObjects.find(it.first);
+                if(itObject != dynamicMeshObjects.end()){
+                    (void) it.second.Evaluate(time, maxExtrapolation, itObject->second->properties.position, itObject->second->properties.quaternion);
+                }
+            }
+        }
+
         /**
          * @brief Draw all dynamic meshes.
          * @param[in] cameraPosition The world-space position of the camera to be used to sort the meshes for rendering.
@@ -102,9 +133,17 @@ class DynamicMeshLibrary {
             }
         }
 
+        /**
+         * @brief Get the culling statistics of the latest view that has been drawn via @ref DrawMeshObjects.
+         * @return The number of visible and culled dynamic meshes. Shadow passes are not taken into account.
+         */
+        CullingStatistics GetCullingStatistics(void) const { return cullingStatistics; }
+
     protected:
         ShaderDynamicMesh shaderDynamicMesh;                                  // The shader for the dynamic mesh.
         std::unordered_map<DynamicMeshID, DynamicMesh*> dynamicMeshObjects;   // List of all dynamic mesh objects.
+        std::unordered_map<DynamicMeshID, PoseHistory> poseHistories;         // Pose histories of all dynamic meshes whose latest pose has been timestamped.
+        CullingStatistics cullingStatistics;                                  // Culling statistics of the latest view that has been drawn via @ref DrawMeshObjects.
 
         /**
          * @brief Delete a dynamic mesh object.
@@ -116,6 +155,7 @@ class DynamicMeshLibrary {
                 itObject->second->Delete();
                 delete itObject->second;
                 dynamicMeshObjects.erase(itObject);
+                poseHistories.erase(meshID);
             }
         }
 
@@ -129,6 +169,12 @@ class DynamicMeshLibrary {
             if(message.updateMesh){
                 existingMesh->UpdateMeshData(message.meshVertices, message.meshIndices, message.aabbOfVertices);
             }
+            if(message.hasTimestamp){
+                poseHistories[message.meshID].Insert(message.timestamp, message.properties.position, message.properties.quaternion);
+            }
+            else{
+                poseHistories.erase(message.meshID);
+            }
         }
 
         /**
@@ -151,10 +197,12 @@ class DynamicMeshLibrary {
          */
         std::vector<DynamicMesh*> SortMeshesForRendering(glm::vec3 cameraPosition, glm::mat4 cameraProjectionView, bool shadowCasting = false){
             std::vector<DynamicMesh*> result;
+            PROFILE_ZONE("CullDynamicMeshes");
 
             // get all visible meshes and their distance to the camera
             std::vector<std::tuple<double,DynamicMesh*>> visibleMeshes;
             CuboidFrustumCuller culler(cameraProjectionView);
+            uint32_t numCulled = 0;
             for(auto& itObject : dynamicMeshObjects){
                 // ignore invisible meshes (either for normal rendering or for shadow casting)
                 DynamicMesh* obj = itObject.second;
@@ -177,6 +225,7 @@ class DynamicMeshLibrary {
                 // ignore meshes that are not visible by the camera
                 AABB cuboid = obj->GetAABBOfTransformedMesh();
                 if(!culler.IsVisible(cuboid)){
+                    numCulled++;
                     continue;
                 }
 
@@ -187,6 +236,10 @@ class DynamicMeshLibrary {
 
             // sort visible meshes by their distance to the camera
             std::sort(visibleMeshes.begin(), visibleMeshes.end(), [](std::tuple<double,DynamicMesh*> a, std::tuple<double,DynamicMesh*> b){ return std::get<0>(a) < std::get<0>(b); });
+            if(!shadowCasting){
+                cullingStatistics.numVisible = static_cast<uint32_t>(visibleMeshes.size());
+                cullingStatistics.numCulled = numCulled;
+            }
 
             // insert to output
             for(auto&& visibleMesh : visibleMeshes){
@@ -1,6 +1,7 @@
 #include <ColorMesh.hpp>
-#include <StringHelper.hpp>
+#include <MappedFile.hpp>
 #include <PrismaConfiguration.hpp>
+#include <Profiler.hpp>
 
 
 ColorMesh::ColorMesh(){
@@ -8,10 +9,14 @@ ColorMesh::ColorMesh(){
     vbo = 0;
     ebo = 0;
     numIndices = 0;
+    format = PLY_FORMAT_ASCII;
 }
 
 bool ColorMesh::Generate(void){
-    if(vertices.empty() || indices.empty()){
+    PROFILE_ZONE("UploadColorMesh");
+    std::span<const ColorMeshVertex> vertexData = GetVertices();
+    std::span<const GLuint> indexData = GetIndices();
+    if(vertexData.empty() || indexData.empty()){
         return false;
     }
     DEBUG_GLCHECK( glGenVertexArrays(1, &vao); );
@@ -19,9 +24,9 @@ bool ColorMesh::Generate(void){
     DEBUG_GLCHECK( glGenBuffers(1, &ebo); );
     DEBUG_GLCHECK( glBindVertexArray(vao); );
         DEBUG_GLCHECK( glBindBuffer(GL_ARRAY_BUFFER, vbo); );
-        DEBUG_GLCHECK( glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(ColorMeshVertex), &(vertices[0]), GL_STATIC_DRAW); );
+        DEBUG_GLCHECK( glBufferData(GL_ARRAY_BUFFER, vertexData.size_bytes(), vertexData.data(), GL_STATIC_DRAW); );
         DEBUG_GLCHECK( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo); );
-        DEBUG_GLCHECK( glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), &(indices[0]), GL_STATIC_DRAW); );
+        DEBUG_GLCHECK( glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexData.size_bytes(), indexData.data(), GL_STATIC_DRAW); );
         // Position
         DEBUG_GLCHECK( glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ColorMeshVertex), (GLvoid*)0); );
         DEBUG_GLCHECK( glEnableVertexAttribArray(0); );
@@ -32,9 +37,10 @@ bool ColorMesh::Generate(void){
         DEBUG_GLCHECK( glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(ColorMeshVertex), (GLvoid*)offsetof(ColorMeshVertex, color)); );
         DEBUG_GLCHECK( glEnableVertexAttribArray(2); );
     DEBUG_GLCHECK( glBindVertexArray(0); );
-    numIndices = static_cast<GLsizei>(indices.size());
+    numIndices = static_cast<GLsizei>(indexData.size());
     vertices.clear();
     indices.clear();
+    ReleaseCacheFile();
     return true;
 }
 
@@ -67,62 +73,154 @@ bool ColorMesh::ReadFromFile(std::string filename){
     aabbVertices.Clear();
     vertices.clear();
     indices.clear();
-    std::ifstream file(filename, std::ifstream::binary);
-    if(!file.is_open()){
+    ReleaseCacheFile();
+    MappedFile file;
+    if(!file.Open(filename)){
         PrintE("Could not open file \"%s\"!\n", filename.c_str());
         return false;
     }
-    if(!ParsePlyHeader(file)){
+    TextTokenizer tokenizer(file.GetData(), file.GetSize());
+    if(!ParsePlyHeader(tokenizer)){
         PrintE("Could not parse header of ply file \"%s\"!\n", filename.c_str());
         return false;
     }
-    if(!ParsePlyData(file)){
+    bool success;
+    if(PLY_FORMAT_ASCII == format){
+        success = ParsePlyData(tokenizer);
+    }
+    else{
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(tokenizer.GetNextLinePosition());
+        success = ParsePlyDataBinary(data, reinterpret_cast<const uint8_t*>(file.GetData()) + file.GetSize());
+    }
+    if(!success){
         PrintE("Could not parse data of ply file \"%s\"!\n", filename.c_str());
         return false;
     }
     return true;
 }
 
-bool ColorMesh::ParsePlyHeader(std::ifstream& file){
+std::vector<std::string> ColorMesh::GetDependencies(void){
+    return {};
+}
+
+bool ColorMesh::ReadFromCache(MeshCacheReader& reader){
+    aabbVertices.Clear();
+    vertices.clear();
+    indices.clear();
+    ReleaseCacheFile();
+    glm::vec3 lowestPosition, dimension;
+    if(!reader.ReadVec3(lowestPosition) || !reader.ReadVec3(dimension) || !reader.ReadArray(cachedVertices) || !reader.ReadIndexArray(cachedIndices, cachedVertices.size())){
+        ReleaseCacheFile();
+        return false;
+    }
+    aabbVertices.lowestPosition = lowestPosition;
+    aabbVertices.dimension = dimension;
+    cacheFile = reader.GetFile();
+    return true;
+}
+
+bool ColorMesh::WriteToCache(MeshCacheWriter& writer){
+    writer.WriteVec3(aabbVertices.lowestPosition);
+    writer.WriteVec3(aabbVertices.dimension);
+    writer.WriteArray(GetVertices());
+    writer.WriteArray(GetIndices());
+    return writer.IsGood();
+}
+
+std::span<const ColorMeshVertex> ColorMesh::GetVertices(void) const {
+    return cacheFile ? cachedVertices : std::span<const ColorMeshVertex>(vertices);
+}
+
+std::span<const GLuint> ColorMesh::GetIndices(void) const {
+    return cacheFile ? cachedIndices : std::span<const GLuint>(indices);
+}
+
+void ColorMesh::ReleaseCacheFile(void){
+    cacheFile.reset();
+    cachedVertices = {};
+    cachedIndices = {};
+}
+
+bool ColorMesh::ParsePlyHeader(TextTokenizer& tokenizer){
     bool success = false;
     elements.clear();
+    std::vector<std::string_view> words;
+    auto nextWords = [&tokenizer, &words](){
+        words.clear();
+        for(std::string_view word = tokenizer.NextWord(); !word.empty(); word = tokenizer.NextWord()){
+            words.push_back(word);
+        }
+    };
     try{
-        std::string headerMagicNumber = ReadNextLine(file);
-        if(0 != headerMagicNumber.compare("ply")){
+        if(!tokenizer.NextLine() || (tokenizer.NextWord() != "ply") || !tokenizer.IsEndOfLine() || !tokenizer.NextLine()){
             throw(0);
         }
-        std::string headerFormat = ReadNextLine(file);
-        if(0 != headerFormat.compare("format ascii 1.0")){
+        nextWords();
+        if((3 != words.size()) || (words[0] != "format") || (words[2] != "1.0")){
             throw(0);
         }
-        while(file.good()){
-            std::string line = ReadNextLine(file);
-            std::vector<std::string> words = StringHelper::SplitString(line);
-            if(words.empty() || (0 == words[0].compare("comment"))){
+        if(words[1] == "ascii"){
+            format = PLY_FORMAT_ASCII;
+        }
+        else if(words[1] == "binary_little_endian"){
+            format = PLY_FORMAT_BINARY_LITTLE_ENDIAN;
+        }
+        else if(words[1] == "binary_big_endian"){
+            format = PLY_FORMAT_BINARY_BIG_ENDIAN;
+        }
+        else{
+            throw(0);
+        }
+        while(tokenizer.NextLine()){
+            nextWords();
+            if(words.empty() || (words[0] == "comment")){
                 continue;
             }
-            else if(0 == words[0].compare("element")){
-                if(3 != words.size()){
+            else if(words[0] == "element"){
+                uint32_t number;
+                if((3 != words.size()) || !TextTokenizer::ParseNumber(words[2], number)){
                     throw(0);
                 }
                 PlyElement element;
                 element.name = words[1];
-                element.number = static_cast<uint32_t>(std::stoul(words[2]));
+                element.number = number;
                 elements.push_back(element);
             }
-            else if(0 == words[0].compare("property")){
+            else if(words[0] == "property"){
                 if(elements.empty() || (words.size() < 3)){
                     throw(0);
                 }
-                if((0 == elements.back().name.compare("face")) && (0 == words.back().compare("vertex_indices")) && (0 != words[1].compare("list"))){
+                if((elements.back().name == "face") && (words.back() == "vertex_indices") && (words[1] != "list")){
                     throw(0);
                 }
-                if((3 == words.size()) && ((0 == words[2].compare("red")) || (0 == words[2].compare("green")) || (0 == words[2].compare("blue")) || (0 == words[2].compare("alpha"))) && ((0 == words[1].compare("float")) || (0 == words[1].compare("double")))){ // color format must not be floating point
+                if((3 == words.size()) && ((words[2] == "red") || (words[2] == "green") || (words[2] == "blue") || (words[2] == "alpha")) && ((words[1] == "float") || (words[1] == "double"))){ // color format must not be floating point
                     throw(0);
                 }
-                elements.back().propertyNames.push_back(words.back());
+                PlyProperty property;
+                property.name = words.back();
+                if(words[1] == "list"){
+                    if(5 != words.size()){
+                        throw(0);
+                    }
+                    property.listCountType = GetPlyScalarType(words[2]);
+                    property.type = GetPlyScalarType(words[3]);
+                    if((PLY_SCALAR_TYPE_INVALID == property.listCountType) || (PLY_SCALAR_TYPE_INVALID == property.type)){
+                        throw(0);
+                    }
+                }
+                else{
+                    if(3 != words.size()){
+                        throw(0);
+                    }
+                    property.listCountType = PLY_SCALAR_TYPE_INVALID;
+                    property.type = GetPlyScalarType(words[1]);
+                    if(PLY_SCALAR_TYPE_INVALID == property.type){
+                        throw(0);
+                    }
+                }
+                elements.back().properties.push_back(property);
             }
-            else if(0 == words[0].compare("end_header")){
+            else if(words[0] == "end_header"){
                 success = true;
                 break;
             }
@@ -132,58 +230,87 @@ bool ColorMesh::ParsePlyHeader(std::ifstream& file){
     return success;
 }
 
-bool ColorMesh::ParsePlyData(std::ifstream& file){
+bool ColorMesh::ParsePlyData(TextTokenizer& tokenizer){
+    const bool toLinearRGB = prismaConfiguration.engine.convertSRGBToLinearRGB;
     std::vector<ColorMeshVertex> plyVertices;
     std::vector<GLuint> plyIndices;
-    try{
-        for(auto&& element : elements){
+    for(auto&& element : elements){
+        if(element.name == "vertex"){
+            // value index of each property in the order of vertexPropertyNames or -1 if the property is not evaluated
+            std::vector<int32_t> valueIndices;
+            for(auto&& property : element.properties){
+                valueIndices.push_back(GetVertexValueIndex(property.name));
+            }
+            plyVertices.reserve(element.number);
             for(size_t n = 0; n < element.number; ++n){
-                if(!file.good()){
-                    throw(0);
+                if(!tokenizer.NextLine()){
+                    return false;
                 }
-                std::string line = ReadNextLine(file);
-                std::vector<std::string> words = StringHelper::SplitString(line);
-                if(0 == element.name.compare("vertex")){
-                    if(element.propertyNames.size() != words.size()){
-                        throw(0);
+                double values[9] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+                for(auto&& valueIndex : valueIndices){
+                    std::string_view word = tokenizer.NextWord();
+                    if(word.empty() || ((valueIndex >= 0) && !TextTokenizer::ParseNumber(word, values[valueIndex]))){
+                        return false;
                     }
-                    int32_t ix = GetPropertyIndex(element.propertyNames, "x");
-                    int32_t iy = GetPropertyIndex(element.propertyNames, "y");
-                    int32_t iz = GetPropertyIndex(element.propertyNames, "z");
-                    int32_t inx = GetPropertyIndex(element.propertyNames, "nx");
-                    int32_t iny = GetPropertyIndex(element.propertyNames, "ny");
-                    int32_t inz = GetPropertyIndex(element.propertyNames, "nz");
-                    int32_t ired = GetPropertyIndex(element.propertyNames, "red");
-                    int32_t igreen = GetPropertyIndex(element.propertyNames, "green");
-                    int32_t iblue = GetPropertyIndex(element.propertyNames, "blue");
-                    ColorMeshVertex v = GetDefaultVertex();
-                    if(ix >= 0) v.position[0] = static_cast<GLfloat>(std::stof(words[ix]));
-                    if(iy >= 0) v.position[1] = static_cast<GLfloat>(std::stof(words[iy]));
-                    if(iz >= 0) v.position[2] = static_cast<GLfloat>(std::stof(words[iz]));
-                    if(inx >= 0) v.normal[0] = static_cast<GLfloat>(std::stof(words[inx]));
-                    if(iny >= 0) v.normal[1] = static_cast<GLfloat>(std::stof(words[iny]));
-                    if(inz >= 0) v.normal[2] = static_cast<GLfloat>(std::stof(words[inz]));
-                    if(ired >= 0) v.color[0] = static_cast<GLfloat>(std::stod(words[ired]) / 255.0);
-                    if(igreen >= 0) v.color[1] = static_cast<GLfloat>(std::stod(words[igreen]) / 255.0);
-                    if(iblue >= 0) v.color[2] = static_cast<GLfloat>(std::stod(words[iblue]) / 255.0);
-                    EnsureCorrectNormal(v);
-                    if(prismaConfiguration.engine.convertSRGBToLinearRGB){
-                        SRGBToLinearRGB(v);
-                    }
-                    plyVertices.push_back(v);
                 }
-                else if(0 == element.name.compare("face")){
-                    if((1 != element.propertyNames.size()) || (0 != element.propertyNames[0].compare("vertex_indices")) || (4 != words.size()) || (0 != words[0].compare("3"))){
-                        throw(0);
-                    }
-                    plyIndices.push_back(static_cast<GLuint>(std::stoul(words[1])));
-                    plyIndices.push_back(static_cast<GLuint>(std::stoul(words[2])));
-                    plyIndices.push_back(static_cast<GLuint>(std::stoul(words[3])));
+                if(!tokenizer.IsEndOfLine()){
+                    return false;
+                }
+                plyVertices.push_back(ToVertex(values, toLinearRGB));
+            }
+        }
+        else if(element.name == "face"){
+            if((1 != element.properties.size()) || (element.properties[0].name != "vertex_indices")){
+                return false;
+            }
+            plyIndices.reserve(3 * static_cast<size_t>(element.number));
+            for(size_t n = 0; n < element.number; ++n){
+                GLuint i1, i2, i3;
+                if(!tokenizer.NextLine() || (tokenizer.NextWord() != "3") || !tokenizer.NextNumber(i1) || !tokenizer.NextNumber(i2) || !tokenizer.NextNumber(i3) || !tokenizer.IsEndOfLine()){
+                    return false;
                 }
+                plyIndices.push_back(i1);
+                plyIndices.push_back(i2);
+                plyIndices.push_back(i3);
             }
         }
+        else{
+            for(size_t n = 0; n < element.number; ++n){
+                if(!tokenizer.NextLine()){
+                    return false;
+                }
+            }
+        }
+    }
+    if(!IndicesAreInRange(plyIndices, plyVertices.size())){
+        return false;
+    }
+    vertices.swap(plyVertices);
+    indices.swap(plyIndices);
+    UpdateAABB();
+    return true;
+}
+
+bool ColorMesh::ParsePlyDataBinary(const uint8_t* data, const uint8_t* end){
+    const bool swapBytes = ((PLY_FORMAT_BINARY_BIG_ENDIAN == format) != (std::endian::big == std::endian::native));
+    std::vector<ColorMeshVertex> plyVertices;
+    std::vector<GLuint> plyIndices;
+    for(auto&& element : elements){
+        bool success;
+        if(element.name == "vertex"){
+            success = ReadBinaryVertices(data, end, element, swapBytes, plyVertices);
+        }
+        else if(element.name == "face"){
+            success = ReadBinaryFaces(data, end, element, swapBytes, plyIndices);
+        }
+        else{
+            success = SkipBinaryElement(data, end, element, swapBytes);
+        }
+        if(!success){
+            return false;
+        }
     }
-    catch(...){
+    if(!IndicesAreInRange(plyIndices, plyVertices.size())){
         return false;
     }
     vertices.swap(plyVertices);
@@ -192,29 +319,239 @@ bool ColorMesh::ParsePlyData(std::ifstream& file){
     return true;
 }
 
-std::string ColorMesh::ReadNextLine(std::ifstream& file){
-    std::string line;
-    std::getline(file, line);
-    line.erase(std::remove_if(line.begin(), line.end(), [](char c){ return ('\r' == c) || ('\n' == c); }), line.end());
-    return line;
+bool ColorMesh::ReadBinaryVertices(const uint8_t*& data, const uint8_t* end, const PlyElement& element, bool swapBytes, std::vector<ColorMeshVertex>& plyVertices){
+    struct VertexField {
+        size_t offset;          // Byte offset of the property within a record.
+        PlyScalarType type;     // Type of the property.
+        int32_t valueIndex;     // Index of the value in the order of @ref vertexPropertyNames.
+    };
+
+    // precompute the offsets of all evaluated properties
+    std::vector<VertexField> fields;
+    size_t stride = 0;
+    for(auto&& property : element.properties){
+        if(PLY_SCALAR_TYPE_INVALID != property.listCountType){
+            return false;
+        }
+        int32_t valueIndex = GetVertexValueIndex(property.name);
+        if(valueIndex >= 0){
+            fields.push_back({stride, property.type, valueIndex});
+        }
+        stride += GetPlyScalarSize(property.type);
+    }
+    if(!stride || ((static_cast<size_t>(end - data) / stride) < element.number)){
+        return false;
+    }
+
+    // typed fast path: positions and normals are float32 and colors are uint8, which is the layout of most binary ply files
+    const bool toLinearRGB = prismaConfiguration.engine.convertSRGBToLinearRGB;
+    plyVertices.resize(element.number);
+    static_assert(sizeof(ColorMeshVertex) == (9 * sizeof(GLfloat)));
+    if(std::all_of(fields.begin(), fields.end(), [](const VertexField& field){ return (field.valueIndex < 6) ? (PLY_SCALAR_TYPE_FLOAT32 == field.type) : (PLY_SCALAR_TYPE_UINT8 == field.type); })){
+        std::array<GLfloat,256> colorTable;
+        for(size_t i = 0; i < colorTable.size(); ++i){
+            colorTable[i] = ConvertColorChannel(static_cast<double>(i), toLinearRGB);
+        }
+        ColorMeshVertex defaultVertex = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {colorTable[0], colorTable[0], colorTable[0]}};
+        for(auto&& v : plyVertices){
+            GLfloat destination[9];
+            std::memcpy(destination, &defaultVertex, sizeof(destination));
+            for(auto&& field : fields){
+                if(PLY_SCALAR_TYPE_UINT8 == field.type){
+                    destination[field.valueIndex] = colorTable[data[field.offset]];
+                }
+                else{
+                    uint32_t bits;
+                    std::memcpy(&bits, data + field.offset, sizeof(bits));
+                    if(swapBytes){
+                        bits = SwapBytes(bits);
+                    }
+                    std::memcpy(&destination[field.valueIndex], &bits, sizeof(bits));
+                }
+            }
+            std::memcpy(&v, destination, sizeof(destination));
+            EnsureCorrectNormal(v);
+            data += stride;
+        }
+        return true;
+    }
+
+    // decode all records in place
+    for(auto&& v : plyVertices){
+        double values[9] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        for(auto&& field : fields){
+            values[field.valueIndex] = ReadPlyScalar(data + field.offset, field.type, swapBytes);
+        }
+        v = ToVertex(values, toLinearRGB);
+        data += stride;
+    }
+    return true;
 }
 
-int32_t ColorMesh::GetPropertyIndex(const std::vector<std::string>& propertyNames, std::string name){
-    int32_t result = -1;
-    for(int32_t i = 0; i < static_cast<int32_t>(propertyNames.size()); ++i){
-        if(0 == propertyNames[i].compare(name)){
-            result = i;
+bool ColorMesh::ReadBinaryFaces(const uint8_t*& data, const uint8_t* end, const PlyElement& element, bool swapBytes, std::vector<GLuint>& plyIndices){
+    if((1 != element.properties.size()) || (element.properties[0].name != "vertex_indices") || (PLY_SCALAR_TYPE_INVALID == element.properties[0].listCountType)){
+        return false;
+    }
+
+    // all faces must be triangles, so each record has a fixed size
+    const PlyScalarType countType = element.properties[0].listCountType;
+    const PlyScalarType indexType = element.properties[0].type;
+    const size_t countSize = GetPlyScalarSize(countType);
+    const size_t indexSize = GetPlyScalarSize(indexType);
+    const size_t stride = countSize + 3 * indexSize;
+    if((static_cast<size_t>(end - data) / stride) < element.number){
+        return false;
+    }
+    plyIndices.resize(3 * static_cast<size_t>(element.number));
+    GLuint* destination = plyIndices.data();
+
+    // typed fast path: uint8 count and int32/uint32 indices, where the indices are copied directly and negative int32 indices are detected via the sign bit
+    if((PLY_SCALAR_TYPE_UINT8 == countType) && ((PLY_SCALAR_TYPE_INT32 == indexType) || (PLY_SCALAR_TYPE_UINT32 == indexType))){
+        uint32_t combinedBits = 0;
+        for(size_t n = 0; n < element.number; ++n){
+            if(3 != data[0]){
+                return false;
+            }
+            std::memcpy(destination, data + 1, 3 * sizeof(GLuint));
+            if(swapBytes){
+                destination[0] = SwapBytes(destination[0]);
+                destination[1] = SwapBytes(destination[1]);
+                destination[2] = SwapBytes(destination[2]);
+            }
+            combinedBits |= destination[0] | destination[1] | destination[2];
+            destination += 3;
+            data += stride;
+        }
+        return (PLY_SCALAR_TYPE_UINT32 == indexType) || !(combinedBits & 0x80000000u);
+    }
+
+    for(size_t n = 0; n < element.number; ++n){
+        if(3.0 != ReadPlyScalar(data, countType, swapBytes)){
+            return false;
+        }
+        for(size_t k = 0; k < 3; ++k){
+            if(!ReadPlyIndex(data + countSize + k * indexSize, indexType, swapBytes, *destination++)){
+                return false;
+            }
+        }
+        data += stride;
+    }
+    return true;
+}
+
+bool ColorMesh::SkipBinaryElement(const uint8_t*& data, const uint8_t* end, const PlyElement& element, bool swapBytes){
+    for(size_t n = 0; n < element.number; ++n){
+        for(auto&& property : element.properties){
+            size_t numBytes = GetPlyScalarSize(property.type);
+            if(PLY_SCALAR_TYPE_INVALID != property.listCountType){
+                size_t countSize = GetPlyScalarSize(property.listCountType);
+                GLuint count;
+                if((static_cast<size_t>(end - data) < countSize) || !ReadPlyIndex(data, property.listCountType, swapBytes, count)){
+                    return false;
+                }
+                numBytes *= static_cast<size_t>(count);
+                data += countSize;
+            }
+            if(static_cast<size_t>(end - data) < numBytes){
+                return false;
+            }
+            data += numBytes;
+        }
+    }
+    return true;
+}
+
+ColorMesh::PlyScalarType ColorMesh::GetPlyScalarType(std::string_view name){
+    if((name == "char") || (name == "int8")) return PLY_SCALAR_TYPE_INT8;
+    if((name == "uchar") || (name == "uint8")) return PLY_SCALAR_TYPE_UINT8;
+    if((name == "short") || (name == "int16")) return PLY_SCALAR_TYPE_INT16;
+    if((name == "ushort") || (name == "uint16")) return PLY_SCALAR_TYPE_UINT16;
+    if((name == "int") || (name == "int32")) return PLY_SCALAR_TYPE_INT32;
+    if((name == "uint") || (name == "uint32")) return PLY_SCALAR_TYPE_UINT32;
+    if((name == "float") || (name == "float32")) return PLY_SCALAR_TYPE_FLOAT32;
+    if((name == "double") || (name == "float64")) return PLY_SCALAR_TYPE_FLOAT64;
+    return PLY_SCALAR_TYPE_INVALID;
+}
+
+size_t ColorMesh::GetPlyScalarSize(PlyScalarType type){
+    switch(type){
+        case PLY_SCALAR_TYPE_INT8:
+        case PLY_SCALAR_TYPE_UINT8:
+            return 1;
+        case PLY_SCALAR_TYPE_INT16:
+        case PLY_SCALAR_TYPE_UINT16:
+            return 2;
+        case PLY_SCALAR_TYPE_INT32:
+        case PLY_SCALAR_TYPE_UINT32:
+        case PLY_SCALAR_TYPE_FLOAT32:
+            return 4;
+        case PLY_SCALAR_TYPE_FLOAT64:
+            return 8;
+        case PLY_SCALAR_TYPE_INVALID:
             break;
+    }
+    return 0;
+}
+
+double ColorMesh::ReadPlyScalar(const uint8_t* bytes, PlyScalarType type, bool swapBytes){
+    uint8_t b[8];
+    const size_t size = GetPlyScalarSize(type);
+    std::memcpy(b, bytes, size);
+    if(swapBytes){
+        std::reverse(b, b + size);
+    }
+    switch(type){
+        case PLY_SCALAR_TYPE_INT8:    { int8_t v;   std::memcpy(&v, b, sizeof(v)); return static_cast<double>(v); }
+        case PLY_SCALAR_TYPE_UINT8:   { uint8_t v;  std::memcpy(&v, b, sizeof(v)); return static_cast<double>(v); }
+        case PLY_SCALAR_TYPE_INT16:   { int16_t v;  std::memcpy(&v, b, sizeof(v)); return static_cast<double>(v); }
+        case PLY_SCALAR_TYPE_UINT16:  { uint16_t v; std::memcpy(&v, b, sizeof(v)); return static_cast<double>(v); }
+        case PLY_SCALAR_TYPE_INT32:   { int32_t v;  std::memcpy(&v, b, sizeof(v)); return static_cast<double>(v); }
+        case PLY_SCALAR_TYPE_UINT32:  { uint32_t v; std::memcpy(&v, b, sizeof(v)); return static_cast<double>(v); }
+        case PLY_SCALAR_TYPE_FLOAT32: { float v;    std::memcpy(&v, b, sizeof(v)); return static_cast<double>(v); }
+        case PLY_SCALAR_TYPE_FLOAT64: { double v;   std::memcpy(&v, b, sizeof(v)); return v; }
+        case PLY_SCALAR_TYPE_INVALID: break;
+    }
+    return 0.0;
+}
+
+uint32_t ColorMesh::SwapBytes(uint32_t value){
+    return (value >> 24) | ((value >> 8) & 0x0000FF00u) | ((value << 8) & 0x00FF0000u) | (value << 24);
+}
+
+bool ColorMesh::ReadPlyIndex(const uint8_t* bytes, PlyScalarType type, bool swapBytes, GLuint& value){
+    double v = ReadPlyScalar(bytes, type, swapBytes);
+    if(!(v >= 0.0) || (v > static_cast<double>(std::numeric_limits<GLuint>::max())) || (v != std::floor(v))){
+        return false;
+    }
+    value = static_cast<GLuint>(v);
+    return true;
+}
+
+bool ColorMesh::IndicesAreInRange(const std::vector<GLuint>& plyIndices, size_t numVertices){
+    GLuint maxIndex = 0;
+    for(GLuint index : plyIndices){
+        maxIndex = std::max(maxIndex, index);
+    }
+    return plyIndices.empty() || (static_cast<size_t>(maxIndex) < numVertices);
+}
+
+int32_t ColorMesh::GetVertexValueIndex(std::string_view name){
+    for(int32_t i = 0; i < 9; ++i){
+        if(name == vertexPropertyNames[i]){
+            return i;
         }
     }
-    return result;
+    return -1;
 }
 
-ColorMeshVertex ColorMesh::GetDefaultVertex(void){
+ColorMeshVertex ColorMesh::ToVertex(const double (&values)[9], bool toLinearRGB){
     ColorMeshVertex vertex;
-    vertex.position[0] = vertex.position[1] = vertex.position[2] = 0.0f;
-    vertex.normal[0] = vertex.normal[1] = vertex.normal[2] = 0.0f;
-    vertex.color[0] = vertex.color[1] = vertex.color[2] = 0.0f;
+    for(int k = 0; k < 3; ++k){
+        vertex.position[k] = static_cast<GLfloat>(values[k]);
+        vertex.normal[k] = static_cast<GLfloat>(values[3 + k]);
+        vertex.color[k] = ConvertColorChannel(values[6 + k], toLinearRGB);
+    }
+    EnsureCorrectNormal(vertex);
     return vertex;
 }
 
@@ -256,10 +593,19 @@ void ColorMesh::EnsureCorrectNormal(ColorMeshVertex& vertex){
     }
 }
 
-void ColorMesh::SRGBToLinearRGB(ColorMeshVertex& vertex){
+GLfloat ColorMesh::ConvertColorChannel(double value, bool toLinearRGB){
     constexpr double gamma = 2.2;
-    vertex.color[0] = static_cast<GLfloat>(std::pow(static_cast<double>(vertex.color[0]), gamma));
-    vertex.color[1] = static_cast<GLfloat>(std::pow(static_cast<double>(vertex.color[1]), gamma));
-    vertex.color[2] = static_cast<GLfloat>(std::pow(static_cast<double>(vertex.color[2]), gamma));
+    static const std::array<GLfloat,256> linearRGB = [](){
+        std::array<GLfloat,256> table;
+        for(size_t i = 0; i < table.size(); ++i){
+            table[i] = static_cast<GLfloat>(std::pow(static_cast<double>(static_cast<GLfloat>(static_cast<double>(i) / 255.0)), gamma));
+        }
+        return table;
+    }();
+    if(toLinearRGB && (value >= 0.0) && (value <= 255.0) && (value == std::floor(value))){
+        return linearRGB[static_cast<size_t>(value)];
+    }
+    GLfloat channel = static_cast<GLfloat>(value / 255.0);
+    return toLinearRGB ? static_cast<GLfloat>(std::pow(static_cast<double>(channel), gamma)) : channel;
 }
 
@@ -4,6 +4,8 @@
 #include <Common.hpp>
 #include <MeshBase.hpp>
 #include <AABB.hpp>
+#include <TextTokenizer.hpp>
+#include <MappedFile.hpp>
 
 
 #pragma pack(push, 1)
@@ -50,65 +52,217 @@ class ColorMesh: public MeshBase {
          * @brief Read mesh data from ply file.
          * @param[in] filename Filename of the ply file.
          * @return True if success, false otherwise.
+         * @details The file is memory-mapped and parsed in place.
          */
         bool ReadFromFile(std::string filename);
 
+        /**
+         * @brief Get the names of all files other than the ply file that have been read by @ref ReadFromFile.
+         * @return An empty list, a ply file does not refer to other files.
+         */
+        std::vector<std::string> GetDependencies(void);
+
+        /**
+         * @brief Read mesh data from a mesh cache file without parsing. The vertices and indices are used in place until @ref Generate is called.
+         * @param[inout] reader The reader of the mesh cache file, positioned at the start of the mesh data.
+         * @return True if success, false otherwise.
+         */
+        bool ReadFromCache(MeshCacheReader& reader);
+
+        /**
+         * @brief Write the mesh data that has been read via @ref ReadFromFile to a mesh cache file.
+         * @param[inout] writer The writer of the mesh cache file, positioned at the start of the mesh data.
+         * @return True if success, false otherwise.
+         */
+        bool WriteToCache(MeshCacheWriter& writer);
+
     private:
-        GLuint vao;                              // The vertex array object.
-        GLuint vbo;                              // The vertex buffer object.
-        GLuint ebo;                              // The element buffer object.
-        std::vector<ColorMeshVertex> vertices;   // List of vertices for this mesh.
-        std::vector<GLuint> indices;             // List of indices to vertices that describe triangles of the mesh.
-        GLsizei numIndices;                      // The number of indices to draw. This value is set by @ref Generate.
-        AABB aabbVertices;                       // The axis-aligned bounding box containing all @ref vertices.
+        GLuint vao;                                       // The vertex array object.
+        GLuint vbo;                                       // The vertex buffer object.
+        GLuint ebo;                                       // The element buffer object.
+        std::vector<ColorMeshVertex> vertices;            // List of vertices for this mesh.
+        std::vector<GLuint> indices;                      // List of indices to vertices that describe triangles of the mesh.
+        GLsizei numIndices;                               // The number of indices to draw. This value is set by @ref Generate.
+        AABB aabbVertices;                                // The axis-aligned bounding box containing all @ref vertices.
+        std::shared_ptr<MappedFile> cacheFile;            // The mesh cache file if the mesh has been read via @ref ReadFromCache.
+        std::span<const ColorMeshVertex> cachedVertices;  // Vertices in the mesh cache file.
+        std::span<const GLuint> cachedIndices;            // Indices in the mesh cache file.
 
+        enum PlyFormat {
+            PLY_FORMAT_ASCII,
+            PLY_FORMAT_BINARY_LITTLE_ENDIAN,
+            PLY_FORMAT_BINARY_BIG_ENDIAN
+        };
+        enum PlyScalarType: uint8_t {
+            PLY_SCALAR_TYPE_INVALID = 0,
+            PLY_SCALAR_TYPE_INT8,
+            PLY_SCALAR_TYPE_UINT8,
+            PLY_SCALAR_TYPE_INT16,
+            PLY_SCALAR_TYPE_UINT16,
+            PLY_SCALAR_TYPE_INT32,
+            PLY_SCALAR_TYPE_UINT32,
+            PLY_SCALAR_TYPE_FLOAT32,
+            PLY_SCALAR_TYPE_FLOAT64
+        };
+        struct PlyProperty {
+            std::string name;
+            PlyScalarType type;            // Type of the value or of the list items.
+            PlyScalarType listCountType;   // Type of the list count or @ref PLY_SCALAR_TYPE_INVALID if the property is not a list.
+        };
         struct PlyElement {
             std::string name;
             uint32_t number;
-            std::vector<std::string> propertyNames;
+            std::vector<PlyProperty> properties;
         };
+        PlyFormat format;                   // The format of the ply file specified in the header.
         std::vector<PlyElement> elements;   // List of elements specified in the header of a ply file.
 
+        /**
+         * @brief The names of the vertex properties that are evaluated, in the order of the values of @ref ColorMeshVertex.
+         */
+        static constexpr const char* vertexPropertyNames[9] = {"x", "y", "z", "nx", "ny", "nz", "red", "green", "blue"};
+
         /**
          * @brief Parse the ply header.
-         * @param[in] file The open file from which to read.
+         * @param[inout] tokenizer The tokenizer of the file content, positioned at the start of the file.
+         * @return True if success, false otherwise.
+         */
+        bool ParsePlyHeader(TextTokenizer& tokenizer);
+
+        /**
+         * @brief Parse the ply data in ASCII format.
+         * @param[inout] tokenizer The tokenizer of the file content, positioned at the end of the header.
+         * @return True if success, false otherwise.
+         */
+        bool ParsePlyData(TextTokenizer& tokenizer);
+
+        /**
+         * @brief Parse the ply data in binary format (little or big endian).
+         * @param[in] data Pointer to the first byte after the header.
+         * @param[in] end Pointer to the end of the file content.
+         * @return True if success, false otherwise.
+         * @details Fixed-size records are decoded in place at precomputed property offsets, such that no property name is
+         * looked up per vertex.
+         */
+        bool ParsePlyDataBinary(const uint8_t* data, const uint8_t* end);
+
+        /**
+         * @brief Read all vertices of a vertex element in binary format.
+         * @param[inout] data Pointer to the first record, is advanced to the first byte after the element.
+         * @param[in] end Pointer to the end of the file content.
+         * @param[in] element The vertex element.
+         * @param[in] swapBytes True if the byte order of the file differs from the native byte order.
+         * @param[out] plyVertices The vertices that have been read.
+         * @return True if success, false otherwise.
+         */
+        bool ReadBinaryVertices(const uint8_t*& data, const uint8_t* end, const PlyElement& element, bool swapBytes, std::vector<ColorMeshVertex>& plyVertices);
+
+        /**
+         * @brief Read all triangles of a face element in binary format.
+         * @param[inout] data Pointer to the first record, is advanced to the first byte after the element.
+         * @param[in] end Pointer to the end of the file content.
+         * @param[in] element The face element.
+         * @param[in] swapBytes True if the byte order of the file differs from the native byte order.
+         * @param[out] plyIndices The indices that have been read.
          * @return True if success, false otherwise.
          */
-        bool ParsePlyHeader(std::ifstream& file);
+        bool ReadBinaryFaces(const uint8_t*& data, const uint8_t* end, const PlyElement& element, bool swapBytes, std::vector<GLuint>& plyIndices);
 
         /**
-         * @brief Parse the ply data.
-         * @param[in] file The open file from which to read.
+         * @brief Skip all records of an element in binary format.
+         * @param[inout] data Pointer to the first record, is advanced to the first byte after the element.
+         * @param[in] end Pointer to the end of the file content.
+         * @param[in] element The element to be skipped.
+         * @param[in] swapBytes True if the byte order of the file differs from the native byte order.
          * @return True if success, false otherwise.
          */
-        bool ParsePlyData(std::ifstream& file);
+        bool SkipBinaryElement(const uint8_t*& data, const uint8_t* end, const PlyElement& element, bool swapBytes);
+
+        /**
+         * @brief Get the scalar type of a ply datatype name.
+         * @param[in] name The name of the datatype, e.g. "float" or "uint8".
+         * @return The scalar type or @ref PLY_SCALAR_TYPE_INVALID if the name is unknown.
+         */
+        static PlyScalarType GetPlyScalarType(std::string_view name);
 
         /**
-         * @brief Read the next line from the file.
-         * @param[in] file The open file from which to read.
-         * @return The line exluding <CR> and <LF>.
+         * @brief Get the size of a scalar type.
+         * @param[in] type The scalar type.
+         * @return Size in bytes or zero if the type is invalid.
          */
-        std::string ReadNextLine(std::ifstream& file);
+        static size_t GetPlyScalarSize(PlyScalarType type);
 
         /**
-         * @brief Get the index of a specific property name from a list of property names.
-         * @param[in] propertyNames The list of property names.
-         * @param[in] name Specific property name to be searched for.
-         * @return Index of the propertyNames container or -1 if that name does not exist.
+         * @brief Read a binary scalar value.
+         * @param[in] bytes Pointer to the first byte of the value.
+         * @param[in] type The scalar type of the value.
+         * @param[in] swapBytes True if the byte order of the value differs from the native byte order.
+         * @return The value.
          */
-        int32_t GetPropertyIndex(const std::vector<std::string>& propertyNames, std::string name);
+        static double ReadPlyScalar(const uint8_t* bytes, PlyScalarType type, bool swapBytes);
 
         /**
-         * @brief Get a vertex with default values.
-         * @return Vertex for the color mesh.
+         * @brief Reverse the byte order of a 32-bit value.
+         * @param[in] value The value.
+         * @return The value with reversed byte order.
          */
-        ColorMeshVertex GetDefaultVertex(void);
+        static uint32_t SwapBytes(uint32_t value);
+
+        /**
+         * @brief Read a binary scalar value that is used as an index or a count.
+         * @param[in] bytes Pointer to the first byte of the value.
+         * @param[in] type The scalar type of the value.
+         * @param[in] swapBytes True if the byte order of the value differs from the native byte order.
+         * @param[out] value The value.
+         * @return True if success, false if the value is negative, not integral, not a number or too large for a GLuint.
+         */
+        static bool ReadPlyIndex(const uint8_t* bytes, PlyScalarType type, bool swapBytes, GLuint& value);
+
+        /**
+         * @brief Check whether all indices refer to existing vertices.
+         * @param[in] plyIndices The indices to be checked.
+         * @param[in] numVertices The number of vertices.
+         * @return True if all indices are less than the number of vertices, false otherwise.
+         */
+        static bool IndicesAreInRange(const std::vector<GLuint>& plyIndices, size_t numVertices);
+
+        /**
+         * @brief Get the index of a vertex value for a property name.
+         * @param[in] name The property name.
+         * @return Index of the value in the order of @ref vertexPropertyNames or -1 if the property is not evaluated.
+         */
+        static int32_t GetVertexValueIndex(std::string_view name);
+
+        /**
+         * @brief Convert the values of a ply vertex to a vertex of the color mesh.
+         * @param[in] values The values in the order of @ref vertexPropertyNames, where colors are in range [0, 255].
+         * @param[in] toLinearRGB True if the color is to be converted from sRGB to linear RGB.
+         * @return Vertex for the color mesh with a normalized normal vector.
+         */
+        ColorMeshVertex ToVertex(const double (&values)[9], bool toLinearRGB);
 
         /**
          * @brief Update the @ref aabbVertices based on @ref vertices.
          */
         void UpdateAABB(void);
 
+        /**
+         * @brief Get the vertices that are going to be uploaded by @ref Generate.
+         * @return Either the vertices in the mesh cache file or @ref vertices.
+         */
+        std::span<const ColorMeshVertex> GetVertices(void) const;
+
+        /**
+         * @brief Get the indices that are going to be uploaded by @ref Generate.
+         * @return Either the indices in the mesh cache file or @ref indices.
+         */
+        std::span<const GLuint> GetIndices(void) const;
+
+        /**
+         * @brief Release the mesh cache file and the views of its vertices and indices.
+         */
+        void ReleaseCacheFile(void);
+
         /**
          * @brief Ensure that the normal vector is indeed a normalized vector.
          * @param[inout] vertex The vertex for which to ensure the correct normal vector.
@@ -116,9 +270,12 @@ class ColorMesh: public MeshBase {
         void EnsureCorrectNormal(ColorMeshVertex& vertex);
 
         /**
-         * @brief Convert the color of a vertex from sRGB to linear RGB.
-         * @param[inout] vertex The vertex for which to convert the color space.
+         * @brief Convert a color channel of a ply vertex to range [0, 1] and optionally from sRGB to linear RGB.
+         * @param[in] value The color channel in range [0, 255].
+         * @param[in] toLinearRGB True if the color is to be converted from sRGB to linear RGB.
+         * @return The converted color channel.
+         * @details Integer values in range [0, 255] are converted via a precomputed table of 256 entries.
          */
-        void SRGBToLinearRGB(ColorMeshVertex& vertex);
+        static GLfloat ConvertColorChannel(double value, bool toLinearRGB);
 };
 
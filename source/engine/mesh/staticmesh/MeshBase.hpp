@@ -3,6 +3,7 @@
 
 #include <Common.hpp>
 #include <AABB.hpp>
+#include <MeshCache.hpp>
 
 
 /**
@@ -22,6 +23,26 @@ class MeshBase {
          */
         virtual bool ReadFromFile(std::string filename) = 0;
 
+        /**
+         * @brief Get the names of all files other than the mesh file that have been read by @ref ReadFromFile, e.g. material libraries and textures.
+         * @return List of filenames.
+         */
+        virtual std::vector<std::string> GetDependencies(void) = 0;
+
+        /**
+         * @brief Read mesh data from a mesh cache file without parsing. The data is used in place until @ref Generate is called.
+         * @param[inout] reader The reader of the mesh cache file, positioned at the start of the mesh data.
+         * @return True if success, false otherwise.
+         */
+        virtual bool ReadFromCache(MeshCacheReader& reader) = 0;
+
+        /**
+         * @brief Write the mesh data that has been read via @ref ReadFromFile to a mesh cache file.
+         * @param[inout] writer The writer of the mesh cache file, positioned at the start of the mesh data.
+         * @return True if success, false otherwise.
+         */
+        virtual bool WriteToCache(MeshCacheWriter& writer) = 0;
+
         /**
          * @brief Generate GL content (vao, vbo, ebo) and free memory.
          * @return True if success, false otherwise. If this mesh has already been generated, false is returned.
@@ -0,0 +1,183 @@
+#include <MeshCache.hpp>
+#include <MeshBase.hpp>
+#include <PrismaConfiguration.hpp>
+#include <Profiler.hpp>
+
+
+bool MeshCache::IsUpToDate(const std::string& filename){
+    MeshCacheReader reader;
+    return ReadHeader(filename, reader);
+}
+
+bool MeshCache::Read(const std::string& filename, MeshBase& mesh){
+    PROFILE_ZONE("ReadMeshCache");
+    MeshCacheReader reader;
+    if(!ReadHeader(filename, reader)){
+        return false;
+    }
+    if(!mesh.ReadFromCache(reader)){
+        PrintW("Mesh cache file \"%s\" is corrupt and is going to be rewritten\n", GetCacheFilename(filename).c_str());
+        return false;
+    }
+    return true;
+}
+
+bool MeshCache::Write(const std::string& filename, MeshBase& mesh){
+    PROFILE_ZONE("WriteMeshCache");
+    std::filesystem::path directory = std::filesystem::path(filename).parent_path();
+    std::vector<std::string> sourceFilenames = mesh.GetDependencies();
+    sourceFilenames.insert(sourceFilenames.begin(), filename);
+    std::vector<SourceFile> sourceFiles(sourceFilenames.size());
+    for(size_t i = 0; i < sourceFilenames.size(); ++i){
+        if(!GetSourceFile(directory, sourceFilenames[i], sourceFiles[i])){
+            return false;
+        }
+    }
+    std::string cacheFilename = GetCacheFilename(filename);
+    std::string temporaryFilename = cacheFilename + ".tmp" + std::to_string(std::random_device()());
+    bool success = false;
+    try{
+        std::ofstream file(temporaryFilename, std::ofstream::binary | std::ofstream::trunc);
+        if(file.is_open()){
+            MeshCacheWriter writer(file);
+            writer.Write(magic);
+            writer.Write(version);
+            writer.Write(GetFlags());
+            writer.Write(static_cast<uint32_t>(sourceFiles.size()));
+            for(auto&& sourceFile : sourceFiles){
+                writer.WriteString(sourceFile.filename);
+                writer.Write(sourceFile.size);
+                writer.Write(sourceFile.modificationTime);
+                writer.Write(sourceFile.hash);
+            }
+            success = mesh.WriteToCache(writer);
+            writer.Write(magic);
+            success = success && writer.IsGood();
+            file.close();
+            success &= !file.fail();
+        }
+        if(success){
+            std::filesystem::rename(temporaryFilename, cacheFilename);
+        }
+    }
+    catch(...){
+        success = false;
+    }
+    if(!success){
+        std::error_code ec;
+        (void) std::filesystem::remove(temporaryFilename, ec);
+    }
+    return success;
+}
+
+bool MeshCache::ReadHeader(const std::string& filename, MeshCacheReader& reader){
+    if(!reader.Open(GetCacheFilename(filename)) || !reader.HasTrailer(magic)){
+        return false;
+    }
+    std::array<char,8> fileMagic;
+    uint32_t fileVersion, fileFlags, numSourceFiles;
+    if(!reader.Read(fileMagic) || (fileMagic != magic) || !reader.Read(fileVersion) || (fileVersion != version) || !reader.Read(fileFlags) || (fileFlags != GetFlags()) || !reader.Read(numSourceFiles) || !numSourceFiles){
+        return false;
+    }
+    std::filesystem::path directory = std::filesystem::path(filename).parent_path();
+    std::vector<std::pair<uint64_t,int64_t>> modificationTimes;
+    for(uint32_t n = 0; n < numSourceFiles; ++n){
+        SourceFile sourceFile;
+        if(!reader.ReadString(sourceFile.filename) || !reader.Read(sourceFile.size)){
+            return false;
+        }
+        uint64_t modificationTimeOffset = static_cast<uint64_t>(reader.GetOffset());
+        if(!reader.Read(sourceFile.modificationTime) || !reader.Read(sourceFile.hash)){
+            return false;
+        }
+        int64_t modificationTime;
+        if(!IsUnchanged(directory, sourceFile, modificationTime)){
+            return false;
+        }
+        if(modificationTime != sourceFile.modificationTime){
+            modificationTimes.push_back({modificationTimeOffset, modificationTime});
+        }
+    }
+    if(!modificationTimes.empty() && !UpdateModificationTimes(filename, modificationTimes)){
+        PrintW("Could not update modification times in mesh cache file \"%s\"\n", GetCacheFilename(filename).c_str());
+    }
+    return true;
+}
+
+uint32_t MeshCache::GetFlags(void){
+    uint32_t flags = 0;
+    if(prismaConfiguration.engine.convertSRGBToLinearRGB){
+        flags |= FLAG_LINEAR_RGB;
+    }
+    return flags;
+}
+
+bool MeshCache::GetSourceFile(const std::filesystem::path& directory, const std::string& filename, SourceFile& sourceFile){
+    std::error_code ec;
+    std::filesystem::path p(filename);
+    sourceFile.size = static_cast<uint64_t>(std::filesystem::file_size(p, ec));
+    if(ec){
+        return false;
+    }
+    auto modificationTime = std::filesystem::last_write_time(p, ec);
+    if(ec){
+        return false;
+    }
+    sourceFile.modificationTime = static_cast<int64_t>(modificationTime.time_since_epoch().count());
+    std::filesystem::path relativePath = p.lexically_relative(directory);
+    sourceFile.filename = relativePath.empty() ? p.generic_string() : relativePath.generic_string();
+    return ComputeHash(filename, sourceFile.hash);
+}
+
+bool MeshCache::IsUnchanged(const std::filesystem::path& directory, const SourceFile& sourceFile, int64_t& modificationTime){
+    std::error_code ec;
+    std::filesystem::path p = directory / std::filesystem::path(sourceFile.filename);
+    uint64_t size = static_cast<uint64_t>(std::filesystem::file_size(p, ec));
+    if(ec || (size != sourceFile.size)){
+        return false;
+    }
+    auto fileTime = std::filesystem::last_write_time(p, ec);
+    if(ec){
+        return false;
+    }
+    modificationTime = static_cast<int64_t>(fileTime.time_since_epoch().count());
+    if(modificationTime == sourceFile.modificationTime){
+        return true;
+    }
+    // the file has been touched, e.g. by a checkout: compare the content
+    uint64_t hash;
+    return ComputeHash(p.string(), hash) && (hash == sourceFile.hash);
+}
+
+bool MeshCache::UpdateModificationTimes(const std::string& filename, const std::vector<std::pair<uint64_t,int64_t>>& modificationTimes){
+    try{
+        std::fstream file(GetCacheFilename(filename), std::fstream::in | std::fstream::out | std::fstream::binary);
+        if(!file.is_open()){
+            return false;
+        }
+        for(auto&& [offset, modificationTime] : modificationTimes){
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(reinterpret_cast<const char*>(&modificationTime), sizeof(modificationTime));
+        }
+        file.close();
+        return !file.fail();
+    }
+    catch(...){
+        return false;
+    }
+}
+
+bool MeshCache::ComputeHash(const std::string& filename, uint64_t& hash){
+    MappedFile file;
+    if(!file.Open(filename)){
+        return false;
+    }
+    hash = 0xCBF29CE484222325ull;
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(file.GetData());
+    for(size_t n = 0; n < file.GetSize(); ++n){
+        hash ^= static_cast<uint64_t>(data[n]);
+        hash *= 0x00000100000001B3ull;
+    }
+    return true;
+}
+
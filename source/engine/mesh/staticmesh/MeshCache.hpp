@@ -0,0 +1,333 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <MappedFile.hpp>
+
+
+class MeshBase;
+
+
+/**
+ * @brief Writes the content of a mesh cache file sequentially.
+ * @details Arrays are stored as a 64-bit number of elements followed by the raw elements, where the first element is
+ * aligned to @ref alignment bytes relative to the start of the file. Values are stored in native byte order.
+ */
+class MeshCacheWriter {
+    public:
+        static constexpr uint64_t alignment = 16;   // Alignment of the first element of an array in bytes.
+
+        /**
+         * @brief Construct a new mesh cache writer.
+         * @param[inout] stream The binary output stream, positioned at the start of the file.
+         */
+        explicit MeshCacheWriter(std::ostream& stream): stream(stream), offset(0){}
+
+        /**
+         * @brief Write a trivially copyable value.
+         * @param[in] value The value to be written.
+         */
+        template <typename T> void Write(const T& value){
+            static_assert(std::is_trivially_copyable_v<T>);
+            WriteBytes(&value, sizeof(T));
+        }
+
+        /**
+         * @brief Write a 3D vector as three floating point values.
+         * @param[in] value The vector to be written.
+         */
+        void WriteVec3(const glm::vec3& value){
+            Write(std::array<GLfloat,3>({value.x, value.y, value.z}));
+        }
+
+        /**
+         * @brief Write a string as a 32-bit length followed by the characters.
+         * @param[in] value The string to be written.
+         */
+        void WriteString(std::string_view value){
+            Write(static_cast<uint32_t>(value.size()));
+            WriteBytes(value.data(), value.size());
+        }
+
+        /**
+         * @brief Write an array of trivially copyable elements, such that it can be used in place by @ref MeshCacheReader::ReadArray.
+         * @param[in] values The elements to be written.
+         */
+        template <typename T> void WriteArray(std::span<const T> values){
+            static_assert(std::is_trivially_copyable_v<T>);
+            Write(static_cast<uint64_t>(values.size()));
+            const char padding[alignment] = {};
+            WriteBytes(padding, static_cast<size_t>((alignment - (offset % alignment)) % alignment));
+            WriteBytes(values.data(), values.size_bytes());
+        }
+
+        /**
+         * @brief Check whether all values have been written successfully.
+         * @return True if the stream is good, false otherwise.
+         */
+        bool IsGood(void) const { return stream.good(); }
+
+    private:
+        std::ostream& stream;   // The binary output stream.
+        uint64_t offset;        // Number of bytes that have been written.
+
+        /**
+         * @brief Write raw bytes to the stream.
+         * @param[in] data Pointer to the first byte.
+         * @param[in] size Number of bytes to be written.
+         */
+        void WriteBytes(const void* data, size_t size){
+            stream.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+            offset += size;
+        }
+};
+
+
+/**
+ * @brief Reads the content of a memory-mapped mesh cache file sequentially.
+ * @details All reads are bounds-checked. Arrays are not copied but returned as views into the mapped file, which stays
+ * mapped as long as a reference to it (@ref GetFile) exists.
+ */
+class MeshCacheReader {
+    public:
+        /**
+         * @brief Construct a new mesh cache reader without any content.
+         */
+        MeshCacheReader(): offset(0){}
+
+        /**
+         * @brief Map a mesh cache file and move to its start.
+         * @param[in] filename The name of the mesh cache file.
+         * @return True if success, false otherwise.
+         */
+        bool Open(const std::string& filename){
+            offset = 0;
+            file = std::make_shared<MappedFile>();
+            if(!file->Open(filename)){
+                file.reset();
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Check whether the file ends with a given trailer, e.g. to detect a truncated file.
+         * @param[in] trailer The expected last bytes of the file.
+         * @return True if the file ends with the trailer, false otherwise.
+         */
+        template <size_t N> bool HasTrailer(const std::array<char,N>& trailer) const {
+            return file && (file->GetSize() >= N) && (0 == std::memcmp(file->GetData() + file->GetSize() - N, trailer.data(), N));
+        }
+
+        /**
+         * @brief Read a trivially copyable value.
+         * @param[out] value The value.
+         * @return True if success, false if the end of the file has been reached.
+         */
+        template <typename T> bool Read(T& value){
+            static_assert(std::is_trivially_copyable_v<T>);
+            if(GetRemainingSize() < sizeof(T)){
+                return false;
+            }
+            std::memcpy(&value, file->GetData() + offset, sizeof(T));
+            offset += sizeof(T);
+            return true;
+        }
+
+        /**
+         * @brief Read a 3D vector that has been written via @ref MeshCacheWriter::WriteVec3.
+         * @param[out] value The vector.
+         * @return True if success, false if the end of the file has been reached.
+         */
+        bool ReadVec3(glm::vec3& value){
+            std::array<GLfloat,3> v;
+            if(!Read(v)){
+                return false;
+            }
+            value.x = v[0];
+            value.y = v[1];
+            value.z = v[2];
+            return true;
+        }
+
+        /**
+         * @brief Read a string that has been written via @ref MeshCacheWriter::WriteString.
+         * @param[out] value The string.
+         * @return True if success, false if the end of the file has been reached.
+         */
+        bool ReadString(std::string& value){
+            uint32_t length;
+            if(!Read(length) || (GetRemainingSize() < length)){
+                return false;
+            }
+            value.assign(file->GetData() + offset, length);
+            offset += length;
+            return true;
+        }
+
+        /**
+         * @brief Read an array that has been written via @ref MeshCacheWriter::WriteArray.
+         * @param[out] values View of the elements in the mapped file.
+         * @return True if success, false if the end of the file has been reached.
+         */
+        template <typename T> bool ReadArray(std::span<const T>& values){
+            static_assert(std::is_trivially_copyable_v<T>);
+            uint64_t numElements;
+            if(!Read(numElements)){
+                return false;
+            }
+            size_t padding = static_cast<size_t>((MeshCacheWriter::alignment - (offset % MeshCacheWriter::alignment)) % MeshCacheWriter::alignment);
+            if((GetRemainingSize() < padding) || (numElements > ((GetRemainingSize() - padding) / sizeof(T)))){
+                return false;
+            }
+            offset += padding;
+            values = std::span<const T>(reinterpret_cast<const T*>(file->GetData() + offset), static_cast<size_t>(numElements));
+            offset += values.size_bytes();
+            return true;
+        }
+
+        /**
+         * @brief Read an array of triangle indices and check that all indices refer to existing vertices.
+         * @param[out] indices View of the indices in the mapped file.
+         * @param[in] numVertices The number of vertices to which the indices refer.
+         * @return True if success, false if the end of the file has been reached or if the indices are invalid.
+         */
+        bool ReadIndexArray(std::span<const GLuint>& indices, size_t numVertices){
+            if(!ReadArray(indices) || (indices.size() % 3)){
+                return false;
+            }
+            GLuint maxIndex = 0;
+            for(GLuint index : indices){
+                maxIndex = std::max(maxIndex, index);
+            }
+            return indices.empty() || (static_cast<size_t>(maxIndex) < numVertices);
+        }
+
+        /**
+         * @brief Get the mapped file, e.g. to keep the views returned by @ref ReadArray valid.
+         * @return The mapped file or nullptr if no file is open.
+         */
+        const std::shared_ptr<MappedFile>& GetFile(void) const { return file; }
+
+        /**
+         * @brief Get the position of the next byte to be read.
+         * @return Position in bytes relative to the start of the file.
+         */
+        size_t GetOffset(void) const { return offset; }
+
+    private:
+        std::shared_ptr<MappedFile> file;   // The mapped mesh cache file.
+        size_t offset;                      // Position of the next byte to be read.
+
+        /**
+         * @brief Get the number of bytes that have not been read.
+         * @return Number of remaining bytes.
+         */
+        size_t GetRemainingSize(void) const { return file ? (file->GetSize() - offset) : 0; }
+};
+
+
+/**
+ * @brief Reads and writes preprocessed mesh data from and to a binary mesh cache file.
+ * @details The cache file of a mesh file is located next to the mesh file and has the additional extension ".prismamesh".
+ * It contains a versioned header, the list of all source files (mesh file, material library, textures) with their size,
+ * modification time and hash, followed by the GPU-ready mesh data and the magic number as trailer. A cache file is only used if all source files are
+ * unchanged, where the hash is only computed if the modification time of a source file differs. If the hash matches, the new modification time is
+ * written to the cache file, such that the source file is not hashed again.
+ */
+class MeshCache {
+    public:
+        /**
+         * @brief Get the name of the cache file for a mesh file.
+         * @param[in] filename The name of the mesh file.
+         * @return The name of the cache file.
+         */
+        static std::string GetCacheFilename(const std::string& filename){ return filename + ".prismamesh"; }
+
+        /**
+         * @brief Check whether a valid cache file exists for a mesh file.
+         * @param[in] filename The name of the mesh file.
+         * @return True if the cache file exists and all source files are unchanged, false otherwise.
+         */
+        static bool IsUpToDate(const std::string& filename);
+
+        /**
+         * @brief Read a mesh from the cache file of a mesh file.
+         * @param[in] filename The name of the mesh file.
+         * @param[inout] mesh The mesh to be read.
+         * @return True if success, false if there is no valid cache file.
+         * @details The cache file stays mapped until the mesh has been generated.
+         */
+        static bool Read(const std::string& filename, MeshBase& mesh);
+
+        /**
+         * @brief Write the cache file for a mesh that has been read from a mesh file.
+         * @param[in] filename The name of the mesh file.
+         * @param[in] mesh The mesh that has been read via its ReadFromFile member function.
+         * @return True if success, false otherwise.
+         * @details The cache file is written to a temporary file that is then renamed, such that concurrent readers never see a partially written cache file.
+         */
+        static bool Write(const std::string& filename, MeshBase& mesh);
+
+    private:
+        static constexpr std::array<char,8> magic = {'P','R','I','S','M','A','M','C'};
+        static constexpr uint32_t version = 2;
+        static constexpr uint32_t FLAG_LINEAR_RGB = 0x00000001;
+
+        struct SourceFile {
+            std::string filename;        // Name of the source file relative to the directory of the mesh file.
+            uint64_t size;               // Size of the source file in bytes.
+            int64_t modificationTime;    // Time of the last modification of the source file in ticks of the file clock.
+            uint64_t hash;               // FNV-1a hash of the source file content.
+        };
+
+        /**
+         * @brief Map the cache file of a mesh file and check the header and all source files.
+         * @param[in] filename The name of the mesh file.
+         * @param[out] reader The reader, positioned at the start of the mesh data if success.
+         * @return True if success, false if there is no valid cache file.
+         */
+        static bool ReadHeader(const std::string& filename, MeshCacheReader& reader);
+
+        /**
+         * @brief Get the flags of the current configuration that affect the cached mesh data.
+         * @return The flags.
+         */
+        static uint32_t GetFlags(void);
+
+        /**
+         * @brief Get the status of a source file.
+         * @param[in] directory The directory of the mesh file.
+         * @param[in] filename The name of the source file.
+         * @param[out] sourceFile The status of the source file.
+         * @return True if success, false otherwise.
+         */
+        static bool GetSourceFile(const std::filesystem::path& directory, const std::string& filename, SourceFile& sourceFile);
+
+        /**
+         * @brief Check whether a source file is unchanged.
+         * @param[in] directory The directory of the mesh file.
+         * @param[in] sourceFile The status of the source file at the time the cache file has been written.
+         * @param[out] modificationTime The current modification time of the source file.
+         * @return True if the source file is unchanged, false otherwise.
+         */
+        static bool IsUnchanged(const std::filesystem::path& directory, const SourceFile& sourceFile, int64_t& modificationTime);
+
+        /**
+         * @brief Overwrite the modification times of source files in the header of a cache file.
+         * @param[in] filename The name of the mesh file.
+         * @param[in] modificationTimes Pairs of file offset and new modification time.
+         * @return True if success, false otherwise.
+         * @details All other bytes of the cache file remain unchanged, such that concurrent readers never see an invalid cache file.
+         */
+        static bool UpdateModificationTimes(const std::string& filename, const std::vector<std::pair<uint64_t,int64_t>>& modificationTimes);
+
+        /**
+         * @brief Compute the FNV-1a hash of the content of a file.
+         * @param[in] filename The name of the file.
+         * @param[out] hash The hash.
+         * @return True if success, false otherwise.
+         */
+        static bool ComputeHash(const std::string& filename, uint64_t& hash);
+};
+
@@ -5,6 +5,7 @@
 #include <MeshLibraryBase.hpp>
 #include <Camera.hpp>
 #include <CuboidFrustumCuller.hpp>
+#include <Profiler.hpp>
 #include <ShaderMeshShadowDepth.hpp>
 #include <ShaderAlphaMeshShadowDepth.hpp>
 
@@ -60,7 +61,15 @@ class MeshLibrary: public MeshLibraryBase {
             }
         }
 
+        /**
+         * @brief Get the culling statistics of the latest view that has been drawn via @ref DrawMeshObjects.
+         * @return The number of visible and culled mesh objects. Shadow passes are not taken into account.
+         */
+        CullingStatistics GetCullingStatistics(void) const { return cullingStatistics; }
+
     protected:
+        CullingStatistics cullingStatistics;   // Culling statistics of the latest view that has been drawn via @ref DrawMeshObjects.
+
         /**
          * @brief Sort the mesh objects for rendering and obtain all color and texture meshes that are to be rendered.
          * @param[in] cameraPosition The world-space position of the camera to be used to sort the meshes for rendering.
@@ -76,10 +85,12 @@ class MeshLibrary: public MeshLibraryBase {
             std::vector<std::pair<MeshObject*,MeshData*>>& colorMeshes = std::get<0>(result);
             std::vector<std::pair<MeshObject*,MeshData*>>& textureMeshes = std::get<1>(result);
             std::vector<std::pair<MeshObject*,MeshData*>>& transparentTextureMeshes = std::get<2>(result);
+            PROFILE_ZONE("CullMeshes");
 
             // get all visible meshes and their distance to the camera
             std::vector<std::tuple<double,MeshObject*,MeshData*>> visibleMeshes;
             CuboidFrustumCuller culler(cameraProjectionView);
+            uint32_t numCulled = 0;
             for(auto& itObject : meshObjects){
                 // ignore invisible meshes (either for normal rendering or for shadow casting)
                 MeshObject* obj = itObject.second;
@@ -110,6 +121,7 @@ class MeshLibrary: public MeshLibraryBase {
                 AABB cuboid = data->data->GetAABBOfVertices();
                 cuboid.Transform(obj->GetModelMatrix());
                 if(!culler.IsVisible(cuboid)){
+                    numCulled++;
                     continue;
                 }
 
@@ -120,6 +132,10 @@ class MeshLibrary: public MeshLibraryBase {
 
             // sort visible meshes by their distance to the camera
             std::sort(visibleMeshes.begin(), visibleMeshes.end(), [](std::tuple<double,MeshObject*,MeshData*> a, std::tuple<double,MeshObject*,MeshData*> b){ return std::get<0>(a) < std::get<0>(b); });
+            if(!shadowCasting){
+                cullingStatistics.numVisible = static_cast<uint32_t>(visibleMeshes.size());
+                cullingStatistics.numCulled = numCulled;
+            }
 
             // insert to output
             for(auto&& visibleMesh : visibleMeshes){
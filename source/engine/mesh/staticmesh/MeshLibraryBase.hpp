@@ -10,9 +10,14 @@
 #include <MeshID.hpp>
 #include <MeshObject.hpp>
 #include <MeshMessage.hpp>
+#include <MeshPoseMessage.hpp>
 #include <MeshBase.hpp>
 #include <ColorMesh.hpp>
 #include <TextureMesh.hpp>
+#include <PoseHistory.hpp>
+#include <Profiler.hpp>
+#include <MeshCache.hpp>
+#include <PrismaConfiguration.hpp>
 
 
 /**
@@ -47,6 +52,15 @@ class MeshLibraryBase {
             shaderTextureMesh.Delete();
         }
 
+        /**
+         * @brief Get the number of meshes that wait to be loaded or that are currently being loaded by the loader thread.
+         * @return The number of pending mesh files. A mesh name that has been requested several times may be counted several times until the loader thread has picked it up.
+         */
+        uint32_t GetLoaderBacklog(void){
+            const std::lock_guard<std::mutex> lock(mtxMeshNamesToLoad);
+            return static_cast<uint32_t>(meshNamesToLoad.size()) + numMeshesLoading.load();
+        }
+
         /**
          * @brief Start the protection to protect the library against changes from the internal loading thread. End the protection via @ref EndProtection.
          * @details The library has to be protected when using @ref Clear and @ref ProcessMeshMessage.
@@ -70,6 +84,7 @@ class MeshLibraryBase {
                 delete it.second;
             }
             meshObjects.clear();
+            poseHistories.clear();
 
             // delete data
             for(auto& it : meshData){
@@ -109,6 +124,42 @@ class MeshLibraryBase {
             }
         }
 
+        /**
+         * @brief Process a mesh pose message to update the pose of existing mesh objects.
+         * @param[in] message The mesh pose message to be processed.
+         * @details Mesh IDs that do not refer to an existing mesh object are ignored.
+         * @note This function must be called from within the GL main thread. Make sure that the library is protected via @ref StartProtection / @ref EndProtection when calling this function.
+         */
+        void ProcessMeshPoseMessage(const MeshPoseMessage& message){
+            for(size_t i = 0; i < message.meshIDs.size(); ++i){
+                auto it = meshObjects.find(message.meshIDs[i]);
+                if(it == meshObjects.end()){
+                    continue;
+                }
+                it->second->position = message.positions[i];
+                it->second->quaternion = message.quaternions[i];
+                if(message.hasScale){
+                    it->second->scale = message.scales[i];
+                }
+                UpdatePoseHistory(message.meshIDs[i], message.hasTimestamp, message.timestamp, message.positions[i], message.quaternions[i]);
+            }
+        }
+
+        /**
+         * @brief Set the pose of all mesh objects with timestamped poses to the interpolated or extrapolated pose at a given time.
+         * @param[in] time The time in seconds (sender time base) for which to evaluate the poses.
+         * @param[in] maxExtrapolation The maximum time in seconds to extrapolate beyond the latest received pose.
+         * @note This function must be called from within the GL main thread. Make sure that the library is protected via @ref StartProtection / @ref EndProtection when calling this function.
+         */
+        void InterpolatePoses(double time, double maxExtrapolation){
+            for(auto&& it : poseHistories){
+                auto itObject = meshObjects.find(it.first);
+                if(itObject != meshObjects.end()){
+                    (void) it.second.Evaluate(time, maxExtrapolation, itObject->second->position, itObject->second->quaternion);
+                }
+            }
+        }
+
     protected:
         ShaderColorMesh shaderColorMesh;                   // The shader to render color meshes.
         ShaderTextureMesh shaderTextureMesh;               // The shader to render texture meshes.
@@ -116,6 +167,7 @@ class MeshLibraryBase {
         /* All mesh objects are stored in the @ref meshObjects container. They are indicated by a unique mesh ID. */
         /* The actual data such as VBOs, textures, etc. is stored in separate data containers. */
         std::unordered_map<MeshID, MeshObject*> meshObjects;   // List of all mesh objects.
+        std::unordered_map<MeshID, PoseHistory> poseHistories; // Pose histories of all mesh objects whose latest pose has been timestamped.
         struct MeshData {                                      // Represents the value of a mesh data entry.
             MeshBase* data;                                    // Mesh data.
             bool loaded;                                       // True if mesh data has been loaded from a file.
@@ -147,6 +199,24 @@ class MeshLibraryBase {
                 // delete object
                 delete itObject->second;
                 meshObjects.erase(itObject);
+                poseHistories.erase(meshID);
+            }
+        }
+
+        /**
+         * @brief Update the pose history of a mesh object.
+         * @param[in] meshID The unique mesh identifier of the mesh object.
+         * @param[in] hasTimestamp True if the pose is timestamped, false otherwise. The pose history is removed if the pose is not timestamped.
+         * @param[in] timestamp The time in seconds (sender time base) at which the pose is valid.
+         * @param[in] position The position of the mesh object.
+         * @param[in] quaternion The unit quaternion of the mesh object.
+         */
+        void UpdatePoseHistory(const MeshID meshID, bool hasTimestamp, double timestamp, glm::vec3 position, glm::vec4 quaternion){
+            if(hasTimestamp){
+                poseHistories[meshID].Insert(timestamp, position, quaternion);
+            }
+            else{
+                poseHistories.erase(meshID);
             }
         }
 
@@ -159,6 +229,7 @@ class MeshLibraryBase {
         void UpdateMeshObject(MeshObject* existingMesh, const MeshMessage& message){
             if((existingMesh->type == message.object.type) && (0 == message.object.name.compare(existingMesh->name))){
                 *existingMesh = message.object;
+                UpdatePoseHistory(message.meshID, message.hasTimestamp, message.timestamp, message.object.position, message.object.quaternion);
             }
         }
 
@@ -171,6 +242,7 @@ class MeshLibraryBase {
             MeshObject* newMesh = new MeshObject();
             *newMesh = message.object;
             meshObjects.insert({message.meshID, newMesh});
+            UpdatePoseHistory(message.meshID, message.hasTimestamp, message.timestamp, message.object.position, message.object.quaternion);
 
             // add mesh data if it does not exist or increment object counter if it exists
             auto itData = meshData.find(newMesh->name);
@@ -214,6 +286,7 @@ class MeshLibraryBase {
         std::vector<std::string> meshNamesToLoad;   // List of mesh messages to be loaded by the loader thread.
         std::mutex mtxMeshNamesToLoad;              // Protect the @ref messagesToLoad container.
         bool informMeshLoader;                      // Flag that indicates if something has been added to the mesh loader.
+        std::atomic<uint32_t> numMeshesLoading;     // Number of meshes that are currently being loaded by the loader thread.
 
         /**
          * @brief Start the mesh loader thread.
@@ -242,6 +315,7 @@ class MeshLibraryBase {
          * @brief The mesh loader thread function.
          */
         void MeshLoaderThread(void){
+            profiler.SetThreadName("mesh loader");
             while(!terminateThread){
                 // wait for something to be loaded
                 eventMeshLoader.Wait();
@@ -253,11 +327,13 @@ class MeshLibraryBase {
                 std::vector<std::string> meshNames;
                 mtxMeshNamesToLoad.lock();
                 meshNames.swap(meshNamesToLoad);
+                numMeshesLoading = static_cast<uint32_t>(meshNames.size());
                 mtxMeshNamesToLoad.unlock();
 
                 // make meshNames unique
                 std::sort(meshNames.begin(), meshNames.end());
                 meshNames.erase(std::unique(meshNames.begin(), meshNames.end()), meshNames.end());
+                numMeshesLoading = static_cast<uint32_t>(meshNames.size());
 
                 // load all meshes
                 std::vector<std::future<void>> asyncResults;
@@ -266,7 +342,9 @@ class MeshLibraryBase {
                 }
                 for(auto&& ar : asyncResults){
                     try{ ar.get(); } catch(...){}
+                    numMeshesLoading--;
                 }
+                numMeshesLoading = 0;
             }
         }
 
@@ -275,6 +353,7 @@ class MeshLibraryBase {
          * @param[in] meshName The mesh name that defines the mesh to be loaded.
          */
         void LoadMeshFromFile(std::string meshName){
+            profiler.SetThreadName("mesh worker");
             MeshBase* meshData = nullptr;
             if(StringHelper::EndsWith(meshName, ".ply")){
                 meshData = new ColorMesh();
@@ -297,10 +376,23 @@ class MeshLibraryBase {
          * @param[in] meshName The name of the mesh.
          * @param[in] mesh The mesh to be read.
          * @return True if success, false otherwise.
+         * @details If the mesh cache is enabled, the mesh is read from a valid mesh cache file without parsing. Otherwise the mesh file is parsed and the mesh cache file is (re)written.
          */
         bool LoadMeshData(std::string meshName, MeshBase* mesh) const {
             std::string filename = MeshNameToFilename(meshName);
-            return mesh->ReadFromFile(filename);
+            const bool enableMeshCache = prismaConfiguration.engine.enableMeshCache;
+            if(enableMeshCache && MeshCache::Read(filename, *mesh)){
+                return true;
+            }
+            bool success;
+            {
+                PROFILE_ZONE("ParseMesh");
+                success = mesh->ReadFromFile(filename);
+            }
+            if(success && enableMeshCache && !MeshCache::Write(filename, *mesh)){
+                PrintW("Could not write mesh cache file \"%s\"\n", MeshCache::GetCacheFilename(filename).c_str());
+            }
+            return success;
         }
 
         /**
@@ -56,11 +56,10 @@ class MeshObject {
         void SetTypeByName(void){
             type = MESH_TYPE_INVALID;
             if(NameIsValid()){
-                std::string lowerCase = StringHelper::ToLowerASCIICopy(name);
-                if(StringHelper::EndsWith(lowerCase,".ply")){
+                if(StringHelper::EndsWithIgnoreCaseASCII(name, ".ply")){
                     type = MESH_TYPE_COLORMESH;
                 }
-                else if(StringHelper::EndsWith(lowerCase,".obj")){
+                else if(StringHelper::EndsWithIgnoreCaseASCII(name, ".obj")){
                     type = MESH_TYPE_TEXTUREMESH;
                 }
             }
@@ -1,9 +1,12 @@
 #include <TextureMesh.hpp>
-#include <StringHelper.hpp>
+#include <MappedFile.hpp>
+#include <TextTokenizer.hpp>
 #include <ShaderTextureMesh.hpp>
+#include <Profiler.hpp>
 
 
 bool TextureMesh::Generate(void){
+    PROFILE_ZONE("UploadTextureMesh");
     for(auto&& submesh : submeshes){
         if(!submesh.Generate()){
             Delete();
@@ -52,135 +55,134 @@ bool TextureMesh::IsTransparent(void){
 bool TextureMesh::ReadFromFile(std::string filename){
     aabbVertices.Clear();
     submeshes.clear();
+    dependencies.clear();
     std::vector<TextureSubmesh> objects;
     try{
-        std::ifstream file(filename, std::ifstream::binary);
-        if(!file.is_open()){
+        MappedFile file;
+        if(!file.Open(filename)){
             PrintE("Could not open file \"%s\"!\n", filename.c_str());
             return false;
         }
+        TextTokenizer tokenizer(file.GetData(), file.GetSize());
         std::vector<TextureSubmeshMaterial> materials;
         std::vector<std::array<GLfloat,3>> v, vn;
         std::vector<std::array<GLfloat,2>> vt;
-        GLuint indexCounter = 0;
-        while(file.good()){
-            std::string line = ReadNextLine(file);
-            std::vector<std::string> words = StringHelper::SplitString(line);
-            if((words.empty()) || ('#' == words[0][0])){
+        std::unordered_map<ObjCorner, GLuint, ObjCornerHash> vertexIndices; // index of the welded vertex for each corner of the current object
+        while(tokenizer.NextLine()){
+            std::string_view keyword = tokenizer.NextWord();
+            if(keyword.empty() || ('#' == keyword[0])){
                 continue;
             }
-            if(0 == words[0].substr(0,6).compare("mtllib")){
-                std::string mtlFilename = line.substr(7);
+            if(keyword == "mtllib"){
                 std::filesystem::path p(filename);
-                p.replace_filename(mtlFilename);
+                p.replace_filename(std::string(tokenizer.GetRemainder()));
+                dependencies.push_back(p.string());
                 if(!ReadMaterialLibrary(materials, p.string())){
                     throw(0);
                 }
             }
-            else if(0 == words[0].compare("o")){
-                if(2 != words.size()){
+            else if(keyword == "o"){
+                if(tokenizer.NextWord().empty() || !tokenizer.IsEndOfLine()){
                     throw(0);
                 }
                 objects.push_back(TextureSubmesh());
-                indexCounter = 0;
+                vertexIndices.clear();
             }
-            else if(0 == words[0].compare("v")){
-                if((4 != words.size()) || objects.empty()){
+            else if(keyword == "v"){
+                std::array<GLfloat,3> position;
+                if(objects.empty() || !tokenizer.NextNumber(position[0]) || !tokenizer.NextNumber(position[1]) || !tokenizer.NextNumber(position[2]) || !tokenizer.IsEndOfLine()){
                     throw(0);
                 }
-                GLfloat x = static_cast<GLfloat>(std::stof(words[1]));
-                GLfloat y = static_cast<GLfloat>(std::stof(words[2]));
-                GLfloat z = static_cast<GLfloat>(std::stof(words[3]));
-                v.push_back({x, y, z});
+                v.push_back(position);
             }
-            else if(0 == words[0].compare("vn")){
-                if((4 != words.size()) || objects.empty()){
+            else if(keyword == "vn"){
+                std::array<GLfloat,3> normal;
+                if(objects.empty() || !tokenizer.NextNumber(normal[0]) || !tokenizer.NextNumber(normal[1]) || !tokenizer.NextNumber(normal[2]) || !tokenizer.IsEndOfLine()){
                     throw(0);
                 }
-                GLfloat x = static_cast<GLfloat>(std::stof(words[1]));
-                GLfloat y = static_cast<GLfloat>(std::stof(words[2]));
-                GLfloat z = static_cast<GLfloat>(std::stof(words[3]));
-                EnsureCorrectNormal(x, y, z);
-                vn.push_back({x, y, z});
+                EnsureCorrectNormal(normal[0], normal[1], normal[2]);
+                vn.push_back(normal);
             }
-            else if(0 == words[0].compare("vt")){
-                if((3 != words.size()) || objects.empty()){
+            else if(keyword == "vt"){
+                std::array<GLfloat,2> texCoord;
+                if(objects.empty() || !tokenizer.NextNumber(texCoord[0]) || !tokenizer.NextNumber(texCoord[1]) || !tokenizer.IsEndOfLine()){
                     throw(0);
                 }
-                GLfloat s = static_cast<GLfloat>(std::stof(words[1]));
-                GLfloat t = static_cast<GLfloat>(std::stof(words[2]));
-                vt.push_back({s, t});
+                vt.push_back(texCoord);
             }
-            else if(0 == words[0].compare("usemtl")){
-                if((2 != words.size()) || objects.empty()){
+            else if(keyword == "usemtl"){
+                std::string_view name = tokenizer.NextWord();
+                if(name.empty() || !tokenizer.IsEndOfLine() || objects.empty()){
                     throw(0);
                 }
-                int64_t i = GetMaterialIndex(materials, words[1]);
+                int64_t i = GetMaterialIndex(materials, name);
                 if(i < 0){
                     throw(0);
                 }
                 if(!objects.back().vertices.empty()){ // multiple materials for same object: create a new object instead
                     objects.push_back(TextureSubmesh());
-                    indexCounter = 0;
+                    vertexIndices.clear();
                 }
                 objects.back().material = materials[i];
             }
-            else if(0 == words[0].compare("f")){
-                if((4 != words.size()) || objects.empty()){
+            else if(keyword == "f"){
+                if(objects.empty()){
                     throw(0);
                 }
-                std::array<uint32_t,3> u1, u2, u3;
-                int n1, n2, n3;
-                if((3 != std::sscanf(words[1].c_str(),"%u/%u/%u%n",&u1[0],&u1[1],&u1[2],&n1)) || (3 != std::sscanf(words[2].c_str(),"%u/%u/%u%n",&u2[0],&u2[1],&u2[2],&n2)) || (3 != std::sscanf(words[3].c_str(),"%u/%u/%u%n",&u3[0],&u3[1],&u3[2],&n3))){
-                    throw(0);
+                // corners with identical position, texture coordinate and normal share the same vertex
+                std::vector<TextureMeshVertex>& vertices = objects.back().vertices;
+                GLuint i[3];
+                for(auto&& index : i){
+                    ObjCorner corner;
+                    if(!tokenizer.NextNumbers('/', corner)){
+                        throw(0);
+                    }
+                    if(!corner[0] || !corner[1] || !corner[2] || (corner[0] > v.size()) || (corner[1] > vt.size()) || (corner[2] > vn.size())){
+                        throw(0);
+                    }
+                    auto [it, inserted] = vertexIndices.try_emplace(corner, static_cast<GLuint>(vertices.size()));
+                    if(inserted){
+                        TextureMeshVertex vertex;
+                        vertex.position[0] = v[corner[0] - 1][0];
+                        vertex.position[1] = v[corner[0] - 1][1];
+                        vertex.position[2] = v[corner[0] - 1][2];
+                        vertex.texCoord[0] = vt[corner[1] - 1][0];
+                        vertex.texCoord[1] = vt[corner[1] - 1][1];
+                        vertex.normal[0] = vn[corner[2] - 1][0];
+                        vertex.normal[1] = vn[corner[2] - 1][1];
+                        vertex.normal[2] = vn[corner[2] - 1][2];
+                        vertex.tangent[0] = vertex.tangent[1] = vertex.tangent[2] = 0.0f;
+                        vertices.push_back(vertex);
+                    }
+                    index = it->second;
                 }
-                if((n1 != static_cast<int>(words[1].size())) || (n2 != static_cast<int>(words[2].size())) || (n3 != static_cast<int>(words[3].size()))){
+                if(!tokenizer.IsEndOfLine()){
                     throw(0);
                 }
-                TextureMeshVertex v1, v2, v3;
-                v1.position[0] = v[u1[0] - 1][0];
-                v1.position[1] = v[u1[0] - 1][1];
-                v1.position[2] = v[u1[0] - 1][2];
-                v1.texCoord[0] = vt[u1[1] - 1][0];
-                v1.texCoord[1] = vt[u1[1] - 1][1];
-                v1.normal[0] = vn[u1[2] - 1][0];
-                v1.normal[1] = vn[u1[2] - 1][1];
-                v1.normal[2] = vn[u1[2] - 1][2];
-                v2.position[0] = v[u2[0] - 1][0];
-                v2.position[1] = v[u2[0] - 1][1];
-                v2.position[2] = v[u2[0] - 1][2];
-                v2.texCoord[0] = vt[u2[1] - 1][0];
-                v2.texCoord[1] = vt[u2[1] - 1][1];
-                v2.normal[0] = vn[u2[2] - 1][0];
-                v2.normal[1] = vn[u2[2] - 1][1];
-                v2.normal[2] = vn[u2[2] - 1][2];
-                v3.position[0] = v[u3[0] - 1][0];
-                v3.position[1] = v[u3[0] - 1][1];
-                v3.position[2] = v[u3[0] - 1][2];
-                v3.texCoord[0] = vt[u3[1] - 1][0];
-                v3.texCoord[1] = vt[u3[1] - 1][1];
-                v3.normal[0] = vn[u3[2] - 1][0];
-                v3.normal[1] = vn[u3[2] - 1][1];
-                v3.normal[2] = vn[u3[2] - 1][2];
+
+                // accumulate the tangent of the face at all three vertices
+                TextureMeshVertex& v1 = vertices[i[0]];
+                TextureMeshVertex& v2 = vertices[i[1]];
+                TextureMeshVertex& v3 = vertices[i[2]];
                 glm::vec3 edge12(v2.position[0] - v1.position[0], v2.position[1] - v1.position[1], v2.position[2] - v1.position[2]);
                 glm::vec3 edge13(v3.position[0] - v1.position[0], v3.position[1] - v1.position[1], v3.position[2] - v1.position[2]);
                 glm::vec2 deltaUV12(v2.texCoord[0] - v1.texCoord[0], v2.texCoord[1] - v1.texCoord[1]);
                 glm::vec2 deltaUV13(v3.texCoord[0] - v1.texCoord[0], v3.texCoord[1] - v1.texCoord[1]);
                 GLfloat f = 1.0f / (deltaUV12.x * deltaUV13.y - deltaUV13.x * deltaUV12.y);
-                glm::vec3 tangent;
-                tangent.x = f * (deltaUV13.y * edge12.x - deltaUV12.y * edge13.x);
-                tangent.y = f * (deltaUV13.y * edge12.y - deltaUV12.y * edge13.y);
-                tangent.z = f * (deltaUV13.y * edge12.z - deltaUV12.y * edge13.z);
-                tangent = glm::normalize(tangent);
-                v1.tangent[0] = v2.tangent[0] = v3.tangent[0] = tangent.x;
-                v1.tangent[1] = v2.tangent[1] = v3.tangent[1] = tangent.y;
-                v1.tangent[2] = v2.tangent[2] = v3.tangent[2] = tangent.z;
-                objects.back().vertices.push_back(v1);
-                objects.back().vertices.push_back(v2);
-                objects.back().vertices.push_back(v3);
-                objects.back().indices.push_back(indexCounter++);
-                objects.back().indices.push_back(indexCounter++);
-                objects.back().indices.push_back(indexCounter++);
+                if(std::isfinite(f)){
+                    glm::vec3 tangent;
+                    tangent.x = f * (deltaUV13.y * edge12.x - deltaUV12.y * edge13.x);
+                    tangent.y = f * (deltaUV13.y * edge12.y - deltaUV12.y * edge13.y);
+                    tangent.z = f * (deltaUV13.y * edge12.z - deltaUV12.y * edge13.z);
+                    for(auto&& vertex : {&v1, &v2, &v3}){
+                        vertex->tangent[0] += tangent.x;
+                        vertex->tangent[1] += tangent.y;
+                        vertex->tangent[2] += tangent.z;
+                    }
+                }
+                objects.back().indices.push_back(i[0]);
+                objects.back().indices.push_back(i[1]);
+                objects.back().indices.push_back(i[2]);
             }
         }
     }
@@ -199,123 +201,191 @@ bool TextureMesh::ReadFromFile(std::string filename){
         }
     }
 
+    // orthonormalize the accumulated tangents
+    for(auto&& object : objects){
+        for(auto&& vertex : object.vertices){
+            EnsureCorrectTangent(vertex);
+        }
+    }
+
     // update submeshes and aabb
     submeshes.swap(objects);
     UpdateAABB();
     return true;
 }
 
+std::vector<std::string> TextureMesh::GetDependencies(void){
+    std::vector<std::string> filenames(dependencies);
+    std::sort(filenames.begin(), filenames.end());
+    filenames.erase(std::unique(filenames.begin(), filenames.end()), filenames.end());
+    return filenames;
+}
+
+bool TextureMesh::ReadFromCache(MeshCacheReader& reader){
+    aabbVertices.Clear();
+    submeshes.clear();
+    dependencies.clear();
+    glm::vec3 lowestPosition, dimension;
+    uint32_t numSubmeshes;
+    if(!reader.ReadVec3(lowestPosition) || !reader.ReadVec3(dimension) || !reader.Read(numSubmeshes)){
+        return false;
+    }
+    std::vector<TextureSubmesh> objects;
+    for(uint32_t n = 0; n < numSubmeshes; ++n){
+        objects.push_back(TextureSubmesh());
+        TextureSubmesh& object = objects.back();
+        TextureSubmeshMaterial& material = object.material;
+        bool success = reader.ReadString(material.name) && reader.Read(material.shininess);
+        success = success && reader.ReadVec3(material.diffuseColor) && reader.ReadVec3(material.specularColor) && reader.ReadVec3(material.emissionColor);
+        success = success && ReadTexture(reader, material.diffuseMap) && ReadTexture(reader, material.normalMap) && ReadTexture(reader, material.emissionMap) && ReadTexture(reader, material.specularMap);
+        success = success && reader.ReadArray(object.cachedVertices) && reader.ReadIndexArray(object.cachedIndices, object.cachedVertices.size());
+        if(!success || object.cachedVertices.empty() || object.cachedIndices.empty()){
+            return false;
+        }
+        object.cacheFile = reader.GetFile();
+    }
+    submeshes.swap(objects);
+    aabbVertices.lowestPosition = lowestPosition;
+    aabbVertices.dimension = dimension;
+    return true;
+}
+
+bool TextureMesh::WriteToCache(MeshCacheWriter& writer){
+    writer.WriteVec3(aabbVertices.lowestPosition);
+    writer.WriteVec3(aabbVertices.dimension);
+    writer.Write(static_cast<uint32_t>(submeshes.size()));
+    for(auto&& submesh : submeshes){
+        TextureSubmeshMaterial& material = submesh.material;
+        writer.WriteString(material.name);
+        writer.Write(material.shininess);
+        writer.WriteVec3(material.diffuseColor);
+        writer.WriteVec3(material.specularColor);
+        writer.WriteVec3(material.emissionColor);
+        if(!WriteTexture(writer, material.diffuseMap) || !WriteTexture(writer, material.normalMap) || !WriteTexture(writer, material.emissionMap) || !WriteTexture(writer, material.specularMap)){
+            return false;
+        }
+        writer.WriteArray(submesh.GetVertices());
+        writer.WriteArray(submesh.GetIndices());
+    }
+    return writer.IsGood();
+}
+
+bool TextureMesh::WriteTexture(MeshCacheWriter& writer, ImageTexture2D& texture){
+    if(!texture.LoadImageData()){
+        return false;
+    }
+    writer.Write(static_cast<uint32_t>(texture.GetWidth()));
+    writer.Write(static_cast<uint32_t>(texture.GetHeight()));
+    writer.Write(static_cast<uint8_t>(texture.ContainsAlpha()));
+    writer.Write(static_cast<uint8_t>(texture.IsTransparent()));
+    writer.WriteString(texture.GetSourceFilename());
+    writer.WriteArray(texture.GetImageData());
+    return true;
+}
+
+bool TextureMesh::ReadTexture(MeshCacheReader& reader, ImageTexture2D& texture){
+    uint32_t width, height;
+    uint8_t containsAlpha, isTransparent;
+    std::string sourceFilename;
+    std::span<const uint8_t> pixels;
+    if(!reader.Read(width) || !reader.Read(height) || !reader.Read(containsAlpha) || !reader.Read(isTransparent) || !reader.ReadString(sourceFilename) || !reader.ReadArray(pixels)){
+        return false;
+    }
+    return texture.SetMappedData(static_cast<GLuint>(width), static_cast<GLuint>(height), containsAlpha != 0, isTransparent != 0, pixels, reader.GetFile(), sourceFilename);
+}
+
 bool TextureMesh::ReadMaterialLibrary(std::vector<TextureSubmeshMaterial>& materials, std::string filename){
     try{
-        std::ifstream file(filename, std::ifstream::binary);
-        if(!file.is_open()){
+        MappedFile file;
+        if(!file.Open(filename)){
             PrintE("Could not open file \"%s\"!\n", filename.c_str());
             return false;
         }
+        TextTokenizer tokenizer(file.GetData(), file.GetSize());
+        auto nextColor = [&tokenizer](glm::vec3& color){
+            if(!tokenizer.NextNumber(color.r) || !tokenizer.NextNumber(color.g) || !tokenizer.NextNumber(color.b) || !tokenizer.IsEndOfLine()){
+                throw(0);
+            }
+        };
+        auto mapFilename = [this, &tokenizer, &filename](){
+            std::filesystem::path p(filename);
+            p.replace_filename(std::string(tokenizer.GetRemainder()));
+            dependencies.push_back(p.string());
+            return p.string();
+        };
         bool assignedKd = false;
         bool assignedKe = false;
         bool assignedKs = false;
-        while(file.good()){
-            std::string line = ReadNextLine(file);
-            std::vector<std::string> words = StringHelper::SplitString(line);
-            if((words.empty()) || ('#' == words[0][0])){
+        while(tokenizer.NextLine()){
+            std::string_view keyword = tokenizer.NextWord();
+            if(keyword.empty() || ('#' == keyword[0])){
                 continue;
             }
-            if(0 == words[0].compare("newmtl")){
-                if(2 != words.size()){
+            if(keyword == "newmtl"){
+                std::string_view name = tokenizer.NextWord();
+                if(name.empty() || !tokenizer.IsEndOfLine()){
                     throw(0);
                 }
                 materials.push_back(TextureSubmeshMaterial());
-                materials.back().name = words[1];
+                materials.back().name = name;
                 assignedKd = assignedKe = assignedKs = false;
             }
-            else if(0 == words[0].compare("Ns")){ // shininess
-                if(materials.empty() || (2 != words.size())){
+            else if(keyword == "Ns"){ // shininess
+                if(materials.empty() || !tokenizer.NextNumber(materials.back().shininess) || !tokenizer.IsEndOfLine()){
                     throw(0);
                 }
-                materials.back().shininess = std::stof(words[1]);
             }
-            else if(0 == words[0].compare("Ka")){ // ambient color: ignored
+            else if(keyword == "Ka"){ // ambient color: ignored
             }
-            else if(0 == words[0].compare("Ks")){ // specular color
-                if(materials.empty() || (4 != words.size())){
+            else if(keyword == "Ks"){ // specular color
+                if(materials.empty()){
                     throw(0);
                 }
-                materials.back().specularColor.r = std::stof(words[1]);
-                materials.back().specularColor.g = std::stof(words[2]);
-                materials.back().specularColor.b = std::stof(words[3]);
+                nextColor(materials.back().specularColor);
                 assignedKs = true;
             }
-            else if(0 == words[0].compare("Ke")){ // emission color
-                if(materials.empty() || (4 != words.size())){
+            else if(keyword == "Ke"){ // emission color
+                if(materials.empty()){
                     throw(0);
                 }
-                materials.back().emissionColor.r = std::stof(words[1]);
-                materials.back().emissionColor.g = std::stof(words[2]);
-                materials.back().emissionColor.b = std::stof(words[3]);
+                nextColor(materials.back().emissionColor);
                 assignedKe = true;
             }
-            else if(0 == words[0].compare("Kd")){ // diffuse color
-                if(materials.empty() || (4 != words.size())){
+            else if(keyword == "Kd"){ // diffuse color
+                if(materials.empty()){
                     throw(0);
                 }
-                materials.back().diffuseColor.r = std::stof(words[1]);
-                materials.back().diffuseColor.g = std::stof(words[2]);
-                materials.back().diffuseColor.b = std::stof(words[3]);
+                nextColor(materials.back().diffuseColor);
                 assignedKd = true;
             }
-            else if(0 == words[0].compare("d")){ // opacity: ignored
+            else if(keyword == "d"){ // opacity: ignored
             }
-            else if(0 == words[0].compare("map_Kd")){ // diffuse map
-                if(materials.empty()){
-                    throw(0);
-                }
-                std::string imageFilename = line.substr(words[0].length() + 1);
-                std::filesystem::path p(filename);
-                p.replace_filename(imageFilename);
-                if(!materials.back().diffuseMap.ReadFromPngFile(p.string(), true)){
+            else if(keyword == "map_Kd"){ // diffuse map
+                if(materials.empty() || !materials.back().ReadDiffuseMap(mapFilename())){
                     throw(0);
                 }
                 if(!assignedKd){
                     materials.back().diffuseColor = glm::vec3(1.0f);
                 }
             }
-            else if(0 == words[0].compare("map_Ke")){ // emission map
-                if(materials.empty()){
-                    throw(0);
-                }
-                std::string imageFilename = line.substr(words[0].length() + 1);
-                std::filesystem::path p(filename);
-                p.replace_filename(imageFilename);
-                if(!materials.back().emissionMap.ReadFromPngFile(p.string(), false)){
+            else if(keyword == "map_Ke"){ // emission map
+                if(materials.empty() || !materials.back().ReadEmissionMap(mapFilename())){
                     throw(0);
                 }
                 if(!assignedKe){
                     materials.back().emissionColor = glm::vec3(1.0f);
                 }
             }
-            else if(0 == words[0].compare("map_Ks")){ // specular map
-                if(materials.empty()){
-                    throw(0);
-                }
-                std::string imageFilename = line.substr(words[0].length() + 1);
-                std::filesystem::path p(filename);
-                p.replace_filename(imageFilename);
-                if(!materials.back().specularMap.ReadFromPngFile(p.string(), false)){
+            else if(keyword == "map_Ks"){ // specular map
+                if(materials.empty() || !materials.back().ReadSpecularMap(mapFilename())){
                     throw(0);
                 }
                 if(!assignedKs){
                     materials.back().specularColor = glm::vec3(1.0f);
                 }
             }
-            else if((0 == words[0].compare("norm")) || (0 == words[0].compare("map_Kn")) || (0 == words[0].compare("bump")) || (0 == words[0].compare("map_Bump"))){ // normal map
-                if(materials.empty()){
-                    throw(0);
-                }
-                std::string imageFilename = line.substr(words[0].length() + 1);
-                std::filesystem::path p(filename);
-                p.replace_filename(imageFilename);
-                if(!materials.back().normalMap.ReadFromPngFile(p.string(), false)){
+            else if((keyword == "norm") || (keyword == "map_Kn") || (keyword == "bump") || (keyword == "map_Bump")){ // normal map
+                if(materials.empty() || !materials.back().ReadNormalMap(mapFilename())){
                     throw(0);
                 }
             }
@@ -328,17 +398,10 @@ bool TextureMesh::ReadMaterialLibrary(std::vector<TextureSubmeshMaterial>& mater
     return true;
 }
 
-std::string TextureMesh::ReadNextLine(std::ifstream& file){
-    std::string line;
-    std::getline(file, line);
-    line.erase(std::remove_if(line.begin(), line.end(), [](char c){ return ('\r' == c) || ('\n' == c); }), line.end());
-    return line;
-}
-
-int64_t TextureMesh::GetMaterialIndex(const std::vector<TextureSubmeshMaterial>& materials, std::string name){
+int64_t TextureMesh::GetMaterialIndex(const std::vector<TextureSubmeshMaterial>& materials, std::string_view name){
     int64_t result = -1;
     for(int64_t i = 0; i < static_cast<int64_t>(materials.size()); ++i){
-        if(0 == materials[i].name.compare(name)){
+        if(materials[i].name == name){
             result = i;
             break;
         }
@@ -384,3 +447,19 @@ void TextureMesh::EnsureCorrectNormal(GLfloat& nx, GLfloat& ny, GLfloat& nz){
     }
 }
 
+void TextureMesh::EnsureCorrectTangent(TextureMeshVertex& vertex){
+    glm::vec3 n(vertex.normal[0], vertex.normal[1], vertex.normal[2]);
+    glm::vec3 t(vertex.tangent[0], vertex.tangent[1], vertex.tangent[2]);
+    t -= n * glm::dot(n, t);
+    GLfloat squaredLength = glm::dot(t, t);
+    if(std::isfinite(squaredLength) && (squaredLength > std::numeric_limits<GLfloat>::epsilon())){
+        t /= std::sqrt(squaredLength);
+    }
+    else{ // no texture coordinates: use any vector that is perpendicular to the normal vector
+        t = glm::normalize(glm::cross((std::fabs(n.x) < 0.9f) ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f), n));
+    }
+    vertex.tangent[0] = t.x;
+    vertex.tangent[1] = t.y;
+    vertex.tangent[2] = t.z;
+}
+
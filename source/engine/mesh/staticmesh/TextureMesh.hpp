@@ -56,6 +56,26 @@ class TextureMesh: public MeshBase {
          */
         bool ReadFromFile(std::string filename);
 
+        /**
+         * @brief Get the names of all material libraries and textures that have been read by @ref ReadFromFile.
+         * @return List of filenames.
+         */
+        std::vector<std::string> GetDependencies(void);
+
+        /**
+         * @brief Read mesh data from a mesh cache file without parsing. Vertices, indices and decoded textures are used in place until @ref Generate is called.
+         * @param[inout] reader The reader of the mesh cache file, positioned at the start of the mesh data.
+         * @return True if success, false otherwise.
+         */
+        bool ReadFromCache(MeshCacheReader& reader);
+
+        /**
+         * @brief Write the mesh data that has been read via @ref ReadFromFile to a mesh cache file.
+         * @param[inout] writer The writer of the mesh cache file, positioned at the start of the mesh data.
+         * @return True if success, false otherwise.
+         */
+        bool WriteToCache(MeshCacheWriter& writer);
+
         /**
          * @brief Check whether at least one diffuse map of this mesh contains at least one alpha value of less than 0xFF.
          * @return True if any alpha value of the diffuse map if less than 0xFF, false otherwise.
@@ -65,6 +85,23 @@ class TextureMesh: public MeshBase {
     private:
         std::vector<TextureSubmesh> submeshes;   // Container of submeshes.
         AABB aabbVertices;                       // The axis-aligned bounding box containing all vertices of all @ref submeshes.
+        std::vector<std::string> dependencies;   // Names of all material libraries and textures that have been read by @ref ReadFromFile.
+
+        /**
+         * @brief A face corner of an obj file given by the one-based indices of the position, the texture coordinate and
+         * the normal vector.
+         */
+        using ObjCorner = std::array<uint32_t,3>;
+
+        /**
+         * @brief Hash function for @ref ObjCorner.
+         */
+        struct ObjCornerHash {
+            size_t operator()(const ObjCorner& corner) const {
+                uint64_t h = (static_cast<uint64_t>(corner[0]) * 0x9E3779B97F4A7C15ull) ^ (static_cast<uint64_t>(corner[1]) * 0xC2B2AE3D27D4EB4Full) ^ (static_cast<uint64_t>(corner[2]) * 0x165667B19E3779F9ull);
+                return static_cast<size_t>(h ^ (h >> 29));
+            }
+        };
 
         /**
          * @brief Read the material library file.
@@ -74,20 +111,29 @@ class TextureMesh: public MeshBase {
          */
         bool ReadMaterialLibrary(std::vector<TextureSubmeshMaterial>& materials, std::string filename);
 
-        /**
-         * @brief Read the next line from the file.
-         * @param[in] file The open file from which to read.
-         * @return The line exluding <CR> and <LF>.
-         */
-        std::string ReadNextLine(std::ifstream& file);
-
         /**
          * @brief Get the index for a material with a specific name.
          * @param[in] materials The list of materials.
          * @param[in] name The name of the material for which to obtain the index.
          * @return Index to that material in the list that matches the given name or -1 if that material does not exist.
          */
-        int64_t GetMaterialIndex(const std::vector<TextureSubmeshMaterial>& materials, std::string name);
+        int64_t GetMaterialIndex(const std::vector<TextureSubmeshMaterial>& materials, std::string_view name);
+
+        /**
+         * @brief Write the decoded image data of a texture to a mesh cache file.
+         * @param[inout] writer The writer of the mesh cache file.
+         * @param[in] texture The texture to be written. Its png file is decoded if the decode has been skipped.
+         * @return True if success, false if the image data is not available.
+         */
+        static bool WriteTexture(MeshCacheWriter& writer, ImageTexture2D& texture);
+
+        /**
+         * @brief Read the decoded image data of a texture from a mesh cache file. The image data is used in place.
+         * @param[inout] reader The reader of the mesh cache file.
+         * @param[out] texture The texture to be read.
+         * @return True if success, false otherwise.
+         */
+        static bool ReadTexture(MeshCacheReader& reader, ImageTexture2D& texture);
 
         /**
          * @brief Update the @ref aabbVertices based on @ref submeshes.
@@ -99,5 +145,13 @@ class TextureMesh: public MeshBase {
          * @param[inout] nx x component of the normal vector.
          */
         void EnsureCorrectNormal(GLfloat& nx, GLfloat& ny, GLfloat& nz);
+
+        /**
+         * @brief Orthonormalize the accumulated tangent of a vertex with respect to its normal vector (Gram-Schmidt).
+         * @param[inout] vertex The vertex whose tangent is the sum of the tangents of all adjacent faces.
+         * @details If the tangent is undefined, e.g. due to missing texture coordinates, any vector perpendicular to the
+         * normal vector is used.
+         */
+        void EnsureCorrectTangent(TextureMeshVertex& vertex);
 };
 
@@ -4,6 +4,7 @@
 #include <Common.hpp>
 #include <TextureSubmeshMaterial.hpp>
 #include <ShaderTextureMesh.hpp>
+#include <MappedFile.hpp>
 
 
 #pragma pack(push, 1)
@@ -21,13 +22,16 @@ struct TextureMeshVertex {
  */
 class TextureSubmesh {
     public:
-        GLuint vao;                                // The vertex array object.
-        GLuint vbo;                                // The vertex buffer object.
-        GLuint ebo;                                // The element buffer object.
-        std::vector<TextureMeshVertex> vertices;   // List of vertices for this mesh.
-        std::vector<GLuint> indices;               // List of indices to vertices that describe triangles of the mesh.
-        GLsizei numIndices;                        // The number of indices to draw. This value is set by @ref GenerateGL.
-        TextureSubmeshMaterial material;           // The material for this mesh.
+        GLuint vao;                                         // The vertex array object.
+        GLuint vbo;                                         // The vertex buffer object.
+        GLuint ebo;                                         // The element buffer object.
+        std::vector<TextureMeshVertex> vertices;            // List of vertices for this mesh.
+        std::vector<GLuint> indices;                        // List of indices to vertices that describe triangles of the mesh.
+        GLsizei numIndices;                                 // The number of indices to draw. This value is set by @ref GenerateGL.
+        TextureSubmeshMaterial material;                    // The material for this mesh.
+        std::shared_ptr<MappedFile> cacheFile;              // The mesh cache file if the vertices and indices are used in place, nullptr otherwise.
+        std::span<const TextureMeshVertex> cachedVertices;  // Vertices in the mesh cache file.
+        std::span<const GLuint> cachedIndices;              // Indices in the mesh cache file.
 
         /**
          * @brief Construct a new submesh for a texture mesh.
@@ -44,7 +48,9 @@ class TextureSubmesh {
          * @return True if success, false otherwise.
          */
         bool Generate(void){
-            if(vertices.empty() || indices.empty()){
+            std::span<const TextureMeshVertex> vertexData = GetVertices();
+            std::span<const GLuint> indexData = GetIndices();
+            if(vertexData.empty() || indexData.empty()){
                 return false;
             }
             if(!material.Generate()){
@@ -55,9 +61,9 @@ class TextureSubmesh {
             DEBUG_GLCHECK( glGenBuffers(1, &ebo); );
             DEBUG_GLCHECK( glBindVertexArray(vao); );
                 DEBUG_GLCHECK( glBindBuffer(GL_ARRAY_BUFFER, vbo); );
-                DEBUG_GLCHECK( glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(TextureMeshVertex), &(vertices[0]), GL_STATIC_DRAW); );
+                DEBUG_GLCHECK( glBufferData(GL_ARRAY_BUFFER, vertexData.size_bytes(), vertexData.data(), GL_STATIC_DRAW); );
                 DEBUG_GLCHECK( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo); );
-                DEBUG_GLCHECK( glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), &(indices[0]), GL_STATIC_DRAW); );
+                DEBUG_GLCHECK( glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexData.size_bytes(), indexData.data(), GL_STATIC_DRAW); );
                 // Position attribute
                 DEBUG_GLCHECK( glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(TextureMeshVertex), (GLvoid*)0); );
                 DEBUG_GLCHECK( glEnableVertexAttribArray(0); );
@@ -71,12 +77,31 @@ class TextureSubmesh {
                 DEBUG_GLCHECK( glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(TextureMeshVertex), (GLvoid*)offsetof(TextureMeshVertex, texCoord)); );
                 DEBUG_GLCHECK( glEnableVertexAttribArray(3); );
             DEBUG_GLCHECK( glBindVertexArray(0); );
-            numIndices = static_cast<GLsizei>(indices.size());
+            numIndices = static_cast<GLsizei>(indexData.size());
             vertices.clear();
             indices.clear();
+            cacheFile.reset();
+            cachedVertices = {};
+            cachedIndices = {};
             return true;
         }
 
+        /**
+         * @brief Get the vertices that are going to be uploaded by @ref Generate.
+         * @return Either the vertices in the mesh cache file or @ref vertices.
+         */
+        std::span<const TextureMeshVertex> GetVertices(void) const {
+            return cacheFile ? cachedVertices : std::span<const TextureMeshVertex>(vertices);
+        }
+
+        /**
+         * @brief Get the indices that are going to be uploaded by @ref Generate.
+         * @return Either the indices in the mesh cache file or @ref indices.
+         */
+        std::span<const GLuint> GetIndices(void) const {
+            return cacheFile ? cachedIndices : std::span<const GLuint>(indices);
+        }
+
         /**
          * @brief Delete GL content.
          */
@@ -67,15 +67,47 @@ class TextureSubmeshMaterial {
             specularMap.BindTexture();
         }
 
+        /**
+         * @brief Read the diffuse map from a png file.
+         * @param[in] filename The png file from which to read the diffuse map.
+         * @return True if success, false otherwise.
+         * @details The png file is not decoded if a GL texture of it already exists with the options used by @ref Generate.
+         */
+        bool ReadDiffuseMap(std::string filename){ return ReadMap(diffuseMap, filename, true, prismaConfiguration.engine.convertSRGBToLinearRGB); }
+
+        /**
+         * @brief Read the normal map from a png file.
+         * @param[in] filename The png file from which to read the normal map.
+         * @return True if success, false otherwise.
+         * @details The png file is not decoded if a GL texture of it already exists with the options used by @ref Generate.
+         */
+        bool ReadNormalMap(std::string filename){ return ReadMap(normalMap, filename, false, false); }
+
+        /**
+         * @brief Read the emission map from a png file.
+         * @param[in] filename The png file from which to read the emission map.
+         * @return True if success, false otherwise.
+         * @details The png file is not decoded if a GL texture of it already exists with the options used by @ref Generate.
+         */
+        bool ReadEmissionMap(std::string filename){ return ReadMap(emissionMap, filename, false, false); }
+
+        /**
+         * @brief Read the specular map from a png file.
+         * @param[in] filename The png file from which to read the specular map.
+         * @return True if success, false otherwise.
+         * @details The png file is not decoded if a GL texture of it already exists with the options used by @ref Generate.
+         */
+        bool ReadSpecularMap(std::string filename){ return ReadMap(specularMap, filename, false, false); }
+
         /**
          * @brief Generate GL content and free memory.
          * @return True if success, false otherwise.
          */
         bool Generate(void){
-            bool success = diffuseMap.Generate(GL_REPEAT, GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR, true, true, prismaConfiguration.engine.convertSRGBToLinearRGB);
-            success &= normalMap.Generate(GL_REPEAT, GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR, true, true, false);
-            success &= emissionMap.Generate(GL_REPEAT, GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR, true, true, false);
-            success &= specularMap.Generate(GL_REPEAT, GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR, true, true, false);
+            bool success = GenerateMap(diffuseMap, prismaConfiguration.engine.convertSRGBToLinearRGB);
+            success &= GenerateMap(normalMap, false);
+            success &= GenerateMap(emissionMap, false);
+            success &= GenerateMap(specularMap, false);
             if(!success){
                 Delete();
             }
@@ -91,5 +123,28 @@ class TextureSubmeshMaterial {
             emissionMap.Delete();
             specularMap.Delete();
         }
+
+    private:
+        /**
+         * @brief Read a texture map from a png file for a later call to @ref GenerateMap.
+         * @param[inout] map The texture map to be read.
+         * @param[in] filename The png file from which to read the texture map.
+         * @param[in] useAlpha True if pixel format should contain alpha, false otherwise.
+         * @param[in] useSRGB True if SRGB or SRGB_ALPHA is going to be used as internal format.
+         * @return True if success, false otherwise.
+         */
+        static bool ReadMap(ImageTexture2D& map, std::string filename, bool useAlpha, bool useSRGB){
+            return map.ReadFromPngFile(filename, useAlpha, GL_REPEAT, GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR, true, true, useSRGB);
+        }
+
+        /**
+         * @brief Generate the GL content of a texture map.
+         * @param[inout] map The texture map to be generated.
+         * @param[in] useSRGB True if SRGB or SRGB_ALPHA should be used as internal format.
+         * @return True if success, false otherwise.
+         */
+        static bool GenerateMap(ImageTexture2D& map, bool useSRGB){
+            return map.Generate(GL_REPEAT, GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR, true, true, useSRGB);
+        }
 };
 
@@ -1,5 +1,5 @@
 #include <ImageTexture2D.hpp>
-#include <thirdparty/lodepng/lodepng.h>
+#include <Profiler.hpp>
 
 
 ImageTexture2D::ImageTexture2D(){
@@ -8,26 +8,22 @@ ImageTexture2D::ImageTexture2D(){
 }
 
 void ImageTexture2D::SetDefaultDataRGBA(std::array<uint8_t,4> pixelColorRGBA){
-    imageWidth = 1;
-    imageHeight = 1;
-    imageData.clear();
-    imageData.push_back(pixelColorRGBA[0]);
-    imageData.push_back(pixelColorRGBA[1]);
-    imageData.push_back(pixelColorRGBA[2]);
-    imageData.push_back(pixelColorRGBA[3]);
-    containsAlpha = true;
-    isTransparent = (pixelColorRGBA[3] < 0xFF);
+    SetDefaultData({pixelColorRGBA[0], pixelColorRGBA[1], pixelColorRGBA[2], pixelColorRGBA[3]});
 }
 
 void ImageTexture2D::SetDefaultDataRGB(std::array<uint8_t,3> pixelColorRGB){
+    SetDefaultData({pixelColorRGB[0], pixelColorRGB[1], pixelColorRGB[2]});
+}
+
+void ImageTexture2D::SetDefaultData(std::vector<uint8_t> pixel){
+    std::shared_ptr<std::vector<uint8_t>> data = std::make_shared<std::vector<uint8_t>>(std::move(pixel));
     imageWidth = 1;
     imageHeight = 1;
-    imageData.clear();
-    imageData.push_back(pixelColorRGB[0]);
-    imageData.push_back(pixelColorRGB[1]);
-    imageData.push_back(pixelColorRGB[2]);
-    containsAlpha = false;
-    isTransparent = false;
+    imageData = std::span<const uint8_t>(*data);
+    imageOwner = data;
+    containsAlpha = (4 == data->size());
+    isTransparent = containsAlpha && ((*data)[3] < 0xFF);
+    sourceFilename.clear();
 }
 
 bool ImageTexture2D::ReadFromPngFile(std::string filename, bool useAlpha){
@@ -37,43 +33,99 @@ bool ImageTexture2D::ReadFromPngFile(std::string filename, bool useAlpha){
     else{
         SetDefaultDataRGB({0,0,0});
     }
-    std::vector<uint8_t> pngPixels;
-    unsigned int pngWidth, pngHeight;
-    unsigned int error = lodepng::decode(pngPixels, pngWidth, pngHeight, filename, useAlpha ? LCT_RGBA : LCT_RGB, 8);
-    if(error){
-        PrintE("Could not read png file \"%s\" (error=%u)\n", filename.c_str(), error);
+    std::string canonicalFilename = TextureCache::GetCanonicalFilename(filename);
+    std::shared_ptr<const TextureImage> image = textureCache.ReadFromPngFile(canonicalFilename, useAlpha);
+    if(!image){
+        return false;
+    }
+    SetImage(image, canonicalFilename);
+    return true;
+}
+
+bool ImageTexture2D::ReadFromPngFile(std::string filename, bool useAlpha, GLenum textureWrapping, GLenum textureMinFilter, GLenum textureMaxFilter, bool generateMipmap, bool useAnisotropy, bool useSRGB){
+    std::string canonicalFilename = TextureCache::GetCanonicalFilename(filename);
+    std::shared_ptr<const TextureImage> reservation = textureCache.ReserveTexture(TextureCache::GetTextureKey(canonicalFilename, useAlpha, useSRGB, textureWrapping, textureMinFilter, textureMaxFilter, generateMipmap, useAnisotropy));
+    if(reservation){
+        SetImage(reservation, canonicalFilename);
+        return true;
+    }
+    return ReadFromPngFile(filename, useAlpha);
+}
+
+bool ImageTexture2D::LoadImageData(void){
+    if(!imageData.empty()){
+        return true;
+    }
+    if(sourceFilename.empty()){
         return false;
     }
-    imageWidth = static_cast<GLuint>(pngWidth);
-    imageHeight = static_cast<GLuint>(pngHeight);
-    imageData.clear();
-    size_t wn = static_cast<size_t>(useAlpha ? 4 : 3) * static_cast<size_t>(imageWidth);
-    size_t h = static_cast<size_t>(imageHeight);
-    for(size_t i = 0; i < h; ++i){
-        size_t iStart = (h - i - 1) * wn;
-        size_t iEnd = (h - i) * wn;
-        imageData.insert(imageData.end(), pngPixels.begin() + iStart, pngPixels.begin() + iEnd);
+    std::shared_ptr<const TextureImage> image = textureCache.ReadFromPngFile(sourceFilename, containsAlpha);
+    if(!image){
+        return false;
     }
-    CheckTransparency();
+    SetImage(image, sourceFilename);
     return true;
 }
 
-void ImageTexture2D::CheckTransparency(void){
-    isTransparent = false;
-    if(containsAlpha){
-        for(size_t n = 3; n < imageData.size(); n += 4){
-            isTransparent |= (imageData[n] < 0xFF);
-        }
+bool ImageTexture2D::SetMappedData(GLuint width, GLuint height, bool useAlpha, bool transparent, std::span<const uint8_t> pixels, std::shared_ptr<MappedFile> file, const std::string& canonicalFilename){
+    if(!width || !height || (pixels.size() != (static_cast<size_t>(useAlpha ? 4 : 3) * static_cast<size_t>(width) * static_cast<size_t>(height)))){
+        return false;
     }
+    imageWidth = width;
+    imageHeight = height;
+    imageData = pixels;
+    imageOwner = file;
+    containsAlpha = useAlpha;
+    isTransparent = useAlpha && transparent;
+    sourceFilename = canonicalFilename;
+    return true;
+}
+
+std::span<const uint8_t> ImageTexture2D::GetImageData(void){
+    return imageData;
+}
+
+std::string ImageTexture2D::GetSourceFilename(void){
+    return sourceFilename;
+}
+
+bool ImageTexture2D::ContainsAlpha(void){
+    return containsAlpha;
+}
+
+void ImageTexture2D::SetImage(std::shared_ptr<const TextureImage> image, const std::string& canonicalFilename){
+    imageWidth = image->width;
+    imageHeight = image->height;
+    imageData = std::span<const uint8_t>(image->pixels);
+    containsAlpha = image->containsAlpha;
+    isTransparent = image->isTransparent;
+    imageOwner = std::move(image);
+    sourceFilename = canonicalFilename;
+}
+
+void ImageTexture2D::ReleaseImageData(void){
+    imageData = {};
+    imageOwner.reset();
 }
 
 bool ImageTexture2D::Generate(GLenum textureWrapping, GLenum textureMinFilter, GLenum textureMaxFilter, bool generateMipmap, bool useAnisotropy, bool useSRGB){
-    if(imageData.empty()){
+    PROFILE_ZONE("UploadTexture");
+    textureCache.DeleteUnusedTextures();
+    if(!sourceFilename.empty()){ // share the GL texture with all textures of the same png file and options
+        textureKey = TextureCache::GetTextureKey(sourceFilename, containsAlpha, useSRGB, textureWrapping, textureMinFilter, textureMaxFilter, generateMipmap, useAnisotropy);
+        textureID = textureCache.AcquireTexture(textureKey);
+        if(textureID){
+            ReleaseImageData(); // also releases a reservation, the acquired reference keeps the GL texture
+            return true;
+        }
+    }
+    if(!LoadImageData()){ // only if a GL texture has been reserved for other options than these
+        textureKey.clear();
         return false;
     }
     DEBUG_GLCHECK( glGenTextures(1, &textureID); );
     DEBUG_GLCHECK( glBindTexture(GL_TEXTURE_2D, textureID); );
-    DEBUG_GLCHECK( glTexImage2D(GL_TEXTURE_2D, 0, (containsAlpha ? (useSRGB ? GL_SRGB_ALPHA : GL_RGBA) : (useSRGB ? GL_SRGB : GL_RGB)), imageWidth, imageHeight, 0, (containsAlpha ? GL_RGBA : GL_RGB), GL_UNSIGNED_BYTE, &imageData[0]); );
+    DEBUG_GLCHECK( glTexImage2D(GL_TEXTURE_2D, 0, (containsAlpha ? (useSRGB ? GL_SRGB_ALPHA : GL_RGBA) : (useSRGB ? GL_SRGB : GL_RGB)), imageWidth, imageHeight, 0, (containsAlpha ? GL_RGBA : GL_RGB), GL_UNSIGNED_BYTE, imageData.data()); );
     if(generateMipmap){
         DEBUG_GLCHECK( glGenerateMipmap(GL_TEXTURE_2D); );
     }
@@ -86,15 +138,25 @@ bool ImageTexture2D::Generate(GLenum textureWrapping, GLenum textureMinFilter, G
         DEBUG_GLCHECK( glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAnisotropy); );
         DEBUG_GLCHECK( glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, maxAnisotropy); );
     }
-    imageData.clear();
+    if(!textureKey.empty()){
+        textureCache.AddTexture(textureKey, textureID, imageWidth, imageHeight, containsAlpha, isTransparent);
+    }
+    ReleaseImageData();
     return true;
 }
 
 void ImageTexture2D::Delete(void){
     if(textureID){
-        DEBUG_GLCHECK( glDeleteTextures(1, &textureID); );
+        if(textureKey.empty() || textureCache.ReleaseTexture(textureKey)){
+            DEBUG_GLCHECK( glDeleteTextures(1, &textureID); );
+        }
         textureID = 0;
     }
+    textureKey.clear();
+    if(imageData.empty()){ // release a GL texture reservation of a texture that has never been generated
+        imageOwner.reset();
+    }
+    textureCache.DeleteUnusedTextures();
 }
 
 GLuint ImageTexture2D::GetWidth(void){
@@ -2,6 +2,8 @@
 
 
 #include <Common.hpp>
+#include <MappedFile.hpp>
+#include <TextureCache.hpp>
 
 
 class ImageTexture2D {
@@ -32,11 +34,65 @@ class ImageTexture2D {
          * @param[in] useAlpha True if pixel format should contain alpha, false otherwise.
          * @return True if success, false otherwise.
          * @details If this function fails, the image data represents a 1 pixel image with either RGB = {0,0,0} or RGBA = {0,0,0,0} depending on the useAlpha parameter.
+         * The image is decoded via the @ref textureCache, such that all textures of the same png file and pixel format share the decoded image and the GL texture.
          */
         bool ReadFromPngFile(std::string filename, bool useAlpha);
 
         /**
-         * @brief Generate the GL content and free memory (clear image data).
+         * @brief Read the image data from a png file for a later call to @ref Generate with given options.
+         * @param[in] filename The png file from which to read the data.
+         * @param[in] useAlpha True if pixel format should contain alpha, false otherwise.
+         * @param[in] textureWrapping Texture wrapping for s- and t-coordinates, e.g. GL_REPEAT.
+         * @param[in] textureMinFilter Texture filtering for GL_TEXTURE_MIN_FILTER, e.g. GL_LINEAR_MIPMAP_LINEAR.
+         * @param[in] textureMaxFilter Texture filtering for GL_TEXTURE_MAG_FILTER, e.g. GL_LINEAR.
+         * @param[in] generateMipmap True if mipmaps should be generated.
+         * @param[in] useAnisotropy True if anisotropic filtering should be enabled.
+         * @param[in] useSRGB True if SRGB or SRGB_ALPHA should be used as internal format.
+         * @return True if success, false otherwise.
+         * @details If a GL texture of the same png file and options already exists, it is reserved instead of decoding the png file, such that @ref Generate
+         * shares it without decoding. The image data then stays empty until @ref LoadImageData is called. Otherwise the png file is decoded like by @ref ReadFromPngFile.
+         */
+        bool ReadFromPngFile(std::string filename, bool useAlpha, GLenum textureWrapping, GLenum textureMinFilter, GLenum textureMaxFilter, bool generateMipmap, bool useAnisotropy, bool useSRGB);
+
+        /**
+         * @brief Decode the png file if a GL texture has been reserved by @ref ReadFromPngFile instead of decoding it.
+         * @return True if the image data is available, false otherwise.
+         */
+        bool LoadImageData(void);
+
+        /**
+         * @brief Use image data of a mapped file in place, e.g. pixels of a mesh cache file.
+         * @param[in] width Image width in pixels.
+         * @param[in] height Image height in pixels.
+         * @param[in] useAlpha True if the pixel format is RGBA, false if it is RGB.
+         * @param[in] transparent True if at least one pixel contains an alpha value of less than 0xFF.
+         * @param[in] pixels The image data, stored pixel by pixel with the first row being the bottom row of the image.
+         * @param[in] file The mapped file that contains the image data. It is released after the GL content has been generated.
+         * @param[in] canonicalFilename The canonical filename of the png file from which the image data has been decoded or an empty string. Textures with the same png file share the GL texture.
+         * @return True if success, false if the size of the image data does not match the image dimension.
+         */
+        bool SetMappedData(GLuint width, GLuint height, bool useAlpha, bool transparent, std::span<const uint8_t> pixels, std::shared_ptr<MappedFile> file, const std::string& canonicalFilename);
+
+        /**
+         * @brief Get the image data that is going to be uploaded by @ref Generate.
+         * @return The image data, stored pixel by pixel with the first row being the bottom row of the image.
+         */
+        std::span<const uint8_t> GetImageData(void);
+
+        /**
+         * @brief Get the canonical filename of the png file from which the image data has been read.
+         * @return The canonical filename or an empty string if the image data is default data.
+         */
+        std::string GetSourceFilename(void);
+
+        /**
+         * @brief Check whether the image data contains an alpha channel.
+         * @return True if the pixel format is RGBA, false if it is RGB.
+         */
+        bool ContainsAlpha(void);
+
+        /**
+         * @brief Generate the GL content and free memory (clear image data). If a GL texture with the same png file and the same options already exists, it is shared instead.
          * @param[in] textureWrapping Texture wrapping for s- and t-coordinates, e.g. GL_REPEAT.
          * @param[in] textureMinFilter Texture filtering for GL_TEXTURE_MIN_FILTER, e.g. GL_LINEAR_MIPMAP_LINEAR.
          * @param[in] textureMaxFilter Texture filtering for GL_TEXTURE_MAG_FILTER, e.g. GL_LINEAR.
@@ -48,7 +104,7 @@ class ImageTexture2D {
         bool Generate(GLenum textureWrapping, GLenum textureMinFilter, GLenum textureMaxFilter, bool generateMipmap, bool useAnisotropy, bool useSRGB);
 
         /**
-         * @brief Delete all GL content.
+         * @brief Delete all GL content. A shared GL texture is only deleted if it is not used by any other texture. A GL texture reservation is released.
          */
         void Delete(void);
 
@@ -76,17 +132,32 @@ class ImageTexture2D {
         GLuint GetHeight(void);
 
     private:
-        GLuint textureID;                 // The OpenGL texture ID.
-        GLuint imageWidth;                // Image width in pixels.
-        GLuint imageHeight;               // Image height in pixels.
-        std::vector<uint8_t> imageData;   // Image data stored as R,G,B,A and pixel by pixel.
-        bool containsAlpha;               // True if the @ref imageData contains alpha and has format RGBA, false otherwise.
-        bool isTransparent;               // True if there's at least one pixel in @ref imageData, that has an alpha of less than 0xFF.
+        GLuint textureID;                       // The OpenGL texture ID.
+        GLuint imageWidth;                      // Image width in pixels.
+        GLuint imageHeight;                     // Image height in pixels.
+        std::span<const uint8_t> imageData;     // Image data stored as R,G,B,A and pixel by pixel.
+        std::shared_ptr<const void> imageOwner; // Owner of the @ref imageData: default data, a decoded image or a GL texture reservation of the @ref textureCache or a mapped mesh cache file.
+        bool containsAlpha;                     // True if the @ref imageData contains alpha and has format RGBA, false otherwise.
+        bool isTransparent;                     // True if there's at least one pixel in @ref imageData, that has an alpha of less than 0xFF.
+        std::string sourceFilename;             // Canonical filename of the png file from which @ref imageData has been read or empty for default data.
+        std::string textureKey;                 // Key of the shared GL texture in the @ref textureCache or empty if the GL texture is not shared.
+
+        /**
+         * @brief Set default data for the 2D texture.
+         * @param[in] pixel The values of the one pixel, either R,G,B or R,G,B,A.
+         */
+        void SetDefaultData(std::vector<uint8_t> pixel);
+
+        /**
+         * @brief Use the pixels of an image of the @ref textureCache.
+         * @param[in] image The image that becomes the @ref imageOwner. It contains no pixels if it is a GL texture reservation.
+         * @param[in] canonicalFilename The canonical filename of the png file from which the image has been read.
+         */
+        void SetImage(std::shared_ptr<const TextureImage> image, const std::string& canonicalFilename);
 
         /**
-         * @brief Check whether at least one pixel in @ref imageData contains an alpha value of less than 0xFF.
-         * @details This member function sets the @ref isTransparent flag.
+         * @brief Release the @ref imageData and its @ref imageOwner.
          */
-        void CheckTransparency(void);
+        void ReleaseImageData(void);
 };
 
@@ -0,0 +1,161 @@
+#include <TextureCache.hpp>
+#include <Profiler.hpp>
+#include <thirdparty/lodepng/lodepng.h>
+
+
+TextureCache textureCache;
+
+
+std::string TextureCache::GetCanonicalFilename(const std::string& filename){
+    std::error_code ec;
+    std::filesystem::path p = std::filesystem::weakly_canonical(std::filesystem::path(filename), ec);
+    return ec ? filename : p.generic_string();
+}
+
+std::string TextureCache::GetTextureKey(const std::string& canonicalFilename, bool useAlpha, bool useSRGB, GLenum textureWrapping, GLenum textureMinFilter, GLenum textureMaxFilter, bool generateMipmap, bool useAnisotropy){
+    char options[128];
+    std::snprintf(options, sizeof(options), "|%s|%d|%u|%u|%u|%d|%d", useAlpha ? "rgba" : "rgb", useSRGB ? 1 : 0, static_cast<unsigned>(textureWrapping), static_cast<unsigned>(textureMinFilter), static_cast<unsigned>(textureMaxFilter), generateMipmap ? 1 : 0, useAnisotropy ? 1 : 0);
+    return canonicalFilename + options;
+}
+
+std::shared_ptr<const TextureImage> TextureCache::ReadFromPngFile(const std::string& canonicalFilename, bool useAlpha){
+    std::string key = GetImageKey(canonicalFilename, useAlpha);
+    std::shared_ptr<ImageEntry> entry;
+    mtxImages.lock();
+    for(auto it = images.begin(); it != images.end();){ // remove entries whose images are no longer used by anyone
+        if((1 == it->second.use_count()) && it->second->image.expired()){
+            it = images.erase(it);
+        }
+        else{
+            ++it;
+        }
+    }
+    auto [it, inserted] = images.try_emplace(key);
+    if(inserted){
+        it->second = std::make_shared<ImageEntry>();
+    }
+    entry = it->second;
+    mtxImages.unlock();
+
+    // a concurrent request for the same image waits here until the image has been decoded
+    const std::lock_guard<std::mutex> lock(entry->mtx);
+    std::shared_ptr<const TextureImage> image = entry->image.lock();
+    if(!image){
+        image = DecodePngFile(canonicalFilename, useAlpha);
+        entry->image = image;
+    }
+    return image;
+}
+
+std::shared_ptr<const TextureImage> TextureCache::ReserveTexture(const std::string& key){
+    const std::lock_guard<std::mutex> lock(mtxTextures);
+    auto it = textures.find(key);
+    if(it == textures.end()){
+        return nullptr;
+    }
+    it->second.numReferences++;
+    return std::shared_ptr<const TextureImage>(new TextureImage(it->second.header), [this, key](const TextureImage* header){
+        delete header;
+        ReleaseReservation(key);
+    });
+}
+
+GLuint TextureCache::AcquireTexture(const std::string& key){
+    const std::lock_guard<std::mutex> lock(mtxTextures);
+    auto it = textures.find(key);
+    if(it == textures.end()){
+        return 0;
+    }
+    it->second.numReferences++;
+    return it->second.textureID;
+}
+
+void TextureCache::AddTexture(const std::string& key, GLuint textureID, GLuint width, GLuint height, bool containsAlpha, bool isTransparent){
+    const std::lock_guard<std::mutex> lock(mtxTextures);
+    TextureEntry& entry = textures[key];
+    entry.textureID = textureID;
+    entry.numReferences = 1;
+    entry.header.width = width;
+    entry.header.height = height;
+    entry.header.containsAlpha = containsAlpha;
+    entry.header.isTransparent = isTransparent;
+}
+
+bool TextureCache::ReleaseTexture(const std::string& key){
+    const std::lock_guard<std::mutex> lock(mtxTextures);
+    auto it = textures.find(key);
+    if(it == textures.end()){
+        return true;
+    }
+    if(--it->second.numReferences){
+        return false;
+    }
+    textures.erase(it);
+    return true;
+}
+
+void TextureCache::DeleteUnusedTextures(void){
+    const std::lock_guard<std::mutex> lock(mtxTextures);
+    for(auto it = textures.begin(); it != textures.end();){
+        if(!it->second.numReferences){
+            DEBUG_GLCHECK( glDeleteTextures(1, &it->second.textureID); );
+            it = textures.erase(it);
+        }
+        else{
+            ++it;
+        }
+    }
+}
+
+size_t TextureCache::GetNumImages(void){
+    const std::lock_guard<std::mutex> lock(mtxImages);
+    size_t numImages = 0;
+    for(auto&& it : images){
+        numImages += it.second->image.expired() ? 0 : 1;
+    }
+    return numImages;
+}
+
+size_t TextureCache::GetNumTextures(void){
+    const std::lock_guard<std::mutex> lock(mtxTextures);
+    return textures.size();
+}
+
+void TextureCache::ReleaseReservation(const std::string& key){
+    const std::lock_guard<std::mutex> lock(mtxTextures);
+    auto it = textures.find(key);
+    if((it != textures.end()) && it->second.numReferences){
+        it->second.numReferences--;
+    }
+}
+
+std::shared_ptr<const TextureImage> TextureCache::DecodePngFile(const std::string& filename, bool useAlpha){
+    PROFILE_ZONE("DecodePNG");
+    std::vector<uint8_t> pngPixels;
+    unsigned int pngWidth, pngHeight;
+    unsigned int error = lodepng::decode(pngPixels, pngWidth, pngHeight, filename, useAlpha ? LCT_RGBA : LCT_RGB, 8);
+    if(error){
+        PrintE("Could not read png file \"%s\" (error=%u)\n", filename.c_str(), error);
+        return nullptr;
+    }
+    std::shared_ptr<TextureImage> image = std::make_shared<TextureImage>();
+    image->width = static_cast<GLuint>(pngWidth);
+    image->height = static_cast<GLuint>(pngHeight);
+    image->containsAlpha = useAlpha;
+    image->isTransparent = false;
+    size_t wn = static_cast<size_t>(useAlpha ? 4 : 3) * static_cast<size_t>(image->width);
+    size_t h = static_cast<size_t>(image->height);
+    image->pixels.reserve(wn * h);
+    for(size_t i = 0; i < h; ++i){
+        size_t iStart = (h - i - 1) * wn;
+        size_t iEnd = (h - i) * wn;
+        image->pixels.insert(image->pixels.end(), pngPixels.begin() + iStart, pngPixels.begin() + iEnd);
+    }
+    if(useAlpha){
+        for(size_t n = 3; n < image->pixels.size(); n += 4){
+            image->isTransparent |= (image->pixels[n] < 0xFF);
+        }
+    }
+    return image;
+}
+
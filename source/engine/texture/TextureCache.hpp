@@ -0,0 +1,156 @@
+#pragma once
+
+
+#include <Common.hpp>
+
+
+/**
+ * @brief A decoded image that is shared by all textures that have been read from the same png file with the same pixel format.
+ */
+struct TextureImage {
+    GLuint width;                   // Image width in pixels.
+    GLuint height;                  // Image height in pixels.
+    bool containsAlpha;             // True if the @ref pixels have format RGBA, false if they have format RGB.
+    bool isTransparent;             // True if at least one pixel has an alpha value of less than 0xFF.
+    std::vector<uint8_t> pixels;    // Image data stored pixel by pixel with the first row being the bottom row of the image. Empty if the decode has been skipped, see @ref TextureCache::ReserveTexture.
+};
+
+
+/**
+ * @brief Process-wide cache of decoded png images and GL textures, such that a png file that is used by several materials
+ * or meshes is decoded and uploaded only once.
+ * @details Decoded images are keyed by the canonical filename and the pixel format (RGB or RGBA). They are reference-counted
+ * via std::shared_ptr and removed from the cache as soon as no texture refers to them anymore, i.e. after all textures
+ * have been uploaded. GL textures are additionally keyed by all upload options (sRGB, wrapping, filtering, mipmaps,
+ * anisotropy). They are reference-counted explicitly and must be deleted by the caller when the last reference has been
+ * released. A texture that is going to be generated with the options of an existing GL texture can reserve that GL
+ * texture instead of decoding the png file, which keeps the GL texture alive until the texture has been generated.
+ * Decoding is thread-safe, where concurrent requests for the same image wait for a single decode.
+ */
+class TextureCache {
+    public:
+        /**
+         * @brief Get the canonical filename of a file, which is used to identify the file independent of the path via which it has been referenced.
+         * @param[in] filename The name of the file.
+         * @return The canonical filename or @p filename if it cannot be resolved.
+         */
+        static std::string GetCanonicalFilename(const std::string& filename);
+
+        /**
+         * @brief Get the key of a GL texture.
+         * @param[in] canonicalFilename The canonical filename of the png file.
+         * @param[in] useAlpha True if the pixel format is RGBA, false if it is RGB.
+         * @param[in] useSRGB True if SRGB or SRGB_ALPHA is used as internal format.
+         * @param[in] textureWrapping Texture wrapping for s- and t-coordinates.
+         * @param[in] textureMinFilter Texture filtering for GL_TEXTURE_MIN_FILTER.
+         * @param[in] textureMaxFilter Texture filtering for GL_TEXTURE_MAG_FILTER.
+         * @param[in] generateMipmap True if mipmaps are generated.
+         * @param[in] useAnisotropy True if anisotropic filtering is enabled.
+         * @return The key of the GL texture.
+         */
+        static std::string GetTextureKey(const std::string& canonicalFilename, bool useAlpha, bool useSRGB, GLenum textureWrapping, GLenum textureMinFilter, GLenum textureMaxFilter, bool generateMipmap, bool useAnisotropy);
+
+        /**
+         * @brief Read a png file or get the image that has already been decoded for the same file and pixel format.
+         * @param[in] canonicalFilename The canonical filename of the png file.
+         * @param[in] useAlpha True if the pixel format should be RGBA, false if it should be RGB.
+         * @return The decoded image or nullptr if the png file could not be read.
+         */
+        std::shared_ptr<const TextureImage> ReadFromPngFile(const std::string& canonicalFilename, bool useAlpha);
+
+        /**
+         * @brief Reserve a GL texture that has already been generated, such that it is not deleted before a texture with the same key acquires it via @ref AcquireTexture.
+         * @param[in] key The key of the GL texture, see @ref GetTextureKey.
+         * @return The image without pixels or nullptr if there is no GL texture for that key. The GL texture is reserved as long as the returned image exists.
+         * @details This function can be called from any thread, e.g. from a mesh loader thread instead of decoding the png file.
+         */
+        std::shared_ptr<const TextureImage> ReserveTexture(const std::string& key);
+
+        /**
+         * @brief Get a GL texture that has already been generated and increment its reference counter.
+         * @param[in] key The key of the GL texture, see @ref GetTextureKey.
+         * @return The GL texture ID or zero if there is no GL texture for that key.
+         * @note This function must be called from within the GL main thread.
+         */
+        GLuint AcquireTexture(const std::string& key);
+
+        /**
+         * @brief Add a GL texture that has just been generated with a reference counter of one.
+         * @param[in] key The key of the GL texture, see @ref GetTextureKey.
+         * @param[in] textureID The GL texture ID.
+         * @param[in] width Image width in pixels.
+         * @param[in] height Image height in pixels.
+         * @param[in] containsAlpha True if the pixel format is RGBA, false if it is RGB.
+         * @param[in] isTransparent True if at least one pixel has an alpha value of less than 0xFF.
+         * @note This function must be called from within the GL main thread.
+         */
+        void AddTexture(const std::string& key, GLuint textureID, GLuint width, GLuint height, bool containsAlpha, bool isTransparent);
+
+        /**
+         * @brief Decrement the reference counter of a GL texture.
+         * @param[in] key The key of the GL texture, see @ref GetTextureKey.
+         * @return True if the last reference has been released and the GL texture must be deleted by the caller, false otherwise.
+         * @note This function must be called from within the GL main thread.
+         */
+        bool ReleaseTexture(const std::string& key);
+
+        /**
+         * @brief Delete all GL textures whose last reference has been released by a reservation, see @ref ReserveTexture.
+         * @note This function must be called from within the GL main thread.
+         */
+        void DeleteUnusedTextures(void);
+
+        /**
+         * @brief Get the number of decoded images that are currently shared.
+         * @return Number of decoded images.
+         */
+        size_t GetNumImages(void);
+
+        /**
+         * @brief Get the number of GL textures that are currently shared.
+         * @return Number of GL textures.
+         */
+        size_t GetNumTextures(void);
+
+    private:
+        struct ImageEntry {
+            std::mutex mtx;                             // Protects @ref image and serializes the decoding of this entry.
+            std::weak_ptr<const TextureImage> image;    // The decoded image if at least one texture refers to it.
+        };
+        struct TextureEntry {
+            GLuint textureID;                           // The GL texture ID.
+            uint32_t numReferences;                     // Number of textures and reservations that use the GL texture. Zero if the GL texture is to be deleted by @ref DeleteUnusedTextures.
+            TextureImage header;                        // Dimension and transparency of the image without pixels.
+        };
+        std::unordered_map<std::string, std::shared_ptr<ImageEntry>> images;   // Decoded images by canonical filename and pixel format.
+        std::unordered_map<std::string, TextureEntry> textures;                 // GL textures by @ref GetTextureKey.
+        std::mutex mtxImages;                                                   // Protects @ref images.
+        std::mutex mtxTextures;                                                 // Protects @ref textures.
+
+        /**
+         * @brief Get the key of a decoded image.
+         * @param[in] canonicalFilename The canonical filename of the png file.
+         * @param[in] useAlpha True if the pixel format is RGBA, false if it is RGB.
+         * @return The key of the decoded image.
+         */
+        static std::string GetImageKey(const std::string& canonicalFilename, bool useAlpha){ return canonicalFilename + (useAlpha ? "|rgba" : "|rgb"); }
+
+        /**
+         * @brief Release a reservation that has been made via @ref ReserveTexture.
+         * @param[in] key The key of the GL texture, see @ref GetTextureKey.
+         * @details The GL texture is not deleted, even if this was the last reference, because the reservation may be released from any thread.
+         */
+        void ReleaseReservation(const std::string& key);
+
+        /**
+         * @brief Decode a png file.
+         * @param[in] filename The name of the png file.
+         * @param[in] useAlpha True if the pixel format should be RGBA, false if it should be RGB.
+         * @return The decoded image with the rows flipped vertically or nullptr if the png file could not be read.
+         */
+        static std::shared_ptr<const TextureImage> DecodePngFile(const std::string& filename, bool useAlpha);
+};
+
+
+extern TextureCache textureCache;
+
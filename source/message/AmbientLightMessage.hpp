@@ -60,5 +60,11 @@ class AmbientLightMessage: public MessageBaseType {
         bool IsValid(void){
             return std::isfinite(ambientLight.color.r) && std::isfinite(ambientLight.color.g) && std::isfinite(ambientLight.color.b);
         }
+
+        /**
+         * @brief Get the key that identifies the state that is set by this message.
+         * @return The coalescing key of this message.
+         */
+        uint64_t GetCoalescingKey(void) const { return MakeCoalescingKey(0); }
 };
 
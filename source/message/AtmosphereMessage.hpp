@@ -173,5 +173,11 @@ class AtmosphereMessage: public MessageBaseType {
             valid &= std::isfinite(atmosphereProperties.depthBlendOutDistanceRange);
             return valid;
         }
+
+        /**
+         * @brief Get the key that identifies the state that is set by this message.
+         * @return The coalescing key of this message.
+         */
+        uint64_t GetCoalescingKey(void) const { return MakeCoalescingKey(0); }
 };
 
@@ -14,7 +14,8 @@
 union CameraMessageUnion {
     struct CameraMessageStruct {
         uint8_t messageType;              // Message type, must be @ref MESSAGE_TYPE_CAMERA.
-        uint8_t mode;                     // The camera mode.
+        uint8_t mode:7;                   // bit0-bit6: The camera mode.
+        uint8_t hasTimestamp:1;           // bit7: True if a 64-bit floating-point timestamp follows the camera data, false otherwise.
         GLfloat position[3];              // The position in world space coordinates.
         GLfloat quaternion[4];            // The unit quaternion representing the orientation of the camera (stored as x,y,z,w).
         GLfloat clipNear;                 // The near clipping plane.
@@ -24,6 +25,7 @@ union CameraMessageUnion {
         GLfloat orthographicBottom;       // The bottom border limit for orthographic projection.
         GLfloat orthographicTop;          // The top border limit for orthographic projection.
         GLfloat perspectiveFieldOfView;   // The field of view angle in radians for perspective projection.
+        // optional timestamp
     } protocol;
     uint8_t bytes[sizeof(CameraMessageUnion::CameraMessageStruct)];
 };
@@ -36,11 +38,16 @@ union CameraMessageUnion {
 class CameraMessage: public MessageBaseType {
     public:
         CameraProperties camera;   // The properties of the camera.
+        bool hasTimestamp;         // True if the pose of the camera is timestamped, false otherwise.
+        double timestamp;          // The time in seconds (sender time base) at which the pose is valid. Only valid if @ref hasTimestamp is true.
 
         /**
          * @brief Construct a new camera message.
          */
-        CameraMessage(): MessageBaseType(MESSAGE_TYPE_CAMERA){}
+        CameraMessage(): MessageBaseType(MESSAGE_TYPE_CAMERA){
+            hasTimestamp = false;
+            timestamp = 0.0;
+        }
 
         /**
          * @brief Deserialize the message.
@@ -57,6 +64,7 @@ class CameraMessage: public MessageBaseType {
                 return 0;
             }
             camera.mode = static_cast<CameraMode>(msg->protocol.mode);
+            hasTimestamp = static_cast<bool>(msg->protocol.hasTimestamp);
             camera.position.x             = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.position[0]);
             camera.position.y             = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.position[1]);
             camera.position.z             = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.position[2]);
@@ -71,7 +79,16 @@ class CameraMessage: public MessageBaseType {
             camera.orthographicBottom     = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.orthographicBottom);
             camera.orthographicTop        = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.orthographicTop);
             camera.perspectiveFieldOfView = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.perspectiveFieldOfView);
-            return static_cast<int32_t>(sizeof(CameraMessageUnion));
+            int32_t result = static_cast<int32_t>(sizeof(CameraMessageUnion));
+            timestamp = 0.0;
+            if(hasTimestamp){
+                if(length < (result + static_cast<int32_t>(sizeof(double)))){
+                    return 0;
+                }
+                timestamp = NetworkUtils::ReadNetworkByteOrder<double>(&bytes[result]);
+                result += static_cast<int32_t>(sizeof(double));
+            }
+            return result;
         }
 
         /**
@@ -94,7 +111,14 @@ class CameraMessage: public MessageBaseType {
             valid &= std::isfinite(camera.orthographicBottom);
             valid &= std::isfinite(camera.orthographicTop);
             valid &= std::isfinite(camera.perspectiveFieldOfView);
+            valid &= !hasTimestamp || std::isfinite(timestamp);
             return valid;
         }
+
+        /**
+         * @brief Get the key that identifies the state that is set by this message.
+         * @return The coalescing key of this message.
+         */
+        uint64_t GetCoalescingKey(void) const { return MakeCoalescingKey(0); }
 };
 
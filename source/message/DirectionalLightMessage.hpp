@@ -84,5 +84,11 @@ class DirectionalLightMessage: public MessageBaseType {
             valid &= std::isfinite(directionalLight.direction.z);
             return valid;
         }
+
+        /**
+         * @brief Get the key that identifies the state that is set by this message.
+         * @return The coalescing key of this message.
+         */
+        uint64_t GetCoalescingKey(void) const { return MakeCoalescingKey(directionalLightID); }
 };
 
@@ -5,6 +5,7 @@
 #include <DynamicMeshID.hpp>
 #include <MessageBaseType.hpp>
 #include <DynamicMeshProperties.hpp>
+#include <DynamicMesh.hpp>
 #include <AABB.hpp>
 #include <NetworkUtils.hpp>
 
@@ -21,7 +22,8 @@ union DynamicMeshMessageUnion {
         uint8_t updateMesh:1;                     // bit1: True if the mesh should be updated, false otherwise.
         uint8_t visible:1;                        // bit2: True if the mesh should be visible, false otherwise.
         uint8_t castShadow:1;                     // bit3: True if this mesh casts a shadow, false otherwise.
-        uint8_t unused:4;                         // bit4-bit7: unused.
+        uint8_t hasTimestamp:1;                   // bit4: True if a 64-bit floating-point timestamp follows the header, false otherwise.
+        uint8_t unused:3;                         // bit5-bit7: unused.
         GLfloat position[3];                      // Position in OpenGL world space coordinates.
         glm::vec4 quaternion;                     // Unit quaternion that represents the orientation of this mesh.
         GLfloat scale[3];                         // Scaling of this mesh object in body frame coordinates.
@@ -29,7 +31,7 @@ union DynamicMeshMessageUnion {
         GLfloat specularColorMultiplier[3];       // Specular color multiplier for this mesh.
         GLfloat emissionColorMultiplier[3];       // Emission color multiplier for this mesh.
         GLfloat shininessMultiplier;              // Shininess multiplier for this mesh.
-        // variable mesh data
+        // optional timestamp, variable mesh data
     } protocol;
     uint8_t bytes[sizeof(DynamicMeshMessageUnion::DynamicMeshMessageStruct)];
 };
@@ -56,15 +58,19 @@ class DynamicMeshMessage: public MessageBaseType {
         bool shouldBeDeleted;                          // True if the mesh with the @ref meshID should be deleted.
         bool updateMesh;                               // True if the mesh should be updated, false otherwise.
         DynamicMeshProperties properties;              // The properties of the dynamic mesh.
-        std::vector<DynamicMeshVertex> meshVertices;   // Vertices of the dynamic mesh.
+        std::vector<DynamicMeshVertex> meshVertices;   // Vertices of the dynamic mesh. The capacity is kept if the message object is reused.
         std::vector<GLuint> meshIndices;               // Indices to that vertices representing the triangles of the dynamic mesh.
         AABB aabbOfVertices;                           // The axis-aligned bounding box of @ref meshVertices.
+        bool hasTimestamp;                             // True if the pose of the dynamic mesh is timestamped, false otherwise.
+        double timestamp;                              // The time in seconds (sender time base) at which the pose is valid. Only valid if @ref hasTimestamp is true.
 
         /**
          * @brief Construct a new dynamic mesh message.
          */
         DynamicMeshMessage(): MessageBaseType(MESSAGE_TYPE_DYNAMIC_MESH){
             updateMesh = true;
+            hasTimestamp = false;
+            timestamp = 0.0;
         }
 
         /**
@@ -74,6 +80,80 @@ class DynamicMeshMessage: public MessageBaseType {
          * @return The number of bytes that have been deserialized.
          */
         int32_t Deserialize(const uint8_t* bytes, int32_t length){
+            return DeserializeMessage(bytes, length, false);
+        }
+
+        /**
+         * @brief Deserialize a message that has been reassembled from fragments.
+         * @param[in] bytes The bytes containing the message.
+         * @param[in] length The number of bytes containing the message to be deserialized.
+         * @return The number of bytes that have been deserialized.
+         * @details The number of vertices, the number of indices and the indices are 32-bit values.
+         */
+        int32_t DeserializeLarge(const uint8_t* bytes, int32_t length){
+            return DeserializeMessage(bytes, length, true);
+        }
+
+        /**
+         * @brief Check if the message is valid.
+         * @return True if the message is valid, false otherwise.
+         */
+        bool IsValid(void){
+            bool valid = !hasTimestamp || std::isfinite(timestamp);
+            valid &= std::isfinite(properties.position.x);
+            valid &= std::isfinite(properties.position.y);
+            valid &= std::isfinite(properties.position.z);
+            valid &= std::isfinite(properties.quaternion.x);
+            valid &= std::isfinite(properties.quaternion.y);
+            valid &= std::isfinite(properties.quaternion.z);
+            valid &= std::isfinite(properties.quaternion.w);
+            valid &= std::isfinite(properties.scale.x);
+            valid &= std::isfinite(properties.scale.y);
+            valid &= std::isfinite(properties.scale.z);
+            valid &= std::isfinite(properties.diffuseColorMultiplier.x);
+            valid &= std::isfinite(properties.diffuseColorMultiplier.y);
+            valid &= std::isfinite(properties.diffuseColorMultiplier.z);
+            valid &= std::isfinite(properties.specularColorMultiplier.x);
+            valid &= std::isfinite(properties.specularColorMultiplier.y);
+            valid &= std::isfinite(properties.specularColorMultiplier.z);
+            valid &= std::isfinite(properties.emissionColorMultiplier.x);
+            valid &= std::isfinite(properties.emissionColorMultiplier.y);
+            valid &= std::isfinite(properties.emissionColorMultiplier.z);
+            valid &= std::isfinite(properties.shininessMultiplier);
+            return valid;
+        }
+
+        /**
+         * @brief Get the key that identifies the state that is set by this message.
+         * @return The coalescing key of this message.
+         */
+        uint64_t GetCoalescingKey(void) const { return MakeCoalescingKey(meshID); }
+
+        /**
+         * @brief Check whether this message makes an older dynamic mesh message with the same mesh ID obsolete.
+         * @param[in] older An older dynamic mesh message with the same mesh ID.
+         * @return True if this message deletes the mesh, replaces the mesh data or if neither message changes the mesh data.
+         */
+        bool Supersedes(const MessageBaseType& older) const {
+            const DynamicMeshMessage& olderMessage = static_cast<const DynamicMeshMessage&>(older);
+            return SupersedesAll() || (!olderMessage.shouldBeDeleted && !olderMessage.updateMesh);
+        }
+
+        /**
+         * @brief Check whether this message makes any older dynamic mesh message with the same mesh ID obsolete.
+         * @return True if this message deletes the mesh or replaces the mesh data.
+         */
+        bool SupersedesAll(void) const { return shouldBeDeleted || updateMesh; }
+
+    private:
+        /**
+         * @brief Deserialize the message.
+         * @param[in] bytes The bytes containing the message.
+         * @param[in] length The number of bytes containing the message to be deserialized.
+         * @param[in] largeCounts True if the number of vertices, the number of indices and the indices are 32-bit values, false if they are 16-bit values.
+         * @return The number of bytes that have been deserialized.
+         */
+        int32_t DeserializeMessage(const uint8_t* bytes, int32_t length, bool largeCounts){
             if(length < static_cast<int32_t>(sizeof(DynamicMeshMessageUnion))){
                 return 0;
             }
@@ -84,6 +164,7 @@ class DynamicMeshMessage: public MessageBaseType {
             meshID                               = static_cast<DynamicMeshID>(NetworkUtils::NetworkToNativeByteOrder(msg->protocol.meshID));
             shouldBeDeleted                      = static_cast<bool>(msg->protocol.shouldBeDeleted);
             updateMesh                           = static_cast<bool>(msg->protocol.updateMesh);
+            hasTimestamp                         = static_cast<bool>(msg->protocol.hasTimestamp);
             properties.visible                   = static_cast<bool>(msg->protocol.visible);
             properties.castShadow                = static_cast<bool>(msg->protocol.castShadow);
             properties.position.x                = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.position[0]);
@@ -108,85 +189,62 @@ class DynamicMeshMessage: public MessageBaseType {
             properties.shininessMultiplier       = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.shininessMultiplier);
 
             // deserialize variable mesh data
-            int32_t result = static_cast<int32_t>(sizeof(DynamicMeshMessageUnion));
-            if((result + 2) > length){
+            const size_t countSize = largeCounts ? sizeof(uint32_t) : sizeof(uint16_t);
+            size_t result = sizeof(DynamicMeshMessageUnion);
+            timestamp = 0.0;
+            if(hasTimestamp){
+                if((result + sizeof(double)) > static_cast<size_t>(length)){
+                    return 0;
+                }
+                timestamp = NetworkUtils::ReadNetworkByteOrder<double>(&bytes[result]);
+                result += sizeof(double);
+            }
+            if((result + countSize) > static_cast<size_t>(length)){
                 return 0;
             }
-            int32_t numVertices = static_cast<int32_t>(NetworkUtils::NetworkToNativeByteOrder(*reinterpret_cast<const uint16_t*>(&bytes[result])));
-            result += 2;
+            size_t numVertices = ReadCount(&bytes[result], largeCounts);
+            result += countSize;
             if((result + numVertices * sizeof(DynamicMeshMessageVertexUnion)) > static_cast<size_t>(length)){
                 return 0;
             }
-            meshVertices.clear();
+            static_assert(sizeof(DynamicMeshVertex) == sizeof(DynamicMeshMessageVertexUnion));
+            meshVertices.resize(numVertices);
             aabbOfVertices.Clear();
-            glm::vec3 minPosition(std::numeric_limits<GLfloat>::infinity());
-            glm::vec3 maxPosition(-std::numeric_limits<GLfloat>::infinity());
-            for(int32_t v = 0; v < numVertices; ++v){
-                const DynamicMeshMessageVertexUnion* vData = reinterpret_cast<const DynamicMeshMessageVertexUnion*>(&bytes[result]);
-                meshVertices.push_back(DynamicMeshVertex());
-                meshVertices.back().position[0] = NetworkUtils::NetworkToNativeByteOrder(vData->vertex.x);
-                meshVertices.back().position[1] = NetworkUtils::NetworkToNativeByteOrder(vData->vertex.y);
-                meshVertices.back().position[2] = NetworkUtils::NetworkToNativeByteOrder(vData->vertex.z);
-                meshVertices.back().color[0]    = NetworkUtils::NetworkToNativeByteOrder(vData->vertex.r);
-                meshVertices.back().color[1]    = NetworkUtils::NetworkToNativeByteOrder(vData->vertex.g);
-                meshVertices.back().color[2]    = NetworkUtils::NetworkToNativeByteOrder(vData->vertex.b);
-                minPosition.x = std::min(minPosition.x, meshVertices.back().position[0]);
-                minPosition.y = std::min(minPosition.y, meshVertices.back().position[1]);
-                minPosition.z = std::min(minPosition.z, meshVertices.back().position[2]);
-                maxPosition.x = std::max(maxPosition.x, meshVertices.back().position[0]);
-                maxPosition.y = std::max(maxPosition.y, meshVertices.back().position[1]);
-                maxPosition.z = std::max(maxPosition.z, meshVertices.back().position[2]);
-                result += sizeof(DynamicMeshMessageVertexUnion);
-            }
+            glm::vec3 minPosition, maxPosition;
+            NetworkUtils::ReadNetworkByteOrderVertices(reinterpret_cast<GLfloat*>(meshVertices.data()), &bytes[result], numVertices, sizeof(DynamicMeshVertex) / sizeof(GLfloat), minPosition, maxPosition);
+            result += numVertices * sizeof(DynamicMeshMessageVertexUnion);
             if(std::isfinite(minPosition.x)){
                 aabbOfVertices.lowestPosition = minPosition;
                 aabbOfVertices.dimension = maxPosition - minPosition;
             }
-            if((result + 2) > length){
+            if((result + countSize) > static_cast<size_t>(length)){
                 return 0;
             }
-            int32_t numIndices = static_cast<int32_t>(NetworkUtils::NetworkToNativeByteOrder(*reinterpret_cast<const uint16_t*>(&bytes[result])));
-            result += 2;
-            if((result + numIndices * sizeof(uint16_t)) > static_cast<size_t>(length)){
+            size_t numIndices = ReadCount(&bytes[result], largeCounts);
+            result += countSize;
+            if((result + numIndices * countSize) > static_cast<size_t>(length)){
                 return 0;
             }
-            for(int32_t i = 0; i < numIndices; ++i){
-                meshIndices.push_back(static_cast<GLuint>(NetworkUtils::NetworkToNativeByteOrder(*reinterpret_cast<const uint16_t*>(&bytes[result]))));
-                if(static_cast<int32_t>(meshIndices.back()) >= numVertices){
-                    return 0;
-                }
-                result += sizeof(uint16_t);
+            meshIndices.resize(numIndices);
+            uint32_t maxIndex = largeCounts ? NetworkUtils::ReadNetworkByteOrderIndices32(meshIndices.data(), &bytes[result], numIndices) : NetworkUtils::ReadNetworkByteOrderIndices16(meshIndices.data(), &bytes[result], numIndices);
+            if(numIndices && (static_cast<size_t>(maxIndex) >= numVertices)){
+                return 0;
             }
-            return result;
+            result += numIndices * countSize;
+            return static_cast<int32_t>(result);
         }
 
         /**
-         * @brief Check if the message is valid.
-         * @return True if the message is valid, false otherwise.
+         * @brief Read a count or an index value from the message.
+         * @param[in] bytes The bytes containing the value in network byte order.
+         * @param[in] largeCounts True if the value is a 32-bit value, false if it is a 16-bit value.
+         * @return The value in native byte order.
          */
-        bool IsValid(void){
-            bool valid = true;
-            valid &= std::isfinite(properties.position.x);
-            valid &= std::isfinite(properties.position.y);
-            valid &= std::isfinite(properties.position.z);
-            valid &= std::isfinite(properties.quaternion.x);
-            valid &= std::isfinite(properties.quaternion.y);
-            valid &= std::isfinite(properties.quaternion.z);
-            valid &= std::isfinite(properties.quaternion.w);
-            valid &= std::isfinite(properties.scale.x);
-            valid &= std::isfinite(properties.scale.y);
-            valid &= std::isfinite(properties.scale.z);
-            valid &= std::isfinite(properties.diffuseColorMultiplier.x);
-            valid &= std::isfinite(properties.diffuseColorMultiplier.y);
-            valid &= std::isfinite(properties.diffuseColorMultiplier.z);
-            valid &= std::isfinite(properties.specularColorMultiplier.x);
-            valid &= std::isfinite(properties.specularColorMultiplier.y);
-            valid &= std::isfinite(properties.specularColorMultiplier.z);
-            valid &= std::isfinite(properties.emissionColorMultiplier.x);
-            valid &= std::isfinite(properties.emissionColorMultiplier.y);
-            valid &= std::isfinite(properties.emissionColorMultiplier.z);
-            valid &= std::isfinite(properties.shininessMultiplier);
-            return valid;
+        size_t ReadCount(const uint8_t* bytes, bool largeCounts) const {
+            if(largeCounts){
+                return static_cast<size_t>(NetworkUtils::NetworkToNativeByteOrder(*reinterpret_cast<const uint32_t*>(bytes)));
+            }
+            return static_cast<size_t>(NetworkUtils::NetworkToNativeByteOrder(*reinterpret_cast<const uint16_t*>(bytes)));
         }
 };
 
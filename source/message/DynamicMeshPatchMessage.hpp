@@ -0,0 +1,138 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <DynamicMeshID.hpp>
+#include <MessageBaseType.hpp>
+#include <DynamicMesh.hpp>
+#include <DynamicMeshMessage.hpp>
+#include <AABB.hpp>
+#include <NetworkUtils.hpp>
+
+
+/**
+ * @brief Protocol definition for the header of the dynamic mesh patch message.
+ */
+#pragma pack(push, 1)
+union DynamicMeshPatchMessageUnion {
+    struct DynamicMeshPatchMessageStruct {
+        uint8_t messageType;   // Message type, must be @ref MESSAGE_TYPE_DYNAMIC_MESH_PATCH.
+        uint32_t meshID;       // The identifier of an existing dynamic mesh.
+        uint32_t vertexOffset; // Index of the first vertex to be replaced.
+        // variable mesh data
+    } protocol;
+    uint8_t bytes[sizeof(DynamicMeshPatchMessageUnion::DynamicMeshPatchMessageStruct)];
+};
+#pragma pack(pop)
+
+
+/**
+ * @brief Represents the dynamic mesh patch message that replaces a range of vertices and optionally a range of indices of an existing dynamic mesh.
+ */
+class DynamicMeshPatchMessage: public MessageBaseType {
+    public:
+        DynamicMeshID meshID;                          // The identifier of an existing dynamic mesh.
+        uint32_t vertexOffset;                         // Index of the first vertex to be replaced.
+        uint32_t indexOffset;                          // Position of the first index to be replaced.
+        std::vector<DynamicMeshVertex> meshVertices;   // Vertices that replace the vertex range. The capacity is kept if the message object is reused.
+        std::vector<GLuint> meshIndices;               // Indices that replace the index range. The capacity is kept if the message object is reused.
+        AABB aabbOfVertices;                           // The axis-aligned bounding box of all vertices of this patch.
+
+        /**
+         * @brief Construct a new dynamic mesh patch message.
+         */
+        DynamicMeshPatchMessage(): MessageBaseType(MESSAGE_TYPE_DYNAMIC_MESH_PATCH){
+            meshID = 0;
+            vertexOffset = 0;
+            indexOffset = 0;
+        }
+
+        /**
+         * @brief Deserialize the message.
+         * @param[in] bytes The bytes containing the message.
+         * @param[in] length The number of bytes containing the message to be deserialized.
+         * @return The number of bytes that have been deserialized.
+         */
+        int32_t Deserialize(const uint8_t* bytes, int32_t length){
+            if(length < static_cast<int32_t>(sizeof(DynamicMeshPatchMessageUnion))){
+                return 0;
+            }
+            const DynamicMeshPatchMessageUnion* msg = reinterpret_cast<const DynamicMeshPatchMessageUnion*>(&bytes[0]);
+            if(messageType != msg->protocol.messageType){
+                return 0;
+            }
+            meshID       = static_cast<DynamicMeshID>(NetworkUtils::NetworkToNativeByteOrder(msg->protocol.meshID));
+            vertexOffset = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.vertexOffset);
+
+            // deserialize vertex range
+            size_t result = sizeof(DynamicMeshPatchMessageUnion);
+            if((result + sizeof(uint16_t)) > static_cast<size_t>(length)){
+                return 0;
+            }
+            size_t numVertices = static_cast<size_t>(NetworkUtils::NetworkToNativeByteOrder(*reinterpret_cast<const uint16_t*>(&bytes[result])));
+            result += sizeof(uint16_t);
+            if((result + numVertices * sizeof(DynamicMeshMessageVertexUnion)) > static_cast<size_t>(length)){
+                return 0;
+            }
+            meshVertices.resize(numVertices);
+            aabbOfVertices.Clear();
+            glm::vec3 minPosition, maxPosition;
+            NetworkUtils::ReadNetworkByteOrderVertices(reinterpret_cast<GLfloat*>(meshVertices.data()), &bytes[result], numVertices, sizeof(DynamicMeshVertex) / sizeof(GLfloat), minPosition, maxPosition);
+            result += numVertices * sizeof(DynamicMeshMessageVertexUnion);
+            if(std::isfinite(minPosition.x)){
+                aabbOfVertices.lowestPosition = minPosition;
+                aabbOfVertices.dimension = maxPosition - minPosition;
+            }
+
+            // deserialize index range
+            if((result + sizeof(uint32_t) + sizeof(uint16_t)) > static_cast<size_t>(length)){
+                return 0;
+            }
+            indexOffset = NetworkUtils::NetworkToNativeByteOrder(*reinterpret_cast<const uint32_t*>(&bytes[result]));
+            result += sizeof(uint32_t);
+            size_t numIndices = static_cast<size_t>(NetworkUtils::NetworkToNativeByteOrder(*reinterpret_cast<const uint16_t*>(&bytes[result])));
+            result += sizeof(uint16_t);
+            if((result + numIndices * sizeof(uint32_t)) > static_cast<size_t>(length)){
+                return 0;
+            }
+            meshIndices.resize(numIndices);
+            NetworkUtils::ReadNetworkByteOrderArray32(meshIndices.data(), &bytes[result], numIndices);
+            result += numIndices * sizeof(uint32_t);
+            return static_cast<int32_t>(result);
+        }
+
+        /**
+         * @brief Check if the message is valid.
+         * @return True if the message is valid, false otherwise.
+         * @details Whether the ranges fit into the existing dynamic mesh is checked when the message is processed.
+         */
+        bool IsValid(void){
+            bool valid = true;
+            for(auto&& v : meshVertices){
+                valid &= std::isfinite(v.position[0]) && std::isfinite(v.position[1]) && std::isfinite(v.position[2]);
+            }
+            return valid;
+        }
+
+        /**
+         * @brief Get the key that identifies the state that is set by this message.
+         * @return The coalescing key of this message.
+         * @details Patches are never coalesced (see @ref Supersedes), but a non-zero key keeps them from acting as a barrier for other messages.
+         */
+        uint64_t GetCoalescingKey(void) const { return MakeCoalescingKey(meshID); }
+
+        /**
+         * @brief Check whether this message makes an older patch message for the same dynamic mesh obsolete.
+         * @param[in] older An older dynamic mesh patch message with the same mesh ID.
+         * @return Always false. Whether a patch fits into the dynamic mesh is only known when it is processed. If a newer
+         * patch covering the ranges of an older patch were rejected at that point, the older valid patch would be lost.
+         */
+        bool Supersedes(const MessageBaseType& older) const { (void)older; return false; }
+
+        /**
+         * @brief Check whether this message makes any older patch message for the same dynamic mesh obsolete.
+         * @return Always false, see @ref Supersedes.
+         */
+        bool SupersedesAll(void) const { return false; }
+};
+
@@ -93,5 +93,11 @@ class EngineParameterMessage: public MessageBaseType {
             valid &= std::isfinite(engineParameter.toneMappingStrength);
             return valid;
         }
+
+        /**
+         * @brief Get the key that identifies the state that is set by this message.
+         * @return The coalescing key of this message.
+         */
+        uint64_t GetCoalescingKey(void) const { return MakeCoalescingKey(0); }
 };
 
@@ -0,0 +1,94 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <MessageBaseType.hpp>
+#include <NetworkUtils.hpp>
+
+
+/**
+ * @brief Protocol definition for the header of a fragment message.
+ */
+#pragma pack(push, 1)
+union FragmentMessageUnion {
+    struct FragmentMessageStruct {
+        uint8_t messageType;      // Message type, must be @ref MESSAGE_TYPE_FRAGMENT.
+        uint32_t transferID;      // Identifier of the fragmented message, unique for a sender among all transfers that are in progress.
+        uint16_t fragmentIndex;   // Zero-based index of this fragment.
+        uint16_t fragmentCount;   // Total number of fragments of the fragmented message.
+        uint32_t totalLength;     // Total number of bytes of the fragmented message.
+        uint32_t payloadOffset;   // Offset in bytes of this fragment within the fragmented message.
+        uint16_t payloadLength;   // Number of payload bytes that follow this header.
+    } protocol;
+    uint8_t bytes[sizeof(FragmentMessageUnion::FragmentMessageStruct)];
+};
+#pragma pack(pop)
+
+
+/**
+ * @brief Represents a fragment of a message that is too large for a single datagram.
+ * @details Fragment messages are not forwarded to the engine. They are collected by the @ref MessageReassembler of the
+ * network thread until all fragments of a transfer have been received. The reassembled bytes contain a single message
+ * that is decoded via @ref MessageBaseType::DeserializeLarge.
+ */
+class FragmentMessage: public MessageBaseType {
+    public:
+        uint32_t transferID;      // Identifier of the fragmented message.
+        uint16_t fragmentIndex;   // Zero-based index of this fragment.
+        uint16_t fragmentCount;   // Total number of fragments of the fragmented message.
+        uint32_t totalLength;     // Total number of bytes of the fragmented message.
+        uint32_t payloadOffset;   // Offset in bytes of this fragment within the fragmented message.
+        uint16_t payloadLength;   // Number of payload bytes.
+        const uint8_t* payload;   // Pointer to the payload bytes inside the received datagram, only valid until the next datagram is received.
+
+        /**
+         * @brief Construct a new fragment message.
+         */
+        FragmentMessage(): MessageBaseType(MESSAGE_TYPE_FRAGMENT){
+            transferID = 0;
+            fragmentIndex = 0;
+            fragmentCount = 0;
+            totalLength = 0;
+            payloadOffset = 0;
+            payloadLength = 0;
+            payload = nullptr;
+        }
+
+        /**
+         * @brief Deserialize the message.
+         * @param[in] bytes The bytes containing the message.
+         * @param[in] length The number of bytes containing the message to be deserialized.
+         * @return The number of bytes that have been deserialized.
+         * @note The payload is not copied, @ref payload points into the given bytes.
+         */
+        int32_t Deserialize(const uint8_t* bytes, int32_t length){
+            if(length < static_cast<int32_t>(sizeof(FragmentMessageUnion))){
+                return 0;
+            }
+            const FragmentMessageUnion* msg = reinterpret_cast<const FragmentMessageUnion*>(&bytes[0]);
+            if(messageType != msg->protocol.messageType){
+                return 0;
+            }
+            transferID    = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.transferID);
+            fragmentIndex = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.fragmentIndex);
+            fragmentCount = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.fragmentCount);
+            totalLength   = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.totalLength);
+            payloadOffset = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.payloadOffset);
+            payloadLength = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.payloadLength);
+            int32_t result = static_cast<int32_t>(sizeof(FragmentMessageUnion));
+            if((result + static_cast<int32_t>(payloadLength)) > length){
+                return 0;
+            }
+            payload = &bytes[result];
+            return result + static_cast<int32_t>(payloadLength);
+        }
+
+        /**
+         * @brief Check if the message is valid.
+         * @return True if the message is valid, false otherwise.
+         */
+        bool IsValid(void){
+            return fragmentCount && (fragmentIndex < fragmentCount) && (static_cast<uint64_t>(payloadOffset) + static_cast<uint64_t>(payloadLength) <= static_cast<uint64_t>(totalLength));
+        }
+};
+
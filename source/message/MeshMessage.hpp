@@ -19,7 +19,8 @@ union MeshMessageUnion {
         uint8_t shouldBeDeleted:1;            // bit0: True if the mesh with the @ref meshID should be deleted.
         uint8_t visible:1;                    // bit1: True if this mesh object is visible, false otherwise.
         uint8_t castShadow:1;                 // bit2: True if this mesh casts a shadow, false otherwise.
-        uint8_t unused:5;                     // bit3-bit7: unused.
+        uint8_t hasTimestamp:1;               // bit3: True if a 64-bit floating-point timestamp follows the header, false otherwise.
+        uint8_t unused:4;                     // bit4-bit7: unused.
         GLfloat position[3];                  // Position in OpenGL world space coordinates.
         glm::vec4 quaternion;                 // Unit quaternion that represents the orientation of this mesh.
         GLfloat scale[3];                     // Scaling of this mesh object in body frame coordinates.
@@ -28,7 +29,7 @@ union MeshMessageUnion {
         GLfloat emissionColorMultiplier[3];   // Emission color multiplier for this mesh.
         GLfloat shininessMultiplier;          // Shininess multiplier for this mesh.
         uint16_t nameStringLength;            // String length of the mesh name.
-        // variable length ASCII string
+        // optional timestamp, variable length ASCII string
     } protocol;
     uint8_t bytes[sizeof(MeshMessageUnion::MeshMessageStruct)];
 };
@@ -43,6 +44,8 @@ class MeshMessage: public MessageBaseType {
         MeshID meshID;          // A unique mesh identifier.
         bool shouldBeDeleted;   // True if the mesh with the @ref meshID should be deleted.
         MeshObject object;      // The mesh object.
+        bool hasTimestamp;      // True if the pose of the mesh object is timestamped, false otherwise.
+        double timestamp;       // The time in seconds (sender time base) at which the pose is valid. Only valid if @ref hasTimestamp is true.
 
         /**
          * @brief Construct a new mesh sessage.
@@ -50,6 +53,8 @@ class MeshMessage: public MessageBaseType {
         MeshMessage(): MessageBaseType(MESSAGE_TYPE_MESH){
             meshID = 0;
             shouldBeDeleted = false;
+            hasTimestamp = false;
+            timestamp = 0.0;
         }
 
         /**
@@ -68,6 +73,7 @@ class MeshMessage: public MessageBaseType {
             }
             meshID                           = static_cast<MeshID>(NetworkUtils::NetworkToNativeByteOrder(msg->protocol.meshID));
             shouldBeDeleted                  = static_cast<bool>(msg->protocol.shouldBeDeleted);
+            hasTimestamp                     = static_cast<bool>(msg->protocol.hasTimestamp);
             object.visible                   = static_cast<bool>(msg->protocol.visible);
             object.castShadow                = static_cast<bool>(msg->protocol.castShadow);
             object.position.x                = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.position[0]);
@@ -92,6 +98,14 @@ class MeshMessage: public MessageBaseType {
             object.shininessMultiplier       = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.shininessMultiplier);
             int32_t nameLength = static_cast<int32_t>(NetworkUtils::NetworkToNativeByteOrder(msg->protocol.nameStringLength));
             int32_t result = static_cast<int32_t>(sizeof(MeshMessageUnion));
+            timestamp = 0.0;
+            if(hasTimestamp){
+                if(length < (result + static_cast<int32_t>(sizeof(double)))){
+                    return 0;
+                }
+                timestamp = NetworkUtils::ReadNetworkByteOrder<double>(&bytes[result]);
+                result += static_cast<int32_t>(sizeof(double));
+            }
             if(length < (result + nameLength)){
                 return 0;
             }
@@ -109,6 +123,7 @@ class MeshMessage: public MessageBaseType {
          */
         bool IsValid(void){
             bool valid = !object.name.empty();
+            valid &= !hasTimestamp || std::isfinite(timestamp);
             valid &= std::isfinite(object.position.x);
             valid &= std::isfinite(object.position.y);
             valid &= std::isfinite(object.position.z);
@@ -131,5 +146,28 @@ class MeshMessage: public MessageBaseType {
             valid &= std::isfinite(object.shininessMultiplier);
             return valid;
         }
+
+        /**
+         * @brief Get the key that identifies the state that is set by this message.
+         * @return The coalescing key of this message.
+         */
+        uint64_t GetCoalescingKey(void) const { return MakeCoalescingKey(meshID); }
+
+        /**
+         * @brief Check whether this message makes an older mesh message with the same mesh ID obsolete.
+         * @param[in] older An older mesh message with the same mesh ID.
+         * @return True if this message deletes the mesh or if both messages update the same mesh name.
+         * @details An update of an existing mesh with a different name is ignored, thus such messages must not be coalesced.
+         */
+        bool Supersedes(const MessageBaseType& older) const {
+            const MeshMessage& olderMessage = static_cast<const MeshMessage&>(older);
+            return shouldBeDeleted || (!olderMessage.shouldBeDeleted && (0 == olderMessage.object.name.compare(object.name)));
+        }
+
+        /**
+         * @brief Check whether this message makes any older mesh message with the same mesh ID obsolete.
+         * @return True if this message deletes the mesh.
+         */
+        bool SupersedesAll(void) const { return shouldBeDeleted; }
 };
 
@@ -0,0 +1,200 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <MessageBaseType.hpp>
+#include <MeshID.hpp>
+#include <NetworkUtils.hpp>
+
+
+/**
+ * @brief Protocol definition for the header of the mesh pose message.
+ */
+#pragma pack(push, 1)
+union MeshPoseMessageUnion {
+    struct MeshPoseMessageStruct {
+        uint8_t messageType;                // Message type, must be @ref MESSAGE_TYPE_MESH_POSE.
+        uint8_t hasScale:1;                 // bit0: True if the message contains a scale for each mesh, false otherwise.
+        uint8_t compressedQuaternion:1;     // bit1: True if quaternions are compressed to 32 bits (smallest three), false if they are given as four floats.
+        uint8_t halfScale:1;                // bit2: True if scales are given as half-precision floats, false if they are given as single-precision floats.
+        uint8_t hasTimestamp:1;             // bit3: True if a 64-bit floating-point timestamp follows the header, false otherwise.
+        uint8_t unused:4;                   // bit4-bit7: unused.
+        uint16_t numberOfMeshes;            // The number of meshes.
+        // optional timestamp, variable mesh pose data in struct-of-arrays layout
+    } protocol;
+    uint8_t bytes[sizeof(MeshPoseMessageUnion::MeshPoseMessageStruct)];
+};
+#pragma pack(pop)
+
+
+/**
+ * @brief Represents the mesh pose message that updates the pose of many existing meshes at once.
+ * @details The message only changes position, orientation and optionally the scale of meshes that have already been added
+ * via a mesh message. All other attributes of the mesh objects remain unchanged.
+ */
+class MeshPoseMessage: public MessageBaseType {
+    public:
+        std::vector<MeshID> meshIDs;            // Mesh identifiers of the meshes to be updated. The capacity is kept if the message object is reused.
+        std::vector<glm::vec3> positions;       // New positions in OpenGL world space coordinates, one for each mesh.
+        std::vector<glm::vec4> quaternions;     // New unit quaternions {x, y, z, w}, one for each mesh.
+        std::vector<glm::vec3> scales;          // New scales in body frame coordinates, one for each mesh. Empty if @ref hasScale is false.
+        bool hasScale;                          // True if the scale of the meshes should be updated, false otherwise.
+        bool hasTimestamp;                      // True if the poses are timestamped, false otherwise.
+        double timestamp;                       // The time in seconds (sender time base) at which the poses are valid. Only valid if @ref hasTimestamp is true.
+
+        /**
+         * @brief Construct a new mesh pose message.
+         */
+        MeshPoseMessage(): MessageBaseType(MESSAGE_TYPE_MESH_POSE){
+            hasScale = false;
+            hasTimestamp = false;
+            timestamp = 0.0;
+        }
+
+        /**
+         * @brief Deserialize the message.
+         * @param[in] bytes The bytes containing the message.
+         * @param[in] length The number of bytes containing the message to be deserialized.
+         * @return The number of bytes that have been deserialized.
+         */
+        int32_t Deserialize(const uint8_t* bytes, int32_t length){
+            if(length < static_cast<int32_t>(sizeof(MeshPoseMessageUnion))){
+                return 0;
+            }
+            const MeshPoseMessageUnion* msg = reinterpret_cast<const MeshPoseMessageUnion*>(&bytes[0]);
+            if(messageType != msg->protocol.messageType){
+                return 0;
+            }
+            hasScale = static_cast<bool>(msg->protocol.hasScale);
+            hasTimestamp = static_cast<bool>(msg->protocol.hasTimestamp);
+            bool compressedQuaternion = static_cast<bool>(msg->protocol.compressedQuaternion);
+            bool halfScale = static_cast<bool>(msg->protocol.halfScale);
+            size_t numMeshes = static_cast<size_t>(NetworkUtils::NetworkToNativeByteOrder(msg->protocol.numberOfMeshes));
+            size_t quaternionSize = compressedQuaternion ? sizeof(uint32_t) : (4 * sizeof(GLfloat));
+            size_t scaleSize = hasScale ? (halfScale ? (3 * sizeof(uint16_t)) : (3 * sizeof(GLfloat))) : 0;
+            size_t result = sizeof(MeshPoseMessageUnion);
+            timestamp = 0.0;
+            if(hasTimestamp){
+                if((result + sizeof(double)) > static_cast<size_t>(length)){
+                    return 0;
+                }
+                timestamp = NetworkUtils::ReadNetworkByteOrder<double>(&bytes[result]);
+                result += sizeof(double);
+            }
+            if((result + numMeshes * (sizeof(uint32_t) + 3 * sizeof(GLfloat) + quaternionSize + scaleSize)) > static_cast<size_t>(length)){
+                return 0;
+            }
+
+            // mesh IDs
+            meshIDs.resize(numMeshes);
+            static_assert(sizeof(MeshID) == sizeof(uint32_t));
+            NetworkUtils::ReadNetworkByteOrderArray32(meshIDs.data(), &bytes[result], numMeshes);
+            result += numMeshes * sizeof(uint32_t);
+
+            // positions
+            positions.resize(numMeshes);
+            static_assert(sizeof(glm::vec3) == (3 * sizeof(GLfloat)));
+            NetworkUtils::ReadNetworkByteOrderArray32(positions.data(), &bytes[result], 3 * numMeshes);
+            result += numMeshes * 3 * sizeof(GLfloat);
+
+            // quaternions
+            quaternions.resize(numMeshes);
+            if(compressedQuaternion){
+                for(size_t i = 0; i < numMeshes; ++i, result += sizeof(uint32_t)){
+                    quaternions[i] = DecompressQuaternion(NetworkUtils::ReadNetworkByteOrder<uint32_t>(&bytes[result]));
+                }
+            }
+            else{
+                for(size_t i = 0; i < numMeshes; ++i, result += 4 * sizeof(GLfloat)){
+                    quaternions[i].w = NetworkUtils::ReadNetworkByteOrder<GLfloat>(&bytes[result]);
+                    quaternions[i].x = NetworkUtils::ReadNetworkByteOrder<GLfloat>(&bytes[result + 4]);
+                    quaternions[i].y = NetworkUtils::ReadNetworkByteOrder<GLfloat>(&bytes[result + 8]);
+                    quaternions[i].z = NetworkUtils::ReadNetworkByteOrder<GLfloat>(&bytes[result + 12]);
+                }
+            }
+
+            // scales
+            scales.resize(hasScale ? numMeshes : 0);
+            if(hasScale && halfScale){
+                for(size_t i = 0; i < numMeshes; ++i, result += 3 * sizeof(uint16_t)){
+                    scales[i].x = NetworkUtils::HalfToFloat(NetworkUtils::ReadNetworkByteOrder<uint16_t>(&bytes[result]));
+                    scales[i].y = NetworkUtils::HalfToFloat(NetworkUtils::ReadNetworkByteOrder<uint16_t>(&bytes[result + 2]));
+                    scales[i].z = NetworkUtils::HalfToFloat(NetworkUtils::ReadNetworkByteOrder<uint16_t>(&bytes[result + 4]));
+                }
+            }
+            else if(hasScale){
+                NetworkUtils::ReadNetworkByteOrderArray32(scales.data(), &bytes[result], 3 * numMeshes);
+                result += numMeshes * 3 * sizeof(GLfloat);
+            }
+            return static_cast<int32_t>(result);
+        }
+
+        /**
+         * @brief Check if the message is valid.
+         * @return True if the message is valid, false otherwise.
+         */
+        bool IsValid(void){
+            bool valid = !hasTimestamp || std::isfinite(timestamp);
+            for(auto&& p : positions){
+                valid &= std::isfinite(p.x) && std::isfinite(p.y) && std::isfinite(p.z);
+            }
+            for(auto&& q : quaternions){
+                valid &= std::isfinite(q.x) && std::isfinite(q.y) && std::isfinite(q.z) && std::isfinite(q.w);
+            }
+            for(auto&& s : scales){
+                valid &= std::isfinite(s.x) && std::isfinite(s.y) && std::isfinite(s.z);
+            }
+            return valid;
+        }
+
+        /**
+         * @brief Get the key that identifies the state that is set by this message.
+         * @return The coalescing key of this message, which is based on the first mesh ID.
+         */
+        uint64_t GetCoalescingKey(void) const { return MakeCoalescingKey(meshIDs.empty() ? 0 : meshIDs[0]); }
+
+        /**
+         * @brief Check whether this message makes an older mesh pose message obsolete.
+         * @param[in] older An older mesh pose message with the same coalescing key.
+         * @return True if both messages update the same list of meshes and this message updates at least the same attributes.
+         */
+        bool Supersedes(const MessageBaseType& older) const {
+            const MeshPoseMessage& olderMessage = static_cast<const MeshPoseMessage&>(older);
+            return (hasScale || !olderMessage.hasScale) && (meshIDs == olderMessage.meshIDs);
+        }
+
+        /**
+         * @brief Check whether this message makes any older mesh pose message with the same coalescing key obsolete.
+         * @return Always false, because the list of meshes of an older message may differ.
+         */
+        bool SupersedesAll(void) const { return false; }
+
+    private:
+        /**
+         * @brief Decompress a quaternion that has been compressed via the smallest three method.
+         * @param[in] value The compressed quaternion. Bit 31-30 contain the index of the largest component in the order {w, x, y, z}.
+         * The remaining three components are stored in order with 10 bits each (bit 29-20, bit 19-10, bit 9-0), where the range
+         * [-1/sqrt(2), +1/sqrt(2)] is mapped to [0, 1023]. The largest component is positive.
+         * @return The unit quaternion.
+         */
+        static glm::vec4 DecompressQuaternion(uint32_t value){
+            constexpr GLfloat scale = 1.41421356237f / 1023.0f;
+            constexpr GLfloat offset = 0.70710678118f;
+            uint32_t largestIndex = value >> 30;
+            GLfloat wxyz[4];
+            GLfloat sumOfSquares = 0.0f;
+            int32_t shift = 20;
+            for(uint32_t k = 0; k < 4; ++k){
+                if(k == largestIndex){
+                    continue;
+                }
+                GLfloat c = static_cast<GLfloat>((value >> shift) & 0x03FF) * scale - offset;
+                wxyz[k] = c;
+                sumOfSquares += c * c;
+                shift -= 10;
+            }
+            wxyz[largestIndex] = std::sqrt(std::max(0.0f, 1.0f - sumOfSquares));
+            return glm::vec4(wxyz[1], wxyz[2], wxyz[3], wxyz[0]);
+        }
+};
+
@@ -18,7 +18,10 @@ enum MessageType : uint8_t {
     MESSAGE_TYPE_SPOT_LIGHT = 0x07,
     MESSAGE_TYPE_MESH = 0x08,
     MESSAGE_TYPE_WATER_MESH = 0x09,
-    MESSAGE_TYPE_DYNAMIC_MESH = 0x0A
+    MESSAGE_TYPE_DYNAMIC_MESH = 0x0A,
+    MESSAGE_TYPE_FRAGMENT = 0x0B,
+    MESSAGE_TYPE_MESH_POSE = 0x0C,
+    MESSAGE_TYPE_DYNAMIC_MESH_PATCH = 0x0D
 };
 
 
@@ -28,12 +31,13 @@ enum MessageType : uint8_t {
 class MessageBaseType {
     public:
         const MessageType messageType;   // The type indicating the message.
+        int64_t receiveTime;             // Time in nanoseconds of the steady clock at which the datagram containing this message has been received, zero if unknown.
 
         /**
          * @brief Construct a new base type for a message.
          * @param[in] type The type of this message.
          */
-        explicit MessageBaseType(MessageType type): messageType(type) {}
+        explicit MessageBaseType(MessageType type): messageType(type), receiveTime(0) {}
 
         /**
          * @brief Destroy this message.
@@ -48,10 +52,47 @@ class MessageBaseType {
          */
         virtual int32_t Deserialize(const uint8_t* bytes, int32_t length) = 0;
 
+        /**
+         * @brief Deserialize a message that has been reassembled from fragments (see @ref FragmentMessage).
+         * @param[in] bytes The bytes containing the message.
+         * @param[in] length The number of bytes containing the message to be deserialized.
+         * @return The number of bytes that have been deserialized. The default implementation returns zero, which indicates that the message type does not support fragmentation.
+         * @details Messages that support fragmentation use 32-bit values for variable-length data counts.
+         */
+        virtual int32_t DeserializeLarge(const uint8_t* bytes, int32_t length){ (void)bytes; (void)length; return 0; }
+
         /**
          * @brief Check if the message is valid.
          * @return True if the message is valid, false otherwise.
          */
         virtual bool IsValid(void) = 0;
+
+        /**
+         * @brief Get the key that identifies the object whose state is set by this message.
+         * @return A non-zero key that identifies the object (message type and identifier) or zero if this message must never be coalesced.
+         * @details Messages with the same non-zero key may be coalesced, such that only the newest message is processed (see @ref Supersedes).
+         */
+        virtual uint64_t GetCoalescingKey(void) const { return 0; }
+
+        /**
+         * @brief Check whether this message makes an older message with the same coalescing key obsolete.
+         * @param[in] older An older message with the same coalescing key.
+         * @return True if processing only this message results in the same state as processing the older message followed by this message.
+         */
+        virtual bool Supersedes(const MessageBaseType& older) const { (void)older; return true; }
+
+        /**
+         * @brief Check whether this message makes any older message with the same coalescing key obsolete, independent of the content of the older message.
+         * @return True if @ref Supersedes returns true for all older messages with the same coalescing key.
+         */
+        virtual bool SupersedesAll(void) const { return true; }
+
+    protected:
+        /**
+         * @brief Make a coalescing key from the message type and an identifier.
+         * @param[in] id The identifier of the object that is described by this message.
+         * @return A non-zero key that is unique for the message type and the identifier.
+         */
+        uint64_t MakeCoalescingKey(uint32_t id) const { return ((static_cast<uint64_t>(messageType) + 1) << 32) | static_cast<uint64_t>(id); }
 };
 
@@ -0,0 +1,113 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <MessageBaseType.hpp>
+
+
+/**
+ * @brief Removes superseded messages from a list of messages (last-writer-wins).
+ * @details Messages are grouped by their coalescing key (message type and object identifier). A message is removed if the
+ * next newer message with the same key supersedes it (see @ref MessageBaseType::Supersedes). Messages without a coalescing
+ * key, e.g. the clear message, are never removed and act as a barrier: messages are not coalesced across such a message.
+ * The order of the remaining messages is preserved.
+ */
+class MessageCoalescer {
+    public:
+        /**
+         * @brief Construct a new message coalescer.
+         */
+        MessageCoalescer(): generation(0), numCoalesced(0){}
+
+        /**
+         * @brief Coalesce a list of messages.
+         * @param[inout] messages The messages in the order of insertion. Superseded messages are removed from this container.
+         * @param[inout] obsoleteMessages Container to which all superseded messages are appended. The caller takes ownership of these messages.
+         */
+        void Coalesce(std::vector<MessageBaseType*>& messages, std::vector<MessageBaseType*>& obsoleteMessages){
+            PrepareTable(messages.size());
+            size_t numObsolete = obsoleteMessages.size();
+            for(size_t i = messages.size(); i > 0; --i){
+                MessageBaseType* message = messages[i - 1];
+                uint64_t key = message->GetCoalescingKey();
+                if(!key){
+                    ClearTable();
+                    continue;
+                }
+                size_t index = FindSlot(key);
+                if(tableGenerations[index] != generation){
+                    tableGenerations[index] = generation;
+                    tableKeys[index] = key;
+                    tableMessages[index] = message;
+                }
+                else if(tableMessages[index]->Supersedes(*message)){
+                    obsoleteMessages.push_back(message);
+                    messages[i - 1] = nullptr;
+                }
+                else{
+                    tableMessages[index] = message;
+                }
+            }
+            if(obsoleteMessages.size() > numObsolete){
+                messages.erase(std::remove(messages.begin(), messages.end(), nullptr), messages.end());
+                numCoalesced.fetch_add(static_cast<uint64_t>(obsoleteMessages.size() - numObsolete), std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Get the total number of messages that have been removed by this coalescer.
+         * @return Number of superseded messages.
+         */
+        uint64_t GetNumCoalesced(void) const { return numCoalesced.load(std::memory_order_relaxed); }
+
+    private:
+        /* open addressing hash table that maps a coalescing key to the next newer message, an entry is valid if its generation is equal to @ref generation */
+        std::vector<uint64_t> tableKeys;              // Coalescing keys.
+        std::vector<MessageBaseType*> tableMessages;  // Next newer message for each key.
+        std::vector<uint32_t> tableGenerations;       // Generation for each entry.
+        uint32_t generation;                          // The current generation, incremented to clear the table.
+        std::atomic<uint64_t> numCoalesced;           // Total number of superseded messages.
+
+        /**
+         * @brief Clear the table and make sure that it can hold a given number of entries with a load factor of at most 0.5.
+         * @param[in] numEntries The number of entries to be inserted.
+         */
+        void PrepareTable(size_t numEntries){
+            size_t size = 16;
+            while(size < (numEntries << 1)){
+                size <<= 1;
+            }
+            if(size > tableKeys.size()){
+                tableKeys.assign(size, 0);
+                tableMessages.assign(size, nullptr);
+                tableGenerations.assign(size, 0);
+                generation = 0;
+            }
+            ClearTable();
+        }
+
+        /**
+         * @brief Clear the table by starting a new generation.
+         */
+        void ClearTable(void){
+            if(0 == ++generation){
+                std::fill(tableGenerations.begin(), tableGenerations.end(), 0);
+                generation = 1;
+            }
+        }
+
+        /**
+         * @brief Find the slot of a key in the table.
+         * @param[in] key The coalescing key.
+         * @return Index of the entry with the given key or index of an empty entry where to insert the key.
+         */
+        size_t FindSlot(uint64_t key) const {
+            size_t mask = tableKeys.size() - 1;
+            size_t index = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+            while((tableGenerations[index] == generation) && (tableKeys[index] != key)){
+                index = (index + 1) & mask;
+            }
+            return index;
+        }
+};
+
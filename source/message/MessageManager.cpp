@@ -4,20 +4,49 @@
 MessageManager messageManager;
 
 
-void MessageManager::InsertMessages(std::vector<MessageBaseType*>& messages){
-    if(!messages.empty()){
-        mtxMessageQueue.lock();
-        messageQueue.insert(messageQueue.end(), std::make_move_iterator(messages.begin()), std::make_move_iterator(messages.end()));
-        mtxMessageQueue.unlock();
-        messages.clear();
+void MessageManager::Open(size_t capacity, MessageQueueOverflowPolicy policy, bool coalesce){
+    messageQueue.Reset(capacity, policy);
+    messagePool.Reset(capacity);
+    this->coalesce = coalesce;
+}
+
+void MessageManager::Close(void){
+    messageQueue.Close();
+}
+
+MessageBaseType* MessageManager::AcquireMessage(MessageType type){
+    return messagePool.Acquire(type);
+}
+
+void MessageManager::RecycleMessage(MessageBaseType* message){
+    messagePool.Recycle(message);
+}
+
+void MessageManager::InsertMessages(std::vector<MessageBaseType*>& messages, bool reliable){
+    for(auto&& message : messages){
+        messagePool.Recycle(messageQueue.Push(message, reliable));
+    }
+    messages.clear();
+}
+
+void MessageManager::FetchMessages(std::vector<MessageBaseType*>& messages){
+    messageQueue.PopAll(messages);
+    if(coalesce){
+        coalescer.Coalesce(messages, obsoleteMessages);
+        ReleaseMessages(obsoleteMessages);
+    }
+}
+
+void MessageManager::ReleaseMessages(std::vector<MessageBaseType*>& messages){
+    for(auto&& message : messages){
+        messagePool.Release(message);
     }
+    messages.clear();
 }
 
-std::vector<MessageBaseType*> MessageManager::FetchMessages(void){
-    std::vector<MessageBaseType*> result;
-    mtxMessageQueue.lock();
-    result.swap(messageQueue);
-    mtxMessageQueue.unlock();
-    return result;
+MessageQueueStatistics MessageManager::GetStatistics(void) const {
+    MessageQueueStatistics statistics = messageQueue.GetStatistics();
+    statistics.numCoalesced += coalescer.GetNumCoalesced();
+    return statistics;
 }
 
@@ -3,6 +3,9 @@
 
 #include <Common.hpp>
 #include <MessageBaseType.hpp>
+#include <MessageQueue.hpp>
+#include <MessagePool.hpp>
+#include <MessageCoalescer.hpp>
 
 // include all types of messages
 #include <AmbientLightMessage.hpp>
@@ -10,6 +13,7 @@
 #include <CameraMessage.hpp>
 #include <ClearMessage.hpp>
 #include <DirectionalLightMessage.hpp>
+#include <DynamicMeshMessage.hpp>
 #include <EngineParameterMessage.hpp>
 #include <MeshMessage.hpp>
 #include <PointLightMessage.hpp>
@@ -19,26 +23,75 @@
 
 /**
  * @brief Manages all received messages.
+ * @details Messages are handed over from the network thread (single producer) to the render thread (single consumer)
+ * via a bounded lock-free ring. Message objects are taken from typed pools and are returned to the pools by the consumer
+ * after they have been processed, so that messages are not allocated for each received datagram.
  */
 class MessageManager {
     public:
         /**
-         * @brief Insert received messages to the message queue.
+         * @brief Open the message queue and the message pools. All messages that are still in the queue or in the pools are deleted.
+         * @param[in] capacity The maximum number of messages that can be stored in the queue.
+         * @param[in] policy The overflow policy to be used if the queue is full.
+         * @param[in] coalesce True if superseded messages should be removed when fetching messages, false otherwise.
+         * @note This function must not be called while messages are inserted or fetched.
+         */
+        void Open(size_t capacity, MessageQueueOverflowPolicy policy, bool coalesce);
+
+        /**
+         * @brief Close the message queue. A producer waiting for free space is released and further messages are dropped.
+         */
+        void Close(void);
+
+        /**
+         * @brief Get a message object that can be used to deserialize a received message (producer only).
+         * @param[in] type The type of the message.
+         * @return A message object of the given type or nullptr if the type is unknown. Insert the message via @ref InsertMessages or return it via @ref RecycleMessage.
+         */
+        MessageBaseType* AcquireMessage(MessageType type);
+
+        /**
+         * @brief Return a message object that has been acquired via @ref AcquireMessage but has not been inserted to the queue (producer only).
+         * @param[in] message The message to be returned.
+         */
+        void RecycleMessage(MessageBaseType* message);
+
+        /**
+         * @brief Insert received messages to the message queue (producer only).
          * @param[inout] messages The new messages to be inserted into the queue. These messages are moved to the queue. This container is empty after this operation.
+         * @param[in] reliable True if the messages have been received via a reliable transport and must not be dropped. The producer waits for free space instead (back-pressure).
+         * @details If the queue is full, the overflow policy that has been set by @ref Open is applied.
+         */
+        void InsertMessages(std::vector<MessageBaseType*>& messages, bool reliable = false);
+
+        /**
+         * @brief Fetch all messages that are currently present in the queue (consumer only).
+         * @param[inout] messages Container to which all messages are appended in the order of insertion.
+         * @details The internal queue is cleared after this operation. If coalescing is enabled, messages that are superseded by
+         * newer messages of the same object (last-writer-wins) are removed, such that the number of messages is bounded by the number
+         * of distinct objects (see @ref MessageCoalescer).
+         * @note Make sure to release the messages via @ref ReleaseMessages after they have been processed!
+         */
+        void FetchMessages(std::vector<MessageBaseType*>& messages);
+
+        /**
+         * @brief Return processed messages to the message pools (consumer only).
+         * @param[inout] messages The messages that have been fetched via @ref FetchMessages. This container is empty after this operation.
          */
-        void InsertMessages(std::vector<MessageBaseType*>& messages);
+        void ReleaseMessages(std::vector<MessageBaseType*>& messages);
 
         /**
-         * @brief Fetch all messages that are currently present in the queue.
-         * @return The whole message queue.
-         * @details The internal queue is cleared after this operation.
-         * @note Make sure to delete the message!
+         * @brief Get the statistics of the message queue, e.g. the current queue depth and the number of dropped messages.
+         * @return Current statistics of the message queue.
          */
-        std::vector<MessageBaseType*> FetchMessages(void);
+        MessageQueueStatistics GetStatistics(void) const;
 
     private:
-        std::vector<MessageBaseType*> messageQueue;   // The internal thread-safe message queue.
-        std::mutex mtxMessageQueue;                   // A mutex to protect @ref messageQueue.
+        MessageQueue messageQueue;                       // The internal lock-free message queue.
+        MessagePool messagePool;                         // Typed pools of message objects.
+        MessageCoalescer coalescer;                      // Removes superseded messages when fetching messages.
+        std::vector<MessageBaseType*> obsoleteMessages;  // Superseded messages, the capacity is kept between calls.
+        std::atomic<bool> coalesce;                      // True if superseded messages should be removed when fetching messages.
 };
 
 
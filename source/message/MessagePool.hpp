@@ -0,0 +1,181 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <MessageBaseType.hpp>
+#include <MessageQueue.hpp>
+#include <AmbientLightMessage.hpp>
+#include <AtmosphereMessage.hpp>
+#include <CameraMessage.hpp>
+#include <ClearMessage.hpp>
+#include <DirectionalLightMessage.hpp>
+#include <DynamicMeshMessage.hpp>
+#include <DynamicMeshPatchMessage.hpp>
+#include <EngineParameterMessage.hpp>
+#include <MeshMessage.hpp>
+#include <MeshPoseMessage.hpp>
+#include <PointLightMessage.hpp>
+#include <SpotLightMessage.hpp>
+#include <WaterMeshMessage.hpp>
+
+
+/**
+ * @brief The number of different message types (@ref MessageType). Fragment messages are not pooled, their pool remains empty.
+ */
+#define MESSAGE_POOL_NUM_TYPES (static_cast<size_t>(MESSAGE_TYPE_DYNAMIC_MESH_PATCH) + 1)
+
+
+/**
+ * @brief Typed object pools for messages.
+ * @details Messages are acquired by the network thread (producer) and released by the render thread (consumer) after
+ * they have been processed. Released messages are handed back to the producer via a lock-free single-producer/single-consumer
+ * ring for each message type, so that a message object including the capacity of its containers (e.g. vertex and index
+ * buffers of a dynamic mesh) is reused for the next message of the same type. Heap allocations only occur while the
+ * pools are warming up.
+ */
+class MessagePool {
+    public:
+        /**
+         * @brief Construct a new message pool.
+         * @details The pool has to be allocated via @ref Reset.
+         */
+        MessagePool(){}
+
+        /**
+         * @brief Delete all pooled messages.
+         */
+        ~MessagePool(){ Clear(); }
+
+        /**
+         * @brief Reset the pool, delete all pooled messages and allocate the return rings.
+         * @param[in] capacity The maximum number of messages of each type that are kept in the pool. The value is rounded up to the next power of two.
+         * @note This function is not thread-safe and must only be called while neither a producer nor a consumer is active.
+         */
+        void Reset(size_t capacity){
+            Clear();
+            size_t n = 1;
+            while(n < capacity){
+                n <<= 1;
+            }
+            for(auto&& pool : pools){
+                pool.slots = std::vector<std::atomic<MessageBaseType*>>(n);
+                pool.mask = static_cast<uint64_t>(n - 1);
+                pool.freeMessages.reserve(n);
+            }
+        }
+
+        /**
+         * @brief Acquire a message of a given type (producer only).
+         * @param[in] type The type of the message to be acquired.
+         * @return A message of the given type or nullptr if the type is unknown. The content of a reused message is undefined and must be overwritten by @ref MessageBaseType::Deserialize.
+         */
+        MessageBaseType* Acquire(MessageType type){
+            size_t index = static_cast<size_t>(type);
+            if(index >= MESSAGE_POOL_NUM_TYPES){
+                return nullptr;
+            }
+            TypedPool& pool = pools[index];
+            if(pool.freeMessages.empty()){
+                // take all messages that have been released by the consumer
+                uint64_t t = pool.tail.load(std::memory_order_acquire);
+                uint64_t h = pool.head.load(std::memory_order_relaxed);
+                for(; h < t; ++h){
+                    pool.freeMessages.push_back(pool.slots[h & pool.mask].load(std::memory_order_relaxed));
+                }
+                pool.head.store(h, std::memory_order_release);
+            }
+            if(!pool.freeMessages.empty()){
+                MessageBaseType* message = pool.freeMessages.back();
+                pool.freeMessages.pop_back();
+                return message;
+            }
+            return Create(type);
+        }
+
+        /**
+         * @brief Return a message to the pool from within the producer thread, e.g. if it could not be decoded or has been dropped by the message queue.
+         * @param[in] message The message to be returned. The pool takes ownership of the message.
+         */
+        void Recycle(MessageBaseType* message){
+            if(!message){
+                return;
+            }
+            TypedPool& pool = pools[static_cast<size_t>(message->messageType)];
+            if(pool.freeMessages.size() <= pool.mask){
+                pool.freeMessages.push_back(message);
+            }
+            else{
+                delete message;
+            }
+        }
+
+        /**
+         * @brief Return a message to the pool from within the consumer thread after it has been processed.
+         * @param[in] message The message to be returned. The pool takes ownership of the message.
+         * @details If the return ring of the message type is full, the message is deleted.
+         */
+        void Release(MessageBaseType* message){
+            TypedPool& pool = pools[static_cast<size_t>(message->messageType)];
+            uint64_t t = pool.tail.load(std::memory_order_relaxed);
+            if(pool.slots.empty() || ((t - pool.head.load(std::memory_order_acquire)) > pool.mask)){
+                delete message;
+                return;
+            }
+            pool.slots[t & pool.mask].store(message, std::memory_order_relaxed);
+            pool.tail.store(t + 1, std::memory_order_release);
+        }
+
+    private:
+        struct TypedPool {
+            alignas(MESSAGE_QUEUE_CACHE_LINE_SIZE) std::atomic<uint64_t> head;                         // Index of the oldest released message, written by the producer.
+            alignas(MESSAGE_QUEUE_CACHE_LINE_SIZE) std::atomic<uint64_t> tail;                         // Index of the next message to be released, written by the consumer.
+            alignas(MESSAGE_QUEUE_CACHE_LINE_SIZE) std::vector<std::atomic<MessageBaseType*>> slots;   // Return ring from the consumer to the producer.
+            uint64_t mask;                                                                             // Index mask (capacity - 1).
+            std::vector<MessageBaseType*> freeMessages;                                                // Messages that are ready to be reused by the producer.
+            TypedPool(): head(0), tail(0), mask(0){}
+        };
+        std::array<TypedPool, MESSAGE_POOL_NUM_TYPES> pools;   // One pool for each message type.
+
+        /**
+         * @brief Create a new message.
+         * @param[in] type The type of the message to be created.
+         * @return A new message of the given type or nullptr if the type is unknown.
+         */
+        MessageBaseType* Create(MessageType type){
+            switch(type){
+                case MESSAGE_TYPE_CLEAR:               return new ClearMessage();
+                case MESSAGE_TYPE_ENGINE_PARAMETER:    return new EngineParameterMessage();
+                case MESSAGE_TYPE_CAMERA:              return new CameraMessage();
+                case MESSAGE_TYPE_ATMOSPHERE:          return new AtmosphereMessage();
+                case MESSAGE_TYPE_AMBIENT_LIGHT:       return new AmbientLightMessage();
+                case MESSAGE_TYPE_DIRECTIONAL_LIGHT:   return new DirectionalLightMessage();
+                case MESSAGE_TYPE_POINT_LIGHT:         return new PointLightMessage();
+                case MESSAGE_TYPE_SPOT_LIGHT:          return new SpotLightMessage();
+                case MESSAGE_TYPE_MESH:                return new MeshMessage();
+                case MESSAGE_TYPE_WATER_MESH:          return new WaterMeshMessage();
+                case MESSAGE_TYPE_DYNAMIC_MESH:        return new DynamicMeshMessage();
+                case MESSAGE_TYPE_FRAGMENT:            break; // fragments are reassembled by the network thread and never pooled
+                case MESSAGE_TYPE_MESH_POSE:           return new MeshPoseMessage();
+                case MESSAGE_TYPE_DYNAMIC_MESH_PATCH:  return new DynamicMeshPatchMessage();
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Delete all pooled messages and reset all indices.
+         */
+        void Clear(void){
+            for(auto&& pool : pools){
+                for(uint64_t i = pool.head.load(); i < pool.tail.load(); ++i){
+                    delete pool.slots[i & pool.mask].load();
+                }
+                for(auto&& message : pool.freeMessages){
+                    delete message;
+                }
+                pool.freeMessages.clear();
+                pool.head = 0;
+                pool.tail = 0;
+            }
+        }
+};
+
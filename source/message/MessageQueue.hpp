@@ -0,0 +1,270 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <MessageBaseType.hpp>
+
+
+/**
+ * @brief The size of a cache line in bytes that is used to separate data of the producer and the consumer.
+ */
+#define MESSAGE_QUEUE_CACHE_LINE_SIZE (64)
+
+
+/**
+ * @brief Possible actions of the producer if the message queue is full.
+ */
+enum MessageQueueOverflowPolicy : uint8_t {
+    MESSAGE_QUEUE_OVERFLOW_POLICY_BLOCK = 0x00,         // Wait until the consumer has removed messages from the queue.
+    MESSAGE_QUEUE_OVERFLOW_POLICY_DROP_OLDEST = 0x01,   // Drop the oldest message of the queue.
+    MESSAGE_QUEUE_OVERFLOW_POLICY_COALESCE = 0x02       // Drop the oldest message if it is superseded by a newer message (see @ref MessageBaseType::SupersedesAll), otherwise wait.
+};
+
+
+/**
+ * @brief Convert a string to an overflow policy.
+ * @param[out] policy The resulting overflow policy.
+ * @param[in] name The name of the overflow policy, either "block", "dropOldest" or "coalesce".
+ * @return True if success, false if the name is not a valid overflow policy.
+ */
+inline bool MessageQueueOverflowPolicyFromString(MessageQueueOverflowPolicy& policy, const std::string& name){
+    if(0 == name.compare("block")){
+        policy = MESSAGE_QUEUE_OVERFLOW_POLICY_BLOCK;
+        return true;
+    }
+    if(0 == name.compare("dropOldest")){
+        policy = MESSAGE_QUEUE_OVERFLOW_POLICY_DROP_OLDEST;
+        return true;
+    }
+    if(0 == name.compare("coalesce")){
+        policy = MESSAGE_QUEUE_OVERFLOW_POLICY_COALESCE;
+        return true;
+    }
+    return false;
+}
+
+
+/**
+ * @brief Statistics of a message queue.
+ */
+struct MessageQueueStatistics {
+    size_t capacity;          // Maximum number of messages that can be stored in the queue.
+    size_t depth;             // Number of messages that are currently in the queue.
+    size_t maxDepth;          // Maximum number of messages that have been in the queue at once.
+    uint64_t numPushed;       // Total number of messages that have been pushed to the queue.
+    uint64_t numDropped;      // Number of messages that have been dropped because the queue was full.
+    uint64_t numCoalesced;    // Number of messages that have been dropped because they were superseded by newer messages.
+    uint64_t numBlocked;      // Number of push operations that had to wait for the consumer.
+};
+
+
+/**
+ * @brief A bounded lock-free single-producer/single-consumer ring of messages.
+ * @details The producer inserts messages via @ref Push and the consumer removes all messages at once via @ref PopAll.
+ * Both indices grow monotonically. The consumer claims messages by a compare-and-swap on the head index, which allows the
+ * producer to drop the oldest message in case of an overflow without taking a lock. A message is owned by the queue
+ * between @ref Push and @ref PopAll. Messages that are dropped are returned to the producer by @ref Push.
+ */
+class MessageQueue {
+    public:
+        /**
+         * @brief Construct a new message queue.
+         * @details The queue has to be allocated via @ref Reset.
+         */
+        MessageQueue(): head(0), tail(0), mask(0), policy(MESSAGE_QUEUE_OVERFLOW_POLICY_BLOCK), producerTail(0), producerHead(0), maxDepth(0), numDropped(0), numCoalesced(0), numBlocked(0), closed(false){}
+
+        /**
+         * @brief Delete all remaining messages.
+         */
+        ~MessageQueue(){ Clear(); }
+
+        /**
+         * @brief Reset the queue, delete all remaining messages and allocate a new ring.
+         * @param[in] capacity The number of messages that can be stored in the queue. The value is rounded up to the next power of two.
+         * @param[in] policy The overflow policy to be used if the queue is full.
+         * @note This function is not thread-safe and must only be called while neither a producer nor a consumer is active.
+         */
+        void Reset(size_t capacity, MessageQueueOverflowPolicy policy){
+            Clear();
+            size_t n = 1;
+            while(n < capacity){
+                n <<= 1;
+            }
+            slots = std::vector<std::atomic<MessageBaseType*>>(n);
+            keys.assign(n, 0);
+            mask = static_cast<uint64_t>(n - 1);
+            this->policy = policy;
+            closed = false;
+        }
+
+        /**
+         * @brief Close the queue. A producer that waits for free space returns immediately and all further messages are dropped.
+         */
+        void Close(void){ closed = true; }
+
+        /**
+         * @brief Insert a message to the queue (producer only).
+         * @param[in] message The message to be inserted. The queue takes ownership of the message.
+         * @param[in] reliable True if the oldest message must not be dropped to make room for this message, e.g. because it has been received via a reliable stream. The producer waits instead, except for superseded messages if the policy is @ref MESSAGE_QUEUE_OVERFLOW_POLICY_COALESCE.
+         * @return The message that has been dropped due to the overflow policy or nullptr if no message has been dropped. The caller takes ownership of the dropped message.
+         */
+        MessageBaseType* Push(MessageBaseType* message, bool reliable = false){
+            if(slots.empty() || closed){
+                numDropped.fetch_add(1, std::memory_order_relaxed);
+                return message;
+            }
+            MessageBaseType* droppedMessage = nullptr;
+            uint64_t key = message->GetCoalescingKey();
+            bool supersedesAll = key && message->SupersedesAll();
+            bool waiting = false;
+            while((producerTail - producerHead) > mask){
+                producerHead = head.load(std::memory_order_acquire);
+                if((producerTail - producerHead) <= mask){
+                    break;
+                }
+                if(!reliable && (MESSAGE_QUEUE_OVERFLOW_POLICY_DROP_OLDEST == policy)){
+                    if(TryDrop(producerHead, droppedMessage)){
+                        numDropped.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    continue;
+                }
+                if(MESSAGE_QUEUE_OVERFLOW_POLICY_COALESCE == policy){
+                    uint64_t oldestKey = keys[producerHead & mask];
+                    if(oldestKey && ((supersedesAll && (oldestKey == key)) || IsSuperseded(oldestKey, producerHead))){
+                        if(TryDrop(producerHead, droppedMessage)){
+                            numCoalesced.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        continue;
+                    }
+                }
+                if(closed){
+                    numDropped.fetch_add(1, std::memory_order_relaxed);
+                    return message;
+                }
+                if(!waiting){
+                    waiting = true;
+                    numBlocked.fetch_add(1, std::memory_order_relaxed);
+                }
+                std::this_thread::yield();
+            }
+            slots[producerTail & mask].store(message, std::memory_order_relaxed);
+            keys[producerTail & mask] = key;
+            if(supersedesAll){
+                latestIndex.insert_or_assign(key, producerTail);
+            }
+            producerTail++;
+            tail.store(producerTail, std::memory_order_release);
+            size_t depth = static_cast<size_t>(producerTail - producerHead);
+            if(depth > maxDepth.load(std::memory_order_relaxed)){
+                maxDepth.store(depth, std::memory_order_relaxed);
+            }
+            return droppedMessage;
+        }
+
+        /**
+         * @brief Remove all messages from the queue (consumer only).
+         * @param[inout] messages Container to which all messages of the queue are appended in the order of insertion.
+         * @note The caller takes ownership of the messages, make sure to delete them!
+         */
+        void PopAll(std::vector<MessageBaseType*>& messages){
+            size_t initialSize = messages.size();
+            uint64_t h = head.load(std::memory_order_acquire);
+            for(;;){
+                uint64_t t = tail.load(std::memory_order_acquire);
+                for(uint64_t i = h; i < t; ++i){
+                    messages.push_back(slots[i & mask].load(std::memory_order_relaxed));
+                }
+                if(head.compare_exchange_strong(h, t, std::memory_order_acq_rel, std::memory_order_acquire)){
+                    break;
+                }
+                messages.resize(initialSize); // the producer dropped messages in the meantime: h has been updated, try again
+            }
+        }
+
+        /**
+         * @brief Get the statistics of this queue.
+         * @return Current statistics.
+         * @details The values are read without synchronization and may be slightly outdated.
+         */
+        MessageQueueStatistics GetStatistics(void) const {
+            MessageQueueStatistics result;
+            uint64_t h = head.load(std::memory_order_relaxed);
+            uint64_t t = tail.load(std::memory_order_relaxed);
+            result.capacity = slots.size();
+            result.depth = (t > h) ? static_cast<size_t>(t - h) : 0;
+            result.maxDepth = maxDepth.load(std::memory_order_relaxed);
+            result.numPushed = t;
+            result.numDropped = numDropped.load(std::memory_order_relaxed);
+            result.numCoalesced = numCoalesced.load(std::memory_order_relaxed);
+            result.numBlocked = numBlocked.load(std::memory_order_relaxed);
+            return result;
+        }
+
+    private:
+        /* shared indices, each on a separate cache line */
+        alignas(MESSAGE_QUEUE_CACHE_LINE_SIZE) std::atomic<uint64_t> head;   // Index of the oldest message, written by the consumer (and by the producer when dropping).
+        alignas(MESSAGE_QUEUE_CACHE_LINE_SIZE) std::atomic<uint64_t> tail;   // Index of the next message to be inserted, written by the producer.
+
+        /* ring storage, only changed during @ref Reset */
+        alignas(MESSAGE_QUEUE_CACHE_LINE_SIZE) std::vector<std::atomic<MessageBaseType*>> slots;   // Message pointers of the ring.
+        uint64_t mask;                                                                             // Index mask (capacity - 1).
+        MessageQueueOverflowPolicy policy;                                                         // The overflow policy.
+
+        /* producer data */
+        alignas(MESSAGE_QUEUE_CACHE_LINE_SIZE) uint64_t producerTail;   // Local copy of @ref tail.
+        uint64_t producerHead;                                          // Cached value of @ref head, only reloaded if the ring seems to be full.
+        std::vector<uint64_t> keys;                                     // Coalescing key for each slot of the ring.
+        std::unordered_map<uint64_t, uint64_t> latestIndex;             // Index of the latest message that has been inserted for a coalescing key and that supersedes all older messages.
+        std::atomic<size_t> maxDepth;                                   // Maximum number of messages that have been in the queue at once.
+        std::atomic<uint64_t> numDropped;                               // Number of dropped messages.
+        std::atomic<uint64_t> numCoalesced;                             // Number of coalesced messages.
+        std::atomic<uint64_t> numBlocked;                               // Number of push operations that had to wait.
+        std::atomic<bool> closed;                                       // True if the queue has been closed.
+
+        /**
+         * @brief Check whether a message with a given coalescing key has been superseded by a newer message in the queue.
+         * @param[in] key The coalescing key of the message.
+         * @param[in] index The index of the message.
+         * @return True if a newer message with the same key that supersedes all older messages has been inserted.
+         */
+        bool IsSuperseded(uint64_t key, uint64_t index) const {
+            auto it = latestIndex.find(key);
+            return (it != latestIndex.end()) && (it->second > index);
+        }
+
+        /**
+         * @brief Try to drop the oldest message of the queue (producer only).
+         * @param[in] index The index of the oldest message.
+         * @param[out] droppedMessage The message that has been dropped.
+         * @return True if the message has been dropped, false if the consumer has removed it in the meantime.
+         */
+        bool TryDrop(uint64_t index, MessageBaseType*& droppedMessage){
+            MessageBaseType* message = slots[index & mask].load(std::memory_order_relaxed);
+            if(head.compare_exchange_strong(index, index + 1, std::memory_order_acq_rel, std::memory_order_acquire)){
+                droppedMessage = message;
+                producerHead = index + 1;
+                return true;
+            }
+            producerHead = index;
+            return false;
+        }
+
+        /**
+         * @brief Delete all remaining messages and reset all indices and counters.
+         */
+        void Clear(void){
+            for(uint64_t i = head.load(); i < tail.load(); ++i){
+                delete slots[i & mask].load();
+            }
+            head = 0;
+            tail = 0;
+            producerTail = 0;
+            producerHead = 0;
+            latestIndex.clear();
+            maxDepth = 0;
+            numDropped = 0;
+            numCoalesced = 0;
+            numBlocked = 0;
+        }
+};
+
@@ -90,5 +90,11 @@ class PointLightMessage: public MessageBaseType {
             valid &= std::isfinite(pointLight.invRadiusPow4);
             return valid;
         }
+
+        /**
+         * @brief Get the key that identifies the state that is set by this message.
+         * @return The coalescing key of this message.
+         */
+        uint64_t GetCoalescingKey(void) const { return MakeCoalescingKey(pointLightID); }
 };
 
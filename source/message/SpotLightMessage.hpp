@@ -103,5 +103,11 @@ class SpotLightMessage: public MessageBaseType {
             valid &= std::isfinite(spotLight.cosOuterCutOffAngle);
             return valid;
         }
+
+        /**
+         * @brief Get the key that identifies the state that is set by this message.
+         * @return The coalescing key of this message.
+         */
+        uint64_t GetCoalescingKey(void) const { return MakeCoalescingKey(spotLightID); }
 };
 
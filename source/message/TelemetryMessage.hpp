@@ -0,0 +1,174 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <RenderPass.hpp>
+#include <CuboidFrustumCuller.hpp>
+#include <LatencyHistogram.hpp>
+#include <NetworkUtils.hpp>
+
+
+/**
+ * @brief Protocol definition for the telemetry message.
+ */
+#pragma pack(push, 1)
+union TelemetryMessageUnion {
+    struct TelemetryMessageStruct {
+        char header[6];                              // Header, must be "PRISMT".
+        uint32_t sequenceNumber;                     // Sequence number, incremented with each telemetry message.
+        uint32_t numberOfFrames;                     // Number of frames that have been rendered during the telemetry period.
+        float frameTimeMean;                         // Mean frame time during the telemetry period in milliseconds.
+        float frameTimeP50;                          // 50th percentile of the frame time in milliseconds.
+        float frameTimeP95;                          // 95th percentile of the frame time in milliseconds.
+        float frameTimeP99;                          // 99th percentile of the frame time in milliseconds.
+        float frameTimeMax;                          // Maximum frame time in milliseconds.
+        uint8_t gpuPassTimesValid:1;                 // bit0: True if GPU pass times are measured.
+        uint8_t gpuMemoryValid:1;                    // bit1: True if the GPU memory is reported by the driver.
+        uint8_t unused:6;                            // bit2-bit7: unused.
+        float gpuPassTimes[RENDER_PASS_COUNT];       // GPU time of each render pass in milliseconds, see @ref RenderPass.
+        uint32_t numberOfVisibleMeshes;              // Number of meshes that passed frustum culling.
+        uint32_t numberOfCulledMeshes;               // Number of meshes that have been culled.
+        uint32_t numberOfVisibleDynamicMeshes;       // Number of dynamic meshes that passed frustum culling.
+        uint32_t numberOfCulledDynamicMeshes;        // Number of dynamic meshes that have been culled.
+        uint32_t numberOfVisiblePointLights;         // Number of point lights that passed frustum culling.
+        uint32_t numberOfCulledPointLights;          // Number of point lights that have been culled.
+        uint32_t numberOfVisibleSpotLights;          // Number of spot lights that passed frustum culling.
+        uint32_t numberOfCulledSpotLights;           // Number of spot lights that have been culled.
+        uint32_t messageQueueDepth;                  // Number of messages in the message queue.
+        uint32_t messageQueueMaxDepth;               // Maximum number of messages in the message queue so far.
+        uint32_t numberOfDroppedMessages;            // Number of messages that have been dropped because the queue was full.
+        uint32_t meshLoaderBacklog;                  // Number of mesh files that wait to be loaded or that are being loaded.
+        uint32_t gpuMemoryUsed;                      // Used dedicated GPU memory in KiB.
+        uint32_t gpuMemoryAvailable;                 // Available dedicated GPU memory in KiB.
+        uint32_t numberOfAppliedMessages;            // Number of messages that have been applied during the telemetry period.
+        float receiveToApplyMean;                    // Mean latency from receiving a message until it is applied in milliseconds.
+        float receiveToApplyP50;                     // 50th percentile of the receive→apply latency in milliseconds.
+        float receiveToApplyP99;                     // 99th percentile of the receive→apply latency in milliseconds.
+        float receiveToApplyMax;                     // Maximum receive→apply latency in milliseconds.
+        float applyToSwapMean;                       // Mean latency from applying a message until the frame is swapped in milliseconds.
+        float applyToSwapP50;                        // 50th percentile of the apply→swap latency in milliseconds.
+        float applyToSwapP99;                        // 99th percentile of the apply→swap latency in milliseconds.
+        float applyToSwapMax;                        // Maximum apply→swap latency in milliseconds.
+    } protocol;
+    uint8_t bytes[sizeof(TelemetryMessageUnion::TelemetryMessageStruct)];
+};
+#pragma pack(pop)
+
+
+/**
+ * @brief Summary of the latencies of a telemetry period.
+ */
+struct TelemetryLatency {
+    float mean;   // Mean latency in milliseconds.
+    float p50;    // 50th percentile in milliseconds.
+    float p99;    // 99th percentile in milliseconds.
+    float max;    // Maximum latency in milliseconds.
+
+    /**
+     * @brief Construct a new latency summary with all values being zero.
+     */
+    TelemetryLatency(): mean(0.0f), p50(0.0f), p99(0.0f), max(0.0f){}
+
+    /**
+     * @brief Set the latency summary from a histogram.
+     * @param[in] histogram The histogram of latencies.
+     * @return Reference to this summary.
+     */
+    TelemetryLatency& operator=(const LatencyHistogram& histogram){
+        mean = static_cast<float>(histogram.GetMean());
+        p50 = static_cast<float>(histogram.GetPercentile(0.5));
+        p99 = static_cast<float>(histogram.GetPercentile(0.99));
+        max = static_cast<float>(histogram.GetMax());
+        return *this;
+    }
+};
+
+
+/**
+ * @brief Represents the telemetry message to be send from PRISMA.
+ * @details Times are given in milliseconds, culling statistics refer to the main view of the latest frame.
+ */
+class TelemetryMessage {
+    public:
+        uint32_t sequenceNumber;                                  // Sequence number, incremented with each telemetry message.
+        uint32_t numberOfFrames;                                  // Number of frames that have been rendered during the telemetry period.
+        float frameTimeMean;                                      // Mean frame time in milliseconds.
+        float frameTimeP50;                                       // 50th percentile of the frame time in milliseconds.
+        float frameTimeP95;                                       // 95th percentile of the frame time in milliseconds.
+        float frameTimeP99;                                       // 99th percentile of the frame time in milliseconds.
+        float frameTimeMax;                                       // Maximum frame time in milliseconds.
+        bool gpuPassTimesValid;                                   // True if @ref gpuPassTimes contains measured values.
+        std::array<float, RENDER_PASS_COUNT> gpuPassTimes;        // GPU time of each render pass in milliseconds.
+        CullingStatistics meshes;                                 // Culling statistics of meshes.
+        CullingStatistics dynamicMeshes;                          // Culling statistics of dynamic meshes.
+        CullingStatistics pointLights;                            // Culling statistics of point lights.
+        CullingStatistics spotLights;                             // Culling statistics of spot lights.
+        uint32_t messageQueueDepth;                               // Number of messages in the message queue.
+        uint32_t messageQueueMaxDepth;                            // Maximum number of messages in the message queue so far.
+        uint32_t numberOfDroppedMessages;                         // Number of messages that have been dropped because the queue was full.
+        uint32_t meshLoaderBacklog;                               // Number of mesh files that wait to be loaded or that are being loaded.
+        bool gpuMemoryValid;                                      // True if @ref gpuMemoryUsed and @ref gpuMemoryAvailable are reported by the driver.
+        uint32_t gpuMemoryUsed;                                   // Used dedicated GPU memory in KiB.
+        uint32_t gpuMemoryAvailable;                              // Available dedicated GPU memory in KiB.
+        uint32_t numberOfAppliedMessages;                         // Number of messages that have been applied during the telemetry period.
+        TelemetryLatency receiveToApply;                          // Latency from receiving a message until it is applied by the render thread.
+        TelemetryLatency applyToSwap;                             // Latency from applying a message until the frame is swapped.
+
+        /**
+         * @brief Construct a new telemetry message.
+         */
+        TelemetryMessage(): sequenceNumber(0), numberOfFrames(0), frameTimeMean(0.0f), frameTimeP50(0.0f), frameTimeP95(0.0f), frameTimeP99(0.0f), frameTimeMax(0.0f), gpuPassTimesValid(false), messageQueueDepth(0), messageQueueMaxDepth(0), numberOfDroppedMessages(0), meshLoaderBacklog(0), gpuMemoryValid(false), gpuMemoryUsed(0), gpuMemoryAvailable(0), numberOfAppliedMessages(0){ gpuPassTimes.fill(0.0f); }
+
+        /**
+         * @brief Serialize the message.
+         * @param[out] bytes Bytes representing the binary message. The capacity of the container is reused.
+         */
+        void Serialize(std::vector<uint8_t>& bytes){
+            TelemetryMessageUnion msg;
+            msg.protocol.header[0]                    = 'P';
+            msg.protocol.header[1]                    = 'R';
+            msg.protocol.header[2]                    = 'I';
+            msg.protocol.header[3]                    = 'S';
+            msg.protocol.header[4]                    = 'M';
+            msg.protocol.header[5]                    = 'T';
+            msg.protocol.sequenceNumber               = NetworkUtils::NetworkToNativeByteOrder(sequenceNumber);
+            msg.protocol.numberOfFrames               = NetworkUtils::NetworkToNativeByteOrder(numberOfFrames);
+            msg.protocol.frameTimeMean                = NetworkUtils::NetworkToNativeByteOrder(frameTimeMean);
+            msg.protocol.frameTimeP50                 = NetworkUtils::NetworkToNativeByteOrder(frameTimeP50);
+            msg.protocol.frameTimeP95                 = NetworkUtils::NetworkToNativeByteOrder(frameTimeP95);
+            msg.protocol.frameTimeP99                 = NetworkUtils::NetworkToNativeByteOrder(frameTimeP99);
+            msg.protocol.frameTimeMax                 = NetworkUtils::NetworkToNativeByteOrder(frameTimeMax);
+            msg.protocol.gpuPassTimesValid            = gpuPassTimesValid;
+            msg.protocol.gpuMemoryValid               = gpuMemoryValid;
+            msg.protocol.unused                       = 0;
+            for(size_t i = 0; i < gpuPassTimes.size(); ++i){
+                msg.protocol.gpuPassTimes[i]          = NetworkUtils::NetworkToNativeByteOrder(gpuPassTimes[i]);
+            }
+            msg.protocol.numberOfVisibleMeshes        = NetworkUtils::NetworkToNativeByteOrder(meshes.numVisible);
+            msg.protocol.numberOfCulledMeshes         = NetworkUtils::NetworkToNativeByteOrder(meshes.numCulled);
+            msg.protocol.numberOfVisibleDynamicMeshes = NetworkUtils::NetworkToNativeByteOrder(dynamicMeshes.numVisible);
+            msg.protocol.numberOfCulledDynamicMeshes  = NetworkUtils::NetworkToNativeByteOrder(dynamicMeshes.numCulled);
+            msg.protocol.numberOfVisiblePointLights   = NetworkUtils::NetworkToNativeByteOrder(pointLights.numVisible);
+            msg.protocol.numberOfCulledPointLights    = NetworkUtils::NetworkToNativeByteOrder(pointLights.numCulled);
+            msg.protocol.numberOfVisibleSpotLights    = NetworkUtils::NetworkToNativeByteOrder(spotLights.numVisible);
+            msg.protocol.numberOfCulledSpotLights     = NetworkUtils::NetworkToNativeByteOrder(spotLights.numCulled);
+            msg.protocol.messageQueueDepth            = NetworkUtils::NetworkToNativeByteOrder(messageQueueDepth);
+            msg.protocol.messageQueueMaxDepth         = NetworkUtils::NetworkToNativeByteOrder(messageQueueMaxDepth);
+            msg.protocol.numberOfDroppedMessages      = NetworkUtils::NetworkToNativeByteOrder(numberOfDroppedMessages);
+            msg.protocol.meshLoaderBacklog            = NetworkUtils::NetworkToNativeByteOrder(meshLoaderBacklog);
+            msg.protocol.gpuMemoryUsed                = NetworkUtils::NetworkToNativeByteOrder(gpuMemoryUsed);
+            msg.protocol.gpuMemoryAvailable           = NetworkUtils::NetworkToNativeByteOrder(gpuMemoryAvailable);
+            msg.protocol.numberOfAppliedMessages      = NetworkUtils::NetworkToNativeByteOrder(numberOfAppliedMessages);
+            msg.protocol.receiveToApplyMean           = NetworkUtils::NetworkToNativeByteOrder(receiveToApply.mean);
+            msg.protocol.receiveToApplyP50            = NetworkUtils::NetworkToNativeByteOrder(receiveToApply.p50);
+            msg.protocol.receiveToApplyP99            = NetworkUtils::NetworkToNativeByteOrder(receiveToApply.p99);
+            msg.protocol.receiveToApplyMax            = NetworkUtils::NetworkToNativeByteOrder(receiveToApply.max);
+            msg.protocol.applyToSwapMean              = NetworkUtils::NetworkToNativeByteOrder(applyToSwap.mean);
+            msg.protocol.applyToSwapP50               = NetworkUtils::NetworkToNativeByteOrder(applyToSwap.p50);
+            msg.protocol.applyToSwapP99               = NetworkUtils::NetworkToNativeByteOrder(applyToSwap.p99);
+            msg.protocol.applyToSwapMax               = NetworkUtils::NetworkToNativeByteOrder(applyToSwap.max);
+            bytes.resize(sizeof(msg));
+            std::memcpy(&bytes[0], &msg.bytes[0], sizeof(msg));
+        }
+};
+
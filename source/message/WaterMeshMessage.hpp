@@ -70,6 +70,84 @@ class WaterMeshMessage: public MessageBaseType {
          * @return The number of bytes that have been deserialized.
          */
         int32_t Deserialize(const uint8_t* bytes, int32_t length){
+            return DeserializeMessage(bytes, length, false);
+        }
+
+        /**
+         * @brief Deserialize a message that has been reassembled from fragments.
+         * @param[in] bytes The bytes containing the message.
+         * @param[in] length The number of bytes containing the message to be deserialized.
+         * @return The number of bytes that have been deserialized.
+         * @details The number of polygons and the number of vertices of each polygon are 32-bit values.
+         */
+        int32_t DeserializeLarge(const uint8_t* bytes, int32_t length){
+            return DeserializeMessage(bytes, length, true);
+        }
+
+        /**
+         * @brief Check if the message is valid.
+         * @return True if the message is valid, false otherwise.
+         */
+        bool IsValid(void){
+            bool valid = true;
+            valid &= std::isfinite(parameter.position.x);
+            valid &= std::isfinite(parameter.position.y);
+            valid &= std::isfinite(parameter.position.z);
+            valid &= std::isfinite(parameter.textureCoordinateScaling1);
+            valid &= std::isfinite(parameter.textureCoordinateScaling2);
+            valid &= std::isfinite(parameter.textureCoordinateAnimation1.x);
+            valid &= std::isfinite(parameter.textureCoordinateAnimation1.y);
+            valid &= std::isfinite(parameter.textureCoordinateAnimation2.x);
+            valid &= std::isfinite(parameter.textureCoordinateAnimation2.y);
+            valid &= std::isfinite(parameter.specularColor.r);
+            valid &= std::isfinite(parameter.specularColor.g);
+            valid &= std::isfinite(parameter.specularColor.b);
+            valid &= std::isfinite(parameter.shininess);
+            valid &= std::isfinite(parameter.reflectionColorMultiplier.r);
+            valid &= std::isfinite(parameter.reflectionColorMultiplier.g);
+            valid &= std::isfinite(parameter.reflectionColorMultiplier.b);
+            valid &= std::isfinite(parameter.refractionColorMultiplier.r);
+            valid &= std::isfinite(parameter.refractionColorMultiplier.g);
+            valid &= std::isfinite(parameter.refractionColorMultiplier.b);
+            valid &= std::isfinite(parameter.clippingPlaneOffset);
+            valid &= std::isfinite(parameter.strengthDuDvNormal1.x);
+            valid &= std::isfinite(parameter.strengthDuDvNormal1.y);
+            valid &= std::isfinite(parameter.strengthDuDvNormal2.x);
+            valid &= std::isfinite(parameter.strengthDuDvNormal2.y);
+            valid &= std::isfinite(parameter.distortionWaterDepthScale);
+            return valid;
+        }
+
+        /**
+         * @brief Get the key that identifies the state that is set by this message.
+         * @return The coalescing key of this message.
+         */
+        uint64_t GetCoalescingKey(void) const { return MakeCoalescingKey(0); }
+
+        /**
+         * @brief Check whether this message makes an older water mesh message obsolete.
+         * @param[in] older An older water mesh message.
+         * @return True if this message replaces the mesh data or if the older message does not change the mesh data.
+         */
+        bool Supersedes(const MessageBaseType& older) const { return updateMesh || !static_cast<const WaterMeshMessage&>(older).updateMesh; }
+
+        /**
+         * @brief Check whether this message makes any older water mesh message obsolete.
+         * @return True if this message replaces the mesh data.
+         */
+        bool SupersedesAll(void) const { return updateMesh; }
+
+    private:
+        NonConvexPolygon polygon;   // Polygon that is reused for the triangulation of all polygons of all messages.
+
+        /**
+         * @brief Deserialize the message.
+         * @param[in] bytes The bytes containing the message.
+         * @param[in] length The number of bytes containing the message to be deserialized.
+         * @param[in] largeCounts True if the number of polygons and the number of vertices are 32-bit values, false if they are 16-bit values.
+         * @return The number of bytes that have been deserialized.
+         */
+        int32_t DeserializeMessage(const uint8_t* bytes, int32_t length, bool largeCounts){
             if(length < static_cast<int32_t>(sizeof(WaterMeshMessageUnion))){
                 return 0;
             }
@@ -106,67 +184,45 @@ class WaterMeshMessage: public MessageBaseType {
             parameter.distortionWaterDepthScale     = NetworkUtils::NetworkToNativeByteOrder(msg->protocol.distortionWaterDepthScale);
 
             // deserialize variable mesh data
-            int32_t result = static_cast<int32_t>(sizeof(WaterMeshMessageUnion));
-            if((result + 2) > length){
+            const size_t countSize = largeCounts ? sizeof(uint32_t) : sizeof(uint16_t);
+            size_t result = sizeof(WaterMeshMessageUnion);
+            if((result + countSize) > static_cast<size_t>(length)){
                 return 0;
             }
-            int32_t numPolygons = static_cast<int32_t>(NetworkUtils::NetworkToNativeByteOrder(*reinterpret_cast<const uint16_t*>(&bytes[result])));
-            result += 2;
+            size_t numPolygons = ReadCount(&bytes[result], largeCounts);
+            result += countSize;
             meshVertices.clear();
             meshIndices.clear();
-            for(int32_t p = 0; p < numPolygons; ++p){
-                if((result + 2) > length){
+            polygon.verticesAndHoles.resize(1);
+            for(size_t p = 0; p < numPolygons; ++p){
+                if((result + countSize) > static_cast<size_t>(length)){
                     return 0;
                 }
-                int32_t numVertices = static_cast<int32_t>(NetworkUtils::NetworkToNativeByteOrder(*reinterpret_cast<const uint16_t*>(&bytes[result])));
-                result += 2;
+                size_t numVertices = ReadCount(&bytes[result], largeCounts);
+                result += countSize;
                 if((result + numVertices * sizeof(WaterMeshMessageVertexUnion)) > static_cast<size_t>(length)){
                     return 0;
                 }
-                NonConvexPolygon polygon;
-                polygon.verticesAndHoles.resize(1);
-                for(int32_t v = 0; v < numVertices; ++v){
-                    const WaterMeshMessageVertexUnion* vertex = reinterpret_cast<const WaterMeshMessageVertexUnion*>(&bytes[result]);
-                    polygon.verticesAndHoles[0].push_back({NetworkUtils::NetworkToNativeByteOrder(vertex->point.x), NetworkUtils::NetworkToNativeByteOrder(vertex->point.y)});
-                    result += sizeof(WaterMeshMessageVertexUnion);
-                }
+                static_assert(sizeof(std::array<GLfloat,2>) == sizeof(WaterMeshMessageVertexUnion));
+                polygon.verticesAndHoles[0].resize(numVertices);
+                NetworkUtils::ReadNetworkByteOrderArray32(polygon.verticesAndHoles[0].data(), &bytes[result], 2 * numVertices);
+                result += numVertices * sizeof(WaterMeshMessageVertexUnion);
                 polygon.Triangulate(meshVertices, meshIndices);
             }
-            return result;
+            return static_cast<int32_t>(result);
         }
 
         /**
-         * @brief Check if the message is valid.
-         * @return True if the message is valid, false otherwise.
+         * @brief Read a count value from the message.
+         * @param[in] bytes The bytes containing the value in network byte order.
+         * @param[in] largeCounts True if the value is a 32-bit value, false if it is a 16-bit value.
+         * @return The value in native byte order.
          */
-        bool IsValid(void){
-            bool valid = true;
-            valid &= std::isfinite(parameter.position.x);
-            valid &= std::isfinite(parameter.position.y);
-            valid &= std::isfinite(parameter.position.z);
-            valid &= std::isfinite(parameter.textureCoordinateScaling1);
-            valid &= std::isfinite(parameter.textureCoordinateScaling2);
-            valid &= std::isfinite(parameter.textureCoordinateAnimation1.x);
-            valid &= std::isfinite(parameter.textureCoordinateAnimation1.y);
-            valid &= std::isfinite(parameter.textureCoordinateAnimation2.x);
-            valid &= std::isfinite(parameter.textureCoordinateAnimation2.y);
-            valid &= std::isfinite(parameter.specularColor.r);
-            valid &= std::isfinite(parameter.specularColor.g);
-            valid &= std::isfinite(parameter.specularColor.b);
-            valid &= std::isfinite(parameter.shininess);
-            valid &= std::isfinite(parameter.reflectionColorMultiplier.r);
-            valid &= std::isfinite(parameter.reflectionColorMultiplier.g);
-            valid &= std::isfinite(parameter.reflectionColorMultiplier.b);
-            valid &= std::isfinite(parameter.refractionColorMultiplier.r);
-            valid &= std::isfinite(parameter.refractionColorMultiplier.g);
-            valid &= std::isfinite(parameter.refractionColorMultiplier.b);
-            valid &= std::isfinite(parameter.clippingPlaneOffset);
-            valid &= std::isfinite(parameter.strengthDuDvNormal1.x);
-            valid &= std::isfinite(parameter.strengthDuDvNormal1.y);
-            valid &= std::isfinite(parameter.strengthDuDvNormal2.x);
-            valid &= std::isfinite(parameter.strengthDuDvNormal2.y);
-            valid &= std::isfinite(parameter.distortionWaterDepthScale);
-            return valid;
+        size_t ReadCount(const uint8_t* bytes, bool largeCounts) const {
+            if(largeCounts){
+                return static_cast<size_t>(NetworkUtils::NetworkToNativeByteOrder(*reinterpret_cast<const uint32_t*>(bytes)));
+            }
+            return static_cast<size_t>(NetworkUtils::NetworkToNativeByteOrder(*reinterpret_cast<const uint16_t*>(bytes)));
         }
 };
 
@@ -60,9 +60,9 @@ class WindowEventMessage {
 
         /**
          * @brief Serialize the message.
-         * @return Bytes representing the binary message.
+         * @param[out] bytes Bytes representing the binary message. The capacity of the container is reused.
          */
-        std::vector<uint8_t> Serialize(void){
+        void Serialize(std::vector<uint8_t>& bytes){
             eventContainer.LimitNumberOfEvents(255);
             WindowEventMessageUnion msg;
             msg.protocol.header[0]                  = 'P';
@@ -79,7 +79,6 @@ class WindowEventMessage {
             msg.protocol.numberOfMouseButtonEvents  = static_cast<uint8_t>(eventContainer.mouseButtonEvents.size());
             msg.protocol.numberOfCursorEvents       = static_cast<uint8_t>(eventContainer.cursorEvents.size());
             msg.protocol.numberOfScrollEvents       = static_cast<uint8_t>(eventContainer.scrollEvents.size());
-            std::vector<uint8_t> bytes;
             bytes.resize(sizeof(WindowEventMessageUnion) + (eventContainer.keyEvents.size() + eventContainer.mouseButtonEvents.size()) * sizeof(WindowEventDataI3Union) + (eventContainer.cursorEvents.size() + eventContainer.scrollEvents.size()) * sizeof(WindowEventDataD2Union));
             std::memcpy(&bytes[0], &msg.bytes[0], sizeof(msg));
             size_t offset = sizeof(msg);
@@ -113,7 +112,6 @@ class WindowEventMessage {
                 std::memcpy(&bytes[offset], &msgD2.bytes[0], sizeof(msgD2));
                 offset += sizeof(msgD2);
             }
-            return bytes;
         }
 };
 
@@ -0,0 +1,95 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <IPAddress.hpp>
+
+
+/**
+ * @brief A ring of receive buffers that can be filled by a single @ref UDPSocket::ReceiveMany call.
+ * @details Under linux the batch additionally holds the message headers required for recvmmsg(), so that no memory has to be
+ * allocated while receiving.
+ */
+class DatagramBatch {
+    public:
+        /**
+         * @brief Construct a new datagram batch.
+         * @details The buffers have to be allocated by @ref Resize.
+         */
+        DatagramBatch(): numDatagrams(0), bufferSize(0){}
+
+        /**
+         * @brief Allocate the buffer ring.
+         * @param[in] batchSize The number of datagrams that can be received at once (at least 1).
+         * @param[in] bufferSize The size of a single receive buffer in bytes (maximum datagram size).
+         */
+        void Resize(size_t batchSize, size_t bufferSize){
+            batchSize = std::max(batchSize, static_cast<size_t>(1));
+            this->bufferSize = bufferSize;
+            buffer.assign(batchSize * bufferSize, 0);
+            lengths.assign(batchSize, 0);
+            sources.assign(batchSize, IPAddress());
+            #ifdef __linux__
+            headers.assign(batchSize, mmsghdr{});
+            vectors.assign(batchSize, iovec{});
+            addresses.assign(batchSize, sockaddr_in{});
+            for(size_t n = 0; n < batchSize; ++n){
+                vectors[n].iov_base = &buffer[n * bufferSize];
+                vectors[n].iov_len = bufferSize;
+                headers[n].msg_hdr.msg_iov = &vectors[n];
+                headers[n].msg_hdr.msg_iovlen = 1;
+                headers[n].msg_hdr.msg_name = &addresses[n];
+                headers[n].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            }
+            #endif
+            numDatagrams = 0;
+        }
+
+        /**
+         * @brief Get the maximum number of datagrams that can be stored in this batch.
+         * @return Number of receive buffers.
+         */
+        size_t Capacity(void) const { return lengths.size(); }
+
+        /**
+         * @brief Get the number of datagrams that have been received by the last @ref UDPSocket::ReceiveMany call.
+         * @return Number of valid datagrams in this batch.
+         */
+        size_t Size(void) const { return numDatagrams; }
+
+        /**
+         * @brief Get the bytes of a received datagram.
+         * @param[in] n Index of the datagram, must be less than @ref Size.
+         * @return Pointer to the first byte of the datagram.
+         */
+        const uint8_t* GetBytes(size_t n) const { return &buffer[n * bufferSize]; }
+
+        /**
+         * @brief Get the length of a received datagram.
+         * @param[in] n Index of the datagram, must be less than @ref Size.
+         * @return Number of bytes of the datagram.
+         */
+        int32_t GetLength(size_t n) const { return lengths[n]; }
+
+        /**
+         * @brief Get the source address of a received datagram.
+         * @param[in] n Index of the datagram, must be less than @ref Size.
+         * @return The address of the sender.
+         */
+        const IPAddress& GetSource(size_t n) const { return sources[n]; }
+
+    private:
+        friend class UDPSocket;
+
+        size_t numDatagrams;                  // Number of datagrams that have been received.
+        size_t bufferSize;                    // Size of a single receive buffer in bytes.
+        std::vector<uint8_t> buffer;          // Continuous memory for all receive buffers.
+        std::vector<int32_t> lengths;         // Number of bytes received for each buffer.
+        std::vector<IPAddress> sources;       // Source addresses for each buffer.
+        #ifdef __linux__
+        std::vector<mmsghdr> headers;         // Message headers for recvmmsg().
+        std::vector<iovec> vectors;           // Scatter/gather elements, one for each receive buffer.
+        std::vector<sockaddr_in> addresses;   // Raw source addresses for each receive buffer.
+        #endif
+};
+
@@ -0,0 +1,57 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <IPAddress.hpp>
+
+
+/**
+ * @brief A list of destination addresses to which the same datagram is sent by a single @ref UDPSocket::SendToAll call.
+ * @details Under linux the fan-out additionally holds the message headers required for sendmmsg(), so that no memory has to
+ * be allocated while sending.
+ */
+class DatagramFanOut {
+    public:
+        /**
+         * @brief Construct a new datagram fan-out without destinations.
+         */
+        DatagramFanOut(){}
+
+        /**
+         * @brief Set the destination addresses.
+         * @param[in] destinations The destination addresses to which datagrams are to be sent.
+         */
+        void SetDestinations(const std::vector<IPAddress>& destinations){
+            this->destinations = destinations;
+            #ifdef __linux__
+            size_t numDestinations = destinations.size();
+            headers.assign(numDestinations, mmsghdr{});
+            addresses.assign(numDestinations, sockaddr_in{});
+            for(size_t n = 0; n < numDestinations; ++n){
+                addresses[n].sin_family = AF_INET;
+                addresses[n].sin_port = htons(destinations[n].port);
+                addresses[n].sin_addr.s_addr = htonl((static_cast<uint32_t>(destinations[n].ip[0]) << 24) | (static_cast<uint32_t>(destinations[n].ip[1]) << 16) | (static_cast<uint32_t>(destinations[n].ip[2]) << 8) | static_cast<uint32_t>(destinations[n].ip[3]));
+                headers[n].msg_hdr.msg_iov = &vector;
+                headers[n].msg_hdr.msg_iovlen = 1;
+                headers[n].msg_hdr.msg_name = &addresses[n];
+                headers[n].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            }
+            #endif
+        }
+
+        /**
+         * @brief Get the number of destinations.
+         * @return Number of destination addresses.
+         */
+        size_t Size(void) const { return destinations.size(); }
+
+    private:
+        friend class UDPSocket;
+
+        std::vector<IPAddress> destinations;   // Destination addresses.
+        #ifdef __linux__
+        std::vector<mmsghdr> headers;          // Message headers for sendmmsg(), one for each destination.
+        std::vector<sockaddr_in> addresses;    // Raw destination addresses.
+        iovec vector;                          // Scatter/gather element that refers to the datagram, shared by all headers.
+        #endif
+};
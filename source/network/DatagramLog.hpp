@@ -0,0 +1,283 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <IPAddress.hpp>
+#include <NetworkUtils.hpp>
+
+
+/**
+ * @brief The magic bytes at the beginning of a datagram log file.
+ */
+#define DATAGRAM_LOG_MAGIC "PRISMADL"
+
+
+/**
+ * @brief The version of the datagram log file format.
+ */
+#define DATAGRAM_LOG_VERSION (1)
+
+
+/**
+ * @brief The size of the file header in bytes (magic bytes and version).
+ */
+#define DATAGRAM_LOG_FILE_HEADER_SIZE (12)
+
+
+/**
+ * @brief The size of the record header in bytes (timestamp, source address, flags and length).
+ */
+#define DATAGRAM_LOG_RECORD_HEADER_SIZE (19)
+
+
+/**
+ * @brief The size of the file buffer in bytes that is used to read or write a datagram log.
+ */
+#define DATAGRAM_LOG_FILE_BUFFER_SIZE (1048576)
+
+
+/**
+ * @brief Flags of a datagram log record.
+ */
+enum DatagramLogFlag: uint8_t {
+    DATAGRAM_LOG_FLAG_RELIABLE = 0x01   // The datagram has been received via a reliable stream.
+};
+
+
+/**
+ * @brief A single datagram of a datagram log.
+ */
+struct DatagramLogRecord {
+    uint64_t timestamp;           // Receive time in nanoseconds since 1970-01-01 (UTC), advanced by the steady clock since the log has been opened.
+    IPAddress source;             // The source address of the datagram, zero for frames of the shared memory ring.
+    uint8_t flags;                // Flags of the datagram, see @ref DatagramLogFlag.
+    std::vector<uint8_t> bytes;   // The bytes of the datagram, the capacity is reused.
+
+    /**
+     * @brief Construct a new datagram log record.
+     */
+    DatagramLogRecord(): timestamp(0), flags(0){}
+};
+
+
+/**
+ * @brief Writes received datagrams to a compact binary log file.
+ * @details The file starts with the magic bytes "PRISMADL" and a uint32 version. Each record consists of a uint64
+ * timestamp, the IPv4 address (4 bytes), a uint16 port, a uint8 flags field and a uint32 length followed by the bytes
+ * of the datagram. All values are stored in network byte order. The timestamp is the system time at which the file
+ * has been opened plus the elapsed time of the steady clock, such that the deltas between records, which define the
+ * replay timing, are not affected by adjustments of the system time. The file is written via a large buffer, such that
+ * the network thread is not slowed down by a system call for each datagram.
+ */
+class DatagramLogWriter {
+    public:
+        /**
+         * @brief Construct a new datagram log writer.
+         */
+        DatagramLogWriter(): file(nullptr), numRecords(0), openSystemTime(0){}
+
+        /**
+         * @brief Close the log file.
+         */
+        ~DatagramLogWriter(){ Close(); }
+
+        /**
+         * @brief Create a new log file. An existing file is overwritten.
+         * @param[in] filename The name of the log file.
+         * @return True if success, false otherwise.
+         */
+        bool Open(const std::string& filename){
+            Close();
+            file = std::fopen(filename.c_str(), "wb");
+            if(!file){
+                PrintE("Could not create datagram log \"%s\"!\n", filename.c_str());
+                return false;
+            }
+            fileBuffer.resize(DATAGRAM_LOG_FILE_BUFFER_SIZE);
+            (void) std::setvbuf(file, reinterpret_cast<char*>(&fileBuffer[0]), _IOFBF, fileBuffer.size());
+            uint8_t header[DATAGRAM_LOG_FILE_HEADER_SIZE];
+            std::memcpy(&header[0], DATAGRAM_LOG_MAGIC, 8);
+            uint32_t version = NetworkUtils::NativeToNetworkByteOrder(static_cast<uint32_t>(DATAGRAM_LOG_VERSION));
+            std::memcpy(&header[8], &version, sizeof(version));
+            if(std::fwrite(&header[0], 1, sizeof(header), file) != sizeof(header)){
+                PrintE("Could not write to datagram log \"%s\"!\n", filename.c_str());
+                Close();
+                return false;
+            }
+            this->filename = filename;
+            numRecords = 0;
+            openSystemTime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+            openSteadyTime = std::chrono::steady_clock::now();
+            return true;
+        }
+
+        /**
+         * @brief Flush and close the log file.
+         */
+        void Close(void){
+            if(file){
+                std::fclose(file);
+                file = nullptr;
+                Print("datagram log \"%s\": records=%llu\n", filename.c_str(), static_cast<unsigned long long>(numRecords));
+            }
+            fileBuffer.clear();
+            fileBuffer.shrink_to_fit();
+        }
+
+        /**
+         * @brief Check whether the log file is open.
+         * @return True if the log file is open, false otherwise.
+         */
+        bool IsOpen(void) const { return nullptr != file; }
+
+        /**
+         * @brief Append a datagram to the log file using the current time as timestamp.
+         * @param[in] source The source address of the datagram.
+         * @param[in] bytes The bytes of the datagram.
+         * @param[in] length The number of bytes.
+         * @param[in] flags Flags of the datagram, see @ref DatagramLogFlag.
+         * @details If writing fails, the log file is closed.
+         */
+        void Write(const IPAddress& source, const uint8_t* bytes, int32_t length, uint8_t flags){
+            if(!file || (length < 0)){
+                return;
+            }
+            uint64_t timestamp = openSystemTime + static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - openSteadyTime).count());
+            uint8_t header[DATAGRAM_LOG_RECORD_HEADER_SIZE];
+            timestamp = NetworkUtils::NativeToNetworkByteOrder(timestamp);
+            uint16_t port = NetworkUtils::NativeToNetworkByteOrder(source.port);
+            uint32_t len = NetworkUtils::NativeToNetworkByteOrder(static_cast<uint32_t>(length));
+            std::memcpy(&header[0], &timestamp, 8);
+            std::memcpy(&header[8], &source.ip[0], 4);
+            std::memcpy(&header[12], &port, 2);
+            header[14] = flags;
+            std::memcpy(&header[15], &len, 4);
+            if((std::fwrite(&header[0], 1, sizeof(header), file) != sizeof(header)) || (length && (std::fwrite(bytes, 1, static_cast<size_t>(length), file) != static_cast<size_t>(length)))){
+                PrintE("Could not write to datagram log \"%s\"!\n", filename.c_str());
+                Close();
+                return;
+            }
+            numRecords++;
+        }
+
+    private:
+        std::FILE* file;                  // The log file or nullptr if no file is open.
+        std::string filename;             // The name of the log file.
+        std::vector<uint8_t> fileBuffer;  // The buffer of the file stream.
+        uint64_t numRecords;              // The number of records that have been written.
+        uint64_t openSystemTime;          // System time in nanoseconds since 1970-01-01 (UTC) at which the log file has been opened.
+        std::chrono::steady_clock::time_point openSteadyTime; // Steady clock time at which the log file has been opened.
+};
+
+
+/**
+ * @brief Reads datagrams from a log file that has been written by the @ref DatagramLogWriter.
+ * @details The length of a record is checked against the maximum record length and the remaining size of the file
+ * before any memory is allocated, such that a corrupt or truncated log cannot trigger huge allocations.
+ */
+class DatagramLogReader {
+    public:
+        /**
+         * @brief Construct a new datagram log reader.
+         */
+        DatagramLogReader(): file(nullptr), maxRecordLength(0), remainingSize(0){}
+
+        /**
+         * @brief Close the log file.
+         */
+        ~DatagramLogReader(){ Close(); }
+
+        /**
+         * @brief Open a log file and check the file header.
+         * @param[in] filename The name of the log file.
+         * @param[in] maxRecordLength The maximum number of bytes of a single record. A record with a larger length is treated as corrupt.
+         * @return True if success, false otherwise.
+         */
+        bool Open(const std::string& filename, uint32_t maxRecordLength){
+            Close();
+            std::error_code ec;
+            uintmax_t fileSize = std::filesystem::file_size(filename, ec);
+            file = ec ? nullptr : std::fopen(filename.c_str(), "rb");
+            if(!file){
+                PrintE("Could not open datagram log \"%s\"!\n", filename.c_str());
+                return false;
+            }
+            fileBuffer.resize(DATAGRAM_LOG_FILE_BUFFER_SIZE);
+            (void) std::setvbuf(file, reinterpret_cast<char*>(&fileBuffer[0]), _IOFBF, fileBuffer.size());
+            uint8_t header[DATAGRAM_LOG_FILE_HEADER_SIZE];
+            if((std::fread(&header[0], 1, sizeof(header), file) != sizeof(header)) || std::memcmp(&header[0], DATAGRAM_LOG_MAGIC, 8)){
+                PrintE("File \"%s\" is not a datagram log!\n", filename.c_str());
+                Close();
+                return false;
+            }
+            uint32_t version = NetworkUtils::ReadNetworkByteOrder<uint32_t>(&header[8]);
+            if(DATAGRAM_LOG_VERSION != version){
+                PrintE("Datagram log \"%s\" has unsupported version %u!\n", filename.c_str(), version);
+                Close();
+                return false;
+            }
+            this->filename = filename;
+            this->maxRecordLength = maxRecordLength;
+            remainingSize = static_cast<uint64_t>(fileSize) - sizeof(header);
+            return true;
+        }
+
+        /**
+         * @brief Close the log file.
+         */
+        void Close(void){
+            if(file){
+                std::fclose(file);
+                file = nullptr;
+            }
+            fileBuffer.clear();
+            fileBuffer.shrink_to_fit();
+        }
+
+        /**
+         * @brief Read the next record from the log file.
+         * @param[out] record The record to which to read the datagram.
+         * @return True if a record has been read, false if the end of the file has been reached or if the file is corrupt.
+         */
+        bool Read(DatagramLogRecord& record){
+            if(!file){
+                return false;
+            }
+            uint8_t header[DATAGRAM_LOG_RECORD_HEADER_SIZE];
+            size_t rx = std::fread(&header[0], 1, sizeof(header), file);
+            if(rx != sizeof(header)){
+                if(rx){
+                    PrintW("Datagram log \"%s\" ends with an incomplete record!\n", filename.c_str());
+                }
+                return false;
+            }
+            remainingSize -= std::min(remainingSize, static_cast<uint64_t>(sizeof(header)));
+            record.timestamp = NetworkUtils::ReadNetworkByteOrder<uint64_t>(&header[0]);
+            std::memcpy(&record.source.ip[0], &header[8], 4);
+            record.source.port = NetworkUtils::ReadNetworkByteOrder<uint16_t>(&header[12]);
+            record.flags = header[14];
+            uint32_t length = NetworkUtils::ReadNetworkByteOrder<uint32_t>(&header[15]);
+            if(length > maxRecordLength){
+                PrintW("Datagram log \"%s\" contains a record of %u bytes, which exceeds the maximum length of %u bytes!\n", filename.c_str(), length, maxRecordLength);
+                return false;
+            }
+            if(static_cast<uint64_t>(length) > remainingSize){
+                PrintW("Datagram log \"%s\" ends with an incomplete record!\n", filename.c_str());
+                return false;
+            }
+            record.bytes.resize(length);
+            if(length && (std::fread(&record.bytes[0], 1, length, file) != length)){
+                PrintW("Datagram log \"%s\" ends with an incomplete record!\n", filename.c_str());
+                return false;
+            }
+            remainingSize -= static_cast<uint64_t>(length);
+            return true;
+        }
+
+    private:
+        std::FILE* file;                  // The log file or nullptr if no file is open.
+        std::string filename;             // The name of the log file.
+        std::vector<uint8_t> fileBuffer;  // The buffer of the file stream.
+        uint32_t maxRecordLength;         // Maximum number of bytes of a single record.
+        uint64_t remainingSize;           // Number of bytes of the file that have not been read.
+};
@@ -0,0 +1,270 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <IPAddress.hpp>
+#include <FragmentMessage.hpp>
+
+
+/**
+ * @brief The maximum number of transfers that are reassembled at the same time. If a new transfer is started while this
+ * limit or the maximum number of bytes in flight is reached, the transfer with the oldest update is discarded.
+ */
+#define MESSAGE_REASSEMBLER_MAX_TRANSFERS (64)
+
+
+/**
+ * @brief The maximum number of buffers of finished transfers that are kept for reuse.
+ */
+#define MESSAGE_REASSEMBLER_MAX_SPARE_BUFFERS (4)
+
+
+/**
+ * @brief The result of inserting a fragment to the @ref MessageReassembler.
+ */
+enum MessageReassemblerResult : uint8_t {
+    MESSAGE_REASSEMBLER_RESULT_INCOMPLETE = 0x00,   // The fragment has been stored, but further fragments are missing.
+    MESSAGE_REASSEMBLER_RESULT_COMPLETE = 0x01,     // All fragments of the transfer have been received.
+    MESSAGE_REASSEMBLER_RESULT_TOO_LARGE = 0x02,    // The total length of the transfer exceeds the maximum length or the maximum number of bytes in flight.
+    MESSAGE_REASSEMBLER_RESULT_INVALID = 0x03       // The fragment overlaps other fragments or leaves a gap, the transfer has been discarded.
+};
+
+
+/**
+ * @brief Statistics of a message reassembler.
+ */
+struct MessageReassemblerStatistics {
+    size_t numTransfers;        // Number of transfers that are currently in progress.
+    uint64_t numCompleted;      // Total number of transfers that have been completed.
+    uint64_t numTimedOut;       // Total number of transfers that have been discarded because of missing fragments.
+    uint64_t numDuplicates;     // Total number of fragments that have been received more than once.
+    uint64_t numInvalid;        // Total number of transfers that have been discarded because of overlapping fragments or gaps.
+};
+
+
+/**
+ * @brief Reassembles fragmented messages (see @ref FragmentMessage) within the network thread.
+ * @details A transfer is identified by the source address of the sender and the transfer identifier. Fragments may be
+ * received in any order, but the byte ranges of the fragments must be consecutive in the order of their fragment indices,
+ * i.e. fragment 0 starts at offset 0, each fragment starts where the previous one ends and the last fragment ends at the
+ * total length. A transfer that violates this is discarded, such that a reassembled message never contains bytes that have
+ * not been received. A transfer that did not receive a fragment within the timeout is discarded. The total length of all
+ * transfers in progress is limited by the maximum number of bytes in flight, because the buffer of a transfer is allocated
+ * with the first fragment. Buffers of completed or discarded transfers are kept and reused for subsequent transfers.
+ * @note This class is not thread-safe.
+ */
+class MessageReassembler {
+    public:
+        /**
+         * @brief Construct a new message reassembler.
+         */
+        MessageReassembler(): maxLength(0), maxBytesInFlight(0), bytesInFlight(0), timeout(0), numCompleted(0), numTimedOut(0), numDuplicates(0), numInvalid(0){}
+
+        /**
+         * @brief Reset the reassembler and discard all transfers that are in progress.
+         * @param[in] maxLength The maximum total length in bytes of a fragmented message.
+         * @param[in] maxBytesInFlight The maximum sum of the total lengths in bytes of all transfers that are in progress.
+         * @param[in] timeoutMs Time in milliseconds after which a transfer is discarded if no further fragment has been received.
+         */
+        void Reset(size_t maxLength, size_t maxBytesInFlight, uint32_t timeoutMs){
+            while(!transfers.empty()){
+                RemoveTransfer(transfers.size() - 1);
+            }
+            this->maxLength = maxLength;
+            this->maxBytesInFlight = maxBytesInFlight;
+            timeout = std::chrono::milliseconds(timeoutMs);
+            numCompleted = 0;
+            numTimedOut = 0;
+            numDuplicates = 0;
+            numInvalid = 0;
+        }
+
+        /**
+         * @brief Insert a fragment.
+         * @param[in] source The source address of the datagram that contained the fragment.
+         * @param[in] fragment A valid fragment message whose payload is still accessible.
+         * @param[inout] bytes If the transfer is complete, the content of this container is swapped with the reassembled bytes. The previous buffer of the container is reused for further transfers.
+         * @return The result of the insertion. The bytes are only changed if @ref MESSAGE_REASSEMBLER_RESULT_COMPLETE is returned.
+         */
+        MessageReassemblerResult Insert(const IPAddress& source, const FragmentMessage& fragment, std::vector<uint8_t>& bytes){
+            if((static_cast<size_t>(fragment.totalLength) > maxLength) || (static_cast<size_t>(fragment.totalLength) > maxBytesInFlight)){
+                return MESSAGE_REASSEMBLER_RESULT_TOO_LARGE;
+            }
+            auto now = std::chrono::steady_clock::now();
+            size_t index = FindTransfer(source, fragment.transferID);
+            if((index < transfers.size()) && ((transfers[index].totalLength != static_cast<size_t>(fragment.totalLength)) || (transfers[index].ranges.size() != fragment.fragmentCount))){
+                RemoveTransfer(index); // the sender restarted the transfer with different parameters
+                index = transfers.size();
+            }
+            if(index == transfers.size()){
+                index = AddTransfer(source, fragment, now);
+            }
+            Transfer& transfer = transfers[index];
+            if(transfer.received[fragment.fragmentIndex]){
+                numDuplicates++;
+                return MESSAGE_REASSEMBLER_RESULT_INCOMPLETE;
+            }
+            uint32_t begin = fragment.payloadOffset;
+            uint32_t end = fragment.payloadOffset + static_cast<uint32_t>(fragment.payloadLength);
+            if(!IsConsecutive(transfer, fragment.fragmentIndex, begin, end)){
+                RemoveTransfer(index);
+                numInvalid++;
+                return MESSAGE_REASSEMBLER_RESULT_INVALID;
+            }
+            if(fragment.payloadLength){
+                std::memcpy(&transfer.buffer[begin], fragment.payload, fragment.payloadLength);
+            }
+            transfer.received[fragment.fragmentIndex] = 1;
+            transfer.ranges[fragment.fragmentIndex] = {begin, end};
+            transfer.numReceivedBytes += static_cast<size_t>(fragment.payloadLength);
+            transfer.lastUpdate = now;
+            if((++transfer.numReceived < transfer.ranges.size()) || (transfer.numReceivedBytes != transfer.totalLength)){
+                return MESSAGE_REASSEMBLER_RESULT_INCOMPLETE;
+            }
+            std::swap(bytes, transfer.buffer);
+            RemoveTransfer(index);
+            numCompleted++;
+            return MESSAGE_REASSEMBLER_RESULT_COMPLETE;
+        }
+
+        /**
+         * @brief Discard all transfers that did not receive a fragment within the timeout.
+         */
+        void RemoveExpiredTransfers(void){
+            auto now = std::chrono::steady_clock::now();
+            for(size_t i = transfers.size(); i > 0; --i){
+                if((now - transfers[i - 1].lastUpdate) > timeout){
+                    RemoveTransfer(i - 1);
+                    numTimedOut++;
+                }
+            }
+        }
+
+        /**
+         * @brief Get the statistics of this reassembler.
+         * @return Current statistics.
+         */
+        MessageReassemblerStatistics GetStatistics(void) const {
+            MessageReassemblerStatistics result;
+            result.numTransfers = transfers.size();
+            result.numCompleted = numCompleted;
+            result.numTimedOut = numTimedOut;
+            result.numDuplicates = numDuplicates;
+            result.numInvalid = numInvalid;
+            return result;
+        }
+
+    private:
+        struct Transfer {
+            IPAddress source;                                   // Source address of the sender.
+            uint32_t transferID;                                // Transfer identifier.
+            std::vector<uint8_t> buffer;                        // Reassembled bytes, the size is equal to the total length.
+            size_t totalLength;                                 // Total length of the transfer in bytes.
+            std::vector<uint8_t> received;                      // Nonzero for each fragment that has been received.
+            std::vector<std::array<uint32_t,2>> ranges;         // Byte range {begin, end} of each fragment that has been received.
+            size_t numReceived;                                 // Number of different fragments that have been received.
+            size_t numReceivedBytes;                            // Number of payload bytes that have been received.
+            std::chrono::steady_clock::time_point lastUpdate;   // Time when the last fragment has been received.
+        };
+        std::vector<Transfer> transfers;                        // Transfers that are in progress.
+        std::vector<std::vector<uint8_t>> spareBuffers;         // Buffers of finished transfers that are reused.
+        size_t maxLength;                                       // Maximum total length of a fragmented message.
+        size_t maxBytesInFlight;                                // Maximum sum of the total lengths of all transfers in progress.
+        size_t bytesInFlight;                                   // Sum of the total lengths of all transfers in progress.
+        std::chrono::steady_clock::duration timeout;            // Timeout after which an incomplete transfer is discarded.
+        uint64_t numCompleted;                                  // Number of completed transfers.
+        uint64_t numTimedOut;                                   // Number of discarded transfers.
+        uint64_t numDuplicates;                                 // Number of duplicate fragments.
+        uint64_t numInvalid;                                    // Number of transfers with overlapping fragments or gaps.
+
+        /**
+         * @brief Find a transfer.
+         * @param[in] source The source address of the sender.
+         * @param[in] transferID The transfer identifier.
+         * @return Index of the transfer or the number of transfers if there is no such transfer.
+         */
+        size_t FindTransfer(const IPAddress& source, uint32_t transferID) const {
+            size_t i = 0;
+            for(; i < transfers.size(); ++i){
+                const Transfer& t = transfers[i];
+                if((t.transferID == transferID) && (t.source.port == source.port) && (t.source.ip == source.ip)){
+                    break;
+                }
+            }
+            return i;
+        }
+
+        /**
+         * @brief Check whether the byte range of a fragment is consecutive to the byte ranges of its neighbouring fragments that have already been received.
+         * @param[in] transfer The transfer to which the fragment belongs.
+         * @param[in] fragmentIndex The index of the fragment.
+         * @param[in] begin The offset of the first payload byte of the fragment.
+         * @param[in] end The offset behind the last payload byte of the fragment.
+         * @return True if the fragment neither overlaps its neighbours nor leaves a gap to them, false otherwise.
+         * @details If all fragments have been received and each of them passed this check, the fragments cover the whole transfer exactly once.
+         */
+        bool IsConsecutive(const Transfer& transfer, uint16_t fragmentIndex, uint32_t begin, uint32_t end) const {
+            size_t i = static_cast<size_t>(fragmentIndex);
+            size_t last = transfer.ranges.size() - 1;
+            if(i ? (transfer.received[i - 1] && (transfer.ranges[i - 1][1] != begin)) : (begin != 0)){
+                return false;
+            }
+            if((i < last) ? (transfer.received[i + 1] && (transfer.ranges[i + 1][0] != end)) : (static_cast<size_t>(end) != transfer.totalLength)){
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Add a new transfer for a given fragment. If the maximum number of transfers or the maximum number of bytes in flight is reached, transfers with the oldest update are discarded.
+         * @param[in] source The source address of the sender.
+         * @param[in] fragment The first fragment that has been received for the transfer.
+         * @param[in] now The current time.
+         * @return Index of the new transfer.
+         */
+        size_t AddTransfer(const IPAddress& source, const FragmentMessage& fragment, std::chrono::steady_clock::time_point now){
+            while(!transfers.empty() && ((transfers.size() >= MESSAGE_REASSEMBLER_MAX_TRANSFERS) || ((bytesInFlight + static_cast<size_t>(fragment.totalLength)) > maxBytesInFlight))){
+                size_t oldest = 0;
+                for(size_t i = 1; i < transfers.size(); ++i){
+                    if(transfers[i].lastUpdate < transfers[oldest].lastUpdate){
+                        oldest = i;
+                    }
+                }
+                RemoveTransfer(oldest);
+                numTimedOut++;
+            }
+            transfers.emplace_back();
+            Transfer& transfer = transfers.back();
+            transfer.source = source;
+            transfer.transferID = fragment.transferID;
+            if(!spareBuffers.empty()){
+                std::swap(transfer.buffer, spareBuffers.back());
+                spareBuffers.pop_back();
+            }
+            transfer.totalLength = static_cast<size_t>(fragment.totalLength);
+            transfer.buffer.resize(transfer.totalLength);
+            transfer.received.assign(fragment.fragmentCount, 0);
+            transfer.ranges.resize(fragment.fragmentCount);
+            transfer.numReceived = 0;
+            transfer.numReceivedBytes = 0;
+            transfer.lastUpdate = now;
+            bytesInFlight += transfer.totalLength;
+            return transfers.size() - 1;
+        }
+
+        /**
+         * @brief Remove a transfer and keep its buffer for reuse.
+         * @param[in] index Index of the transfer to be removed.
+         */
+        void RemoveTransfer(size_t index){
+            bytesInFlight -= transfers[index].totalLength;
+            if(spareBuffers.size() < MESSAGE_REASSEMBLER_MAX_SPARE_BUFFERS){
+                spareBuffers.push_back(std::move(transfers[index].buffer));
+            }
+            if(index != (transfers.size() - 1)){
+                std::swap(transfers[index], transfers.back());
+            }
+            transfers.pop_back();
+        }
+};
+
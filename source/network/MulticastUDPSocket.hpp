@@ -9,8 +9,11 @@
 class MulticastUDPSocket: protected UDPSocket {
     public:
         using UDPSocket::IsOpen;
+        using UDPSocket::GetDescriptor;
         using UDPSocket::ReceiveFrom;
+        using UDPSocket::ReceiveMany;
         using UDPSocket::SendTo;
+        using UDPSocket::SendToAll;
         using UDPSocket::GetLastError;
         using UDPSocket::ResetLastError;
 
@@ -40,6 +43,15 @@ class MulticastUDPSocket: protected UDPSocket {
             }
             #endif
 
+            // Set receive buffer size
+            if(conf.receiveBufferSize > 0){
+                ResetLastError();
+                if(SetReceiveBufferSize(conf.receiveBufferSize) < 0){
+                    auto [errorCode, errorString] = GetLastError();
+                    PrintW("Could not set receive buffer size %d for UDP socket! %s\n", conf.receiveBufferSize, errorString.c_str());
+                }
+            }
+
             // Reuse port and ignore errors
             ResetLastError();
             if(ReusePort(true) < 0){
@@ -3,15 +3,29 @@
 
 #include <Common.hpp>
 #include <MulticastUDPSocket.hpp>
+#include <SharedMemoryRing.hpp>
+#include <StreamListener.hpp>
+#include <DatagramLog.hpp>
+#include <WindowEventSender.hpp>
 #include <MessageManager.hpp>
+#include <MessageReassembler.hpp>
+#include <FragmentMessage.hpp>
+#include <WindowEventMessage.hpp>
+#include <TelemetryMessage.hpp>
 #include <Event.hpp>
 #include <PrismaConfiguration.hpp>
 #include <StringHelper.hpp>
+#include <Profiler.hpp>
+#include <LatencyStatistics.hpp>
 
 
 /**
  * @brief The network manager handles the UDP multicast socket and receives and processes messages.
  * Successfully received messages are inserted to the @ref MessageManager.
+ * @details Messages are either received via the UDP socket or via a @ref SharedMemoryRing, depending on the configured
+ * transport. Messages are always sent via the UDP socket by a separate @ref WindowEventSender thread. In addition, messages
+ * can be received reliably via stream connections (see @ref StreamListener), which are served by the same thread.
+ * All received datagrams can be captured to a @ref DatagramLogWriter and a captured log can be replayed via @ref StartReplay.
  */
 class NetworkManager {
     public:
@@ -29,19 +43,46 @@ class NetworkManager {
                 dst.port = address[4];
                 destinations.push_back(dst);
             }
+            OpenMessageManager();
+            if(!prismaConfiguration.network.receive.captureFile.empty() && captureLog.Open(prismaConfiguration.network.receive.captureFile)){
+                Print("Capturing received datagrams to \"%s\"\n", prismaConfiguration.network.receive.captureFile.c_str());
+            }
+            windowEventSender.Start(udpSocket, destinations, prismaConfiguration.network.send.onlyOnChange);
             networkMainThread = std::thread(&NetworkManager::NetworkMainThread, this);
         }
 
+        /**
+         * @brief Start the network manager in replay mode by launching a separate thread that feeds a datagram log to the message manager.
+         * @param[in] filename The name of the datagram log that has been captured via the "network.receive.captureFile" setting.
+         * @param[in] speed The replay speed relative to the original timing, e.g. 1 for the original speed or 10 for a ten times faster replay.
+         * A value less than or equal to zero replays the datagrams as fast as possible.
+         * @param[in] onFinished Callback function that is called by the replay thread after all datagrams have been replayed and fetched from the message queue.
+         * @details The sockets are not opened and no messages are sent. If datagrams are replayed as fast as possible, they
+         * are never dropped by the message queue (back-pressure), such that each replay processes the same messages.
+         */
+        void StartReplay(const std::string& filename, double speed, std::function<void(void)> onFinished){
+            Stop();
+            OpenMessageManager();
+            networkMainThread = std::thread(&NetworkManager::ReplayThread, this, filename, speed, onFinished);
+        }
+
         /**
          * @brief Stop the network manager.
          */
         void Stop(void){
+            windowEventSender.Stop();
             terminate = true;
             udpSocket.Close();
             udpRetryTimer.NotifyOne(0);
+            messageManager.Close();
             if(networkMainThread.joinable()){
                 networkMainThread.join();
+                MessageQueueStatistics statistics = messageManager.GetStatistics();
+                MessageReassemblerStatistics reassemblerStatistics = reassembler.GetStatistics();
+                Print("message reassembler: completed=%llu, timedOut=%llu, duplicates=%llu, invalid=%llu\n", static_cast<unsigned long long>(reassemblerStatistics.numCompleted), static_cast<unsigned long long>(reassemblerStatistics.numTimedOut), static_cast<unsigned long long>(reassemblerStatistics.numDuplicates), static_cast<unsigned long long>(reassemblerStatistics.numInvalid));
+                Print("message queue: capacity=%zu, maxDepth=%zu, pushed=%llu, dropped=%llu, coalesced=%llu, blocked=%llu\n", statistics.capacity, statistics.maxDepth, static_cast<unsigned long long>(statistics.numPushed), static_cast<unsigned long long>(statistics.numDropped), static_cast<unsigned long long>(statistics.numCoalesced), static_cast<unsigned long long>(statistics.numBlocked));
             }
+            captureLog.Close();
             udpRetryTimer.Clear();
             terminate = false;
             destinations.clear();
@@ -50,29 +91,58 @@ class NetworkManager {
         /**
          * @brief Send a window event message via the UDP socket.
          * @param[in] msg The message to be send.
-         * @details If the socket is not open, then the message is discarded.
+         * @details The message is serialized and sent asynchronously by the @ref WindowEventSender, this function never blocks.
+         * If the socket is not open, then the message is discarded.
          */
         void SendWindowEventMessage(WindowEventMessage& msg){
-            for(auto&& destination : destinations){
-                std::vector<uint8_t> bytes = msg.Serialize();
-                (void) udpSocket.SendTo(destination, &bytes[0], static_cast<int32_t>(bytes.size()));
-            }
+            windowEventSender.Send(msg);
+        }
+
+        /**
+         * @brief Send a telemetry message via the UDP socket.
+         * @param[in] msg The message to be send.
+         * @details The message is serialized and sent asynchronously by the @ref WindowEventSender, this function never blocks.
+         * It must be called from the same thread as @ref SendWindowEventMessage.
+         */
+        void SendTelemetryMessage(TelemetryMessage& msg){
+            windowEventSender.Send(msg);
         }
 
     private:
-        std::thread networkMainThread;         // Thread object for the internal network manager thread.
-        std::atomic<bool> terminate;           // True if the thread should be terminated, false otherwise.
-        MulticastUDPSocket udpSocket;          // The multicast UDP socket.
-        Event udpRetryTimer;                   // A timer to wait before retrying to initialize a UDP socket in case of errors.
-        std::vector<IPAddress> destinations;   // The destination addresses to which to send messages. The destinations are set during @ref Start.
+        std::thread networkMainThread;               // Thread object for the internal network manager thread.
+        std::atomic<bool> terminate;                 // True if the thread should be terminated, false otherwise.
+        MulticastUDPSocket udpSocket;                // The multicast UDP socket.
+        Event udpRetryTimer;                         // A timer to wait before retrying to initialize a UDP socket in case of errors.
+        std::vector<IPAddress> destinations;         // The destination addresses to which to send messages. The destinations are set during @ref Start.
+        std::vector<MessageBaseType*> newMessages;   // Messages of the datagram that is currently processed, the capacity is kept between datagrams.
+        MessageReassembler reassembler;              // Reassembles fragmented messages.
+        FragmentMessage fragment;                    // The fragment message that is currently processed.
+        std::vector<uint8_t> reassembledBytes;       // Bytes of the latest reassembled message, the capacity is reused.
+        SharedMemoryRing sharedMemoryRing;           // The shared memory ring if messages are received via shared memory.
+        StreamListener streamListener;               // Listens for reliable stream connections if enabled.
+        WindowEventSender windowEventSender;         // Sends window event messages and telemetry messages from a separate thread.
+        DatagramLogWriter captureLog;                // Captures all received datagrams if a capture file has been configured.
+
+        /**
+         * @brief Reset the message reassembler and open the message manager according to the PRISMA configuration.
+         */
+        void OpenMessageManager(void){
+            MessageQueueOverflowPolicy policy = MESSAGE_QUEUE_OVERFLOW_POLICY_DROP_OLDEST;
+            (void) MessageQueueOverflowPolicyFromString(policy, prismaConfiguration.network.receive.overflowPolicy);
+            reassembler.Reset(static_cast<size_t>(prismaConfiguration.network.receive.maxMessageSize), static_cast<size_t>(prismaConfiguration.network.receive.maxReassemblyBytes), prismaConfiguration.network.receive.fragmentTimeoutMs);
+            messageManager.Open(static_cast<size_t>(prismaConfiguration.network.receive.queueCapacity), policy, prismaConfiguration.network.receive.coalesceMessages);
+        }
 
         /**
          * @brief The main thread function of the network manager.
          */
         void NetworkMainThread(void){
-            // local buffer where to store received messages
+            profiler.SetThreadName("network");
+
+            // local buffers where to store received messages
             constexpr size_t rxBufferSize = 65507;
-            uint8_t* rxBuffer = new uint8_t[rxBufferSize];
+            DatagramBatch rxBatch;
+            rxBatch.Resize(static_cast<size_t>(prismaConfiguration.network.receive.batchSize), rxBufferSize);
 
             // get network configuration from PRISMA configuration file
             SocketConfiguration conf;
@@ -82,6 +152,7 @@ class NetworkManager {
             conf.joinInterfaceName    = prismaConfiguration.network.interfaceName;
             conf.useJoinInterfaceName = !prismaConfiguration.network.interfaceName.empty();
             conf.socketPriority       = prismaConfiguration.network.socketPriority;
+            conf.receiveBufferSize    = prismaConfiguration.network.receive.socketBufferSize;
             conf.ttl                  = prismaConfiguration.network.send.timeToLive;
             conf.txInterfaceAddress   = prismaConfiguration.network.interfaceAddress;
             conf.txInterfaceName      = prismaConfiguration.network.interfaceName;
@@ -94,86 +165,338 @@ class NetworkManager {
                     udpRetryTimer.WaitFor(prismaConfiguration.network.socketErrorRetryTimeMs);
                     continue;
                 }
+                if(!OpenStreamListener()){
+                    udpSocket.Close();
+                    udpRetryTimer.WaitFor(prismaConfiguration.network.socketErrorRetryTimeMs);
+                    continue;
+                }
 
                 // receive messages and process them
-                IPAddress source;
-                while(!terminate && udpSocket.IsOpen()){
-                    udpSocket.ResetLastError();
-                    int32_t rx = udpSocket.ReceiveFrom(source, &rxBuffer[0], rxBufferSize);
-                    auto [errorCode, errorStringIgnored] = udpSocket.GetLastError();
-                    if(!udpSocket.IsOpen() || terminate){
-                        break;
+                if("sharedMemory" == prismaConfiguration.network.transport){
+                    ReceiveFromSharedMemory();
+                }
+                else{
+                    ReceiveFromUDPSocket(rxBatch);
+                }
+
+                // terminate the sockets
+                streamListener.Close();
+                udpSocket.Close();
+            }
+        }
+
+        /**
+         * @brief Open the stream listener if a TCP port or a Unix domain socket has been configured.
+         * @return True if success or if no stream transport has been configured, false otherwise.
+         */
+        bool OpenStreamListener(void){
+            const auto& stream = prismaConfiguration.network.stream;
+            if(!stream.tcpPort && stream.unixSocketPath.empty()){
+                return true;
+            }
+            if(!streamListener.Open(stream.tcpAddress, stream.tcpPort, stream.unixSocketPath, stream.receiveBufferSize, prismaConfiguration.network.receive.maxMessageSize)){
+                return false;
+            }
+            if(stream.tcpPort){
+                Print("Listening for stream connections at TCP %u.%u.%u.%u:%u\n", stream.tcpAddress[0], stream.tcpAddress[1], stream.tcpAddress[2], stream.tcpAddress[3], stream.tcpPort);
+            }
+            if(!stream.unixSocketPath.empty()){
+                Print("Listening for stream connections at \"%s\"\n", stream.unixSocketPath.c_str());
+            }
+            return true;
+        }
+
+        /**
+         * @brief Receive and process messages from the UDP socket until the socket is closed or the network manager is terminated.
+         * @param[inout] rxBatch The batch of local buffers where to store received datagrams.
+         */
+        void ReceiveFromUDPSocket(DatagramBatch& rxBatch){
+            constexpr int32_t pollTimeoutMs = 100;
+            while(!terminate && udpSocket.IsOpen()){
+                if(streamListener.IsOpen() && !streamListener.Poll(udpSocket.GetDescriptor(), pollTimeoutMs, [this](const IPAddress& frameSource, const uint8_t* frameBytes, int32_t frameLength){ return ProcessReceivedMessage(frameSource, frameBytes, frameLength, true); })){
+                    reassembler.RemoveExpiredTransfers();
+                    continue;
+                }
+                udpSocket.ResetLastError();
+                int32_t rx = udpSocket.ReceiveMany(rxBatch);
+                auto [errorCode, errorStringIgnored] = udpSocket.GetLastError();
+                if(!udpSocket.IsOpen() || terminate){
+                    break;
+                }
+                if(rx < 0){
+                    #ifdef _WIN32
+                    if(WSAEMSGSIZE == errorCode){
+                        continue;
                     }
-                    if(rx < 0){
-                        #ifdef _WIN32
-                        if(WSAEMSGSIZE == errorCode){
-                            continue;
-                        }
+                    #endif
+                    udpRetryTimer.WaitFor(prismaConfiguration.network.socketErrorRetryTimeMs);
+                    break;
+                }
+                for(size_t n = 0; n < rxBatch.Size(); ++n){
+                    std::string errorString = ProcessReceivedMessage(rxBatch.GetSource(n), rxBatch.GetBytes(n), rxBatch.GetLength(n));
+                    if(!errorString.empty()){
+                        udpSocket.SendTo(rxBatch.GetSource(n), reinterpret_cast<const uint8_t*>(errorString.c_str()), static_cast<int32_t>(errorString.length()));
+                    }
+                }
+                reassembler.RemoveExpiredTransfers();
+            }
+        }
+
+        /**
+         * @brief Receive and process messages from the shared memory ring until the network manager is terminated.
+         * @details Each frame of the ring is decoded directly from the mapped memory. The UDP socket must be open and is
+         * only used to send messages. Errors are printed, because there is no source address to reply to. If the stream
+         * listener is open, a separate thread forwards the futex doorbell of the ring to an eventfd (see @ref DoorbellThread),
+         * such that this thread sleeps in a single poll call until either the ring or a stream connection has data.
+         */
+        void ReceiveFromSharedMemory(void){
+            constexpr uint32_t waitTimeoutMs = 100;
+            const std::string& name = prismaConfiguration.network.sharedMemory.name;
+            if(!sharedMemoryRing.Create(name, static_cast<size_t>(prismaConfiguration.network.sharedMemory.size))){
+                udpRetryTimer.WaitFor(prismaConfiguration.network.socketErrorRetryTimeMs);
+                return;
+            }
+            int doorbellEvent = -1;
+            std::atomic<bool> stopDoorbell(false);
+            std::thread doorbellThread;
+            if(streamListener.IsOpen()){
+                #ifdef __linux__
+                doorbellEvent = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                #endif
+                if(doorbellEvent < 0){
+                    PrintE("Could not create doorbell event for shared memory \"%s\"!\n", name.c_str());
+                    sharedMemoryRing.Close();
+                    udpRetryTimer.WaitFor(prismaConfiguration.network.socketErrorRetryTimeMs);
+                    return;
+                }
+                doorbellThread = std::thread(&NetworkManager::DoorbellThread, this, doorbellEvent, std::ref(stopDoorbell));
+            }
+            Print("Receiving messages via shared memory \"%s\" (%zu bytes)\n", name.c_str(), sharedMemoryRing.GetCapacity());
+            const IPAddress source;
+            const uint8_t* bytes;
+            int32_t length;
+            while(!terminate && udpSocket.IsOpen()){
+                if(streamListener.IsOpen()){
+                    bool hasFrames = sharedMemoryRing.Peek(bytes, length);
+                    if(streamListener.Poll(doorbellEvent, hasFrames ? 0 : static_cast<int32_t>(waitTimeoutMs), [this](const IPAddress& frameSource, const uint8_t* frameBytes, int32_t frameLength){ return ProcessReceivedMessage(frameSource, frameBytes, frameLength, true); })){
+                        #ifdef __linux__
+                        uint64_t value;
+                        (void) read(doorbellEvent, &value, sizeof(value));
                         #endif
-                        udpRetryTimer.WaitFor(prismaConfiguration.network.socketErrorRetryTimeMs);
-                        break;
                     }
-                    std::string errorString = ProcessReceivedMessage(&rxBuffer[0], rx);
+                }
+                else{
+                    (void) sharedMemoryRing.Wait(waitTimeoutMs);
+                }
+                while(!terminate && sharedMemoryRing.Peek(bytes, length)){
+                    std::string errorString = ProcessReceivedMessage(source, bytes, length);
+                    sharedMemoryRing.Pop();
                     if(!errorString.empty()){
-                        udpSocket.SendTo(source, reinterpret_cast<const uint8_t*>(errorString.c_str()), static_cast<int32_t>(errorString.length()));
+                        PrintW("Shared memory \"%s\": %s\n", name.c_str(), errorString.c_str());
                     }
-                    std::this_thread::yield();
                 }
+                reassembler.RemoveExpiredTransfers();
+            }
+            if(doorbellThread.joinable()){
+                stopDoorbell = true;
+                sharedMemoryRing.Wake();
+                doorbellThread.join();
+            }
+            #ifdef __linux__
+            if(doorbellEvent >= 0){
+                (void) close(doorbellEvent);
+            }
+            #endif
+            sharedMemoryRing.Close();
+        }
 
-                // terminate the socket
-                udpSocket.Close();
+        /**
+         * @brief The doorbell thread function, which signals an eventfd each time the doorbell of the shared memory ring is rung.
+         * @param[in] doorbellEvent The eventfd that is polled together with the stream connections.
+         * @param[in] stop True if the thread should be terminated.
+         * @details The eventfd is signalled after the producer has published the frame. It is therefore sufficient to read the
+         * eventfd before fetching all frames from the ring, a frame that is published in between signals the eventfd again.
+         */
+        void DoorbellThread(int doorbellEvent, const std::atomic<bool>& stop){
+            profiler.SetThreadName("network doorbell");
+            constexpr uint32_t waitTimeoutMs = 100;
+            uint32_t sequence = sharedMemoryRing.GetDoorbell();
+            while(!stop){
+                if(sharedMemoryRing.WaitForDoorbell(sequence, waitTimeoutMs)){
+                    #ifdef __linux__
+                    uint64_t value = 1;
+                    (void) write(doorbellEvent, &value, sizeof(value));
+                    #else
+                    (void) doorbellEvent;
+                    #endif
+                }
             }
-            delete[] rxBuffer;
         }
 
         /**
-         * @brief Process a received UDP message.
+         * @brief The replay thread function, which feeds all datagrams of a datagram log to @ref ProcessReceivedMessage.
+         * @param[in] filename The name of the datagram log.
+         * @param[in] speed The replay speed relative to the original timing. A value less than or equal to zero replays the datagrams as fast as possible.
+         * @param[in] onFinished Callback function that is called after all datagrams have been replayed and fetched from the message queue.
+         */
+        void ReplayThread(std::string filename, double speed, std::function<void(void)> onFinished){
+            profiler.SetThreadName("network replay");
+            // a record is a UDP datagram, a frame of the shared memory ring or a frame of a stream connection
+            constexpr uint32_t maxDatagramSize = 65507;
+            uint32_t maxRecordLength = std::max({maxDatagramSize, prismaConfiguration.network.sharedMemory.size, prismaConfiguration.network.receive.maxMessageSize});
+            DatagramLogReader reader;
+            if(!reader.Open(filename, maxRecordLength)){
+                onFinished();
+                return;
+            }
+            Print("Replaying datagram log \"%s\" (speed: %s)\n", filename.c_str(), (speed > 0.0) ? std::to_string(speed).c_str() : "as fast as possible");
+            DatagramLogRecord record;
+            uint64_t numRecords = 0;
+            uint64_t numErrors = 0;
+            uint64_t firstTimestamp = 0;
+            auto tStart = std::chrono::steady_clock::now();
+            while(!terminate && reader.Read(record)){
+                if(!numRecords){
+                    firstTimestamp = record.timestamp;
+                }
+                if((speed > 0.0) && (record.timestamp > firstTimestamp)){
+                    auto tReplay = tStart + std::chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(record.timestamp - firstTimestamp) / speed));
+                    for(auto tNow = std::chrono::steady_clock::now(); !terminate && (tNow < tReplay); tNow = std::chrono::steady_clock::now()){
+                        uint32_t remainingMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(tReplay - tNow).count());
+                        if(remainingMs){
+                            udpRetryTimer.WaitFor(remainingMs);
+                        }
+                        else{
+                            std::this_thread::sleep_until(tReplay);
+                        }
+                    }
+                }
+                bool reliable = (speed <= 0.0) || (record.flags & DATAGRAM_LOG_FLAG_RELIABLE);
+                std::string errorString = ProcessReceivedMessage(record.source, record.bytes.empty() ? nullptr : &record.bytes[0], static_cast<int32_t>(record.bytes.size()), reliable);
+                if(!errorString.empty()){
+                    numErrors++;
+                    PrintW("Replay of datagram %llu: %s\n", static_cast<unsigned long long>(numRecords), errorString.c_str());
+                }
+                reassembler.RemoveExpiredTransfers();
+                numRecords++;
+            }
+            double duration = 1e-9 * static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count());
+            Print("datagram replay: records=%llu, errors=%llu, duration=%.3f s\n", static_cast<unsigned long long>(numRecords), static_cast<unsigned long long>(numErrors), duration);
+
+            // wait until the render thread has fetched all messages
+            constexpr uint32_t pollIntervalMs = 10;
+            while(!terminate && messageManager.GetStatistics().depth){
+                udpRetryTimer.WaitFor(pollIntervalMs);
+            }
+            if(!terminate){
+                onFinished();
+            }
+        }
+
+        /**
+         * @brief Process a received UDP message or a frame of the shared memory ring.
+         * @param[in] source The source address of the received UDP message. The address is zero for frames of the shared memory ring.
          * @param[in] bytes The bytes containing the message.
-         * @param[in] length The length of the received UDP message.
+         * @param[in] length The length of the received UDP message or frame.
+         * @param[in] reliable True if the message has been received via a reliable stream. Such messages are not dropped if the message queue is full.
          * @return An empty string if success or an error message if processing failed.
+         * @details All messages of the datagram are stamped with the receive time for latency measurements (see @ref LatencyStatistics).
          */
-        std::string ProcessReceivedMessage(const uint8_t* bytes, int32_t length){
-            std::vector<MessageBaseType*> newMessages;
+        std::string ProcessReceivedMessage(const IPAddress& source, const uint8_t* bytes, int32_t length, bool reliable = false){
+            int64_t receiveTime = LatencyStatistics::Now();
+            PROFILE_ZONE("DecodeDatagram");
+            if(captureLog.IsOpen()){
+                captureLog.Write(source, bytes, length, reliable ? DATAGRAM_LOG_FLAG_RELIABLE : 0);
+            }
+            newMessages.clear();
             int32_t i = 0;
             int32_t remainingBytes = length;
             while(i < length){
                 MessageType messageType = static_cast<MessageType>(bytes[i]);
-                switch(messageType){
-                    case MESSAGE_TYPE_CLEAR:               newMessages.push_back(new ClearMessage());              break;
-                    case MESSAGE_TYPE_ENGINE_PARAMETER:    newMessages.push_back(new EngineParameterMessage());    break;
-                    case MESSAGE_TYPE_CAMERA:              newMessages.push_back(new CameraMessage());             break;
-                    case MESSAGE_TYPE_ATMOSPHERE:          newMessages.push_back(new AtmosphereMessage());         break;
-                    case MESSAGE_TYPE_AMBIENT_LIGHT:       newMessages.push_back(new AmbientLightMessage());       break;
-                    case MESSAGE_TYPE_DIRECTIONAL_LIGHT:   newMessages.push_back(new DirectionalLightMessage());   break;
-                    case MESSAGE_TYPE_POINT_LIGHT:         newMessages.push_back(new PointLightMessage());         break;
-                    case MESSAGE_TYPE_SPOT_LIGHT:          newMessages.push_back(new SpotLightMessage());          break;
-                    case MESSAGE_TYPE_MESH:                newMessages.push_back(new MeshMessage());               break;
-                    case MESSAGE_TYPE_WATER_MESH:          newMessages.push_back(new WaterMeshMessage());          break;
-                    case MESSAGE_TYPE_DYNAMIC_MESH:        newMessages.push_back(new DynamicMeshMessage());        break;
-                    default:
-                        for(auto&& m : newMessages){
-                            delete m;
-                        }
-                        return "unknown message type " + StringHelper::ByteToHexString(static_cast<uint8_t>(messageType));
+                if(MESSAGE_TYPE_FRAGMENT == messageType){
+                    int32_t numDeserializedBytes = fragment.Deserialize(&bytes[i], remainingBytes);
+                    std::string errorString = ProcessFragment(source, numDeserializedBytes);
+                    if(!errorString.empty()){
+                        RecycleNewMessages();
+                        return errorString;
+                    }
+                    i += numDeserializedBytes;
+                    remainingBytes -= numDeserializedBytes;
+                    continue;
                 }
-                int32_t numDeserializedBytes = newMessages.back()->Deserialize(&bytes[i], remainingBytes);
+                MessageBaseType* message = messageManager.AcquireMessage(messageType);
+                if(!message){
+                    RecycleNewMessages();
+                    return "unknown message type " + StringHelper::ByteToHexString(static_cast<uint8_t>(messageType));
+                }
+                newMessages.push_back(message);
+                int32_t numDeserializedBytes = message->Deserialize(&bytes[i], remainingBytes);
                 if(numDeserializedBytes < 1){
-                    for(auto&& m : newMessages){
-                        delete m;
-                    }
+                    RecycleNewMessages();
                     return "invalid format of message " + StringHelper::ByteToHexString(static_cast<uint8_t>(messageType));
                 }
-                if(!newMessages.back()->IsValid()){
-                    for(auto&& m : newMessages){
-                        delete m;
-                    }
+                if(!message->IsValid()){
+                    RecycleNewMessages();
                     return "invalid data of message " + StringHelper::ByteToHexString(static_cast<uint8_t>(messageType));
                 }
                 i += numDeserializedBytes;
                 remainingBytes -= numDeserializedBytes;
             }
-            messageManager.InsertMessages(newMessages);
+            for(auto&& message : newMessages){
+                message->receiveTime = receiveTime;
+            }
+            messageManager.InsertMessages(newMessages, reliable);
             return "";
         }
+
+        /**
+         * @brief Process the fragment message that has been deserialized to @ref fragment.
+         * @param[in] source The source address of the received UDP message.
+         * @param[in] numDeserializedBytes The number of bytes that have been deserialized.
+         * @return An empty string if success or an error message if processing failed.
+         * @details If the fragment completes a transfer, the reassembled message is appended to @ref newMessages.
+         */
+        std::string ProcessFragment(const IPAddress& source, int32_t numDeserializedBytes){
+            if(numDeserializedBytes < 1){
+                return "invalid format of message " + StringHelper::ByteToHexString(static_cast<uint8_t>(MESSAGE_TYPE_FRAGMENT));
+            }
+            if(!fragment.IsValid()){
+                return "invalid data of message " + StringHelper::ByteToHexString(static_cast<uint8_t>(MESSAGE_TYPE_FRAGMENT));
+            }
+            MessageReassemblerResult result = reassembler.Insert(source, fragment, reassembledBytes);
+            if(MESSAGE_REASSEMBLER_RESULT_TOO_LARGE == result){
+                return "fragmented message " + std::to_string(fragment.transferID) + " exceeds the maximum message size";
+            }
+            if(MESSAGE_REASSEMBLER_RESULT_INVALID == result){
+                return "fragments of fragmented message " + std::to_string(fragment.transferID) + " overlap or leave a gap";
+            }
+            if(MESSAGE_REASSEMBLER_RESULT_COMPLETE != result){
+                return "";
+            }
+            MessageType messageType = reassembledBytes.empty() ? MESSAGE_TYPE_FRAGMENT : static_cast<MessageType>(reassembledBytes[0]);
+            MessageBaseType* message = messageManager.AcquireMessage(messageType);
+            if(!message){
+                return "unknown message type " + StringHelper::ByteToHexString(static_cast<uint8_t>(messageType)) + " in fragmented message " + std::to_string(fragment.transferID);
+            }
+            newMessages.push_back(message);
+            int32_t length = static_cast<int32_t>(reassembledBytes.size());
+            if(message->DeserializeLarge(&reassembledBytes[0], length) != length){
+                return "invalid format of fragmented message " + StringHelper::ByteToHexString(static_cast<uint8_t>(messageType));
+            }
+            if(!message->IsValid()){
+                return "invalid data of fragmented message " + StringHelper::ByteToHexString(static_cast<uint8_t>(messageType));
+            }
+            return "";
+        }
+
+        /**
+         * @brief Return all messages of @ref newMessages to the message pools and clear the container.
+         */
+        void RecycleNewMessages(void){
+            for(auto&& m : newMessages){
+                messageManager.RecycleMessage(m);
+            }
+            newMessages.clear();
+        }
 };
 
@@ -0,0 +1,417 @@
+#pragma once
+
+
+#include <Common.hpp>
+
+
+/**
+ * @brief Identifier of a valid shared memory ring ("PRSM").
+ */
+#define SHARED_MEMORY_RING_MAGIC (0x5052534D)
+
+
+/**
+ * @brief Version of the memory layout of the shared memory ring.
+ */
+#define SHARED_MEMORY_RING_VERSION (1)
+
+
+/**
+ * @brief Frame length that marks the end of the ring, the next frame starts at the beginning of the ring.
+ */
+#define SHARED_MEMORY_RING_WRAP_MARKER (0xFFFFFFFF)
+
+
+/**
+ * @brief Header of a shared memory ring that is located at the beginning of the shared memory object.
+ * @details The shared memory object consists of this header followed by the data region. The data region contains frames,
+ * each frame consists of a 32-bit length in native byte order followed by the bytes of the frame. The bytes of a frame
+ * use the same format as a UDP datagram, i.e. one or more messages in network byte order. Each frame starts at an offset
+ * that is a multiple of 8 bytes and frames never wrap around the end of the data region.
+ */
+struct SharedMemoryRingHeader {
+    std::atomic<uint32_t> magic;                 // Must be @ref SHARED_MEMORY_RING_MAGIC, set to zero by the consumer when the ring is closed.
+    uint32_t version;                            // Must be @ref SHARED_MEMORY_RING_VERSION.
+    uint64_t capacity;                           // Size of the data region in bytes (power of two).
+    alignas(64) std::atomic<uint64_t> head;      // Read position of the consumer, written by the consumer.
+    alignas(64) std::atomic<uint64_t> tail;      // Write position of the producer, written by the producer.
+    alignas(64) std::atomic<uint32_t> doorbell;  // Futex word that is incremented by the producer for each frame.
+    std::atomic<uint32_t> consumerWaiting;       // Nonzero if the consumer waits on the @ref doorbell.
+};
+
+
+/**
+ * @brief A single-producer/single-consumer ring buffer of frames in POSIX shared memory with a futex doorbell (linux only).
+ * @details PRISMA (consumer) creates the shared memory object via @ref Create and reads frames directly from the mapped
+ * memory via @ref Peek and @ref Pop. A co-located process (producer) connects via @ref Connect and inserts frames via
+ * @ref Write. If the producer is faster than the consumer, @ref Write fails and the producer decides whether to retry
+ * or to drop the frame. A producer should reconnect if @ref Write keeps failing, e.g. because PRISMA has been restarted.
+ */
+class SharedMemoryRing {
+    public:
+        /**
+         * @brief Construct a new shared memory ring.
+         */
+        SharedMemoryRing(): header(nullptr), data(nullptr), mask(0), mappedSize(0), owner(false), localPosition(0), peekedFrameSize(0){}
+
+        /**
+         * @brief Close the shared memory ring.
+         */
+        ~SharedMemoryRing(){ Close(); }
+
+        /**
+         * @brief Create the shared memory object and initialize an empty ring (consumer).
+         * @param[in] name The name of the POSIX shared memory object, e.g. "/prisma".
+         * @param[in] capacity The size of the data region in bytes. The value is rounded up to the next power of two.
+         * @return True if success, false otherwise.
+         */
+        bool Create(const std::string& name, size_t capacity){
+            Close();
+            #ifdef __linux__
+            size_t n = 4096;
+            while(n < capacity){
+                n <<= 1;
+            }
+            (void) shm_unlink(name.c_str()); // producers that are still connected to an old ring must not write to the new ring
+            int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if(fd < 0){
+                PrintE("Could not create shared memory \"%s\"! %s\n", name.c_str(), std::strerror(errno));
+                return false;
+            }
+            size_t size = GetHeaderSize() + n;
+            if(ftruncate(fd, static_cast<off_t>(size)) < 0){
+                PrintE("Could not resize shared memory \"%s\" to %zu bytes! %s\n", name.c_str(), size, std::strerror(errno));
+                ::close(fd);
+                (void) shm_unlink(name.c_str());
+                return false;
+            }
+            if(!Map(fd, size)){
+                PrintE("Could not map shared memory \"%s\"! %s\n", name.c_str(), std::strerror(errno));
+                ::close(fd);
+                (void) shm_unlink(name.c_str());
+                return false;
+            }
+            ::close(fd);
+            header->magic.store(0, std::memory_order_relaxed);
+            header->version = SHARED_MEMORY_RING_VERSION;
+            header->capacity = static_cast<uint64_t>(n);
+            header->head.store(0, std::memory_order_relaxed);
+            header->tail.store(0, std::memory_order_relaxed);
+            header->doorbell.store(0, std::memory_order_relaxed);
+            header->consumerWaiting.store(0, std::memory_order_relaxed);
+            header->magic.store(SHARED_MEMORY_RING_MAGIC, std::memory_order_release);
+            mask = static_cast<uint64_t>(n - 1);
+            localPosition = 0;
+            peekedFrameSize = 0;
+            this->name = name;
+            owner = true;
+            return true;
+            #else
+            (void) name;
+            (void) capacity;
+            PrintE("Shared memory transport is not supported on this system!\n");
+            return false;
+            #endif
+        }
+
+        /**
+         * @brief Connect to a shared memory ring that has been created by @ref Create (producer).
+         * @param[in] name The name of the POSIX shared memory object, e.g. "/prisma".
+         * @return True if success, false otherwise.
+         */
+        bool Connect(const std::string& name){
+            Close();
+            #ifdef __linux__
+            int fd = shm_open(name.c_str(), O_RDWR, 0600);
+            if(fd < 0){
+                return false;
+            }
+            struct stat info;
+            if((fstat(fd, &info) < 0) || (static_cast<size_t>(info.st_size) <= GetHeaderSize()) || !Map(fd, static_cast<size_t>(info.st_size))){
+                ::close(fd);
+                return false;
+            }
+            ::close(fd);
+            uint64_t capacity = header->capacity;
+            if(!IsValid() || (SHARED_MEMORY_RING_VERSION != header->version) || ((GetHeaderSize() + capacity) != mappedSize) || (capacity & (capacity - 1))){
+                Close();
+                return false;
+            }
+            mask = capacity - 1;
+            localPosition = header->tail.load(std::memory_order_relaxed);
+            peekedFrameSize = 0;
+            return true;
+            #else
+            (void) name;
+            return false;
+            #endif
+        }
+
+        /**
+         * @brief Close the shared memory ring. If the ring has been created by this object, it is marked as invalid and the shared memory object is removed.
+         */
+        void Close(void){
+            #ifdef __linux__
+            if(header){
+                if(owner){
+                    header->magic.store(0, std::memory_order_release);
+                    (void) shm_unlink(name.c_str());
+                }
+                (void) munmap(header, mappedSize);
+            }
+            #endif
+            header = nullptr;
+            data = nullptr;
+            mask = 0;
+            mappedSize = 0;
+            owner = false;
+            localPosition = 0;
+            peekedFrameSize = 0;
+            name.clear();
+        }
+
+        /**
+         * @brief Check whether the ring is open and has not been closed by the consumer.
+         * @return True if the ring can be used, false otherwise.
+         */
+        bool IsValid(void) const { return header && (SHARED_MEMORY_RING_MAGIC == header->magic.load(std::memory_order_acquire)); }
+
+        /**
+         * @brief Get the size of the data region.
+         * @return The capacity of the ring in bytes or zero if the ring is not open.
+         */
+        size_t GetCapacity(void) const { return header ? static_cast<size_t>(mask + 1) : 0; }
+
+        /**
+         * @brief Get the maximum length of a single frame.
+         * @return Maximum number of bytes of a frame that can be written via @ref Write.
+         */
+        size_t GetMaxFrameLength(void) const { return header ? static_cast<size_t>(std::min(header->capacity >> 1, static_cast<uint64_t>(std::numeric_limits<int32_t>::max()))) - sizeof(uint32_t) : 0; }
+
+        /**
+         * @brief Write a frame to the ring and notify the consumer (producer only).
+         * @param[in] bytes The bytes of the frame (one or more messages).
+         * @param[in] length The number of bytes of the frame.
+         * @return True if success, false if the frame is too large, the ring is full or the ring has been closed by the consumer.
+         */
+        bool Write(const uint8_t* bytes, int32_t length){
+            if(!IsValid() || (length < 1) || (static_cast<size_t>(length) > GetMaxFrameLength())){
+                return false;
+            }
+            uint64_t capacity = mask + 1;
+            uint64_t frameSize = GetFrameSize(static_cast<uint64_t>(length));
+            uint64_t offset = localPosition & mask;
+            uint64_t contiguous = capacity - offset;
+            uint64_t required = (frameSize > contiguous) ? (frameSize + contiguous) : frameSize;
+            uint64_t used = localPosition - header->head.load(std::memory_order_acquire);
+            if((capacity - used) < required){
+                return false;
+            }
+            if(frameSize > contiguous){
+                *reinterpret_cast<uint32_t*>(&data[offset]) = SHARED_MEMORY_RING_WRAP_MARKER;
+                localPosition += contiguous;
+                offset = 0;
+            }
+            *reinterpret_cast<uint32_t*>(&data[offset]) = static_cast<uint32_t>(length);
+            std::memcpy(&data[offset + sizeof(uint32_t)], bytes, static_cast<size_t>(length));
+            localPosition += frameSize;
+            header->tail.store(localPosition, std::memory_order_seq_cst);
+            header->doorbell.fetch_add(1, std::memory_order_seq_cst);
+            if(header->consumerWaiting.load(std::memory_order_seq_cst)){
+                Wake();
+            }
+            return true;
+        }
+
+        /**
+         * @brief Wait until the ring contains at least one frame (consumer only).
+         * @param[in] timeoutMs Maximum time to wait in milliseconds.
+         * @return True if the ring is not empty, false otherwise.
+         */
+        bool Wait(uint32_t timeoutMs){
+            if(!header){
+                return false;
+            }
+            uint32_t sequence = header->doorbell.load(std::memory_order_seq_cst);
+            if(header->tail.load(std::memory_order_acquire) != localPosition){
+                return true;
+            }
+            #ifdef __linux__
+            header->consumerWaiting.store(1, std::memory_order_seq_cst);
+            if(header->tail.load(std::memory_order_seq_cst) == localPosition){
+                struct timespec timeout;
+                timeout.tv_sec = static_cast<time_t>(timeoutMs / 1000);
+                timeout.tv_nsec = static_cast<long>(timeoutMs % 1000) * 1000000L;
+                (void) syscall(SYS_futex, reinterpret_cast<uint32_t*>(&header->doorbell), FUTEX_WAIT, sequence, &timeout, nullptr, 0);
+            }
+            header->consumerWaiting.store(0, std::memory_order_seq_cst);
+            #else
+            (void) sequence;
+            (void) timeoutMs;
+            #endif
+            return header->tail.load(std::memory_order_acquire) != localPosition;
+        }
+
+        /**
+         * @brief Wait until the doorbell has been rung since a given doorbell value has been seen (consumer only).
+         * @param[inout] sequence The doorbell value that has been seen last, updated to the current doorbell value.
+         * @param[in] timeoutMs Maximum time to wait in milliseconds.
+         * @return True if the doorbell has been rung, false otherwise.
+         * @details Unlike @ref Wait, this function does not access the read position. It can therefore be called by another
+         * thread than @ref Peek and @ref Pop, e.g. to forward the doorbell to a descriptor that is polled together with sockets.
+         */
+        bool WaitForDoorbell(uint32_t& sequence, uint32_t timeoutMs){
+            if(!header){
+                return false;
+            }
+            #ifdef __linux__
+            header->consumerWaiting.store(1, std::memory_order_seq_cst);
+            if(header->doorbell.load(std::memory_order_seq_cst) == sequence){
+                struct timespec timeout;
+                timeout.tv_sec = static_cast<time_t>(timeoutMs / 1000);
+                timeout.tv_nsec = static_cast<long>(timeoutMs % 1000) * 1000000L;
+                (void) syscall(SYS_futex, reinterpret_cast<uint32_t*>(&header->doorbell), FUTEX_WAIT, sequence, &timeout, nullptr, 0);
+            }
+            header->consumerWaiting.store(0, std::memory_order_seq_cst);
+            #else
+            (void) timeoutMs;
+            #endif
+            uint32_t value = header->doorbell.load(std::memory_order_seq_cst);
+            bool rung = (value != sequence);
+            sequence = value;
+            return rung;
+        }
+
+        /**
+         * @brief Get the current value of the doorbell.
+         * @return The number of frames that have been written modulo 2^32 or zero if the ring is not open.
+         */
+        uint32_t GetDoorbell(void) const { return header ? header->doorbell.load(std::memory_order_seq_cst) : 0; }
+
+        /**
+         * @brief Wake up a consumer that waits via @ref Wait or @ref WaitForDoorbell.
+         */
+        void Wake(void){
+            #ifdef __linux__
+            if(header){
+                (void) syscall(SYS_futex, reinterpret_cast<uint32_t*>(&header->doorbell), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+            }
+            #endif
+        }
+
+        /**
+         * @brief Get the oldest frame of the ring without removing it (consumer only).
+         * @param[out] bytes Pointer to the first byte of the frame inside the shared memory. The bytes remain valid until @ref Pop is called.
+         * @param[out] length The number of bytes of the frame.
+         * @return True if a frame is available, false if the ring is empty.
+         * @details If the ring contains an invalid frame, all frames are dropped. A frame is invalid if its length is out of
+         * range or if it exceeds the tail. A wrap marker is invalid at offset zero or if it exceeds the tail.
+         */
+        bool Peek(const uint8_t*& bytes, int32_t& length){
+            peekedFrameSize = 0;
+            if(!header){
+                return false;
+            }
+            uint64_t capacity = mask + 1;
+            uint64_t tail = header->tail.load(std::memory_order_acquire);
+            if((tail - localPosition) > capacity){ // also covers a tail that is behind the read position
+                return DropFrames(tail);
+            }
+            while(localPosition < tail){
+                uint64_t offset = localPosition & mask;
+                uint32_t frameLength = *reinterpret_cast<const uint32_t*>(&data[offset]);
+                if(SHARED_MEMORY_RING_WRAP_MARKER == frameLength){
+                    uint64_t contiguous = capacity - offset;
+                    if(!offset || (contiguous > (tail - localPosition))){
+                        return DropFrames(tail);
+                    }
+                    localPosition += contiguous;
+                    continue;
+                }
+                uint64_t frameSize = GetFrameSize(frameLength);
+                if(!frameLength || (static_cast<size_t>(frameLength) > GetMaxFrameLength()) || ((offset + frameSize) > capacity) || (frameSize > (tail - localPosition))){
+                    return DropFrames(tail);
+                }
+                bytes = &data[offset + sizeof(uint32_t)];
+                length = static_cast<int32_t>(frameLength);
+                peekedFrameSize = frameSize;
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Remove the frame that has been obtained by @ref Peek and release its memory to the producer (consumer only).
+         * @details The read position is advanced by the frame size that has been validated by @ref Peek, such that a producer
+         * cannot change it via the shared memory in the meantime.
+         */
+        void Pop(void){
+            if(!header || !peekedFrameSize){
+                return;
+            }
+            localPosition += peekedFrameSize;
+            peekedFrameSize = 0;
+            header->head.store(localPosition, std::memory_order_release);
+        }
+
+    private:
+        SharedMemoryRingHeader* header;   // The header of the mapped shared memory object.
+        uint8_t* data;                    // The data region of the mapped shared memory object.
+        uint64_t mask;                    // Position mask (capacity - 1).
+        size_t mappedSize;                // Total number of bytes that have been mapped.
+        bool owner;                       // True if the shared memory object has been created by this object.
+        uint64_t localPosition;           // Local copy of the tail (producer) or the head (consumer).
+        uint64_t peekedFrameSize;         // Size of the frame that has been obtained by @ref Peek or zero if there is none (consumer only).
+        std::string name;                 // Name of the shared memory object, only set for the owner.
+
+        static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free, "shared memory ring requires lock-free atomics");
+
+        /**
+         * @brief Get the size of the header region, which is a multiple of the page size.
+         * @return Size of the header region in bytes.
+         */
+        static constexpr size_t GetHeaderSize(void){ return 4096; }
+
+        /**
+         * @brief Get the size of a frame in the ring including its length field and the alignment padding.
+         * @param[in] length The number of bytes of the frame.
+         * @return Number of bytes that are occupied in the ring.
+         */
+        static constexpr uint64_t GetFrameSize(uint64_t length){ return (sizeof(uint32_t) + length + 7) & ~static_cast<uint64_t>(7); }
+
+        /**
+         * @brief Drop all frames of the ring after an invalid frame has been found (consumer only).
+         * @param[in] tail The tail that has been read from the header.
+         * @return Always false.
+         */
+        bool DropFrames(uint64_t tail){
+            PrintW("Invalid frame in shared memory ring, dropping %llu bytes!\n", static_cast<unsigned long long>((tail > localPosition) ? (tail - localPosition) : 0));
+            localPosition = tail;
+            header->head.store(localPosition, std::memory_order_release);
+            return false;
+        }
+
+        /**
+         * @brief Map a shared memory object.
+         * @param[in] fd The file descriptor of the shared memory object.
+         * @param[in] size The number of bytes to be mapped.
+         * @return True if success, false otherwise.
+         */
+        bool Map(int fd, size_t size){
+            #ifdef __linux__
+            void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if(MAP_FAILED == memory){
+                return false;
+            }
+            header = reinterpret_cast<SharedMemoryRingHeader*>(memory);
+            data = reinterpret_cast<uint8_t*>(memory) + GetHeaderSize();
+            mappedSize = size;
+            return true;
+            #else
+            (void) fd;
+            (void) size;
+            return false;
+            #endif
+        }
+};
+
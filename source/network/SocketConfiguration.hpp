@@ -10,6 +10,7 @@
 class SocketConfiguration {
     public:
         int32_t socketPriority;                              // The socket priority (linux only, in range [0 (lowest), 6 (greatest)]).
+        int32_t receiveBufferSize;                           // The size of the socket receive buffer in bytes (SO_RCVBUF). A value less than or equal to zero keeps the default value of the OS.
         uint16_t localPort;                                  // The local port to be bound.
         uint8_t ttl;                                         // The time-to-live (TTL) value to be set for multicast messages.
         std::vector<std::array<uint8_t,4>> groupAddresses;   // The group addresses to be joined.
@@ -30,6 +31,7 @@ class SocketConfiguration {
          */
         void Clear(void){
             socketPriority = 0;
+            receiveBufferSize = 0;
             localPort = 0;
             ttl = 0;
             groupAddresses = {{239,0,0,0}};
@@ -0,0 +1,386 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <IPAddress.hpp>
+#include <NetworkUtils.hpp>
+
+
+/**
+ * @brief The maximum number of stream connections that are served at the same time.
+ */
+#define STREAM_LISTENER_MAX_CONNECTIONS (16)
+
+
+/**
+ * @brief The minimum number of free bytes in the receive buffer of a connection before a single receive call.
+ */
+#define STREAM_LISTENER_READ_SIZE (262144)
+
+
+/**
+ * @brief Listens for reliable stream connections (TCP and/or Unix domain socket) and receives length-prefixed frames.
+ * @details Each frame consists of a 32-bit length in network byte order followed by the bytes of the frame. The bytes of a
+ * frame use the same format as a UDP datagram, i.e. one or more messages. Frames are passed to a handler directly from the
+ * receive buffer of the connection. All sockets are served by @ref Poll, which also waits for an external socket, so
+ * that a single thread can serve the UDP socket and all stream connections. If the handler blocks, no further data is read
+ * from the connection and the sender is slowed down by the flow control of the stream (back-pressure).
+ * @note This class is not thread-safe.
+ */
+class StreamListener {
+    public:
+        /**
+         * @brief Construct a new stream listener.
+         */
+        StreamListener(): tcpSocket(-1), unixSocket(-1), receiveBufferSize(0), maxFrameLength(0), nextConnectionID(1){}
+
+        /**
+         * @brief Close the stream listener.
+         */
+        ~StreamListener(){ Close(); }
+
+        /**
+         * @brief Open the listening sockets.
+         * @param[in] tcpAddress IPv4 address of the interface at which to listen for TCP connections. Set this value to {0,0,0,0} to listen at all interfaces.
+         * @param[in] tcpPort The TCP port to listen at. If this value is zero, no TCP socket is opened.
+         * @param[in] unixSocketPath The path of the Unix domain socket (linux only). If this string is empty, no Unix domain socket is opened.
+         * @param[in] receiveBufferSize Size of the socket receive buffer of each connection in bytes. A value less than or equal to zero keeps the default value of the OS.
+         * @param[in] maxFrameLength The maximum number of bytes of a single frame. A connection that announces a larger frame is closed.
+         * @return True if success, false otherwise.
+         */
+        bool Open(std::array<uint8_t,4> tcpAddress, uint16_t tcpPort, const std::string& unixSocketPath, int32_t receiveBufferSize, uint32_t maxFrameLength){
+            Close();
+            this->receiveBufferSize = receiveBufferSize;
+            this->maxFrameLength = maxFrameLength;
+            if(tcpPort){
+                tcpSocket = static_cast<int>(socket(AF_INET, SOCK_STREAM, 0));
+                if(tcpSocket < 0){
+                    PrintE("Could not open TCP socket! %s\n", GetLastErrorString().c_str());
+                    Close();
+                    return false;
+                }
+                unsigned yes = 1;
+                (void) setsockopt(tcpSocket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&yes), sizeof(yes));
+                SetReceiveBufferSize(tcpSocket);
+                sockaddr_in addr{};
+                addr.sin_family = AF_INET;
+                addr.sin_port = htons(tcpPort);
+                addr.sin_addr.s_addr = htonl((static_cast<uint32_t>(tcpAddress[0]) << 24) | (static_cast<uint32_t>(tcpAddress[1]) << 16) | (static_cast<uint32_t>(tcpAddress[2]) << 8) | static_cast<uint32_t>(tcpAddress[3]));
+                if((bind(tcpSocket, reinterpret_cast<const struct sockaddr*>(&addr), sizeof(addr)) < 0) || (listen(tcpSocket, STREAM_LISTENER_MAX_CONNECTIONS) < 0)){
+                    PrintE("Could not listen at TCP %u.%u.%u.%u:%u! %s\n", tcpAddress[0], tcpAddress[1], tcpAddress[2], tcpAddress[3], tcpPort, GetLastErrorString().c_str());
+                    Close();
+                    return false;
+                }
+            }
+            if(!unixSocketPath.empty()){
+                #ifdef __linux__
+                sockaddr_un addr{};
+                if(unixSocketPath.length() >= sizeof(addr.sun_path)){
+                    PrintE("Path of Unix domain socket \"%s\" is too long!\n", unixSocketPath.c_str());
+                    Close();
+                    return false;
+                }
+                unixSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+                if(unixSocket < 0){
+                    PrintE("Could not open Unix domain socket! %s\n", GetLastErrorString().c_str());
+                    Close();
+                    return false;
+                }
+                SetReceiveBufferSize(unixSocket);
+                addr.sun_family = AF_UNIX;
+                std::memcpy(addr.sun_path, unixSocketPath.c_str(), unixSocketPath.length());
+                (void) unlink(unixSocketPath.c_str());
+                if((bind(unixSocket, reinterpret_cast<const struct sockaddr*>(&addr), sizeof(addr)) < 0) || (listen(unixSocket, STREAM_LISTENER_MAX_CONNECTIONS) < 0)){
+                    PrintE("Could not listen at Unix domain socket \"%s\"! %s\n", unixSocketPath.c_str(), GetLastErrorString().c_str());
+                    Close();
+                    return false;
+                }
+                this->unixSocketPath = unixSocketPath;
+                #else
+                PrintE("Unix domain sockets are not supported on this system!\n");
+                Close();
+                return false;
+                #endif
+            }
+            return true;
+        }
+
+        /**
+         * @brief Close all connections and the listening sockets.
+         */
+        void Close(void){
+            for(auto&& connection : connections){
+                CloseSocket(connection.socket);
+            }
+            connections.clear();
+            CloseSocket(tcpSocket);
+            CloseSocket(unixSocket);
+            #ifdef __linux__
+            if(!unixSocketPath.empty()){
+                (void) unlink(unixSocketPath.c_str());
+            }
+            #endif
+            unixSocketPath.clear();
+        }
+
+        /**
+         * @brief Check whether at least one listening socket is open.
+         * @return True if the stream listener is open, false otherwise.
+         */
+        bool IsOpen(void) const { return (tcpSocket >= 0) || (unixSocket >= 0); }
+
+        /**
+         * @brief Get the number of connections.
+         * @return The number of connected streams.
+         */
+        size_t GetNumConnections(void) const { return connections.size(); }
+
+        /**
+         * @brief Wait for incoming connections, data of existing connections or data of an external socket and receive
+         * available data of all connections.
+         * @tparam Handler Callable with the signature std::string(const IPAddress& source, const uint8_t* bytes, int32_t length).
+         * It is called for each complete frame and returns an empty string if success or an error message that is sent
+         * back to the sender as a frame.
+         * @param[in] externalSocket An additional socket to wait for, e.g. the UDP socket. A negative value is ignored.
+         * @param[in] timeoutMs Maximum time to wait in milliseconds.
+         * @param[in] handler The handler that processes complete frames.
+         * @return True if the external socket is readable (or has been shut down), false otherwise.
+         * @details The source address of a Unix domain socket connection is zero with a unique port value for each connection.
+         */
+        template <typename Handler> bool Poll(int externalSocket, int32_t timeoutMs, Handler&& handler){
+            descriptors.clear();
+            if(externalSocket >= 0){
+                AddDescriptor(externalSocket);
+            }
+            if(tcpSocket >= 0){
+                AddDescriptor(tcpSocket);
+            }
+            if(unixSocket >= 0){
+                AddDescriptor(unixSocket);
+            }
+            size_t firstConnection = descriptors.size();
+            size_t numConnections = connections.size();
+            for(auto&& connection : connections){
+                AddDescriptor(connection.socket);
+            }
+            #ifdef _WIN32
+            int n = WSAPoll(&descriptors[0], static_cast<ULONG>(descriptors.size()), static_cast<INT>(timeoutMs));
+            #else
+            int n = poll(&descriptors[0], static_cast<nfds_t>(descriptors.size()), static_cast<int>(timeoutMs));
+            #endif
+            if(n <= 0){
+                return false;
+            }
+            size_t k = 0;
+            bool externalReady = false;
+            if(externalSocket >= 0){
+                externalReady = (0 != descriptors[k++].revents);
+            }
+            for(size_t c = 0; c < numConnections; ++c){
+                if(descriptors[firstConnection + c].revents && !Receive(connections[c], handler)){
+                    CloseSocket(connections[c].socket);
+                }
+            }
+            if(tcpSocket >= 0){
+                if(descriptors[k++].revents){
+                    Accept(tcpSocket, true);
+                }
+            }
+            if(unixSocket >= 0){
+                if(descriptors[k++].revents){
+                    Accept(unixSocket, false);
+                }
+            }
+            connections.erase(std::remove_if(connections.begin(), connections.end(), [](const Connection& c){ return c.socket < 0; }), connections.end());
+            return externalReady;
+        }
+
+    private:
+        struct Connection {
+            int socket;                     // The socket of the connection.
+            IPAddress source;               // Source address of the sender.
+            std::vector<uint8_t> buffer;    // Receive buffer, the capacity is kept between frames.
+            size_t begin;                   // Position of the first byte in the buffer that has not been processed.
+            size_t end;                     // Position after the last received byte in the buffer.
+        };
+        int tcpSocket;                                  // The listening TCP socket or -1 if TCP is disabled.
+        int unixSocket;                                 // The listening Unix domain socket or -1 if Unix domain sockets are disabled.
+        std::string unixSocketPath;                     // The path of the Unix domain socket to be removed when closing.
+        int32_t receiveBufferSize;                      // Size of the socket receive buffer of each connection.
+        uint32_t maxFrameLength;                        // Maximum number of bytes of a single frame.
+        uint16_t nextConnectionID;                      // Identifier of the next Unix domain socket connection.
+        std::vector<Connection> connections;            // All connected streams.
+        #ifdef _WIN32
+        std::vector<WSAPOLLFD> descriptors;             // Descriptors to be polled, the capacity is kept between calls.
+        #else
+        std::vector<struct pollfd> descriptors;         // Descriptors to be polled, the capacity is kept between calls.
+        #endif
+
+        /**
+         * @brief Add a socket to the descriptors to be polled.
+         * @param[in] s The socket to wait for.
+         */
+        void AddDescriptor(int s){
+            descriptors.emplace_back();
+            descriptors.back().fd = s;
+            descriptors.back().events = POLLIN;
+            descriptors.back().revents = 0;
+        }
+
+        /**
+         * @brief Accept a new connection.
+         * @param[in] listeningSocket The listening socket with a pending connection.
+         * @param[in] isTCP True if the listening socket is a TCP socket, false if it is a Unix domain socket.
+         */
+        void Accept(int listeningSocket, bool isTCP){
+            sockaddr_in addr{};
+            #ifdef _WIN32
+            int addressSize = sizeof(addr);
+            #else
+            socklen_t addressSize = sizeof(addr);
+            #endif
+            int s = static_cast<int>(accept(listeningSocket, isTCP ? reinterpret_cast<struct sockaddr*>(&addr) : nullptr, isTCP ? &addressSize : nullptr));
+            if(s < 0){
+                return;
+            }
+            if(connections.size() >= STREAM_LISTENER_MAX_CONNECTIONS){
+                PrintW("Rejecting stream connection, the maximum number of %d connections is reached!\n", STREAM_LISTENER_MAX_CONNECTIONS);
+                CloseSocket(s);
+                return;
+            }
+            connections.emplace_back();
+            Connection& connection = connections.back();
+            connection.socket = s;
+            if(isTCP){
+                uint32_t u32 = ntohl(addr.sin_addr.s_addr);
+                connection.source = IPAddress(static_cast<uint8_t>(u32 >> 24), static_cast<uint8_t>(u32 >> 16), static_cast<uint8_t>(u32 >> 8), static_cast<uint8_t>(u32), static_cast<uint16_t>(ntohs(addr.sin_port)));
+            }
+            else{
+                connection.source = IPAddress(0, 0, 0, 0, nextConnectionID++);
+            }
+            connection.begin = 0;
+            connection.end = 0;
+        }
+
+        /**
+         * @brief Receive available data of a connection and process all complete frames.
+         * @param[inout] connection The connection with available data.
+         * @param[in] handler The handler that processes complete frames.
+         * @return True if success, false if the connection has been closed by the sender or has to be closed due to an error.
+         */
+        template <typename Handler> bool Receive(Connection& connection, Handler&& handler){
+            // make room for at least STREAM_LISTENER_READ_SIZE bytes, move an incomplete frame to the front
+            if((connection.buffer.size() - connection.end) < STREAM_LISTENER_READ_SIZE){
+                Compact(connection);
+                if((connection.buffer.size() - connection.end) < STREAM_LISTENER_READ_SIZE){
+                    connection.buffer.resize(connection.end + STREAM_LISTENER_READ_SIZE);
+                }
+            }
+            int rx = static_cast<int>(recv(connection.socket, reinterpret_cast<char*>(&connection.buffer[connection.end]), static_cast<int>(connection.buffer.size() - connection.end), 0));
+            if(rx <= 0){
+                return false;
+            }
+            connection.end += static_cast<size_t>(rx);
+
+            // process all complete frames directly from the receive buffer
+            while((connection.end - connection.begin) >= sizeof(uint32_t)){
+                uint32_t length;
+                std::memcpy(&length, &connection.buffer[connection.begin], sizeof(uint32_t));
+                length = NetworkUtils::NetworkToNativeByteOrder(length);
+                if(!length || (length > maxFrameLength)){
+                    PrintW("Closing stream connection, invalid frame length %u!\n", length);
+                    return false;
+                }
+                size_t frameSize = sizeof(uint32_t) + static_cast<size_t>(length);
+                if((connection.end - connection.begin) < frameSize){
+                    break; // the buffer grows with the received bytes, not with the announced frame length
+                }
+                std::string errorString = handler(connection.source, &connection.buffer[connection.begin + sizeof(uint32_t)], static_cast<int32_t>(length));
+                connection.begin += frameSize;
+                if(!errorString.empty()){
+                    SendFrame(connection.socket, reinterpret_cast<const uint8_t*>(errorString.c_str()), static_cast<uint32_t>(errorString.length()));
+                }
+            }
+            if(connection.begin == connection.end){
+                connection.begin = 0;
+                connection.end = 0;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Move the unprocessed bytes of a connection to the beginning of the receive buffer.
+         * @param[inout] connection The connection whose buffer is to be compacted.
+         */
+        static void Compact(Connection& connection){
+            if(connection.begin){
+                std::memmove(&connection.buffer[0], &connection.buffer[connection.begin], connection.end - connection.begin);
+                connection.end -= connection.begin;
+                connection.begin = 0;
+            }
+        }
+
+        /**
+         * @brief Send a frame without blocking. If the sender does not read its socket, the frame is discarded.
+         * @param[in] s The socket of the connection.
+         * @param[in] bytes The bytes of the frame.
+         * @param[in] length The number of bytes of the frame.
+         */
+        static void SendFrame(int s, const uint8_t* bytes, uint32_t length){
+            std::vector<uint8_t> frame(sizeof(uint32_t) + length);
+            uint32_t header = NetworkUtils::NetworkToNativeByteOrder(length);
+            std::memcpy(&frame[0], &header, sizeof(uint32_t));
+            std::memcpy(&frame[sizeof(uint32_t)], bytes, length);
+            #ifdef _WIN32
+            (void) send(s, reinterpret_cast<const char*>(&frame[0]), static_cast<int>(frame.size()), 0);
+            #else
+            (void) send(s, &frame[0], frame.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+            #endif
+        }
+
+        /**
+         * @brief Set the size of the receive buffer of a socket. Accepted connections inherit the value of the listening socket.
+         * @param[in] s The socket.
+         */
+        void SetReceiveBufferSize(int s){
+            if(receiveBufferSize > 0){
+                int value = static_cast<int>(receiveBufferSize);
+                if(setsockopt(s, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&value), sizeof(value)) < 0){
+                    PrintW("Could not set receive buffer size %d for stream socket! %s\n", receiveBufferSize, GetLastErrorString().c_str());
+                }
+            }
+        }
+
+        /**
+         * @brief Close a socket and set it to -1.
+         * @param[inout] s The socket to be closed.
+         */
+        static void CloseSocket(int& s){
+            if(s >= 0){
+                #ifdef _WIN32
+                (void) shutdown(s, SD_BOTH);
+                (void) closesocket(s);
+                #else
+                (void) shutdown(s, SHUT_RDWR);
+                (void) close(s);
+                #endif
+            }
+            s = -1;
+        }
+
+        /**
+         * @brief Get the string representing the last socket error.
+         * @return A string representing the last socket error.
+         */
+        static std::string GetLastErrorString(void){
+            #ifdef _WIN32
+            int err = static_cast<int>(WSAGetLastError());
+            std::string errStr("");
+            #else
+            int err = static_cast<int>(errno);
+            std::string errStr = std::string(strerror(err)) + std::string(" ");
+            #endif
+            return errStr + std::string("(") + std::to_string(err) + std::string(")");
+        }
+};
+
@@ -54,6 +54,10 @@ void UDPSocket::Close(void){
     _socket = -1;
 }
 
+int UDPSocket::GetDescriptor(void){
+    return _socket;
+}
+
 uint16_t UDPSocket::GetPort(void){
     struct sockaddr_in addr_this;
     socklen_t len = sizeof(addr_this);
@@ -130,6 +134,31 @@ int32_t UDPSocket::SendTo(IPAddress destination, const uint8_t *bytes, int32_t s
     return static_cast<int32_t>(sendto(_socket, reinterpret_cast<const char*>(bytes), size, 0, reinterpret_cast<const struct sockaddr*>(&addr), sizeof(addr)));
 }
 
+int32_t UDPSocket::SendToAll(DatagramFanOut& fanOut, const uint8_t *bytes, int32_t size){
+    #ifdef __linux__
+    unsigned int numDestinations = static_cast<unsigned int>(fanOut.headers.size());
+    fanOut.vector.iov_base = const_cast<uint8_t*>(bytes);
+    fanOut.vector.iov_len = static_cast<size_t>(size);
+    unsigned int numSent = 0;
+    while(numSent < numDestinations){
+        int tx = sendmmsg(_socket, &fanOut.headers[numSent], numDestinations - numSent, 0);
+        if(tx <= 0){
+            return numSent ? static_cast<int32_t>(numSent) : static_cast<int32_t>(tx);
+        }
+        numSent += static_cast<unsigned int>(tx);
+    }
+    return static_cast<int32_t>(numSent);
+    #else
+    int32_t numSent = 0;
+    for(auto&& destination : fanOut.destinations){
+        if(SendTo(destination, bytes, size) >= 0){
+            numSent++;
+        }
+    }
+    return numSent;
+    #endif
+}
+
 int32_t UDPSocket::ReceiveFrom(IPAddress& source, uint8_t *bytes, int32_t maxSize){
     sockaddr_in addr{};
     #ifndef _WIN32
@@ -147,6 +176,46 @@ int32_t UDPSocket::ReceiveFrom(IPAddress& source, uint8_t *bytes, int32_t maxSiz
     return static_cast<int32_t>(rx);
 }
 
+int32_t UDPSocket::ReceiveMany(DatagramBatch& batch){
+    batch.numDatagrams = 0;
+    #ifdef __linux__
+    unsigned int batchSize = static_cast<unsigned int>(batch.Capacity());
+    for(unsigned int n = 0; n < batchSize; ++n){
+        batch.headers[n].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        batch.headers[n].msg_hdr.msg_flags = 0;
+        batch.headers[n].msg_len = 0;
+    }
+    int rx = recvmmsg(_socket, &batch.headers[0], batchSize, MSG_WAITFORONE, nullptr);
+    if(rx < 0){
+        return static_cast<int32_t>(rx);
+    }
+    for(int n = 0; n < rx; ++n){
+        uint32_t u32 = ntohl(NETWORK_ADDRESS_IP(batch.addresses[n]));
+        batch.sources[n].ip[0] = (uint8_t)(0x000000FF & (u32 >> 24));
+        batch.sources[n].ip[1] = (uint8_t)(0x000000FF & (u32 >> 16));
+        batch.sources[n].ip[2] = (uint8_t)(0x000000FF & (u32 >> 8));
+        batch.sources[n].ip[3] = (uint8_t)(0x000000FF & u32);
+        batch.sources[n].port = (uint16_t)ntohs(NETWORK_ADDRESS_PORT(batch.addresses[n]));
+        batch.lengths[n] = static_cast<int32_t>(batch.headers[n].msg_len);
+    }
+    batch.numDatagrams = static_cast<size_t>(rx);
+    return static_cast<int32_t>(rx);
+    #else
+    int32_t rx = ReceiveFrom(batch.sources[0], &batch.buffer[0], static_cast<int32_t>(batch.bufferSize));
+    if(rx < 0){
+        return rx;
+    }
+    batch.lengths[0] = rx;
+    batch.numDatagrams = 1;
+    return 1;
+    #endif
+}
+
+int32_t UDPSocket::SetReceiveBufferSize(int32_t size){
+    int value = static_cast<int>(size);
+    return SetOption(SOL_SOCKET, SO_RCVBUF, (const void*)&value, sizeof(value));
+}
+
 int32_t UDPSocket::SetMulticastInterface(std::array<uint8_t,4> ipGroup, std::array<uint8_t,4> ipInterface, std::string interfaceName, bool useInterfaceName){
     #ifdef _WIN32
     struct ip_mreq mreq = ConvertToMREQ(ipGroup, ipInterface, interfaceName, useInterfaceName);
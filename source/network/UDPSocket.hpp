@@ -3,6 +3,8 @@
 
 #include <Common.hpp>
 #include <IPAddress.hpp>
+#include <DatagramBatch.hpp>
+#include <DatagramFanOut.hpp>
 
 
 /**
@@ -38,6 +40,12 @@ class UDPSocket {
          */
         void Close(void);
 
+        /**
+         * @brief Get the descriptor of the socket, e.g. to wait for incoming data via poll().
+         * @return The descriptor of the socket or -1 if the socket is not open.
+         */
+        int GetDescriptor(void);
+
         /**
          * @brief Get the port bound to the socket.
          * @return The port bound to the socket or 0 in case of errors.
@@ -102,6 +110,17 @@ class UDPSocket {
          */
         int32_t SendTo(IPAddress destination, const uint8_t *bytes, int32_t size);
 
+        /**
+         * @brief Send the same bytes to all destinations of a fan-out.
+         * @param[inout] fanOut The fan-out containing all destination addresses.
+         * @param[in] bytes Bytes that should be sent.
+         * @param[in] size Number of bytes.
+         * @return Number of destinations to which the bytes have been sent. If an error occurred before any datagram has been sent, the return value is < 0.
+         * @details Under linux, sendmmsg() is used to send all datagrams with a single system call. On other systems, the
+         * datagrams are sent one after another via @ref SendTo.
+         */
+        int32_t SendToAll(DatagramFanOut& fanOut, const uint8_t *bytes, int32_t size);
+
         /**
          * @brief Receive bytes from address.
          * @param[out] address Address, where to store the sender information.
@@ -111,6 +130,22 @@ class UDPSocket {
          */
         int32_t ReceiveFrom(IPAddress& address, uint8_t *bytes, int32_t maxSize);
 
+        /**
+         * @brief Receive multiple datagrams with a single system call.
+         * @param[inout] batch The datagram batch where to store the received datagrams. The batch must have been allocated via @ref DatagramBatch::Resize.
+         * @return Number of datagrams that have been received. If an error occurred, the return value is < 0.
+         * @details Under linux, recvmmsg() is used, which blocks until at least one datagram is available and then returns all
+         * datagrams that are already queued (up to the capacity of the batch). On other systems, a single datagram is received via @ref ReceiveFrom.
+         */
+        int32_t ReceiveMany(DatagramBatch& batch);
+
+        /**
+         * @brief Set the size of the receive buffer of the socket (SO_RCVBUF).
+         * @param[in] size The size of the receive buffer in bytes.
+         * @return If no error occurs, zero is returned.
+         */
+        int32_t SetReceiveBufferSize(int32_t size);
+
         /**
          * @brief Set the network interface to be used for sending multicast traffic.
          * @param[in] ipGroup IPv4 address of the group to be joined.
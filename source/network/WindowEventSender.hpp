@@ -0,0 +1,177 @@
+#pragma once
+
+
+#include <Common.hpp>
+#include <MulticastUDPSocket.hpp>
+#include <DatagramFanOut.hpp>
+#include <WindowEventMessage.hpp>
+#include <TelemetryMessage.hpp>
+#include <Profiler.hpp>
+
+
+/**
+ * @brief The number of pooled transmit buffers of the window event sender. Must be a power of two.
+ */
+#define WINDOW_EVENT_SENDER_NUM_BUFFERS (8)
+
+
+/**
+ * @brief The size of a cache line in bytes that is used to separate data of the render thread and the sender thread.
+ */
+#define WINDOW_EVENT_SENDER_CACHE_LINE_SIZE (64)
+
+
+/**
+ * @brief Sends window event messages and telemetry messages from a dedicated thread, such that the render thread never waits for the socket.
+ * @details The render thread serializes each message once into a pooled buffer via @ref Send. The buffers form a lock-free
+ * single-producer/single-consumer ring. The sender thread sleeps on an atomic doorbell and sends each buffer to all
+ * destinations via @ref UDPSocket::SendToAll. If all buffers are in use, the message is dropped.
+ */
+class WindowEventSender {
+    public:
+        /**
+         * @brief Construct a new window event sender.
+         */
+        WindowEventSender(): socket(nullptr), sendOnlyOnChange(false), previousWidth(0), previousHeight(0), previousCameraControl(false), hasPrevious(false), numSent(0), numSkipped(0), numDropped(0), head(0), tail(0), doorbell(0), terminate(false){}
+
+        /**
+         * @brief Stop the sender thread.
+         */
+        ~WindowEventSender(){ Stop(); }
+
+        /**
+         * @brief Start the sender thread.
+         * @param[in] udpSocket The socket via which to send the messages. The socket may be closed and opened by another thread.
+         * @param[in] destinations The destination addresses to which to send the messages.
+         * @param[in] onlyOnChange True if a message should only be sent if it contains events or if the framebuffer size or the camera control mode has changed.
+         */
+        void Start(MulticastUDPSocket& udpSocket, const std::vector<IPAddress>& destinations, bool onlyOnChange){
+            Stop();
+            socket = &udpSocket;
+            fanOut.SetDestinations(destinations);
+            sendOnlyOnChange = onlyOnChange;
+            hasPrevious = false;
+            numSent = 0;
+            numSkipped = 0;
+            numDropped = 0;
+            head = 0;
+            tail = 0;
+            if(fanOut.Size()){
+                senderThread = std::thread(&WindowEventSender::SenderThread, this);
+            }
+        }
+
+        /**
+         * @brief Stop the sender thread. Messages that have not been sent are discarded.
+         */
+        void Stop(void){
+            terminate = true;
+            doorbell.fetch_add(1, std::memory_order_release);
+            doorbell.notify_one();
+            if(senderThread.joinable()){
+                senderThread.join();
+                Print("window event sender: sent=%llu, skipped=%llu, dropped=%llu\n", static_cast<unsigned long long>(numSent.load()), static_cast<unsigned long long>(numSkipped), static_cast<unsigned long long>(numDropped));
+            }
+            terminate = false;
+            socket = nullptr;
+        }
+
+        /**
+         * @brief Serialize a window event message and pass it to the sender thread.
+         * @param[inout] msg The message to be sent. The number of events is limited during serialization.
+         * @details This function must only be called by a single thread, e.g. the render thread. It never blocks. The
+         * message is discarded if there are no destinations, if it is skipped because nothing has changed or if all
+         * transmit buffers are in use.
+         */
+        void Send(WindowEventMessage& msg){
+            if(!senderThread.joinable()){
+                return;
+            }
+            bool changed = !hasPrevious || !msg.eventContainer.IsEmpty() || (previousWidth != msg.framebufferWidth) || (previousHeight != msg.framebufferHeight) || (previousCameraControl != msg.prismaCameraControlEnabled);
+            if(sendOnlyOnChange && !changed){
+                numSkipped++;
+                return;
+            }
+            if(!Enqueue(msg)){
+                return;
+            }
+            previousWidth = msg.framebufferWidth;
+            previousHeight = msg.framebufferHeight;
+            previousCameraControl = msg.prismaCameraControlEnabled;
+            hasPrevious = true;
+        }
+
+        /**
+         * @brief Serialize a telemetry message and pass it to the sender thread.
+         * @param[in] msg The message to be sent.
+         * @details This function must be called by the same thread that calls @ref Send for window event messages. It
+         * never blocks. The message is discarded if there are no destinations or if all transmit buffers are in use.
+         */
+        void Send(TelemetryMessage& msg){
+            if(senderThread.joinable()){
+                (void) Enqueue(msg);
+            }
+        }
+
+    private:
+        std::thread senderThread;                                                       // The internal sender thread.
+        MulticastUDPSocket* socket;                                                     // The socket via which to send the messages.
+        DatagramFanOut fanOut;                                                          // The destination addresses, only used by the sender thread after @ref Start.
+        std::vector<uint8_t> buffers[WINDOW_EVENT_SENDER_NUM_BUFFERS];                  // Pooled transmit buffers, the capacity is kept.
+
+        /* attributes that are only used by the producer (render thread) */
+        bool sendOnlyOnChange;                                                          // True if unchanged messages without events should be skipped.
+        uint32_t previousWidth;                                                         // Framebuffer width of the previous message.
+        uint32_t previousHeight;                                                        // Framebuffer height of the previous message.
+        bool previousCameraControl;                                                     // Camera control mode of the previous message.
+        bool hasPrevious;                                                               // True if a message has been passed to the sender thread since @ref Start.
+        std::atomic<uint64_t> numSent;                                                  // Number of messages that have been sent, written by the sender thread.
+        uint64_t numSkipped;                                                            // Number of messages that have been skipped because nothing has changed.
+        uint64_t numDropped;                                                            // Number of messages that have been dropped because all buffers were in use.
+
+        /* ring indices, both indices grow monotonically */
+        alignas(WINDOW_EVENT_SENDER_CACHE_LINE_SIZE) std::atomic<uint64_t> head;        // Index of the oldest buffer that has not been sent, written by the sender thread.
+        alignas(WINDOW_EVENT_SENDER_CACHE_LINE_SIZE) std::atomic<uint64_t> tail;        // Index of the next buffer to be filled, written by the render thread.
+        alignas(WINDOW_EVENT_SENDER_CACHE_LINE_SIZE) std::atomic<uint32_t> doorbell;    // Incremented to wake up the sender thread.
+        std::atomic<bool> terminate;                                                    // True if the sender thread should be terminated.
+
+        /**
+         * @brief Serialize a message into the next free transmit buffer and wake up the sender thread.
+         * @tparam T The message type, which must provide a Serialize(std::vector<uint8_t>&) member function.
+         * @param[inout] msg The message to be serialized.
+         * @return True if the message has been passed to the sender thread, false if all buffers are in use.
+         */
+        template <class T> bool Enqueue(T& msg){
+            uint64_t t = tail.load(std::memory_order_relaxed);
+            if((t - head.load(std::memory_order_acquire)) >= WINDOW_EVENT_SENDER_NUM_BUFFERS){
+                numDropped++;
+                return false;
+            }
+            msg.Serialize(buffers[t & (WINDOW_EVENT_SENDER_NUM_BUFFERS - 1)]);
+            tail.store(t + 1, std::memory_order_release);
+            doorbell.fetch_add(1, std::memory_order_release);
+            doorbell.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief The sender thread function.
+         */
+        void SenderThread(void){
+            profiler.SetThreadName("sender");
+            uint64_t h = head.load(std::memory_order_relaxed);
+            while(!terminate){
+                uint32_t bell = doorbell.load(std::memory_order_acquire);
+                if(h == tail.load(std::memory_order_acquire)){
+                    doorbell.wait(bell, std::memory_order_acquire);
+                    continue;
+                }
+                const std::vector<uint8_t>& bytes = buffers[h & (WINDOW_EVENT_SENDER_NUM_BUFFERS - 1)];
+                PROFILE_ZONE("SendDatagram");
+                if(socket->SendToAll(fanOut, &bytes[0], static_cast<int32_t>(bytes.size())) > 0){
+                    numSent++;
+                }
+                head.store(++h, std::memory_order_release);
+            }
+        }
+};
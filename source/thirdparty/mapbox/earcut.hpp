@@ -100,33 +100,47 @@ private:
             reset(blockSize_);
         }
         ~ObjectPool() {
-            clear();
+            release();
         }
         template <typename... Args>
         T* construct(Args&&... args) {
             if (currentIndex >= blockSize) {
-                currentBlock = alloc_traits::allocate(alloc, blockSize);
-                allocations.emplace_back(currentBlock);
+                if (usedBlocks < allocations.size()) {
+                    currentBlock = allocations[usedBlocks];
+                } else {
+                    currentBlock = alloc_traits::allocate(alloc, blockSize);
+                    allocations.emplace_back(currentBlock);
+                }
+                usedBlocks++;
                 currentIndex = 0;
             }
             T* object = &currentBlock[currentIndex++];
             alloc_traits::construct(alloc, object, std::forward<Args>(args)...);
             return object;
         }
+        // PRISMA: blocks are kept for reuse unless a larger block size is requested, such that a reused Earcut object does not allocate
         void reset(std::size_t newBlockSize) {
-            for (auto allocation : allocations) {
-                alloc_traits::deallocate(alloc, allocation, blockSize);
+            newBlockSize = std::max<std::size_t>(1, newBlockSize);
+            if (newBlockSize > blockSize) {
+                release();
+                blockSize = newBlockSize;
             }
-            allocations.clear();
-            blockSize = std::max<std::size_t>(1, newBlockSize);
+            usedBlocks = 0;
             currentBlock = nullptr;
             currentIndex = blockSize;
         }
         void clear() { reset(blockSize); }
     private:
+        void release() {
+            for (auto allocation : allocations) {
+                alloc_traits::deallocate(alloc, allocation, blockSize);
+            }
+            allocations.clear();
+        }
         T* currentBlock = nullptr;
         std::size_t currentIndex = 1;
         std::size_t blockSize = 1;
+        std::size_t usedBlocks = 0;
         std::vector<T*> allocations;
         Alloc alloc;
         typedef typename std::allocator_traits<Alloc> alloc_traits;
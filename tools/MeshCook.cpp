@@ -0,0 +1,105 @@
+/**
+ * @brief Offline tool that writes the mesh cache files for mesh files, such that PRISMA does not need to parse them at
+ * startup.
+ * @details Each argument is either a mesh file (.ply or .obj) or a directory that is searched recursively for mesh files.
+ * If no argument is given, the mesh directory of PRISMA is used. Mesh files whose cache file is up to date are skipped
+ * unless the option --force is given. The configuration file (default or given via --config) defines options that affect
+ * the cached data, e.g. engine.convertSRGBToLinearRGB.
+ *
+ * Usage: prisma-meshcook [--force] [--config <file>] [mesh files or directories]
+ */
+#include <Common.hpp>
+#include <FileManager.hpp>
+#include <ColorMesh.hpp>
+#include <TextureMesh.hpp>
+#include <MeshCache.hpp>
+#include <PrismaConfiguration.hpp>
+
+
+/**
+ * @brief Create an empty mesh for a mesh file based on its extension.
+ * @param[in] filename The name of the mesh file.
+ * @return The mesh or nullptr if the file is not a mesh file.
+ */
+static std::unique_ptr<MeshBase> CreateMesh(const std::filesystem::path& filename){
+    std::string extension = filename.extension().string();
+    if(".ply" == extension){
+        return std::make_unique<ColorMesh>();
+    }
+    if(".obj" == extension){
+        return std::make_unique<TextureMesh>();
+    }
+    return nullptr;
+}
+
+
+int main(int argc, char** argv){
+    bool force = false;
+    std::string configurationFile;
+    std::vector<std::filesystem::path> paths;
+    for(int i = 1; i < argc; ++i){
+        std::string arg(argv[i]);
+        if("--force" == arg){
+            force = true;
+        }
+        else if(("--config" == arg) && ((i + 1) < argc)){
+            configurationFile = argv[++i];
+        }
+        else{
+            paths.push_back(arg);
+        }
+    }
+    if(!prismaConfiguration.ReadFromFile(configurationFile)){
+        PrintW("Using default values for all invalid configuration values\n");
+    }
+    if(paths.empty()){
+        paths.push_back(FileName(FILENAME_DIRECTORY_MESH));
+    }
+
+    // find all mesh files
+    uint32_t numCooked = 0, numUpToDate = 0, numFailed = 0;
+    std::vector<std::filesystem::path> filenames;
+    for(auto&& path : paths){
+        std::error_code ec;
+        if(std::filesystem::is_directory(path, ec)){
+            for(auto&& entry : std::filesystem::recursive_directory_iterator(path, ec)){
+                if(entry.is_regular_file() && CreateMesh(entry.path())){
+                    filenames.push_back(entry.path());
+                }
+            }
+        }
+        else if(CreateMesh(path)){
+            filenames.push_back(path);
+        }
+        else{
+            PrintE("\"%s\" is neither a directory nor a mesh file (.ply, .obj)\n", path.string().c_str());
+            numFailed++;
+        }
+    }
+    std::sort(filenames.begin(), filenames.end());
+
+    // write cache files
+    for(auto&& filename : filenames){
+        std::string name = filename.string();
+        if(!force && MeshCache::IsUpToDate(name)){
+            std::printf("[UP TO DATE] %s\n", name.c_str());
+            numUpToDate++;
+            continue;
+        }
+        std::unique_ptr<MeshBase> mesh = CreateMesh(filename);
+        auto t0 = std::chrono::steady_clock::now();
+        if(!mesh->ReadFromFile(name) || !MeshCache::Write(name, *mesh)){
+            std::printf("[FAILED]     %s\n", name.c_str());
+            numFailed++;
+            continue;
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        std::error_code ec;
+        uintmax_t numBytes = std::filesystem::file_size(MeshCache::GetCacheFilename(name), ec);
+        std::printf("[COOKED]     %s (%llu bytes, %.1f ms)\n", name.c_str(), static_cast<unsigned long long>(ec ? 0 : numBytes), 1000.0 * std::chrono::duration<double>(t1 - t0).count());
+        numCooked++;
+    }
+    std::printf("%u cooked, %u up to date, %u failed\n", numCooked, numUpToDate, numFailed);
+    return numFailed ? 1 : 0;
+}
+